@@ -24,6 +24,7 @@
 #include "yb/tablet/transaction_participant.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/countdown_latch.h"
 
 namespace yb {
 namespace cdc {
@@ -56,11 +57,39 @@ void AddPrimaryKey(const docdb::SubDocKey& decoded_key,
 }
 } // namespace
 
+boost::optional<TransactionStatusResult> TxnStatusCache::Get(const TransactionId& txn_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = statuses_.find(txn_id);
+  if (it == statuses_.end()) {
+    return boost::none;
+  }
+  return it->second;
+}
+
+void TxnStatusCache::PutIfFinal(const TransactionId& txn_id,
+                                const TransactionStatusResult& status) {
+  if (capacity_ == 0 ||
+      (status.status != TransactionStatus::COMMITTED &&
+       status.status != TransactionStatus::ABORTED)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!statuses_.emplace(txn_id, status).second) {
+    return;
+  }
+  insertion_order_.push_back(txn_id);
+  while (insertion_order_.size() > capacity_) {
+    statuses_.erase(insertion_order_.front());
+    insertion_order_.pop_front();
+  }
+}
+
 Status CDCProducer::GetChanges(const std::string& stream_id,
                                const std::string& tablet_id,
                                const OpIdPB& from_op_id,
                                const StreamMetadata& stream_metadata,
                                const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
+                               TxnStatusCache* txn_status_cache,
                                GetChangesResponsePB* resp) {
 
   // Request scope on transaction participant so that transactions are not removed from participant
@@ -77,7 +106,7 @@ Status CDCProducer::GetChanges(const std::string& stream_id,
                                                                        &have_more_messages));
 
   TxnStatusMap txn_map = VERIFY_RESULT(BuildTxnStatusMap(
-      messages, have_more_messages, tablet_peer->Now(), txn_participant));
+      messages, have_more_messages, tablet_peer->Now(), txn_participant, txn_status_cache));
 
   OpIdPB checkpoint;
   checkpoint.set_term(0);
@@ -185,7 +214,8 @@ Result<std::vector<RecordTimeIndex>> CDCProducer::GetCommittedRecordIndexes(
 Result<TxnStatusMap> CDCProducer::BuildTxnStatusMap(const ReplicateMsgs& messages,
                                                     bool more_replicate_msgs,
                                                     const HybridTime& hybrid_time,
-                                                    TransactionParticipant* txn_participant) {
+                                                    TransactionParticipant* txn_participant,
+                                                    TxnStatusCache* txn_status_cache) {
   TxnStatusMap txn_map;
   // First go through all APPLYING records and mark transaction as committed.
   for (const auto& msg : messages) {
@@ -193,15 +223,18 @@ Result<TxnStatusMap> CDCProducer::BuildTxnStatusMap(const ReplicateMsgs& message
         && msg->transaction_state().status() == TransactionStatus::APPLYING) {
       auto txn_id = VERIFY_RESULT(FullyDecodeTransactionId(
           msg->transaction_state().transaction_id()));
-      txn_map.emplace(txn_id,
-                      TransactionStatusResult(
-                          TransactionStatus::COMMITTED,
-                          HybridTime(msg->transaction_state().commit_hybrid_time())));
+      TransactionStatusResult txn_status(
+          TransactionStatus::COMMITTED,
+          HybridTime(msg->transaction_state().commit_hybrid_time()));
+      txn_map.emplace(txn_id, txn_status);
+      txn_status_cache->PutIfFinal(txn_id, txn_status);
     }
   }
 
-  // Now go through all WRITE_OP records and get transaction status of records for which
-  // corresponding APPLYING record does not exist in WAL as yet.
+  // Now go through all WRITE_OP records and collect transactions for which corresponding
+  // APPLYING record does not exist in WAL as yet, and whose final status is not known from
+  // previous requests.
+  std::vector<TransactionId> txn_ids_to_resolve;
   for (const auto& msg : messages) {
     if (msg->op_type() == consensus::OperationType::WRITE_OP
         && msg->write_request().write_batch().has_transaction()) {
@@ -209,50 +242,70 @@ Result<TxnStatusMap> CDCProducer::BuildTxnStatusMap(const ReplicateMsgs& message
           msg->write_request().write_batch().transaction().transaction_id()));
 
       if (!txn_map.count(txn_id)) {
-        TransactionStatusResult txn_status(TransactionStatus::PENDING, HybridTime::kMin);
-
-        auto result = GetTransactionStatus(txn_id, hybrid_time, txn_participant);
-        if (!result.ok()) {
-          if (result.status().IsNotFound()) {
-            // Consider the transaction as aborted only if more_replicate_msgs is false.
-            // If more_replicate_messages is true, then it's possible that transaction is committed
-            // but we haven't read the commit message yet.
-            // Such a transaction will be considered as pending and will not be returned by CDC
-            // producer until the transaction is committed.
-            // TODO (#2405) : Handle long running or very large transactions correctly.
-            if (!more_replicate_msgs) {
-              LOG(INFO) << "Transaction not found, considering it aborted: " << txn_id;
-              txn_status = TransactionStatusResult::Aborted();
-            }
-          } else {
-            return result.status();
-          }
+        auto cached_status = txn_status_cache->Get(txn_id);
+        if (cached_status) {
+          txn_map.emplace(txn_id, *cached_status);
         } else {
-          txn_status = *result;
+          // Placeholder, replaced after the status is resolved.
+          txn_map.emplace(txn_id, TransactionStatusResult(TransactionStatus::PENDING,
+                                                          HybridTime::kMin));
+          txn_ids_to_resolve.push_back(txn_id);
         }
-        txn_map.emplace(txn_id, txn_status);
       }
     }
   }
+
+  if (txn_ids_to_resolve.empty()) {
+    return txn_map;
+  }
+
+  auto results = GetTransactionStatuses(txn_ids_to_resolve, hybrid_time, txn_participant);
+  for (size_t i = 0; i != txn_ids_to_resolve.size(); ++i) {
+    const auto& txn_id = txn_ids_to_resolve[i];
+    auto& result = results[i];
+    auto& txn_status = txn_map.find(txn_id)->second;
+    if (!result.ok()) {
+      if (result.status().IsNotFound()) {
+        // Consider the transaction as aborted only if more_replicate_msgs is false.
+        // If more_replicate_messages is true, then it's possible that transaction is committed
+        // but we haven't read the commit message yet.
+        // Such a transaction will be considered as pending and will not be returned by CDC
+        // producer until the transaction is committed.
+        // TODO (#2405) : Handle long running or very large transactions correctly.
+        if (!more_replicate_msgs) {
+          LOG(INFO) << "Transaction not found, considering it aborted: " << txn_id;
+          txn_status = TransactionStatusResult::Aborted();
+        }
+      } else {
+        return result.status();
+      }
+    } else {
+      txn_status = *result;
+      txn_status_cache->PutIfFinal(txn_id, txn_status);
+    }
+  }
   return txn_map;
 }
 
-Result<TransactionStatusResult> CDCProducer::GetTransactionStatus(
-    const TransactionId& txn_id,
+std::vector<Result<TransactionStatusResult>> CDCProducer::GetTransactionStatuses(
+    const std::vector<TransactionId>& txn_ids,
     const HybridTime& hybrid_time,
     TransactionParticipant* txn_participant) {
   static const std::string reason = "cdc";
 
-  std::promise<Result<TransactionStatusResult>> txn_status_promise;
-  auto future = txn_status_promise.get_future();
-  auto callback = [&txn_status_promise](Result<TransactionStatusResult> result) {
-    txn_status_promise.set_value(std::move(result));
-  };
-
-  txn_participant->RequestStatusAt(
-      {&txn_id, hybrid_time, hybrid_time, 0, &reason, TransactionLoadFlags{}, callback});
-  future.wait();
-  return future.get();
+  std::vector<Result<TransactionStatusResult>> results(
+      txn_ids.size(), STATUS(Incomplete, "Transaction status not received"));
+  CountDownLatch latch(txn_ids.size());
+  for (size_t i = 0; i != txn_ids.size(); ++i) {
+    auto callback = [&results, &latch, i](Result<TransactionStatusResult> result) {
+      results[i] = std::move(result);
+      latch.CountDown();
+    };
+    txn_participant->RequestStatusAt(
+        {&txn_ids[i], hybrid_time, hybrid_time, 0, &reason, TransactionLoadFlags{}, callback});
+  }
+  latch.Wait();
+  return results;
 }
 
 Status CDCProducer::SetRecordTxnAndTime(const TransactionId& txn_id,
@@ -13,10 +13,13 @@
 #ifndef ENT_SRC_YB_CDC_CDC_PRODUCER_H
 #define ENT_SRC_YB_CDC_CDC_PRODUCER_H
 
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <boost/functional/hash.hpp>
+#include <boost/optional.hpp>
 #include <boost/unordered_map.hpp>
 
 #include "yb/cdc/cdc_service.service.h"
@@ -49,6 +52,27 @@ struct StreamMetadata {
   }
 };
 
+// Bounded cache of final transaction decisions, i.e. commit time of committed transactions and
+// aborts. Shared by all tablets of the CDC service, so transactions that span several polls, or
+// several tablets, are resolved only once. The oldest entries are evicted first.
+class TxnStatusCache {
+ public:
+  explicit TxnStatusCache(size_t capacity) : capacity_(capacity) {}
+
+  boost::optional<TransactionStatusResult> Get(const TransactionId& txn_id);
+
+  // Caches status if it is final, otherwise does nothing.
+  void PutIfFinal(const TransactionId& txn_id, const TransactionStatusResult& status);
+
+ private:
+  const size_t capacity_;
+
+  std::mutex mutex_;
+  TxnStatusMap statuses_;
+  // Transaction ids in statuses_ in insertion order.
+  std::deque<TransactionId> insertion_order_;
+};
+
 class CDCProducer {
  public:
   CDCProducer() = default;
@@ -62,6 +86,7 @@ class CDCProducer {
                                    const OpIdPB& op_id,
                                    const StreamMetadata& record,
                                    const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
+                                   TxnStatusCache* txn_status_cache,
                                    GetChangesResponsePB* resp);
 
  private:
@@ -106,10 +131,12 @@ class CDCProducer {
   static Result<TxnStatusMap> BuildTxnStatusMap(const consensus::ReplicateMsgs& messages,
                                                 bool more_replicate_msgs,
                                                 const HybridTime& hybrid_time,
-                                                tablet::TransactionParticipant* txn_participant);
+                                                tablet::TransactionParticipant* txn_participant,
+                                                TxnStatusCache* txn_status_cache);
 
-  static Result<TransactionStatusResult> GetTransactionStatus(
-      const TransactionId& transaction_id,
+  // Requests statuses of all specified transactions concurrently and waits for all responses.
+  static std::vector<Result<TransactionStatusResult>> GetTransactionStatuses(
+      const std::vector<TransactionId>& transaction_ids,
       const HybridTime& hybrid_time,
       tablet::TransactionParticipant* txn_participant);
 };
@@ -30,6 +30,7 @@
 #include "yb/client/session.h"
 #include "yb/client/yb_table_name.h"
 #include "yb/client/yb_op.h"
+#include "yb/rpc/messenger.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tserver/tablet_server.h"
@@ -37,6 +38,7 @@
 #include "yb/tserver/service_util.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flag_tags.h"
+#include "yb/util/threadpool.h"
 #include "yb/yql/cql/ql/util/statement_result.h"
 
 DEFINE_int32(cdc_rpc_timeout_ms, 30 * 1000,
@@ -51,6 +53,15 @@ TAG_FLAG(cdc_ybclient_reactor_threads, advanced);
 DEFINE_int32(cdc_state_checkpoint_update_interval_ms, 15 * 1000,
              "Rate at which CDC state's checkpoint is updated.");
 
+DEFINE_int32(cdc_max_get_changes_wait_ms, 5000,
+             "Maximum time a GetChanges request waits for new changes, when there are no changes "
+             "after the requested checkpoint.");
+TAG_FLAG(cdc_max_get_changes_wait_ms, runtime);
+
+DEFINE_int32(cdc_txn_status_cache_size, 100000,
+             "Maximum number of final transaction statuses cached by the CDC service, so they "
+             "don't have to be requested again by following GetChanges requests.");
+
 namespace yb {
 namespace cdc {
 
@@ -76,6 +87,13 @@ CDCServiceImpl::CDCServiceImpl(TSTabletManager* tablet_manager,
       server->permanent_uuid(), &server->options(), server->metric_entity(), server->mem_tracker(),
       server->messenger());
   async_client_init_->Start();
+
+  std::unique_ptr<ThreadPool> get_changes_pool;
+  CHECK_OK(ThreadPoolBuilder("cdc_get_changes").Build(&get_changes_pool));
+  get_changes_pool_ = std::move(get_changes_pool);
+
+  txn_status_cache_ = std::make_shared<TxnStatusCache>(
+      std::max(FLAGS_cdc_txn_status_cache_size, 0));
 }
 
 namespace {
@@ -92,6 +110,86 @@ bool YsqlTableHasPrimaryKey(const client::YBSchema& schema) {
 bool IsTabletPeerLeader(const std::shared_ptr<tablet::TabletPeer>& peer) {
   return peer->LeaderStatus() == consensus::LeaderStatus::LEADER_AND_READY;
 }
+
+// GetChanges request that did not find changes after the requested checkpoint, so it waits till
+// new operations are majority replicated, or the deadline passes, and then reads changes again.
+// The response already contains the checkpoint without records, so it could be sent as is.
+class GetChangesWaiter : public std::enable_shared_from_this<GetChangesWaiter> {
+ public:
+  GetChangesWaiter(const GetChangesRequestPB* req, GetChangesResponsePB* resp, RpcContext context,
+                   std::shared_ptr<tablet::TabletPeer> tablet_peer, OpIdPB op_id,
+                   std::shared_ptr<StreamMetadata> stream_metadata,
+                   std::shared_ptr<ThreadPool> pool,
+                   std::shared_ptr<TxnStatusCache> txn_status_cache)
+      : req_(req), resp_(resp), context_(std::move(context)),
+        tablet_peer_(std::move(tablet_peer)), op_id_(std::move(op_id)),
+        stream_metadata_(std::move(stream_metadata)), pool_(std::move(pool)),
+        txn_status_cache_(std::move(txn_status_cache)) {
+  }
+
+  void Start(rpc::Scheduler* scheduler, CoarseTimePoint deadline) {
+    consensus_ = tablet_peer_->shared_consensus();
+    if (!consensus_) {
+      context_.RespondSuccess();
+      return;
+    }
+    auto self = shared_from_this();
+    waiter_id_ = consensus_->AddReplicatedMessagesWaiter(op_id_.index(), [self] {
+      self->Wake();
+    });
+    if (woken_.load(std::memory_order_acquire)) {
+      return;
+    }
+    scheduler->Schedule([self](const Status& status) {
+      self->consensus_->RemoveReplicatedMessagesWaiter(self->waiter_id_);
+      self->Wake();
+    }, deadline - CoarseMonoClock::Now());
+  }
+
+ private:
+  // Invoked from Raft, so reading is done in a separate thread.
+  void Wake() {
+    if (woken_.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+    auto self = shared_from_this();
+    auto status = pool_->SubmitFunc([self] { self->ReadChanges(); });
+    if (!status.ok()) {
+      context_.RespondSuccess();
+    }
+  }
+
+  void ReadChanges() {
+    if (!IsTabletPeerLeader(tablet_peer_)) {
+      // Changes will be read from the new leader by the next request.
+      context_.RespondSuccess();
+      return;
+    }
+    resp_->Clear();
+    auto s = CDCProducer::GetChanges(req_->stream_id(), req_->tablet_id(), op_id_,
+                                     *stream_metadata_, tablet_peer_, txn_status_cache_.get(),
+                                     resp_);
+    RPC_STATUS_RETURN_ERROR(
+        s,
+        resp_->mutable_error(),
+        s.IsNotFound() ? CDCErrorPB::CHECKPOINT_TOO_OLD : CDCErrorPB::UNKNOWN_ERROR,
+        context_);
+    context_.RespondSuccess();
+  }
+
+  const GetChangesRequestPB* const req_;
+  GetChangesResponsePB* const resp_;
+  RpcContext context_;
+  const std::shared_ptr<tablet::TabletPeer> tablet_peer_;
+  const OpIdPB op_id_;
+  const std::shared_ptr<StreamMetadata> stream_metadata_;
+  const std::shared_ptr<ThreadPool> pool_;
+  const std::shared_ptr<TxnStatusCache> txn_status_cache_;
+
+  std::shared_ptr<consensus::Consensus> consensus_;
+  int64_t waiter_id_ = 0;
+  std::atomic<bool> woken_{false};
+};
 } // namespace
 
 template <class ReqType, class RespType>
@@ -320,7 +418,7 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
 
   CDCProducer cdc_producer;
   s = cdc_producer.GetChanges(req->stream_id(), req->tablet_id(), op_id, *record->get(),
-                              tablet_peer, resp);
+                              tablet_peer, txn_status_cache_.get(), resp);
   RPC_STATUS_RETURN_ERROR(
       s,
       resp->mutable_error(),
@@ -333,6 +431,20 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
     RPC_STATUS_RETURN_ERROR(s, resp->mutable_error(), CDCErrorPB::INTERNAL_ERROR, context);
   }
 
+  const auto max_wait_ms = std::min<int64_t>(
+      req->wait_for_changes_ms(), FLAGS_cdc_max_get_changes_wait_ms);
+  if (max_wait_ms > 0 && resp->records_size() == 0 &&
+      resp->checkpoint().op_id().index() == op_id.index()) {
+    // Nothing was read, so instead of letting the caller poll again, wait for new changes.
+    auto deadline = std::min(
+        CoarseMonoClock::Now() + max_wait_ms * 1ms, context.GetClientDeadline());
+    auto waiter = std::make_shared<GetChangesWaiter>(
+        req, resp, std::move(context), tablet_peer, op_id, *record, get_changes_pool_,
+        txn_status_cache_);
+    waiter->Start(&tablet_manager_->server()->messenger()->scheduler(), deadline);
+    return;
+  }
+
   context.RespondSuccess();
 }
 
@@ -492,6 +604,7 @@ void CDCServiceImpl::GetCheckpoint(const GetCheckpointRequestPB* req,
 
 void CDCServiceImpl::Shutdown() {
   async_client_init_->Shutdown();
+  get_changes_pool_->Shutdown();
 }
 
 Result<OpIdPB> CDCServiceImpl::GetLastCheckpoint(
@@ -29,6 +29,8 @@
 
 namespace yb {
 
+class ThreadPool;
+
 namespace tserver {
 
 class TSTabletManager;
@@ -134,6 +136,12 @@ class CDCServiceImpl : public CDCServiceIf {
   // Map of HostPort -> CDCServiceProxy. This is used to redirect requests to tablet leader's
   // CDC service proxy.
   CDCServiceProxyMap cdc_service_map_;
+
+  // Used to read changes for GetChanges requests that were waiting for them. Shared with waiting
+  // requests, since they could outlive the service.
+  std::shared_ptr<ThreadPool> get_changes_pool_;
+
+  std::shared_ptr<TxnStatusCache> txn_status_cache_;
 };
 
 }  // namespace cdc
@@ -1,5 +1,7 @@
 // Copyright (c) YugaByte, Inc.
 
+#include <future>
+
 #include "yb/common/wire_protocol.h"
 #include "yb/common/wire_protocol-test-util.h"
 #include "yb/cdc/cdc_service.proxy.h"
@@ -280,6 +282,76 @@ TEST_F(CDCServiceTest, TestGetChanges) {
   }
 }
 
+TEST_F(CDCServiceTest, TestGetChangesWaitsForChanges) {
+  constexpr int kWaitForChangesMs = 30000;
+
+  CDCStreamId stream_id;
+  CreateCDCStream(cdc_proxy_, table_.table()->id(), &stream_id);
+
+  std::string tablet_id;
+  GetTablet(&tablet_id);
+
+  const auto& proxy = cluster_->mini_tablet_server(0)->server()->proxy();
+
+  auto write_row = [&](int32_t key, int32_t int_val, const std::string& string_val) {
+    tserver::WriteRequestPB write_req;
+    tserver::WriteResponsePB write_resp;
+    write_req.set_tablet_id(tablet_id);
+    AddTestRowInsert(key, int_val, string_val, &write_req);
+
+    RpcController rpc;
+    SCOPED_TRACE(write_req.DebugString());
+    ASSERT_OK(proxy->Write(write_req, &write_resp, &rpc));
+    SCOPED_TRACE(write_resp.DebugString());
+    ASSERT_FALSE(write_resp.has_error());
+  };
+
+  ASSERT_NO_FATALS(write_row(1, 11, "key1"));
+
+  GetChangesRequestPB change_req;
+  GetChangesResponsePB change_resp;
+  change_req.set_tablet_id(tablet_id);
+  change_req.set_stream_id(stream_id);
+  change_req.mutable_from_checkpoint()->mutable_op_id()->set_index(0);
+  change_req.mutable_from_checkpoint()->mutable_op_id()->set_term(0);
+  {
+    RpcController rpc;
+    ASSERT_OK(cdc_proxy_->GetChanges(change_req, &change_resp, &rpc));
+    ASSERT_FALSE(change_resp.has_error());
+    ASSERT_EQ(change_resp.records_size(), 1);
+  }
+
+  // Everything was read, so the next request should wait until a new row is written, instead of
+  // returning an empty response.
+  change_req.mutable_from_checkpoint()->CopyFrom(change_resp.checkpoint());
+  change_req.set_wait_for_changes_ms(kWaitForChangesMs);
+  change_resp.Clear();
+
+  RpcController rpc;
+  rpc.set_timeout(MonoDelta::FromMilliseconds(kWaitForChangesMs * 2));
+  std::promise<void> promise;
+  auto future = promise.get_future();
+  auto start = CoarseMonoClock::Now();
+  cdc_proxy_->GetChangesAsync(change_req, &change_resp, &rpc, [&promise] {
+    promise.set_value();
+  });
+
+  ASSERT_EQ(future.wait_for(std::chrono::milliseconds(500)), std::future_status::timeout);
+
+  ASSERT_NO_FATALS(write_row(2, 22, "key2"));
+
+  ASSERT_EQ(future.wait_for(std::chrono::milliseconds(kWaitForChangesMs)),
+            std::future_status::ready);
+  ASSERT_LT(CoarseMonoClock::Now() - start, std::chrono::milliseconds(kWaitForChangesMs / 2));
+
+  ASSERT_OK(rpc.status());
+  SCOPED_TRACE(change_resp.DebugString());
+  ASSERT_FALSE(change_resp.has_error());
+  ASSERT_EQ(change_resp.records_size(), 1);
+  ASSERT_NO_FATALS(AssertIntKey(change_resp.records(0).key(), 2));
+  ASSERT_NO_FATALS(AssertChangeRecords(change_resp.records(0).changes(), 22, "key2"));
+}
+
 TEST_F(CDCServiceTest, TestGetChangesInvalidStream) {
   std::string tablet_id;
   GetTablet(&tablet_id);
@@ -216,5 +216,77 @@ TEST_F(CDCServiceTxnTest, TestGetChangesForPendingTransaction) {
   }
 }
 
+
+TEST_F(CDCServiceTxnTest, TestGetChangesForManyPendingTransactions) {
+  // Statuses of all pending transactions found by GetChanges are resolved together, and statuses
+  // of committed transactions are reused by the following requests.
+  constexpr int kNumTransactions = 20;
+
+  google::protobuf::RepeatedPtrField<master::TabletLocationsPB> tablets;
+  ASSERT_OK(client_->GetTablets(table_->name(), 0, &tablets));
+  ASSERT_EQ(tablets.size(), 1);
+
+  CDCStreamId stream_id;
+  CreateCDCStream(cdc_proxy_, table_.table()->id(), &stream_id);
+
+  std::vector<client::YBTransactionPtr> txns;
+  for (int i = 0; i != kNumTransactions; ++i) {
+    auto txn = CreateTransaction();
+    auto session = CreateSession(txn);
+    ASSERT_RESULT(WriteRow(session, 10000 + i /* key */, 10000 + i /* value */,
+                           WriteOpType::INSERT, Flush::kTrue));
+    txns.push_back(txn);
+  }
+
+  GetChangesRequestPB change_req;
+  GetChangesResponsePB change_resp;
+
+  change_req.set_stream_id(stream_id);
+  change_req.set_tablet_id(tablets.Get(0).tablet_id());
+  change_req.mutable_from_checkpoint()->mutable_op_id()->set_index(0);
+  change_req.mutable_from_checkpoint()->mutable_op_id()->set_term(0);
+
+  {
+    RpcController rpc;
+    SCOPED_TRACE(change_req.DebugString());
+    ASSERT_OK(cdc_proxy_->GetChanges(change_req, &change_resp, &rpc));
+    SCOPED_TRACE(change_resp.DebugString());
+    ASSERT_FALSE(change_resp.has_error());
+
+    // Expect 0 records because no transaction is committed yet.
+    ASSERT_EQ(change_resp.records_size(), 0);
+  }
+
+  for (const auto& txn : txns) {
+    ASSERT_OK(txn->CommitFuture().get());
+  }
+
+  // Both requests should return the same rows in the same order, regardless of whether
+  // transaction statuses were resolved or taken from the cache.
+  std::vector<int32_t> first_keys;
+  for (int attempt = 0; attempt != 2; ++attempt) {
+    change_resp.Clear();
+    RpcController rpc;
+    SCOPED_TRACE(change_req.DebugString());
+    ASSERT_OK(cdc_proxy_->GetChanges(change_req, &change_resp, &rpc));
+    SCOPED_TRACE(change_resp.DebugString());
+    ASSERT_FALSE(change_resp.has_error());
+
+    std::vector<int32_t> keys;
+    for (const auto& record : change_resp.records()) {
+      if (record.changes_size() != 0) {
+        ASSERT_EQ(record.key_size(), 1);
+        keys.push_back(record.key(0).value().int32_value());
+      }
+    }
+    ASSERT_EQ(keys.size(), static_cast<size_t>(kNumTransactions));
+    if (attempt == 0) {
+      first_keys = keys;
+    } else {
+      ASSERT_EQ(keys, first_keys);
+    }
+  }
+}
+
 } // namespace cdc
 } // namespace yb
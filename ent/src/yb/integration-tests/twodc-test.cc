@@ -56,6 +56,7 @@
 #include "yb/util/atomic.h"
 #include "yb/util/cdc_test_util.h"
 #include "yb/util/faststring.h"
+#include "yb/util/metrics.h"
 #include "yb/util/random.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/test_util.h"
@@ -67,6 +68,9 @@ DECLARE_int32(cdc_wal_retention_time_secs);
 DECLARE_bool(TEST_check_broadcast_address);
 DECLARE_int32(replication_failure_delay_exponent);
 
+METRIC_DECLARE_counter(cdc_consumer_rows_applied);
+METRIC_DECLARE_counter(cdc_consumer_write_batches_applied);
+
 namespace yb {
 
 using client::YBClient;
@@ -620,6 +624,54 @@ TEST_F(TwoDCTest, ApplyOperations) {
   Destroy();
 }
 
+TEST_F(TwoDCTest, ApplyOperationsInBatches) {
+  constexpr int kNumRows = 100;
+
+  uint32_t replication_factor = NonTsanVsTsan(3, 1);
+  auto tables = ASSERT_RESULT(SetUpWithParams({1}, {1}, replication_factor));
+
+  std::vector<std::shared_ptr<client::YBTable>> producer_tables;
+  producer_tables.push_back(tables[0]);
+  ASSERT_OK(SetupUniverseReplication(
+      producer_cluster(), consumer_cluster(), consumer_client(), kUniverseId, producer_tables));
+  ASSERT_OK(CorrectlyPollingAllTablets(consumer_cluster(), 1));
+
+  // Write all rows by a single flush, so they are replicated with the same hybrid time and
+  // could be applied by a single write request.
+  auto session = producer_client()->NewSession();
+  client::TableHandle table_handle;
+  ASSERT_OK(table_handle.Open(tables[0]->name(), producer_client()));
+  for (int32_t key = 0; key != kNumRows; ++key) {
+    auto op = table_handle.NewInsertOp();
+    QLAddInt32HashValue(op->mutable_request(), key);
+    ASSERT_OK(session->Apply(op));
+  }
+  ASSERT_OK(session->Flush());
+
+  ASSERT_OK(VerifyWrittenRecords(tables[0]->name(), tables[1]->name()));
+
+  // Metrics are updated after the write response is received, so wait for them.
+  int64_t rows_applied = 0;
+  int64_t write_batches_applied = 0;
+  ASSERT_OK(LoggedWaitFor([&]() -> Result<bool> {
+    rows_applied = 0;
+    write_batches_applied = 0;
+    for (int i = 0; i != consumer_cluster()->num_tablet_servers(); ++i) {
+      const auto& metric_entity =
+          consumer_cluster()->mini_tablet_server(i)->server()->metric_entity();
+      rows_applied += METRIC_cdc_consumer_rows_applied.Instantiate(metric_entity)->value();
+      write_batches_applied +=
+          METRIC_cdc_consumer_write_batches_applied.Instantiate(metric_entity)->value();
+    }
+    return rows_applied >= kNumRows;
+  }, MonoDelta::FromSeconds(kRpcTimeout), "Wait for rows applied metric"));
+  LOG(INFO) << "Rows applied: " << rows_applied << ", write batches: " << write_batches_applied;
+  ASSERT_LT(write_batches_applied, rows_applied);
+
+  ASSERT_OK(DeleteUniverseReplication(kUniverseId));
+  Destroy();
+}
+
 TEST_F(TwoDCTest, ApplyOperationsWithTransactions) {
   uint32_t replication_factor = NonTsanVsTsan(3, 1);
   auto tables = ASSERT_RESULT(SetUpWithParams({2}, {2}, replication_factor));
@@ -55,7 +55,8 @@ Result<std::unique_ptr<CDCConsumer>> CDCConsumer::Create(
       .Build());
 
   auto cdc_consumer = std::make_unique<CDCConsumer>(
-      std::move(is_leader_for_tablet), proxy_cache, tserver->permanent_uuid(), std::move(client));
+      std::move(is_leader_for_tablet), proxy_cache, tserver->permanent_uuid(), std::move(client),
+      tserver->metric_entity());
 
   RETURN_NOT_OK(yb::Thread::Create(
       "CDCConsumer", "Poll", &CDCConsumer::RunThread, cdc_consumer.get(),
@@ -67,11 +68,13 @@ Result<std::unique_ptr<CDCConsumer>> CDCConsumer::Create(
 CDCConsumer::CDCConsumer(std::function<bool(const std::string&)> is_leader_for_tablet,
                          rpc::ProxyCache* proxy_cache,
                          const string& ts_uuid,
-                         std::unique_ptr<client::YBClient> client) :
+                         std::unique_ptr<client::YBClient> client,
+                         const scoped_refptr<MetricEntity>& metric_entity) :
   is_leader_for_tablet_(std::move(is_leader_for_tablet)),
   proxy_manager_(std::make_unique<cdc::CDCConsumerProxyManager>(proxy_cache)),
   log_prefix_(Format("[TS $0]: ", ts_uuid)),
-  client_(std::move(client)) {}
+  client_(std::move(client)),
+  output_client_metrics_(std::make_shared<TwoDCOutputClientMetrics>(metric_entity)) {}
 
 CDCConsumer::~CDCConsumer() {
   Shutdown();
@@ -190,7 +193,7 @@ void CDCConsumer::TriggerPollForNewTablets() {
           std::bind(&CDCConsumer::ShouldContinuePolling, this, entry.first),
           std::bind(&cdc::CDCConsumerProxyManager::GetProxy, proxy_manager_.get(), entry.first),
           std::bind(&CDCConsumer::RemoveFromPollersMap, this, entry.first),
-          thread_pool_.get(), client_, this);
+          thread_pool_.get(), client_, output_client_metrics_, this);
       LOG_WITH_PREFIX(INFO) << Format("Start polling for producer tablet $0",
                                       entry.first.tablet_id);
       producer_pollers_map_[entry.first] = cdc_poller;
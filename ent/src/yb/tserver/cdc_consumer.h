@@ -17,10 +17,12 @@
 #include <unordered_map>
 
 #include "yb/cdc/cdc_util.h"
+#include "yb/gutil/ref_counted.h"
 #include "yb/util/locks.h"
 
 namespace yb {
 
+class MetricEntity;
 class Thread;
 class ThreadPool;
 
@@ -48,6 +50,7 @@ namespace enterprise {
 
 class CDCPoller;
 class TabletServer;
+struct TwoDCOutputClientMetrics;
 
 class CDCConsumer {
  public:
@@ -59,7 +62,8 @@ class CDCConsumer {
   CDCConsumer(std::function<bool(const std::string&)> is_leader_for_tablet,
       rpc::ProxyCache* proxy_cache,
       const std::string& ts_uuid,
-      std::unique_ptr<client::YBClient> client);
+      std::unique_ptr<client::YBClient> client,
+      const scoped_refptr<MetricEntity>& metric_entity);
 
   ~CDCConsumer();
   void Shutdown();
@@ -118,6 +122,7 @@ class CDCConsumer {
 
   std::string log_prefix_;
   std::shared_ptr<client::YBClient> client_;
+  std::shared_ptr<TwoDCOutputClientMetrics> output_client_metrics_;
 
   bool should_run_ = true;
 
@@ -27,6 +27,9 @@ DEFINE_int32(async_replication_polling_delay_ms, 0,
              "How long to delay in ms between applying and repolling.");
 DEFINE_int32(replication_failure_delay_exponent, 16 /* ~ 2^16/1000 ~= 65 sec */,
              "Max number of failures (N) to use when calculating exponential backoff (2^N-1).");
+DEFINE_int32(async_replication_get_changes_wait_ms, 1000,
+             "How long the producer waits for new changes before responding to GetChanges, when "
+             "there are no changes. 0 to respond immediately.");
 
 DECLARE_int32(cdc_rpc_timeout_ms);
 
@@ -41,6 +44,7 @@ CDCPoller::CDCPoller(const cdc::ProducerTabletInfo& producer_tablet_info,
                      std::function<void(void)> remove_self_from_pollers_map,
                      ThreadPool* thread_pool,
                      const std::shared_ptr<client::YBClient>& client,
+                     const std::shared_ptr<TwoDCOutputClientMetrics>& output_client_metrics,
                      CDCConsumer* cdc_consumer) :
     producer_tablet_info_(producer_tablet_info),
     consumer_tablet_info_(consumer_tablet_info),
@@ -53,6 +57,7 @@ CDCPoller::CDCPoller(const cdc::ProducerTabletInfo& producer_tablet_info,
     output_client_(CreateTwoDCOutputClient(
         consumer_tablet_info,
         client,
+        output_client_metrics,
         std::bind(&CDCPoller::HandleApplyChanges, this, std::placeholders::_1))),
     thread_pool_(thread_pool),
     cdc_consumer_(cdc_consumer) {}
@@ -109,10 +114,14 @@ void CDCPoller::DoPoll() {
     *req.mutable_from_checkpoint() = checkpoint;
   }
 
+  // Let the producer respond as soon as new changes appear, instead of polling an idle tablet.
+  const auto wait_for_changes_ms = std::max(FLAGS_async_replication_get_changes_wait_ms, 0);
+  req.set_wait_for_changes_ms(wait_for_changes_ms);
+
   auto* proxy = get_proxy_();
   resp_ = std::make_unique<cdc::GetChangesResponsePB>();
   rpc_ = std::make_unique<rpc::RpcController>();
-  rpc_->set_timeout(MonoDelta::FromMilliseconds(FLAGS_cdc_rpc_timeout_ms));
+  rpc_->set_timeout(MonoDelta::FromMilliseconds(FLAGS_cdc_rpc_timeout_ms + wait_for_changes_ms));
   proxy->GetChangesAsync(req, resp_.get(), rpc_.get(), std::bind(&CDCPoller::HandlePoll, this));
 }
 
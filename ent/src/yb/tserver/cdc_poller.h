@@ -47,6 +47,7 @@ namespace tserver {
 namespace enterprise {
 
 class CDCConsumer;
+struct TwoDCOutputClientMetrics;
 
 
 class CDCPoller {
@@ -58,6 +59,7 @@ class CDCPoller {
             std::function<void(void)> remove_self_from_pollers_map,
             ThreadPool* thread_pool,
             const std::shared_ptr<client::YBClient>& client,
+            const std::shared_ptr<TwoDCOutputClientMetrics>& output_client_metrics,
             CDCConsumer* cdc_consumer);
   ~CDCPoller();
 
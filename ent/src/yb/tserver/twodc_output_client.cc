@@ -12,6 +12,8 @@
 
 #include "yb/tserver/twodc_output_client.h"
 
+#include <deque>
+#include <mutex>
 #include <shared_mutex>
 
 #include "yb/cdc/cdc_util.h"
@@ -24,27 +26,70 @@
 #include "yb/tserver/tserver_service.proxy.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/util/net/net_util.h"
 
 DEFINE_test_flag(bool, twodc_write_hybrid_time_override, false,
   "Override external_hybrid_time with initialHybridTimeValue for testing.");
 
+DEFINE_int32(cdc_consumer_write_batch_max_records, 512,
+             "Maximum number of replicated records written to a consumer tablet by a single "
+             "write request.");
+TAG_FLAG(cdc_consumer_write_batch_max_records, runtime);
+
+DEFINE_int32(cdc_consumer_max_inflight_write_batches, 16,
+             "Maximum number of write requests sent concurrently to consumer tablets while "
+             "applying changes of a single producer tablet. Requests to the same consumer tablet "
+             "are sent one at a time, so writes of the same row are applied in order.");
+TAG_FLAG(cdc_consumer_max_inflight_write_batches, runtime);
+
 DECLARE_int32(cdc_rpc_timeout_ms);
 
+METRIC_DEFINE_counter(server, cdc_consumer_rows_applied, "CDC Consumer Rows Applied",
+                      yb::MetricUnit::kRows,
+                      "Number of replicated rows written to consumer tablets.");
+
+METRIC_DEFINE_counter(server, cdc_consumer_write_batches_applied,
+                      "CDC Consumer Write Batches Applied", yb::MetricUnit::kRequests,
+                      "Number of write requests with replicated rows sent to consumer tablets.");
+
+METRIC_DEFINE_histogram(server, cdc_consumer_write_batch_size, "CDC Consumer Write Batch Size",
+                        yb::MetricUnit::kRows,
+                        "Number of replicated rows written by a single write request.",
+                        10000, 2);
+
+METRIC_DEFINE_histogram(server, cdc_consumer_write_batch_latency,
+                        "CDC Consumer Write Batch Latency", yb::MetricUnit::kMicroseconds,
+                        "Microseconds spent writing a batch of replicated rows to a consumer "
+                        "tablet.",
+                        60000000LU, 2);
+
 namespace yb {
 namespace tserver {
 namespace enterprise {
 
 using rpc::Rpc;
 
+#define MINIT(x) x(METRIC_cdc_consumer_##x.Instantiate(metric_entity))
+TwoDCOutputClientMetrics::TwoDCOutputClientMetrics(
+    const scoped_refptr<MetricEntity>& metric_entity)
+    : MINIT(rows_applied),
+      MINIT(write_batches_applied),
+      MINIT(write_batch_size),
+      MINIT(write_batch_latency) {
+}
+#undef MINIT
+
 class TwoDCOutputClient : public cdc::CDCOutputClient {
  public:
   TwoDCOutputClient(
       const cdc::ConsumerTabletInfo& consumer_tablet_info,
       const std::shared_ptr<client::YBClient>& client,
+      const std::shared_ptr<TwoDCOutputClientMetrics>& metrics,
       std::function<void(const cdc::OutputClientResponse& response)> apply_changes_clbk) :
       consumer_tablet_info_(consumer_tablet_info),
       client_(client),
+      metrics_(metrics),
       apply_changes_clbk_(std::move(apply_changes_clbk)) {}
 
   ~TwoDCOutputClient() {
@@ -60,13 +105,26 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
   rpc::Rpcs::Handle RegisterRpc(rpc::RpcCommandPtr call);
   rpc::RpcCommandPtr UnregisterRpc(rpc::Rpcs::Handle* handle);
 
-  void WriteCDCRecordDone(
-      const Status& status, const WriteResponsePB& response, const size_t record_idx);
-
  private:
+  // Records written to a consumer tablet by a single write request. All records of a batch have
+  // the same hybrid time, since it is specified per request.
+  struct WriteBatch {
+    client::internal::RemoteTablet* tablet;
+    std::vector<size_t> record_idxs;
+  };
+
   void TabletLookupCallback(
       const size_t record_idx, const Result<client::internal::RemoteTabletPtr>& tablet);
-  void SendCDCWriteToTablet(const size_t record_idx);
+
+  // Groups records by consumer tablet into write batches, keeping the order of records within
+  // each tablet.
+  void PrepareWriteBatches();
+  // Sends next batches of tablets that don't have a batch in flight, while the number of batches
+  // in flight is below the limit.
+  void SendWriteBatches();
+  void SendWriteBatch(WriteBatch batch);
+  void WriteBatchDone(const Status& status, const WriteResponsePB& response,
+                      const WriteBatch& batch, CoarseTimePoint start);
 
   void IncProcessedRecordCount();
 
@@ -75,6 +133,7 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
 
   cdc::ConsumerTabletInfo consumer_tablet_info_;
   std::shared_ptr<client::YBClient> client_;
+  std::shared_ptr<TwoDCOutputClientMetrics> metrics_;
   std::function<void(const cdc::OutputClientResponse& response)> apply_changes_clbk_;
 
   rpc::Rpcs rpcs_;
@@ -93,13 +152,24 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
 
   // This will cache the response to an ApplyChanges() request.
   cdc::GetChangesResponsePB resp_;
+
+  std::mutex batches_mutex_;
+  // Write batches of each consumer tablet that were not sent yet.
+  std::unordered_map<client::internal::RemoteTablet*, std::deque<WriteBatch>> tablet_batches_;
+  // Tablets with pending write batches and without a batch in flight.
+  std::deque<client::internal::RemoteTablet*> ready_tablets_;
+  size_t inflight_batches_ = 0;
+  size_t remaining_batches_ = 0;
+  bool write_failed_ = false;
 };
 
 Status TwoDCOutputClient::ApplyChanges(const cdc::GetChangesResponsePB* resp) {
   // ApplyChanges is called in a single threaded manner.
   // For all the changes in GetChangesResponsePB, we first fan out and find the tablet for
   // every record key.
-  // Then we apply the records in the same order in which we received them.
+  // Then records are grouped by tablet into write batches. Batches of different tablets are
+  // written concurrently, while batches of the same tablet are written in the same order in which
+  // we received the records, so changes of the same row are applied in order.
   // Once all changes have been applied (successfully or not), we invoke the callback which will
   // then either poll for next set of changes (in case of successful application) or will try to
   // re-apply.
@@ -205,61 +275,135 @@ void TwoDCOutputClient::TabletLookupCallback(
       HandleResponse();
     } else {
       // Apply the writes on consumer.
-      SendCDCWriteToTablet(0);
+      PrepareWriteBatches();
+      SendWriteBatches();
     }
   }
 }
 
-void TwoDCOutputClient::SendCDCWriteToTablet(const size_t record_idx) {
-  client::internal::RemoteTablet* tablet;
-  {
-    std::shared_lock<decltype(lock_)> l(lock_);
-    tablet = records_[record_idx];
+void TwoDCOutputClient::PrepareWriteBatches() {
+  const size_t max_records = std::max(FLAGS_cdc_consumer_write_batch_max_records, 1);
+
+  std::shared_lock<decltype(lock_)> l(lock_);
+  std::lock_guard<std::mutex> batches_lock(batches_mutex_);
+  tablet_batches_.clear();
+  ready_tablets_.clear();
+  inflight_batches_ = 0;
+  remaining_batches_ = 0;
+  write_failed_ = false;
+
+  for (int i = 0; i < resp_.records_size(); ++i) {
+    auto* tablet = records_[i];
+    auto& batches = tablet_batches_[tablet];
+    if (batches.empty()) {
+      ready_tablets_.push_back(tablet);
+    }
+    if (batches.empty() || batches.back().record_idxs.size() >= max_records ||
+        resp_.records(batches.back().record_idxs.back()).time() != resp_.records(i).time()) {
+      batches.push_back(WriteBatch{tablet, {}});
+      ++remaining_batches_;
+    }
+    batches.back().record_idxs.push_back(i);
   }
+}
 
+void TwoDCOutputClient::SendWriteBatches() {
+  const size_t max_inflight_batches = std::max(FLAGS_cdc_consumer_max_inflight_write_batches, 1);
+  for (;;) {
+    WriteBatch batch;
+    {
+      std::lock_guard<std::mutex> l(batches_mutex_);
+      if (write_failed_ || ready_tablets_.empty() || inflight_batches_ >= max_inflight_batches) {
+        return;
+      }
+      auto& batches = tablet_batches_[ready_tablets_.front()];
+      ready_tablets_.pop_front();
+      batch = std::move(batches.front());
+      batches.pop_front();
+      ++inflight_batches_;
+    }
+    SendWriteBatch(std::move(batch));
+  }
+}
+
+void TwoDCOutputClient::SendWriteBatch(WriteBatch batch) {
   WriteRequestPB req;
-  req.set_tablet_id(tablet->tablet_id());
+  req.set_tablet_id(batch.tablet->tablet_id());
   if (PREDICT_FALSE(FLAGS_twodc_write_hybrid_time_override)) {
     // Used only for testing external hybrid time.
     req.set_external_hybrid_time(yb::kInitialHybridTimeValue);
   } else {
-    req.set_external_hybrid_time(resp_.records(record_idx).time());
+    req.set_external_hybrid_time(resp_.records(batch.record_idxs.front()).time());
   }
 
-  for (const auto& kv_pair : resp_.records(record_idx).changes()) {
-    auto* write_pair = req.mutable_write_batch()->add_write_pairs();
-    write_pair->set_key(kv_pair.key());
-    write_pair->set_value(kv_pair.value().binary_value());
+  for (auto record_idx : batch.record_idxs) {
+    for (const auto& kv_pair : resp_.records(record_idx).changes()) {
+      auto* write_pair = req.mutable_write_batch()->add_write_pairs();
+      write_pair->set_key(kv_pair.key());
+      write_pair->set_value(kv_pair.value().binary_value());
+    }
   }
 
-  auto deadline = CoarseMonoClock::Now() + MonoDelta::FromMilliseconds(FLAGS_cdc_rpc_timeout_ms);
+  auto start = CoarseMonoClock::Now();
+  auto deadline = start + MonoDelta::FromMilliseconds(FLAGS_cdc_rpc_timeout_ms);
   auto write_rpc = WriteCDCRecord(
       deadline,
-      tablet,
+      batch.tablet,
       client_.get(),
       std::bind(&TwoDCOutputClient::RegisterRpc, this, std::placeholders::_1),
       std::bind(&TwoDCOutputClient::UnregisterRpc, this, std::placeholders::_1),
       &req,
-      std::bind(&TwoDCOutputClient::WriteCDCRecordDone, this,
-                std::placeholders::_1, std::placeholders::_2, record_idx));
+      [this, batch = std::move(batch), start](
+          const Status& status, const WriteResponsePB& response) {
+        WriteBatchDone(status, response, batch, start);
+      });
 }
 
-void TwoDCOutputClient::WriteCDCRecordDone(
-    const Status& status, const WriteResponsePB& response, size_t record_idx) {
-  VLOG(1) << "Wrote CDC record: " << status << ": " << response.DebugString();
-  if (!status.ok()) {
-    HandleError(status, resp_.records(record_idx));
-    return;
-  } else if (response.has_error()) {
-    HandleError(StatusFromPB(response.error().status()), resp_.records(record_idx));
-    return;
+void TwoDCOutputClient::WriteBatchDone(
+    const Status& status, const WriteResponsePB& response, const WriteBatch& batch,
+    CoarseTimePoint start) {
+  VLOG(1) << "Wrote " << batch.record_idxs.size() << " CDC records: " << status << ": "
+          << response.DebugString();
+  Status s = status;
+  if (s.ok() && response.has_error()) {
+    s = StatusFromPB(response.error().status());
+  }
+
+  if (!s.ok()) {
+    LOG(ERROR) << "Error while applying " << batch.record_idxs.size() << " replicated records to "
+               << batch.tablet->tablet_id() << ", first record "
+               << resp_.records(batch.record_idxs.front()).DebugString() << ": " << s;
+    std::lock_guard<decltype(lock_)> l(lock_);
+    error_status_ = s;
+  } else {
+    metrics_->rows_applied->IncrementBy(batch.record_idxs.size());
+    metrics_->write_batches_applied->Increment();
+    metrics_->write_batch_size->Increment(batch.record_idxs.size());
+    metrics_->write_batch_latency->Increment(
+        MonoDelta(CoarseMonoClock::Now() - start).ToMicroseconds());
+  }
+
+  bool done;
+  {
+    std::lock_guard<std::mutex> l(batches_mutex_);
+    --inflight_batches_;
+    if (!s.ok()) {
+      // Remaining batches are not sent, all changes will be applied again.
+      write_failed_ = true;
+    } else {
+      --remaining_batches_;
+      if (!tablet_batches_[batch.tablet].empty()) {
+        ready_tablets_.push_back(batch.tablet);
+      }
+    }
+    done = inflight_batches_ == 0 && (write_failed_ || remaining_batches_ == 0);
   }
 
-  if (record_idx == resp_.records_size() - 1) {
-    // Last record, return response to caller.
+  if (done) {
+    // Last batch, return response to caller.
     HandleResponse();
   } else {
-    SendCDCWriteToTablet(record_idx + 1);
+    SendWriteBatches();
   }
 }
 
@@ -296,9 +440,10 @@ void TwoDCOutputClient::IncProcessedRecordCount() {
 std::unique_ptr<cdc::CDCOutputClient> CreateTwoDCOutputClient(
     const cdc::ConsumerTabletInfo& consumer_tablet_info,
     const std::shared_ptr<client::YBClient>& client,
+    const std::shared_ptr<TwoDCOutputClientMetrics>& metrics,
     std::function<void(const cdc::OutputClientResponse& response)> apply_changes_clbk) {
   return std::make_unique<TwoDCOutputClient>(
-      consumer_tablet_info, client, std::move(apply_changes_clbk));
+      consumer_tablet_info, client, metrics, std::move(apply_changes_clbk));
 }
 
 } // namespace enterprise
@@ -13,11 +13,16 @@
 #include "yb/cdc/cdc_output_client_interface.h"
 #include "yb/cdc/cdc_util.h"
 
+#include "yb/gutil/ref_counted.h"
+
 #ifndef ENT_SRC_YB_TSERVER_TWODC_OUTPUT_CLIENT_H
 #define ENT_SRC_YB_TSERVER_TWODC_OUTPUT_CLIENT_H
 
 namespace yb {
 
+class Counter;
+class Histogram;
+class MetricEntity;
 class ThreadPool;
 
 namespace client {
@@ -29,9 +34,20 @@ class YBClient;
 namespace tserver {
 namespace enterprise {
 
+// Metrics of replicated changes applied by all output clients of a tablet server.
+struct TwoDCOutputClientMetrics {
+  explicit TwoDCOutputClientMetrics(const scoped_refptr<MetricEntity>& metric_entity);
+
+  scoped_refptr<Counter> rows_applied;
+  scoped_refptr<Counter> write_batches_applied;
+  scoped_refptr<Histogram> write_batch_size;
+  scoped_refptr<Histogram> write_batch_latency;
+};
+
 std::unique_ptr<cdc::CDCOutputClient> CreateTwoDCOutputClient(
     const cdc::ConsumerTabletInfo& consumer_tablet_info,
     const std::shared_ptr<client::YBClient>& client,
+    const std::shared_ptr<TwoDCOutputClientMetrics>& metrics,
     std::function<void(const cdc::OutputClientResponse& response)> apply_changes_clbk);
 
 } // namespace enterprise
@@ -0,0 +1,90 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+package org.yb.cql;
+
+import java.util.*;
+
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+import org.yb.client.TestUtils;
+import org.yb.minicluster.BaseMiniClusterTest;
+import org.yb.minicluster.RocksDBMetrics;
+
+import org.yb.YBTestRunner;
+
+import org.junit.runner.RunWith;
+
+@RunWith(value=YBTestRunner.class)
+public class TestIndexBackfill extends BaseCQLTest {
+
+  @BeforeClass
+  public static void SetUpBeforeClass() throws Exception {
+    BaseMiniClusterTest.masterArgs.add("--enable_index_backfill");
+    // Use small chunks, so every tablet is backfilled by several requests.
+    BaseMiniClusterTest.tserverArgs.add("--index_backfill_write_batch_size=16");
+    BaseCQLTest.setUpBeforeClass();
+  }
+
+  @Test
+  public void testBackfillExistingRows() throws Exception {
+    // Create and populate the table before the index exists.
+    session.execute("create table test_backfill (h int, r int, v1 text, v2 int," +
+                    "  primary key ((h), r)) with transactions = {'enabled' : true};");
+    for (int h = 1; h <= 5; h++) {
+      for (int r = 1; r <= 100; r++) {
+        int val = (r == 3) ? 333 : h * 10 + r;
+        session.execute("insert into test_backfill (h, r, v1, v2) values (?, ?, ?, ?);",
+                        h, r, "v" + val, val);
+      }
+    }
+
+    session.execute("create index test_backfill_by_v1 on test_backfill (v1) include (v2);");
+
+    // Rows written while the index is backfilled are indexed by the writes themselves.
+    session.execute("insert into test_backfill (h, r, v1, v2) values (6, 3, 'v333', 333);");
+    session.execute("delete from test_backfill where h = 5 and r = 3;");
+
+    // Wait until the index is readable and used to serve the query.
+    TestUtils.waitFor(() -> {
+      RocksDBMetrics indexMetrics = getRocksDBMetric("test_backfill_by_v1");
+      session.execute("select * from test_backfill where v1 = 'v333';");
+      return getRocksDBMetric("test_backfill_by_v1").subtract(indexMetrics).nextCount > 0;
+    }, 60000);
+
+    assertQuery("select * from test_backfill where v1 = 'v333';",
+                new HashSet<String>(Arrays.asList("Row[1, 3, v333, 333]",
+                                                  "Row[2, 3, v333, 333]",
+                                                  "Row[3, 3, v333, 333]",
+                                                  "Row[4, 3, v333, 333]",
+                                                  "Row[6, 3, v333, 333]")));
+    assertQuery("select v2 from test_backfill where v1 = 'v145';", "Row[145]");
+  }
+
+  @Test
+  public void testBackfillEmptyTable() throws Exception {
+    // Tablets of an empty table are not scanned, rows written later are indexed by the writes.
+    session.execute("create table test_backfill_empty (h int, r int, v text," +
+                    "  primary key ((h), r)) with transactions = {'enabled' : true};");
+    session.execute("create index test_backfill_empty_by_v on test_backfill_empty (v);");
+    session.execute("insert into test_backfill_empty (h, r, v) values (1, 1, 'v1');");
+
+    TestUtils.waitFor(() -> {
+      RocksDBMetrics indexMetrics = getRocksDBMetric("test_backfill_empty_by_v");
+      session.execute("select * from test_backfill_empty where v = 'v1';");
+      return getRocksDBMetric("test_backfill_empty_by_v").subtract(indexMetrics).nextCount > 0;
+    }, 60000);
+
+    assertQuery("select * from test_backfill_empty where v = 'v1';", "Row[1, 1, v1]");
+  }
+}
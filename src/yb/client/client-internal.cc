@@ -1060,24 +1060,7 @@ void GetTableSchemaRpc::Finished(const Status& status) {
   auto retained_self = client_->data_->rpcs_.Unregister(&retained_self_);
 
   if (new_status.ok()) {
-    std::unique_ptr<Schema> schema(new Schema());
-    new_status = SchemaFromPB(resp_.schema(), schema.get());
-    if (new_status.ok()) {
-      info_->schema.Reset(std::move(schema));
-      info_->schema.set_version(resp_.version());
-      new_status = PartitionSchema::FromPB(resp_.partition_schema(),
-                                           GetSchema(&info_->schema),
-                                           &info_->partition_schema);
-
-      info_->table_name.GetFromTableIdentifierPB(resp_.identifier());
-      info_->table_id = resp_.identifier().table_id();
-      YBTable::PBToClientTableType(resp_.table_type(), &info_->table_type);
-      info_->index_map.FromPB(resp_.indexes());
-      if (resp_.has_index_info()) {
-        info_->index_info.emplace(resp_.index_info());
-      }
-      CHECK_GT(info_->table_id.size(), 0) << "Running against a too-old master";
-    }
+    new_status = CreateTableInfoFromTableSchemaResp(resp_, info_);
   }
   if (!new_status.ok()) {
     LOG(WARNING) << ToString() << " failed: " << new_status.ToString();
@@ -1264,6 +1247,27 @@ void DeleteCDCStreamRpc::Finished(const Status& status) {
 
 } // namespace internal
 
+Status CreateTableInfoFromTableSchemaResp(
+    const master::GetTableSchemaResponsePB& resp, YBTableInfo* info) {
+  std::unique_ptr<Schema> schema(new Schema());
+  RETURN_NOT_OK(SchemaFromPB(resp.schema(), schema.get()));
+  info->schema.Reset(std::move(schema));
+  info->schema.set_version(resp.version());
+  RETURN_NOT_OK(PartitionSchema::FromPB(resp.partition_schema(),
+                                        GetSchema(&info->schema),
+                                        &info->partition_schema));
+
+  info->table_name.GetFromTableIdentifierPB(resp.identifier());
+  info->table_id = resp.identifier().table_id();
+  YBTable::PBToClientTableType(resp.table_type(), &info->table_type);
+  info->index_map.FromPB(resp.indexes());
+  if (resp.has_index_info()) {
+    info->index_info.emplace(resp.index_info());
+  }
+  CHECK_GT(info->table_id.size(), 0) << "Running against a too-old master";
+  return Status::OK();
+}
+
 Status YBClient::Data::GetTableSchema(YBClient* client,
                                       const YBTableName& table_name,
                                       CoarseTimePoint deadline,
@@ -341,6 +341,10 @@ class YBClient::Data {
   DISALLOW_COPY_AND_ASSIGN(Data);
 };
 
+// Fills info from the response to GetTableSchema master request.
+CHECKED_STATUS CreateTableInfoFromTableSchemaResp(
+    const master::GetTableSchemaResponsePB& resp, YBTableInfo* info);
+
 // Retry helper, takes a function like:
 //     CHECKED_STATUS funcName(const MonoTime& deadline, bool *retry, ...)
 // The function should set the retry flag (default true) if the function should
@@ -81,6 +81,7 @@
 #include "yb/tserver/mini_tablet_server.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/tserver/tserver_service.proxy.h"
 
 #include "yb/util/capabilities.h"
 #include "yb/util/metrics.h"
@@ -2047,6 +2048,65 @@ TEST_F(ClientTest, TestReadFromFollower) {
   }
 }
 
+TEST_F(ClientTest, TabletServerTableCache) {
+  tserver::TabletServerServiceProxy proxy(
+      &client_->proxy_cache(),
+      HostPort::FromBoundEndpoint(cluster_->mini_tablet_server(0)->bound_rpc_addr()));
+
+  auto get_table_info = [this, &proxy](boost::optional<uint32_t> outdated_schema_version)
+      -> Result<tserver::GetTableInfoResponsePB> {
+    tserver::GetTableInfoRequestPB req;
+    tserver::GetTableInfoResponsePB resp;
+    req.set_table_id(client_table_->id());
+    if (outdated_schema_version) {
+      req.set_outdated_schema_version(*outdated_schema_version);
+    }
+    rpc::RpcController controller;
+    controller.set_timeout(MonoDelta::FromSeconds(15));
+    RETURN_NOT_OK(proxy.GetTableInfo(req, &resp, &controller));
+    if (resp.has_error()) {
+      return StatusFromPB(resp.error().status());
+    }
+    return resp;
+  };
+
+  auto resp = ASSERT_RESULT(get_table_info(boost::none));
+  std::shared_ptr<YBTable> table;
+  ASSERT_OK(client_->OpenTable(
+      resp.schema(), std::vector<std::string>(resp.partitions().begin(), resp.partitions().end()),
+      &table));
+  ASSERT_EQ(client_table_->id(), table->id());
+  ASSERT_EQ(client_table_->name(), table->name());
+  ASSERT_EQ(client_table_->table_type(), table->table_type());
+  ASSERT_TRUE(client_table_->schema().Equals(table->schema()));
+  ASSERT_EQ(client_table_->GetPartitions(), table->GetPartitions());
+  const auto old_version = table->schema().version();
+
+  gscoped_ptr<YBTableAlterer> table_alterer(client_->NewTableAlterer(kTableName));
+  table_alterer->AddColumn("new_col")->Type(INT32);
+  ASSERT_OK(table_alterer->Alter());
+
+  // Cached information is returned until the caller reports that its schema version is outdated.
+  resp = ASSERT_RESULT(get_table_info(boost::none));
+  ASSERT_EQ(old_version, resp.schema().version());
+  resp = ASSERT_RESULT(get_table_info(old_version));
+  ASSERT_GT(resp.schema().version(), old_version);
+  ASSERT_EQ(client_table_->schema().num_columns() + 1,
+            static_cast<size_t>(resp.schema().schema().columns_size()));
+
+  // Information about missing table is not cached.
+  {
+    tserver::GetTableInfoRequestPB req;
+    tserver::GetTableInfoResponsePB missing_resp;
+    req.set_table_id("missing_table_id");
+    rpc::RpcController controller;
+    controller.set_timeout(MonoDelta::FromSeconds(15));
+    ASSERT_OK(proxy.GetTableInfo(req, &missing_resp, &controller));
+    ASSERT_TRUE(missing_resp.has_error());
+    ASSERT_TRUE(StatusFromPB(missing_resp.error().status()).IsNotFound());
+  }
+}
+
 TEST_F(ClientTest, Capability) {
   constexpr CapabilityId kFakeCapability = 0x9c40e9a7;
 
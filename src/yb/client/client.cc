@@ -1284,6 +1284,18 @@ Status YBClient::OpenTable(const TableId& table_id, shared_ptr<YBTable>* table)
   return Status::OK();
 }
 
+Status YBClient::OpenTable(const master::GetTableSchemaResponsePB& schema,
+                           std::vector<std::string> partitions,
+                           shared_ptr<YBTable>* table) {
+  YBTableInfo info;
+  RETURN_NOT_OK(CreateTableInfoFromTableSchemaResp(schema, &info));
+
+  std::shared_ptr<YBTable> ret(new YBTable(this, info));
+  ret->Open(std::move(partitions));
+  table->swap(ret);
+  return Status::OK();
+}
+
 shared_ptr<YBSession> YBClient::NewSession() {
   return std::make_shared<YBSession>(this);
 }
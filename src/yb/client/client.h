@@ -495,6 +495,12 @@ class YBClient {
   CHECKED_STATUS OpenTable(const YBTableName& table_name, std::shared_ptr<YBTable>* table);
   CHECKED_STATUS OpenTable(const TableId& table_id, std::shared_ptr<YBTable>* table);
 
+  // Open the table using the schema and partitions fetched in advance, e.g. from the tablet server
+  // cache, without RPCs to master.
+  CHECKED_STATUS OpenTable(const master::GetTableSchemaResponsePB& schema,
+                           std::vector<std::string> partitions,
+                           std::shared_ptr<YBTable>* table);
+
   // Create a new session for interacting with the cluster.
   // User is responsible for destroying the session object.
   // This is a fully local operation (no RPCs or blocking).
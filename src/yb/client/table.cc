@@ -266,6 +266,15 @@ Status YBTable::Open() {
   return Status::OK();
 }
 
+void YBTable::Open(std::vector<std::string> partitions) {
+  partitions_ = std::move(partitions);
+  std::sort(partitions_.begin(), partitions_.end());
+  table_type_ = info_.table_type;
+
+  VLOG(1) << "Open Table " << info_.table_name.ToString() << ", with "
+          << partitions_.size() << " known tablets";
+}
+
 //--------------------------------------------------------------------------------------------------
 
 YBPgsqlWriteOp* YBTable::NewPgsqlWrite() {
@@ -122,6 +122,9 @@ class YBTable : public std::enable_shared_from_this<YBTable> {
 
   CHECKED_STATUS Open();
 
+  // Opens the table using partitions fetched in advance.
+  void Open(std::vector<std::string> partitions);
+
   client::YBClient* const client_;
   YBTableType table_type_;
   YBTableInfo info_;
@@ -87,6 +87,13 @@ class IndexInfo {
     return use_mangled_column_name_;
   }
 
+  IndexPermissions index_permissions() const { return index_permissions_; }
+
+  // Could the index be used to serve reads? An index that is being backfilled is not readable.
+  bool HasReadPermission() const {
+    return index_permissions_ == IndexPermissions::INDEX_PERM_READ_WRITE_AND_DELETE;
+  }
+
  private:
   const TableId table_id_;            // Index table id.
   const TableId indexed_table_id_;    // Indexed table id.
@@ -104,6 +111,8 @@ class IndexInfo {
 
   // Newer INDEX use mangled column name instead of ID.
   bool use_mangled_column_name_ = false;
+
+  IndexPermissions index_permissions_ = IndexPermissions::INDEX_PERM_READ_WRITE_AND_DELETE;
 };
 
 // A map to look up an index by its index table id.
@@ -341,6 +341,14 @@ class Consensus {
   virtual MicrosTime MajorityReplicatedHtLeaseExpiration(
       MicrosTime min_allowed, CoarseTimePoint deadline) const = 0;
 
+  // Returns true if the leader was idle long enough, so peers could stop sending heartbeats till
+  // the next request.
+  virtual bool IsQuiescenceAllowed() const { return false; }
+
+  // Notifies the leader that it is going to serve a request, so peers should resume heartbeats if
+  // they were suspended.
+  virtual void NoteLeaderActivity() const {}
+
   // This includes heartbeats too.
   virtual MonoTime TimeSinceLastMessageFromLeader() = 0;
 
@@ -348,6 +356,15 @@ class Consensus {
   virtual CHECKED_STATUS ReadReplicatedMessagesForCDC(const OpId& from, ReplicateMsgs* msgs,
                                                       bool* have_more_messages) = 0;
 
+  // Registers callback that is invoked once operations after the specified index are majority
+  // replicated, so ReadReplicatedMessagesForCDC would return them, or when this replica stops
+  // being leader. Callback could be invoked before this method returns, and should not block.
+  // Returns id of the waiter.
+  virtual int64_t AddReplicatedMessagesWaiter(int64_t index, std::function<void()> callback) = 0;
+
+  // Removes waiter that was not invoked yet.
+  virtual void RemoveReplicatedMessagesWaiter(int64_t id) = 0;
+
  protected:
   friend class RefCountedThreadSafe<Consensus>;
   friend class tablet::TabletPeer;
@@ -21,8 +21,10 @@ namespace yb {
 namespace consensus {
 
 class Consensus;
+class MultiRaftManager;
 class PeerProxyFactory;
 class PeerMessageQueue;
+class RaftConsensus;
 class ReplicaOperationFactory;
 class ReplicateMsg;
 class ReplicateMsgsHolder;
@@ -50,6 +52,9 @@ typedef scoped_refptr<LeaderElection> LeaderElectionPtr;
 class PeerProxy;
 typedef std::unique_ptr<PeerProxy> PeerProxyPtr;
 
+class MultiRaftHeartbeatBatcher;
+typedef std::shared_ptr<MultiRaftHeartbeatBatcher> MultiRaftHeartbeatBatcherPtr;
+
 struct LeaderElectionData;
 
 // The elected Leader (this peer) can be in not-ready state because it's not yet synced.
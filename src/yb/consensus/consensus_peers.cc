@@ -48,6 +48,7 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/consensus_queue.h"
 #include "yb/consensus/log.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/replicate_msgs_holder.h"
 
 #include "yb/gutil/map-util.h"
@@ -80,6 +81,7 @@ DEFINE_int32(max_wait_for_processresponse_before_closing_ms, 5000,
 TAG_FLAG(max_wait_for_processresponse_before_closing_ms, advanced);
 
 DECLARE_int32(raft_heartbeat_interval_ms);
+DECLARE_bool(enable_multi_raft_heartbeat_batcher);
 
 DEFINE_test_flag(double, fault_crash_on_leader_request_fraction, 0.0,
                  "Fraction of the time when the leader will crash just before sending an "
@@ -146,7 +148,9 @@ Status Peer::Init() {
   heartbeater_ = PeriodicTimer::Create(
       messenger_,
       [weak_peer]() {
-        if (auto p = weak_peer.lock()) {
+        auto p = weak_peer.lock();
+        // Stopped heartbeater could still run the task, it should not wake the quiescent peer.
+        if (p && !p->quiescent_.load(std::memory_order_acquire)) {
           Status s = p->SignalRequest(RequestTriggerMode::kAlwaysSend);
         }
       },
@@ -157,10 +161,19 @@ Status Peer::Init() {
 }
 
 Status Peer::SignalRequest(RequestTriggerMode trigger_mode) {
+  if (PREDICT_FALSE(quiescent_.load(std::memory_order_acquire)) &&
+      quiescent_.exchange(false, std::memory_order_acq_rel)) {
+    ResumeHeartbeats();
+  }
+
   // If the peer is currently sending, return Status::OK().
   // If there are new requests in the queue we'll get them on ProcessResponse().
   auto performing_lock = LockPerforming(std::try_to_lock);
   if (!performing_lock.owns_lock()) {
+    if (trigger_mode == RequestTriggerMode::kNonEmptyOnly) {
+      // The outstanding request could be a heartbeat waiting for the batch, let it go now.
+      proxy_->FlushBatchedHeartbeat();
+    }
     return Status::OK();
   }
 
@@ -294,6 +307,14 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
 
   const bool req_has_ops = (request_.ops_size() > 0) || (commit_index_after > commit_index_before);
 
+  // Only status-only request of the idle leader could announce quiescence.
+  if (!req_has_ops && trigger_mode == RequestTriggerMode::kAlwaysSend && consensus_ &&
+      proxy_->SupportsQuiescence() && consensus_->IsQuiescenceAllowed()) {
+    request_.set_quiescent(true);
+  } else {
+    request_.clear_quiescent();
+  }
+
   // If the queue is empty, check if we were told to send a status-only message (which is what
   // happens during heartbeats). If not, just return.
   if (PREDICT_FALSE(!req_has_ops && trigger_mode == RequestTriggerMode::kNonEmptyOnly)) {
@@ -388,7 +409,33 @@ void Peer::ProcessResponse() {
     processing_lock.unlock();
     performing_lock.release();
     SendNextRequest(RequestTriggerMode::kAlwaysSend);
+    return;
   }
+
+  if (request_.quiescent() && response_.quiescent() && !response_.status().has_error()) {
+    // The follower stopped failure detection, so heartbeats are not needed till the next request.
+    VLOG_WITH_PREFIX(1) << "Suspending heartbeats";
+    heartbeater_->Stop();
+    // Proxy is notified first, so concurrent wake up could not stop quiescence before its start.
+    proxy_->StartQuiescence(tablet_id_);
+    quiescent_.store(true, std::memory_order_release);
+    processing_lock.unlock();
+    performing_lock.unlock();
+
+    // Leader activity noted while the request was in flight should resume heartbeats.
+    if (!consensus_->IsQuiescenceAllowed()) {
+      WARN_NOT_OK(SignalRequest(RequestTriggerMode::kAlwaysSend),
+                  "Failed to resume heartbeats");
+    }
+  }
+}
+
+void Peer::ResumeHeartbeats() {
+  VLOG_WITH_PREFIX(1) << "Resuming heartbeats";
+  // The follower was not contacted while quiescent, that should not be treated as its failure.
+  queue_->NotifyPeerIsResponsiveDespiteError(peer_pb_.permanent_uuid());
+  proxy_->StopQuiescence(tablet_id_, /* notify_follower= */ false);
+  heartbeater_->Start();
 }
 
 Status Peer::SendRemoteBootstrapRequest() {
@@ -445,6 +492,10 @@ void Peer::Close() {
   if (heartbeater_) {
     heartbeater_->Stop();
   }
+  if (quiescent_.exchange(false, std::memory_order_acq_rel)) {
+    // The follower would not get further heartbeats, so it should resume failure detection.
+    proxy_->StopQuiescence(tablet_id_, /* notify_follower= */ true);
+  }
 
   // If the peer is already closed return.
   {
@@ -480,8 +531,10 @@ Peer::~Peer() {
   CHECK_EQ(state_, kPeerClosed) << "Peer cannot be implicitly closed";
 }
 
-RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy)
-    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)) {
+RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+                           MultiRaftHeartbeatBatcherPtr batcher)
+    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)),
+      batcher_(std::move(batcher)) {
 }
 
 void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
@@ -489,10 +542,39 @@ void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
                                ConsensusResponsePB* response,
                                rpc::RpcController* controller,
                                const rpc::ResponseCallback& callback) {
+  // Only heartbeats without operations are batched, so replication latency is not affected.
+  if (batcher_ && trigger_mode == RequestTriggerMode::kAlwaysSend && request->ops_size() == 0 &&
+      FLAGS_enable_multi_raft_heartbeat_batcher && batcher_->supported()) {
+    heartbeat_batched_.store(true, std::memory_order_release);
+    batcher_->AddRequestToBatch(request, response, controller, [this, callback] {
+      heartbeat_batched_.store(false, std::memory_order_release);
+      callback();
+    });
+    return;
+  }
+
   controller->set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
   consensus_proxy_->UpdateConsensusAsync(*request, response, controller, callback);
 }
 
+void RpcPeerProxy::FlushBatchedHeartbeat() {
+  if (heartbeat_batched_.load(std::memory_order_acquire)) {
+    batcher_->FlushNow();
+  }
+}
+
+bool RpcPeerProxy::SupportsQuiescence() const {
+  return batcher_ && FLAGS_enable_multi_raft_heartbeat_batcher && batcher_->supported();
+}
+
+void RpcPeerProxy::StartQuiescence(const std::string& tablet_id) {
+  batcher_->AddQuiescentPeer(tablet_id);
+}
+
+void RpcPeerProxy::StopQuiescence(const std::string& tablet_id, bool notify_follower) {
+  batcher_->RemoveQuiescentPeer(tablet_id, notify_follower);
+}
+
 void RpcPeerProxy::RequestConsensusVoteAsync(const VoteRequestPB* request,
                                              VoteResponsePB* response,
                                              rpc::RpcController* controller,
@@ -525,13 +607,19 @@ void RpcPeerProxy::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB* req
 RpcPeerProxy::~RpcPeerProxy() {}
 
 RpcPeerProxyFactory::RpcPeerProxyFactory(
-    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from)
-    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)) {}
+    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+    MultiRaftManager* multi_raft_manager)
+    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)),
+      multi_raft_manager_(multi_raft_manager) {}
 
 PeerProxyPtr RpcPeerProxyFactory::NewProxy(const RaftPeerPB& peer_pb) {
   auto hostport = HostPortFromPB(DesiredHostPort(peer_pb, from_));
   auto proxy = std::make_unique<ConsensusServiceProxy>(proxy_cache_, hostport);
-  return std::make_unique<RpcPeerProxy>(std::move(hostport), std::move(proxy));
+  MultiRaftHeartbeatBatcherPtr batcher;
+  if (multi_raft_manager_) {
+    batcher = multi_raft_manager_->AddOrGetBatcher(hostport);
+  }
+  return std::make_unique<RpcPeerProxy>(std::move(hostport), std::move(proxy), std::move(batcher));
 }
 
 RpcPeerProxyFactory::~RpcPeerProxyFactory() {}
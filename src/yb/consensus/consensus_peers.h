@@ -195,6 +195,9 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // Signals there was an error sending the request to the peer.
   void ProcessResponseError(const Status& status);
 
+  // Resumes heartbeats suspended while the Raft group was quiescent.
+  void ResumeHeartbeats();
+
   // Returns true if the peer is closed and the calling function should return.
   std::unique_lock<simple_spinlock> StartProcessingUnlocked();
 
@@ -252,6 +255,9 @@ class Peer : public std::enable_shared_from_this<Peer> {
   Consensus* consensus_ = nullptr;
   rpc::Messenger* messenger_ = nullptr;
   std::atomic<int> using_thread_pool_{0};
+
+  // Whether heartbeats are suspended, because the follower accepted quiescence of the leader.
+  std::atomic<bool> quiescent_{false};
 };
 
 // A proxy to another peer. Usually a thin wrapper around an rpc proxy but can be replaced for
@@ -295,6 +301,21 @@ class PeerProxy {
     LOG(DFATAL) << "Not implemented";
   }
 
+  // Sends status-only request that is waiting to be batched with heartbeats of other Raft groups,
+  // if any. Called when there are new operations for the peer, so they are not delayed.
+  virtual void FlushBatchedHeartbeat() {}
+
+  // Returns true if liveness of this server could be tracked by the peer's server while the Raft
+  // group is quiescent, so heartbeats could be suspended.
+  virtual bool SupportsQuiescence() const { return false; }
+
+  // Notifies that heartbeats to the peer are suspended for the specified tablet.
+  virtual void StartQuiescence(const std::string& tablet_id) {}
+
+  // Notifies that heartbeats to the peer are resumed for the specified tablet. If notify_follower
+  // is true, the follower is told to resume failure detection, since it would not get heartbeats.
+  virtual void StopQuiescence(const std::string& tablet_id, bool notify_follower) {}
+
   virtual ~PeerProxy() {}
 };
 
@@ -316,7 +337,8 @@ class PeerProxyFactory {
 // PeerProxy implementation that does RPC calls
 class RpcPeerProxy : public PeerProxy {
  public:
-  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy);
+  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+               MultiRaftHeartbeatBatcherPtr batcher = nullptr);
 
   virtual void UpdateAsync(const ConsensusRequestPB* request,
                            RequestTriggerMode trigger_mode,
@@ -344,17 +366,32 @@ class RpcPeerProxy : public PeerProxy {
                                        rpc::RpcController* controller,
                                        const rpc::ResponseCallback& callback) override;
 
+  void FlushBatchedHeartbeat() override;
+
+  bool SupportsQuiescence() const override;
+
+  void StartQuiescence(const std::string& tablet_id) override;
+
+  void StopQuiescence(const std::string& tablet_id, bool notify_follower) override;
+
   virtual ~RpcPeerProxy();
 
  private:
   HostPort hostport_;
   ConsensusServiceProxyPtr consensus_proxy_;
+  MultiRaftHeartbeatBatcherPtr batcher_;
+
+  // Whether the status-only request was added to the batch and not yet responded.
+  std::atomic<bool> heartbeat_batched_{false};
 };
 
 // PeerProxyFactory implementation that generates RPCPeerProxies
 class RpcPeerProxyFactory : public PeerProxyFactory {
  public:
-  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from);
+  // When multi_raft_manager is specified, heartbeats are coalesced with heartbeats of other Raft
+  // groups sent to the same server.
+  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+                      MultiRaftManager* multi_raft_manager = nullptr);
 
   PeerProxyPtr NewProxy(const RaftPeerPB& peer_pb) override;
 
@@ -366,6 +403,7 @@ class RpcPeerProxyFactory : public PeerProxyFactory {
   rpc::Messenger* messenger_ = nullptr;
   rpc::ProxyCache* const proxy_cache_;
   const CloudInfoPB from_;
+  MultiRaftManager* const multi_raft_manager_;
 };
 
 // Query the consensus service at last known host/port that is specified in 'remote_peer' and set
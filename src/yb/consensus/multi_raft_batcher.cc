@@ -0,0 +1,402 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include <algorithm>
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "yb/consensus/consensus.proxy.h"
+#include "yb/consensus/raft_consensus.h"
+
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/periodic.h"
+#include "yb/rpc/rpc_header.pb.h"
+#include "yb/rpc/scheduler.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+
+using namespace std::literals;
+
+DEFINE_bool(enable_multi_raft_heartbeat_batcher, false,
+            "Whether heartbeats of Raft groups without pending operations, sent to the same "
+            "server, should be coalesced into a single MultiRaftUpdateConsensus RPC.");
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, advanced);
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, runtime);
+
+DEFINE_int32(multi_raft_heartbeat_window_ms, 20,
+             "Maximum time a heartbeat waits for other heartbeats to the same server, before "
+             "the batch is sent. Should be much less than raft_heartbeat_interval_ms.");
+TAG_FLAG(multi_raft_heartbeat_window_ms, advanced);
+TAG_FLAG(multi_raft_heartbeat_window_ms, runtime);
+
+DEFINE_int32(multi_raft_batch_size, 100,
+             "Maximum number of heartbeats in a single MultiRaftUpdateConsensus RPC. The receiver "
+             "applies them one by one in the RPC handler, so large batches delay the last ones.");
+TAG_FLAG(multi_raft_batch_size, advanced);
+TAG_FLAG(multi_raft_batch_size, runtime);
+
+DECLARE_int32(consensus_rpc_timeout_ms);
+DECLARE_double(leader_failure_max_missed_heartbeat_periods);
+DECLARE_int32(raft_heartbeat_interval_ms);
+
+namespace yb {
+namespace consensus {
+
+namespace {
+
+const auto kUnsupportedRecheckInterval = 60s;
+
+} // namespace
+
+MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
+    rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, const HostPort& hostport,
+    const NodeInstancePB& local_instance)
+    : messenger_(messenger),
+      hostport_(hostport),
+      local_instance_(local_instance),
+      proxy_(std::make_unique<ConsensusServiceProxy>(proxy_cache, hostport)) {
+}
+
+MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() {
+  // Each pending entry retains the batcher through the proxy of its peer, so nothing is left here.
+  DCHECK(!current_batch_);
+}
+
+bool MultiRaftHeartbeatBatcher::supported() const {
+  return CoarseMonoClock::Now() >= unsupported_until_.load(std::memory_order_acquire);
+}
+
+void MultiRaftHeartbeatBatcher::AddRequestToBatch(const ConsensusRequestPB* request,
+                                                  ConsensusResponsePB* response,
+                                                  rpc::RpcController* controller,
+                                                  rpc::ResponseCallback callback) {
+  bool flush_now = false;
+  bool schedule_flush = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!current_batch_) {
+      current_batch_ = std::make_shared<Batch>();
+    }
+    current_batch_->entries.push_back(BatchEntry{request, response, controller, callback});
+    if (current_batch_->entries.size() >= static_cast<size_t>(FLAGS_multi_raft_batch_size)) {
+      flush_now = true;
+    } else if (!flush_scheduled_) {
+      flush_scheduled_ = true;
+      schedule_flush = true;
+    }
+  }
+
+  if (flush_now) {
+    Flush();
+  } else if (schedule_flush) {
+    std::weak_ptr<MultiRaftHeartbeatBatcher> weak_self = shared_from_this();
+    // Task is invoked with an error status when the messenger is shut down, the batch is flushed
+    // anyway, so callbacks of all peers are invoked.
+    messenger_->scheduler().Schedule(
+        [weak_self](const Status& status) {
+          auto self = weak_self.lock();
+          if (self) {
+            self->Flush();
+          }
+        },
+        FLAGS_multi_raft_heartbeat_window_ms * 1ms);
+  }
+}
+
+void MultiRaftHeartbeatBatcher::FlushNow() {
+  Flush();
+}
+
+void MultiRaftHeartbeatBatcher::Flush() {
+  std::shared_ptr<Batch> batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batch.swap(current_batch_);
+    flush_scheduled_ = false;
+  }
+  if (!batch) {
+    return;
+  }
+
+  VLOG(4) << "Sending " << batch->entries.size() << " heartbeats to " << hostport_;
+  *batch->request.mutable_caller_instance() = local_instance_;
+  batch->request.mutable_consensus_request()->Reserve(batch->entries.size());
+  for (const auto& entry : batch->entries) {
+    *batch->request.add_consensus_request() = *entry.request;
+  }
+  batch->controller.set_timeout(FLAGS_consensus_rpc_timeout_ms * 1ms);
+  proxy_->MultiRaftUpdateConsensusAsync(
+      batch->request, &batch->response, &batch->controller,
+      [self = shared_from_this(), batch] {
+        self->ProcessBatchResponse(batch);
+      });
+}
+
+void MultiRaftHeartbeatBatcher::ProcessBatchResponse(const std::shared_ptr<Batch>& batch) {
+  auto status = batch->controller.status();
+  if (status.ok() &&
+      static_cast<size_t>(batch->response.consensus_response_size()) == batch->entries.size()) {
+    for (size_t i = 0; i != batch->entries.size(); ++i) {
+      const auto& entry = batch->entries[i];
+      entry.response->Swap(batch->response.mutable_consensus_response(i));
+      entry.callback();
+    }
+    return;
+  }
+
+  if (status.ok()) {
+    status = STATUS_FORMAT(
+        IllegalState, "Wrong number of responses: $0, while $1 expected",
+        batch->response.consensus_response_size(), batch->entries.size());
+  } else if (status.IsRemoteError()) {
+    const auto* error = batch->controller.error_response();
+    if (error && error->code() == rpc::ErrorStatusPB::ERROR_NO_SUCH_METHOD) {
+      // Could happen during rolling upgrade, so check again later.
+      LOG(INFO) << hostport_ << " does not support MultiRaftUpdateConsensus, heartbeats will be "
+                << "sent separately";
+      unsupported_until_.store(CoarseMonoClock::Now() + kUnsupportedRecheckInterval,
+                               std::memory_order_release);
+    }
+  }
+
+  // Let each peer observe its own result, as it would without batching.
+  YB_LOG_EVERY_N_SECS(WARNING, 5) << "Failed to send " << batch->entries.size()
+                                  << " heartbeats to " << hostport_ << ": " << status
+                                  << ", sending them separately";
+  for (const auto& entry : batch->entries) {
+    SendSeparately(entry);
+  }
+}
+
+void MultiRaftHeartbeatBatcher::SendSeparately(const BatchEntry& entry) {
+  entry.controller->set_timeout(FLAGS_consensus_rpc_timeout_ms * 1ms);
+  proxy_->UpdateConsensusAsync(*entry.request, entry.response, entry.controller, entry.callback);
+}
+
+void MultiRaftHeartbeatBatcher::AddQuiescentPeer(const std::string& tablet_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++num_quiescent_peers_;
+  // The follower should not be woken by notification sent when previous leader was closed.
+  woken_tablet_ids_.erase(
+      std::remove(woken_tablet_ids_.begin(), woken_tablet_ids_.end(), tablet_id),
+      woken_tablet_ids_.end());
+  SchedulePingUnlocked();
+}
+
+void MultiRaftHeartbeatBatcher::RemoveQuiescentPeer(
+    const std::string& tablet_id, bool notify_follower) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  DCHECK_GT(num_quiescent_peers_, 0);
+  --num_quiescent_peers_;
+  if (notify_follower) {
+    woken_tablet_ids_.push_back(tablet_id);
+    SchedulePingUnlocked();
+  }
+}
+
+void MultiRaftHeartbeatBatcher::SchedulePingUnlocked() {
+  if (ping_scheduled_ || (num_quiescent_peers_ == 0 && woken_tablet_ids_.empty())) {
+    return;
+  }
+  ping_scheduled_ = true;
+  // Ping is not retained by the scheduler, so the batcher could be destroyed when the last peer
+  // to the destination is closed. Such peer has sent its notification already, or the destination
+  // server will detect that pings stopped.
+  std::weak_ptr<MultiRaftHeartbeatBatcher> weak_self = shared_from_this();
+  messenger_->scheduler().Schedule(
+      [weak_self](const Status& status) {
+        auto self = weak_self.lock();
+        if (self && status.ok()) {
+          self->Ping();
+        }
+      },
+      FLAGS_raft_heartbeat_interval_ms * 1ms);
+}
+
+void MultiRaftHeartbeatBatcher::Ping() {
+  auto ping = std::make_shared<Batch>();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ping_scheduled_ = false;
+    if (num_quiescent_peers_ == 0 && woken_tablet_ids_.empty()) {
+      return;
+    }
+    for (auto& tablet_id : woken_tablet_ids_) {
+      ping->request.add_woken_tablet_ids(std::move(tablet_id));
+    }
+    woken_tablet_ids_.clear();
+  }
+
+  VLOG(4) << "Pinging " << hostport_ << ", woken tablets: "
+          << ping->request.woken_tablet_ids_size();
+  *ping->request.mutable_caller_instance() = local_instance_;
+  ping->controller.set_timeout(FLAGS_consensus_rpc_timeout_ms * 1ms);
+  proxy_->MultiRaftUpdateConsensusAsync(
+      ping->request, &ping->response, &ping->controller,
+      [self = shared_from_this(), ping] {
+        self->ProcessPingResponse(ping);
+      });
+}
+
+void MultiRaftHeartbeatBatcher::ProcessPingResponse(const std::shared_ptr<Batch>& ping) {
+  auto status = ping->controller.status();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!status.ok()) {
+    YB_LOG_EVERY_N_SECS(WARNING, 5) << "Failed to ping " << hostport_ << ": " << status;
+    // Notifications should be delivered, otherwise followers would not resume failure detection.
+    for (auto& tablet_id : *ping->request.mutable_woken_tablet_ids()) {
+      woken_tablet_ids_.push_back(std::move(tablet_id));
+    }
+  }
+  SchedulePingUnlocked();
+}
+
+MultiRaftManager::MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache,
+                                   NodeInstancePB local_instance)
+    : messenger_(messenger), proxy_cache_(proxy_cache), local_instance_(std::move(local_instance)) {
+}
+
+MultiRaftManager::~MultiRaftManager() {
+  Shutdown();
+}
+
+void MultiRaftManager::Shutdown() {
+  std::lock_guard<std::mutex> lock(followers_mutex_);
+  if (liveness_checker_) {
+    liveness_checker_->Stop();
+  }
+}
+
+MultiRaftHeartbeatBatcherPtr MultiRaftManager::AddOrGetBatcher(const HostPort& hostport) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& weak_batcher = batchers_[hostport];
+  auto result = weak_batcher.lock();
+  if (!result) {
+    result = std::make_shared<MultiRaftHeartbeatBatcher>(
+        messenger_, proxy_cache_, hostport, local_instance_);
+    weak_batcher = result;
+  }
+  return result;
+}
+
+void MultiRaftManager::RegisterQuiescentFollower(const std::string& leader_uuid,
+                                                 const std::string& tablet_id,
+                                                 std::weak_ptr<RaftConsensus> consensus) {
+  std::lock_guard<std::mutex> lock(followers_mutex_);
+  auto& server = leader_servers_[leader_uuid];
+  // Follower is registered when heartbeat from the leader is received.
+  server.last_contact = CoarseMonoClock::Now();
+  server.quiescent_followers[tablet_id] = std::move(consensus);
+  if (!liveness_checker_) {
+    liveness_checker_ = rpc::PeriodicTimer::Create(
+        messenger_, std::bind(&MultiRaftManager::CheckLeaderServers, this),
+        MonoDelta::FromMilliseconds(FLAGS_raft_heartbeat_interval_ms));
+    liveness_checker_->Start();
+  }
+}
+
+void MultiRaftManager::UnregisterQuiescentFollower(
+    const std::string& leader_uuid, const std::string& tablet_id) {
+  std::lock_guard<std::mutex> lock(followers_mutex_);
+  auto it = leader_servers_.find(leader_uuid);
+  if (it == leader_servers_.end()) {
+    return;
+  }
+  it->second.quiescent_followers.erase(tablet_id);
+  if (it->second.quiescent_followers.empty()) {
+    leader_servers_.erase(it);
+  }
+}
+
+void MultiRaftManager::ProcessLeaderServerLiveness(const MultiRaftConsensusRequestPB& req) {
+  if (!req.has_caller_instance()) {
+    return;
+  }
+  const auto& instance = req.caller_instance();
+  FollowersToWake followers_to_wake;
+  {
+    std::lock_guard<std::mutex> lock(followers_mutex_);
+    auto it = leader_servers_.find(instance.permanent_uuid());
+    if (it == leader_servers_.end()) {
+      // There are no quiescent followers of this server.
+      return;
+    }
+    auto& server = it->second;
+    server.last_contact = CoarseMonoClock::Now();
+    if (server.instance_seqno != instance.instance_seqno()) {
+      if (server.instance_seqno != -1) {
+        LOG(INFO) << "Server " << instance.permanent_uuid() << " was restarted, waking "
+                  << server.quiescent_followers.size() << " quiescent followers";
+        TakeQuiescentFollowersUnlocked(&server, &followers_to_wake);
+      }
+      server.instance_seqno = instance.instance_seqno();
+    }
+    for (const auto& tablet_id : req.woken_tablet_ids()) {
+      auto follower_it = server.quiescent_followers.find(tablet_id);
+      if (follower_it != server.quiescent_followers.end()) {
+        followers_to_wake.push_back(std::move(follower_it->second));
+        server.quiescent_followers.erase(follower_it);
+      }
+    }
+    if (server.quiescent_followers.empty()) {
+      leader_servers_.erase(it);
+    }
+  }
+  WakeFollowers(followers_to_wake);
+}
+
+void MultiRaftManager::TakeQuiescentFollowersUnlocked(
+    LeaderServer* server, FollowersToWake* followers_to_wake) {
+  for (auto& follower : server->quiescent_followers) {
+    followers_to_wake->push_back(std::move(follower.second));
+  }
+  server->quiescent_followers.clear();
+}
+
+void MultiRaftManager::WakeFollowers(const FollowersToWake& followers_to_wake) {
+  for (const auto& weak_consensus : followers_to_wake) {
+    auto consensus = weak_consensus.lock();
+    if (consensus) {
+      consensus->WakeFromQuiescence();
+    }
+  }
+}
+
+void MultiRaftManager::CheckLeaderServers() {
+  const auto timeout = std::chrono::milliseconds(static_cast<int64_t>(
+      FLAGS_leader_failure_max_missed_heartbeat_periods * FLAGS_raft_heartbeat_interval_ms));
+  const auto now = CoarseMonoClock::Now();
+  FollowersToWake followers_to_wake;
+  {
+    std::lock_guard<std::mutex> lock(followers_mutex_);
+    for (auto it = leader_servers_.begin(); it != leader_servers_.end();) {
+      if (now - it->second.last_contact > timeout) {
+        LOG(INFO) << "Server " << it->first << " did not contact us for "
+                  << MonoDelta(now - it->second.last_contact).ToString() << ", waking "
+                  << it->second.quiescent_followers.size() << " quiescent followers";
+        TakeQuiescentFollowersUnlocked(&it->second, &followers_to_wake);
+        it = leader_servers_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  WakeFollowers(followers_to_wake);
+}
+
+} // namespace consensus
+} // namespace yb
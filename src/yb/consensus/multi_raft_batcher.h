@@ -0,0 +1,180 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+#define YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/common/wire_protocol.pb.h"
+
+#include "yb/consensus/consensus_fwd.h"
+#include "yb/consensus/consensus.pb.h"
+
+#include "yb/rpc/response_callback.h"
+#include "yb/rpc/rpc_controller.h"
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/net/net_util.h"
+
+namespace yb {
+
+namespace rpc {
+class PeriodicTimer;
+}
+
+namespace consensus {
+
+// Collects status-only UpdateConsensus requests, i.e. heartbeats of Raft groups without pending
+// operations, sent by this server to a single destination server, and sends them as a single
+// MultiRaftUpdateConsensus RPC.
+//
+// Requests are not modified, so leader lease and safe time are propagated exactly as by a separate
+// RPC, the only difference is that request could be delayed by up to the batching window.
+//
+// Also, while there are quiescent Raft groups led by this server and followed by the destination
+// server, periodically pings the destination server, so followers know that the leader is alive.
+class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
+ public:
+  MultiRaftHeartbeatBatcher(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache,
+                            const HostPort& hostport, const NodeInstancePB& local_instance);
+  ~MultiRaftHeartbeatBatcher();
+
+  // Returns false if batching is not supported by the destination server, so request should be
+  // sent separately.
+  bool supported() const;
+
+  // Adds request to the current batch. request and response should be alive till callback is
+  // invoked. If the batch could not be delivered, request is sent separately using controller, so
+  // callback observes the same errors as for a regular UpdateConsensus RPC.
+  void AddRequestToBatch(const ConsensusRequestPB* request,
+                         ConsensusResponsePB* response,
+                         rpc::RpcController* controller,
+                         rpc::ResponseCallback callback);
+
+  // Sends the current batch without waiting for the batching window to pass.
+  void FlushNow();
+
+  // Notifies that the leader of the specified tablet stopped sending heartbeats to the destination
+  // server, because the Raft group is quiescent.
+  void AddQuiescentPeer(const std::string& tablet_id);
+
+  // Notifies that the leader of the specified tablet is not quiescent anymore. If notify_follower
+  // is true, the follower is told to resume failure detection, this is used when the leader is
+  // closed, so the follower would not get further heartbeats.
+  void RemoveQuiescentPeer(const std::string& tablet_id, bool notify_follower);
+
+ private:
+  struct BatchEntry {
+    const ConsensusRequestPB* request;
+    ConsensusResponsePB* response;
+    rpc::RpcController* controller;
+    rpc::ResponseCallback callback;
+  };
+
+  struct Batch {
+    std::vector<BatchEntry> entries;
+    MultiRaftConsensusRequestPB request;
+    MultiRaftConsensusResponsePB response;
+    rpc::RpcController controller;
+  };
+
+  void Flush();
+  void ProcessBatchResponse(const std::shared_ptr<Batch>& batch);
+  void SendSeparately(const BatchEntry& entry);
+
+  // Schedules next ping if there are quiescent peers or pending notifications. Should be called
+  // with mutex_ locked.
+  void SchedulePingUnlocked();
+  void Ping();
+  void ProcessPingResponse(const std::shared_ptr<Batch>& ping);
+
+  rpc::Messenger* const messenger_;
+  const HostPort hostport_;
+  const NodeInstancePB local_instance_;
+  const ConsensusServiceProxyPtr proxy_;
+
+  std::atomic<CoarseTimePoint> unsupported_until_{CoarseTimePoint()};
+
+  std::mutex mutex_;
+  std::shared_ptr<Batch> current_batch_;
+  bool flush_scheduled_ = false;
+
+  size_t num_quiescent_peers_ = 0;
+  std::vector<std::string> woken_tablet_ids_;
+  bool ping_scheduled_ = false;
+};
+
+// Keeps one MultiRaftHeartbeatBatcher per destination server, shared by all Raft groups of this
+// server.
+//
+// Also tracks quiescent followers of this server, grouped by the server of their leader. When the
+// leader's server did not contact this server for the election timeout, or was restarted, its
+// quiescent followers are woken, so they resume failure detection.
+class MultiRaftManager {
+ public:
+  MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache,
+                   NodeInstancePB local_instance);
+  ~MultiRaftManager();
+
+  void Shutdown();
+
+  // Returns batcher for the specified destination, creating it if necessary.
+  MultiRaftHeartbeatBatcherPtr AddOrGetBatcher(const HostPort& hostport);
+
+  // Registers follower that stopped failure detection, because its leader on the specified server
+  // announced quiescence.
+  void RegisterQuiescentFollower(const std::string& leader_uuid,
+                                 const std::string& tablet_id,
+                                 std::weak_ptr<RaftConsensus> consensus);
+
+  void UnregisterQuiescentFollower(const std::string& leader_uuid, const std::string& tablet_id);
+
+  // Handles liveness information received in MultiRaftUpdateConsensus.
+  void ProcessLeaderServerLiveness(const MultiRaftConsensusRequestPB& req);
+
+ private:
+  struct LeaderServer {
+    int64_t instance_seqno = -1;
+    CoarseTimePoint last_contact;
+    std::unordered_map<std::string, std::weak_ptr<RaftConsensus>> quiescent_followers;
+  };
+
+  typedef std::vector<std::weak_ptr<RaftConsensus>> FollowersToWake;
+
+  // Moves all quiescent followers of the specified leader server to followers_to_wake.
+  void TakeQuiescentFollowersUnlocked(LeaderServer* server, FollowersToWake* followers_to_wake);
+  void WakeFollowers(const FollowersToWake& followers_to_wake);
+  void CheckLeaderServers();
+
+  rpc::Messenger* const messenger_;
+  rpc::ProxyCache* const proxy_cache_;
+  const NodeInstancePB local_instance_;
+
+  std::mutex mutex_;
+  std::unordered_map<HostPort, std::weak_ptr<MultiRaftHeartbeatBatcher>, HostPortHash> batchers_;
+
+  std::mutex followers_mutex_;
+  std::unordered_map<std::string, LeaderServer> leader_servers_;
+  std::shared_ptr<rpc::PeriodicTimer> liveness_checker_;
+};
+
+} // namespace consensus
+} // namespace yb
+
+#endif // YB_CONSENSUS_MULTI_RAFT_BATCHER_H
@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <mutex>
 
@@ -45,6 +46,7 @@
 #include "yb/consensus/consensus_peers.h"
 #include "yb/consensus/leader_election.h"
 #include "yb/consensus/log.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/peer_manager.h"
 #include "yb/consensus/quorum_util.h"
 #include "yb/consensus/replica_state.h"
@@ -198,6 +200,15 @@ DEFINE_bool(quick_leader_election_on_create, true, "Do we trigger quick leader e
 TAG_FLAG(quick_leader_election_on_create, advanced);
 TAG_FLAG(quick_leader_election_on_create, hidden);
 
+DEFINE_int32(raft_quiescence_idle_heartbeat_periods, 0,
+             "Number of heartbeat periods without replicated operations and leader lease requests, "
+             "after which the leader stops sending heartbeats to followers, while the liveness of "
+             "its server is confirmed by a single ping per pair of servers. The first request to "
+             "the tablet resumes heartbeats. 0 to disable quiescence. Requires "
+             "enable_multi_raft_heartbeat_batcher.");
+TAG_FLAG(raft_quiescence_idle_heartbeat_periods, advanced);
+TAG_FLAG(raft_quiescence_idle_heartbeat_periods, runtime);
+
 namespace yb {
 namespace consensus {
 
@@ -224,9 +235,10 @@ shared_ptr<RaftConsensus> RaftConsensus::Create(
     const Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
     ThreadPool* raft_pool,
-    RetryableRequests* retryable_requests) {
+    RetryableRequests* retryable_requests,
+    MultiRaftManager* multi_raft_manager) {
   gscoped_ptr<PeerProxyFactory> rpc_factory(new RpcPeerProxyFactory(
-      messenger, proxy_cache, local_peer_pb.cloud_info()));
+      messenger, proxy_cache, local_peer_pb.cloud_info(), multi_raft_manager));
 
   // The message queue that keeps track of which operations need to be replicated
   // where.
@@ -274,7 +286,8 @@ shared_ptr<RaftConsensus> RaftConsensus::Create(
       parent_mem_tracker,
       mark_dirty_clbk,
       table_type,
-      retryable_requests);
+      retryable_requests,
+      multi_raft_manager);
 }
 
 RaftConsensus::RaftConsensus(
@@ -288,7 +301,8 @@ RaftConsensus::RaftConsensus(
     shared_ptr<MemTracker> parent_mem_tracker,
     Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
-    RetryableRequests* retryable_requests)
+    RetryableRequests* retryable_requests,
+    MultiRaftManager* multi_raft_manager)
     : raft_pool_token_(std::move(raft_pool_token)),
       log_(log),
       clock_(clock),
@@ -306,7 +320,8 @@ RaftConsensus::RaftConsensus(
       parent_mem_tracker_(std::move(parent_mem_tracker)),
       table_type_(table_type),
       update_raft_config_dns_latency_(
-          METRIC_dns_resolve_latency_during_update_raft_config.Instantiate(metric_entity)) {
+          METRIC_dns_resolve_latency_during_update_raft_config.Instantiate(metric_entity)),
+      multi_raft_manager_(multi_raft_manager) {
   DCHECK_NOTNULL(log_.get());
 
   if (PREDICT_FALSE(FLAGS_follower_reject_update_consensus_requests_seconds > 0)) {
@@ -835,6 +850,8 @@ Status RaftConsensus::BecomeLeaderUnlocked() {
 
   // Disable FD while we are leader.
   DisableFailureDetector();
+  LeaveFollowerQuiescence();
+  NoteLeaderActivity();
 
   // Don't vote for anyone if we're a leader.
   withhold_votes_until_ = MonoTime::Max();
@@ -885,8 +902,12 @@ Status RaftConsensus::BecomeReplicaUnlocked(const std::string& new_leader_uuid,
   state_->ClearLeaderUnlocked();
 
   // FD should be running while we are a follower.
+  LeaveFollowerQuiescence();
   EnableFailureDetector(initial_fd_wait);
 
+  // Changes should be read from the new leader.
+  NotifyReplicatedMessagesWaiters(std::numeric_limits<int64_t>::max());
+
   // Now that we're a replica, we can allow voting for other nodes.
   withhold_votes_until_ = MonoTime::Min();
 
@@ -927,6 +948,7 @@ Status RaftConsensus::ReplicateBatch(ConsensusRounds* rounds) {
     RETURN_NOT_OK(AppendNewRoundsToQueueUnlocked(*rounds));
   }
 
+  NoteLeaderActivity();
   peer_manager_->SignalRequest(RequestTriggerMode::kNonEmptyOnly);
   RETURN_NOT_OK(ExecuteHook(POST_REPLICATE));
   return Status::OK();
@@ -1045,6 +1067,7 @@ void RaftConsensus::UpdateMajorityReplicated(
   if (majority_replicated_listener_ && state_->GetLeaderStateUnlocked().ok()) {
     majority_replicated_listener_();
   }
+  NotifyReplicatedMessagesWaiters(majority_replicated_data.op_id.index());
   if (PREDICT_FALSE(!s.ok())) {
     string msg = Substitute("Unable to mark committed up to $0: $1",
                             majority_replicated_data.op_id.ShortDebugString(),
@@ -1607,6 +1630,7 @@ Result<RaftConsensus::UpdateReplicaResult> RaftConsensus::UpdateReplica(
   // We are guaranteed to be acting as a FOLLOWER at this point by the above
   // sanity check.
   SnoozeFailureDetector(DO_NOT_LOG);
+  UpdateFollowerQuiescence(*request, response);
 
   auto now = MonoTime::Now();
   last_message_from_leader_time_ = now;
@@ -2239,6 +2263,9 @@ void RaftConsensus::Shutdown() {
     LOG_WITH_PREFIX(INFO) << "Raft consensus shutting down.";
   }
 
+  LeaveFollowerQuiescence();
+  NotifyReplicatedMessagesWaiters(std::numeric_limits<int64_t>::max());
+
   // Close the peer manager.
   peer_manager_->Close();
 
@@ -2360,9 +2387,83 @@ Status RaftConsensus::CheckIsActiveLeaderAndHasLease() const {
 
 MicrosTime RaftConsensus::MajorityReplicatedHtLeaseExpiration(
     MicrosTime min_allowed, CoarseTimePoint deadline) const {
+  if (min_allowed) {
+    // Somebody is waiting for the lease, so it should be extended by heartbeats.
+    NoteLeaderActivity();
+  }
   return state_->MajorityReplicatedHtLeaseExpiration(min_allowed, deadline);
 }
 
+bool RaftConsensus::IsQuiescenceAllowed() const {
+  const auto idle_periods = FLAGS_raft_quiescence_idle_heartbeat_periods;
+  if (idle_periods <= 0 || !multi_raft_manager_) {
+    return false;
+  }
+  const auto idle_time =
+      CoarseMonoClock::Now() - last_leader_activity_.load(std::memory_order_acquire);
+  if (idle_time < idle_periods * FLAGS_raft_heartbeat_interval_ms * 1ms) {
+    return false;
+  }
+  // Activity noted after this point will find the flag set and resume heartbeats. Activity noted
+  // concurrently is caught by the peer, that checks this method again after suspending heartbeats.
+  quiescence_allowed_.store(true, std::memory_order_release);
+  return true;
+}
+
+void RaftConsensus::NoteLeaderActivity() const {
+  last_leader_activity_.store(CoarseMonoClock::Now(), std::memory_order_release);
+  if (quiescence_allowed_.load(std::memory_order_acquire) &&
+      quiescence_allowed_.exchange(false, std::memory_order_acq_rel)) {
+    peer_manager_->SignalRequest(RequestTriggerMode::kAlwaysSend);
+  }
+}
+
+void RaftConsensus::UpdateFollowerQuiescence(
+    const ConsensusRequestPB& request, ConsensusResponsePB* response) {
+  if (!request.quiescent() || !multi_raft_manager_) {
+    if (follower_quiescent_.load(std::memory_order_acquire) && LeaveFollowerQuiescence()) {
+      EnableFailureDetector(MinimumElectionTimeout());
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(quiescence_mutex_);
+    if (quiescent_leader_uuid_ != request.caller_uuid()) {
+      if (!quiescent_leader_uuid_.empty()) {
+        multi_raft_manager_->UnregisterQuiescentFollower(quiescent_leader_uuid_, tablet_id());
+      }
+      VLOG_WITH_PREFIX(1) << "Leader " << request.caller_uuid() << " is quiescent";
+      DisableFailureDetector();
+      quiescent_leader_uuid_ = request.caller_uuid();
+      follower_quiescent_.store(true, std::memory_order_release);
+      multi_raft_manager_->RegisterQuiescentFollower(
+          quiescent_leader_uuid_, tablet_id(), shared_from_this());
+    }
+  }
+  response->set_quiescent(true);
+}
+
+bool RaftConsensus::LeaveFollowerQuiescence() {
+  std::lock_guard<std::mutex> lock(quiescence_mutex_);
+  if (quiescent_leader_uuid_.empty()) {
+    return false;
+  }
+  VLOG_WITH_PREFIX(1) << "Leader " << quiescent_leader_uuid_ << " is not quiescent anymore";
+  multi_raft_manager_->UnregisterQuiescentFollower(quiescent_leader_uuid_, tablet_id());
+  quiescent_leader_uuid_.clear();
+  follower_quiescent_.store(false, std::memory_order_release);
+  return true;
+}
+
+void RaftConsensus::WakeFromQuiescence() {
+  if (LeaveFollowerQuiescence()) {
+    LOG_WITH_PREFIX(INFO) << "Liveness of the quiescent leader is not confirmed, resuming failure "
+                          << "detection";
+    EnableFailureDetector(MinimumElectionTimeout());
+  }
+}
+
 std::string RaftConsensus::GetRequestVoteLogPrefix(const VoteRequestPB& request) const {
   return Format("$0 Leader $1election vote request",
                 state_->LogPrefix(), request.preelection() ? "pre-" : "");
@@ -2927,6 +3028,62 @@ Status RaftConsensus::ReadReplicatedMessagesForCDC(const OpId& from, ReplicateMs
   return queue_->ReadReplicatedMessagesForCDC(from, msgs, have_more_messages);
 }
 
+int64_t RaftConsensus::AddReplicatedMessagesWaiter(
+    int64_t index, std::function<void()> callback) {
+  int64_t id;
+  {
+    std::lock_guard<std::mutex> lock(replicated_messages_waiters_mutex_);
+    id = ++next_replicated_messages_waiter_id_;
+    if (index >= notified_majority_replicated_index_.load()) {
+      replicated_messages_waiters_.push_back(ReplicatedMessagesWaiter{index, id, callback});
+      has_replicated_messages_waiters_.store(true);
+      // Index could be updated concurrently, before it observed that there are waiters.
+      if (index >= notified_majority_replicated_index_.load()) {
+        return id;
+      }
+      replicated_messages_waiters_.pop_back();
+      has_replicated_messages_waiters_.store(!replicated_messages_waiters_.empty());
+    }
+  }
+  callback();
+  return id;
+}
+
+void RaftConsensus::RemoveReplicatedMessagesWaiter(int64_t id) {
+  std::lock_guard<std::mutex> lock(replicated_messages_waiters_mutex_);
+  auto it = std::find_if(
+      replicated_messages_waiters_.begin(), replicated_messages_waiters_.end(),
+      [id](const ReplicatedMessagesWaiter& waiter) { return waiter.id == id; });
+  if (it != replicated_messages_waiters_.end()) {
+    replicated_messages_waiters_.erase(it);
+    has_replicated_messages_waiters_.store(!replicated_messages_waiters_.empty());
+  }
+}
+
+void RaftConsensus::NotifyReplicatedMessagesWaiters(int64_t majority_replicated_index) {
+  if (majority_replicated_index != std::numeric_limits<int64_t>::max()) {
+    notified_majority_replicated_index_.store(majority_replicated_index);
+  }
+  if (!has_replicated_messages_waiters_.load()) {
+    return;
+  }
+  std::vector<ReplicatedMessagesWaiter> ready;
+  {
+    std::lock_guard<std::mutex> lock(replicated_messages_waiters_mutex_);
+    auto it = std::partition(
+        replicated_messages_waiters_.begin(), replicated_messages_waiters_.end(),
+        [majority_replicated_index](const ReplicatedMessagesWaiter& waiter) {
+          return waiter.index >= majority_replicated_index;
+        });
+    std::move(it, replicated_messages_waiters_.end(), std::back_inserter(ready));
+    replicated_messages_waiters_.erase(it, replicated_messages_waiters_.end());
+    has_replicated_messages_waiters_.store(!replicated_messages_waiters_.empty());
+  }
+  for (const auto& waiter : ready) {
+    waiter.callback();
+  }
+}
+
 void RaftConsensus::RollbackIdAndDeleteOpId(const ReplicateMsgPtr& replicate_msg,
                                             bool should_exists) {
   std::unique_ptr<OpId> op_id(replicate_msg->release_id());
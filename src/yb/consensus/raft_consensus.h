@@ -109,7 +109,8 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
     const Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
     ThreadPool* raft_pool,
-    RetryableRequests* retryable_requests);
+    RetryableRequests* retryable_requests,
+    MultiRaftManager* multi_raft_manager = nullptr);
 
   RaftConsensus(
     const ConsensusOptions& options,
@@ -126,7 +127,8 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
     std::shared_ptr<MemTracker> parent_mem_tracker,
     Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
-    RetryableRequests* retryable_requests);
+    RetryableRequests* retryable_requests,
+    MultiRaftManager* multi_raft_manager = nullptr);
 
   virtual ~RaftConsensus();
 
@@ -222,6 +224,14 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
   MicrosTime MajorityReplicatedHtLeaseExpiration(
       MicrosTime min_allowed, CoarseTimePoint deadline) const override;
 
+  bool IsQuiescenceAllowed() const override;
+
+  void NoteLeaderActivity() const override;
+
+  // Resumes failure detection of the quiescent follower, invoked when liveness of its leader could
+  // not be confirmed anymore.
+  void WakeFromQuiescence();
+
   // The on-disk size of the consensus metadata.
   uint64_t OnDiskSize() const;
 
@@ -252,6 +262,10 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
   CHECKED_STATUS ReadReplicatedMessagesForCDC(const OpId& from, ReplicateMsgs* msgs,
                                               bool* have_more_messages) override;
 
+  int64_t AddReplicatedMessagesWaiter(int64_t index, std::function<void()> callback) override;
+
+  void RemoveReplicatedMessagesWaiter(int64_t id) override;
+
   // Start memory tracking of following operation in case it is still present in our caches.
   void TrackOperationMemory(const yb::OpId& op_id);
 
@@ -498,6 +512,17 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
   // If the failure detector is already disabled, has no effect.
   void DisableFailureDetector();
 
+  // Handles quiescence announced by the leader in the accepted request. The failure detector is
+  // stopped while the leader is quiescent, liveness of the leader's server is tracked by
+  // MultiRaftManager instead.
+  void UpdateFollowerQuiescence(const ConsensusRequestPB& request, ConsensusResponsePB* response);
+
+  // Stops follower quiescence, if any. Returns true if the follower was quiescent.
+  bool LeaveFollowerQuiescence();
+
+  // Invokes replicated messages waiters for indexes below the specified one.
+  void NotifyReplicatedMessagesWaiters(int64_t majority_replicated_index);
+
   // "Reset" the failure detector to indicate leader activity.
   // When this is called a failure is guaranteed not to be detected
   // before 'FLAGS_leader_failure_max_missed_heartbeat_periods' *
@@ -679,6 +704,34 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
 
   std::atomic<MonoDelta> TEST_delay_update_{MonoDelta::kZero};
 
+  MultiRaftManager* const multi_raft_manager_;
+
+  // Leader side of quiescence. Time of the last operation that requires heartbeats, i.e.
+  // replication or leader lease, and whether peers were allowed to stop heartbeats after it.
+  mutable std::atomic<CoarseTimePoint> last_leader_activity_{CoarseTimePoint()};
+  mutable std::atomic<bool> quiescence_allowed_{false};
+
+  // Follower side of quiescence. follower_quiescent_ allows to check quiescence without locking
+  // quiescence_mutex_.
+  std::atomic<bool> follower_quiescent_{false};
+  std::mutex quiescence_mutex_;
+  std::string quiescent_leader_uuid_;
+
+  struct ReplicatedMessagesWaiter {
+    int64_t index;
+    int64_t id;
+    std::function<void()> callback;
+  };
+
+  // Index that was majority replicated when waiters were notified last time.
+  // has_replicated_messages_waiters_ allows to skip locking when there are no waiters, both are
+  // accessed with sequential consistency, so a waiter is either notified or observes the index.
+  std::atomic<int64_t> notified_majority_replicated_index_{0};
+  std::atomic<bool> has_replicated_messages_waiters_{false};
+  std::mutex replicated_messages_waiters_mutex_;
+  int64_t next_replicated_messages_waiter_id_ = 0;
+  std::vector<ReplicatedMessagesWaiter> replicated_messages_waiters_;
+
   DISALLOW_COPY_AND_ASSIGN(RaftConsensus);
 };
 
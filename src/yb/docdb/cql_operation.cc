@@ -1098,6 +1098,40 @@ Status QLWriteOperation::UpdateIndexes(const QLTableRow& existing_row, const QLT
   return Status::OK();
 }
 
+Status PrepareIndexInsertRequest(const IndexInfo& index,
+                                 const QLTableRow& row,
+                                 QLExprExecutor* executor,
+                                 QLWriteRequestPB* request) {
+  request->set_type(QLWriteRequestPB::QL_STMT_INSERT);
+  for (size_t idx = 0; idx < index.key_column_count(); idx++) {
+    const IndexInfo::IndexColumn& index_column = index.column(idx);
+    QLExpressionPB *key_column = NewKeyColumn(request, index, idx);
+    if (index_column.colexpr.expr_case() == QLExpressionPB::ExprCase::EXPR_NOT_SET ||
+        index_column.colexpr.expr_case() == QLExpressionPB::ExprCase::kColumnId) {
+      auto result = row.GetValue(index_column.indexed_column_id);
+      if (result) {
+        key_column->mutable_value()->CopyFrom(*result);
+      }
+    } else {
+      QLValue result;
+      RETURN_NOT_OK(executor->EvalExpr(index_column.colexpr, row, &result));
+      key_column->mutable_value()->CopyFrom(result.value());
+    }
+  }
+
+  for (size_t idx = index.key_column_count(); idx < index.columns().size(); idx++) {
+    const IndexInfo::IndexColumn& index_column = index.column(idx);
+    auto result = row.GetValue(index_column.indexed_column_id);
+    if (result) {
+      QLColumnValuePB* covering_column = request->add_column_values();
+      covering_column->set_column_id(index_column.column_id);
+      covering_column->mutable_expr()->mutable_value()->CopyFrom(*result);
+    }
+  }
+
+  return Status::OK();
+}
+
 Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
                                 CoarseTimePoint deadline,
                                 const ReadHybridTime& read_time,
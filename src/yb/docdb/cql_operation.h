@@ -225,6 +225,13 @@ class QLReadOperation : public DocExprExecutor {
   QLResponsePB response_;
 };
 
+// Fills request with the insert of the entry of index, that corresponds to the row of the indexed
+// table. Used to backfill index with rows that existed before the index was created.
+CHECKED_STATUS PrepareIndexInsertRequest(const IndexInfo& index,
+                                         const QLTableRow& row,
+                                         QLExprExecutor* executor,
+                                         QLWriteRequestPB* request);
+
 }  // namespace docdb
 }  // namespace yb
 
@@ -13,6 +13,7 @@
 //
 //
 
+#include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksdb/db/dbformat.h"
 
 #include "yb/docdb/consensus_frontier.h"
@@ -223,8 +224,43 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
   }
 };
 
+// Excludes files that contain only records written before min_write_time. Such records are
+// shadowed when the subdocument being read was deleted or overwritten at min_write_time.
+class RecordsSinceFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  RecordsSinceFileFilter(std::shared_ptr<rocksdb::ReadFileFilter> base_filter,
+                         const DocHybridTime& min_write_time)
+      : base_filter_(std::move(base_filter)), min_write_time_(min_write_time) {
+  }
+
+  bool Filter(const rocksdb::FdWithBoundaries& file) const override {
+    if (base_filter_ && !base_filter_->Filter(file)) {
+      return false;
+    }
+    // Largest boundary value of DocHybridTimeValue is the latest write time in the file.
+    auto* encoded = file.largest.user_value_with_tag(kDocHybridTimeTag);
+    if (!encoded) {
+      return true;
+    }
+    DocHybridTime max_write_time;
+    if (!max_write_time.FullyDecodeFrom(*encoded).ok()) {
+      return true;
+    }
+    return max_write_time >= min_write_time_;
+  }
+
+ private:
+  std::shared_ptr<rocksdb::ReadFileFilter> base_filter_;
+  DocHybridTime min_write_time_;
+};
+
 } // namespace
 
+std::shared_ptr<rocksdb::ReadFileFilter> CreateFileFilterForRecordsSince(
+    std::shared_ptr<rocksdb::ReadFileFilter> base_filter, const DocHybridTime& min_write_time) {
+  return std::make_shared<RecordsSinceFileFilter>(std::move(base_filter), min_write_time);
+}
+
 std::shared_ptr<rocksdb::BoundaryValuesExtractor> DocBoundaryValuesExtractorInstance() {
   static std::shared_ptr<rocksdb::BoundaryValuesExtractor> instance =
       std::make_shared<DocBoundaryValuesExtractor>();
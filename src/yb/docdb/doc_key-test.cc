@@ -22,6 +22,7 @@
 #include "yb/gutil/strings/substitute.h"
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/random_util.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
 
@@ -656,5 +657,55 @@ TEST_F(DocKeyTest, TestEnumerateIntents) {
   }
 }
 
+#ifdef NDEBUG
+// Measures decoding of keys with string components, that dominates DocDB read path profiles.
+TEST_F(DocKeyTest, BenchmarkDecode) {
+  constexpr int kNumKeys = 10000;
+  constexpr int kNumIterations = 100;
+
+  std::mt19937_64 rng(kNumKeys);
+  std::vector<KeyBytes> encoded_keys;
+  for (int i = 0; i != kNumKeys; ++i) {
+    std::string with_zero = RandomHumanReadableString(24, &rng);
+    with_zero[12] = '\0';
+    DocKey doc_key(
+        i, PrimitiveValues(RandomHumanReadableString(32, &rng), i),
+        {PrimitiveValue(with_zero), PrimitiveValue(RandomHumanReadableString(16, &rng),
+                                                   SortOrder::kDescending)});
+    SubDocKey sub_doc_key(
+        doc_key, PrimitiveValue(ColumnId(i % 10)), HybridTime::FromMicros(1000 + i));
+    encoded_keys.push_back(sub_doc_key.Encode());
+  }
+
+  size_t total_components = 0;
+  auto bench = [&](const char* description, const auto& decode) {
+    auto start = MonoTime::Now();
+    for (int iteration = 0; iteration != kNumIterations; ++iteration) {
+      for (const auto& key : encoded_keys) {
+        total_components += decode(key.AsSlice());
+      }
+    }
+    LOG(INFO) << description << ": "
+              << (MonoTime::Now() - start).ToNanoseconds() / (kNumKeys * kNumIterations)
+              << " ns per key";
+  };
+
+  bench("SubDocKey::FullyDecodeFrom", [](const Slice& key) {
+    SubDocKey sub_doc_key;
+    CHECK_OK(sub_doc_key.FullyDecodeFrom(key));
+    return sub_doc_key.doc_key().range_group().size();
+  });
+  bench("DocKey::DecodeFrom", [](Slice key) {
+    DocKey doc_key;
+    CHECK_OK(doc_key.DecodeFrom(&key));
+    return doc_key.hashed_group().size();
+  });
+  bench("DocKey::EncodedSize", [](const Slice& key) {
+    return CHECK_RESULT(DocKey::EncodedSize(key, DocKeyPart::WHOLE_DOC_KEY));
+  });
+  ASSERT_GT(total_components, 0);
+}
+#endif
+
 }  // namespace docdb
 }  // namespace yb
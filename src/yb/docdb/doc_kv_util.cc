@@ -13,6 +13,13 @@
 
 #include "yb/docdb/doc_kv_util.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/value.h"
@@ -73,22 +80,81 @@ Status CheckHybridTimeSizeAndValueType(
   return Status::OK();
 }
 
+namespace {
+
+// Returns pointer to the first byte equal to ch in [p, end), or end if there is no such byte.
+// Encoded strings are scanned a vector at a time, since bytes that require escaping are rare.
+inline const char* FindByte(const char* p, const char* end, char ch) {
+#if defined(__AVX2__)
+  const __m256i pattern256 = _mm256_set1_epi8(ch);
+  while (end - p >= 32) {
+    const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(data, pattern256));
+    if (mask) {
+      return p + __builtin_ctz(mask);
+    }
+    p += 32;
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i pattern = _mm_set1_epi8(ch);
+  while (end - p >= 16) {
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const uint32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(data, pattern));
+    if (mask) {
+      return p + __builtin_ctz(mask);
+    }
+    p += 16;
+  }
+#endif
+  while (p != end && *p != ch) {
+    ++p;
+  }
+  return p;
+}
+
+// Appends bytes of [p, end) xored with MASK to dest.
+template <char MASK>
+inline void AppendXored(const char* p, const char* end, string* dest) {
+  if (MASK == '\0') {
+    dest->append(p, end);
+    return;
+  }
+  const size_t old_size = dest->size();
+  dest->resize(old_size + (end - p));
+  char* out = &(*dest)[old_size];
+#if defined(__SSE2__)
+  const __m128i mask = _mm_set1_epi8(MASK);
+  while (end - p >= 16) {
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_xor_si128(data, mask));
+    p += 16;
+    out += 16;
+  }
+#endif
+  while (p != end) {
+    *out++ = *p++ ^ MASK;
+  }
+}
+
+} // namespace
+
 template <char END_OF_STRING>
 void AppendEncodedStrToKey(const string &s, string *dest) {
   static_assert(END_OF_STRING == '\0' || END_OF_STRING == '\xff',
                 "Only characters '\0' and '\xff' allowed as a template parameter");
-  if (END_OF_STRING == '\0' && s.find('\0') == string::npos) {
-    // Fast path: no zero characters, nothing to encode.
-    dest->append(s);
-  } else {
-    for (char c : s) {
-      if (c == '\0') {
-        dest->push_back(END_OF_STRING);
-        dest->push_back(END_OF_STRING ^ 1);
-      } else {
-        dest->push_back(END_OF_STRING ^ c);
-      }
+  const char* p = s.data();
+  const char* end = p + s.size();
+  for (;;) {
+    // Only zero characters have to be escaped, everything in between is copied in bulk.
+    const char* zero = FindByte(p, end, '\0');
+    AppendXored<END_OF_STRING>(p, zero, dest);
+    if (zero == end) {
+      break;
     }
+    dest->push_back(END_OF_STRING);
+    dest->push_back(END_OF_STRING ^ 1);
+    p = zero + 1;
   }
 }
 
@@ -123,34 +189,37 @@ Status DecodeEncodedStr(rocksdb::Slice* slice, string* result) {
   const char* end = p + slice->size();
 
   while (p != end) {
+    // Bytes other than END_OF_STRING are decoded as is, so look up the next END_OF_STRING and
+    // decode everything before it in bulk.
+    const char* special = FindByte(p, end, END_OF_STRING);
+    if (result != nullptr) {
+      AppendXored<END_OF_STRING>(p, special, result);
+    }
+    p = special;
+    if (p == end) {
+      break;
+    }
+    ++p;
+    if (p == end) {
+      return STATUS(Corruption, StringPrintf("Encoded string ends with only one \\0x%02x ",
+                                             END_OF_STRING));
+    }
     if (*p == END_OF_STRING) {
+      // Found two END_OF_STRING characters, this is the end of the encoded string.
       ++p;
-      if (p == end) {
-        return STATUS(Corruption, StringPrintf("Encoded string ends with only one \\0x%02x ",
-                                               END_OF_STRING));
-      }
-      if (*p == END_OF_STRING) {
-        // Found two END_OF_STRING characters, this is the end of the encoded string.
-        ++p;
-        break;
-      }
-      if (*p == END_OF_STRING_ESCAPE) {
-        // Character END_OF_STRING is encoded as AB.
-        if (result != nullptr) {
-          result->push_back(END_OF_STRING ^ END_OF_STRING);
-        }
-        ++p;
-      } else {
-        return STATUS(Corruption, StringPrintf(
-            "Invalid sequence in encoded string: "
-            R"#(\0x%02x\0x%02x (must be either \0x%02x\0x%02x or \0x%02x\0x%02x))#",
-            END_OF_STRING, *p, END_OF_STRING, END_OF_STRING, END_OF_STRING, END_OF_STRING_ESCAPE));
-      }
-    } else {
+      break;
+    }
+    if (*p == END_OF_STRING_ESCAPE) {
+      // Character END_OF_STRING is encoded as AB.
       if (result != nullptr) {
-        result->push_back((*p) ^ END_OF_STRING);
+        result->push_back(END_OF_STRING ^ END_OF_STRING);
       }
       ++p;
+    } else {
+      return STATUS(Corruption, StringPrintf(
+          "Invalid sequence in encoded string: "
+          R"#(\0x%02x\0x%02x (must be either \0x%02x\0x%02x or \0x%02x\0x%02x))#",
+          END_OF_STRING, *p, END_OF_STRING, END_OF_STRING, END_OF_STRING, END_OF_STRING_ESCAPE));
     }
   }
   if (result != nullptr) {
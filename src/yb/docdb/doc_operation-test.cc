@@ -31,6 +31,7 @@
 
 #include "yb/server/hybrid_clock.h"
 
+#include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/tostring.h"
@@ -46,6 +47,10 @@ namespace docdb {
 
 using server::HybridClock;
 
+METRIC_DEFINE_entity(doc_operation_test);
+METRIC_DEFINE_histogram(doc_operation_test, test_redis_read_latency, "Redis read latency",
+                        MetricUnit::kMicroseconds, "Latency of Redis reads", 60000000LU, 2);
+
 namespace {
 
 std::vector<ColumnId> CreateColumnIds(size_t count) {
@@ -236,8 +241,58 @@ SubDocKey(DocKey(0x0000, [1], []), [ColumnId(3); HT{ <max> w: 2 }]) -> 4
     EXPECT_OK(row_block.Deserialize(YQL_CLIENT_CQL, &data));
     return row_block;
   }
+
+  void WriteRedis(
+      uint32_t hash_code, const std::string& key, RedisDataType type, const std::string& subkey,
+      const std::string& value, const HybridTime& hybrid_time) {
+    RedisWriteRequestPB redis_write_request;
+    redis_write_request.mutable_set_request();
+    auto* key_value = redis_write_request.mutable_key_value();
+    key_value->set_hash_code(hash_code);
+    key_value->set_key(key);
+    key_value->set_type(type);
+    if (!subkey.empty()) {
+      key_value->add_subkey()->set_string_subkey(subkey);
+    }
+    key_value->add_value(value);
+    RedisWriteOperation redis_write_operation(&redis_write_request);
+    auto doc_write_batch = MakeDocWriteBatch();
+    ASSERT_OK(redis_write_operation.Apply(
+        {&doc_write_batch, CoarseTimePoint::max() /* deadline */, ReadHybridTime()}));
+    ASSERT_OK(WriteToRocksDB(doc_write_batch, hybrid_time));
+  }
+
+  // Executes requests one by one, as it is done without batching.
+  std::vector<std::string> ReadRedisOneByOne(
+      const google::protobuf::RepeatedPtrField<RedisReadRequestPB>& requests,
+      const ReadHybridTime& read_time) {
+    std::vector<std::string> result;
+    for (const auto& request : requests) {
+      RedisReadOperation operation(request, doc_db(), CoarseTimePoint::max(), read_time);
+      EXPECT_OK(operation.Execute());
+      result.push_back(operation.response().ShortDebugString());
+    }
+    return result;
+  }
 };
 
+namespace {
+
+void AddRedisGetRequest(
+    uint32_t hash_code, const std::string& key, RedisGetRequestPB::GetRequestType type,
+    const std::string& subkey, google::protobuf::RepeatedPtrField<RedisReadRequestPB>* requests) {
+  auto* request = requests->Add();
+  request->mutable_get_request()->set_request_type(type);
+  auto* key_value = request->mutable_key_value();
+  key_value->set_hash_code(hash_code);
+  key_value->set_key(key);
+  if (!subkey.empty()) {
+    key_value->add_subkey()->set_string_subkey(subkey);
+  }
+}
+
+} // namespace
+
 TEST_F(DocOperationTest, TestRedisSetKVWithTTL) {
   // Write key with ttl to docdb.
   auto db = rocksdb();
@@ -269,6 +324,65 @@ TEST_F(DocOperationTest, TestRedisSetKVWithTTL) {
   EXPECT_EQ(2000, ttl.ToMilliseconds());
 }
 
+TEST_F(DocOperationTest, RedisPointReadsBatch) {
+  // Hash codes are descending, so key order differs from request order.
+  WriteRedis(300, "a", REDIS_TYPE_STRING, "", "va", HybridTime::FromMicros(1000));
+  WriteRedis(200, "h", REDIS_TYPE_HASH, "f", "vf", HybridTime::FromMicros(1000));
+  WriteRedis(100, "b", REDIS_TYPE_STRING, "", "vb", HybridTime::FromMicros(1000));
+
+  google::protobuf::RepeatedPtrField<RedisReadRequestPB> requests;
+  AddRedisGetRequest(300, "a", RedisGetRequestPB::GET, "", &requests);
+  // Wrong type for GET of a hash.
+  AddRedisGetRequest(200, "h", RedisGetRequestPB::GET, "", &requests);
+  AddRedisGetRequest(250, "missing", RedisGetRequestPB::GET, "", &requests);
+  AddRedisGetRequest(200, "h", RedisGetRequestPB::HGET, "f", &requests);
+  // Wrong type for HGET of a string.
+  AddRedisGetRequest(100, "b", RedisGetRequestPB::HGET, "f", &requests);
+  AddRedisGetRequest(100, "b", RedisGetRequestPB::GET, "", &requests);
+  AddRedisGetRequest(300, "a", RedisGetRequestPB::GET, "", &requests);
+
+  const auto read_time = ReadHybridTime::SingleTime(HybridTime::FromMicros(2000));
+  auto expected = ReadRedisOneByOne(requests, read_time);
+
+  MetricRegistry registry;
+  auto entity = METRIC_ENTITY_doc_operation_test.Instantiate(&registry, "doc-operation-test");
+  auto read_latency = METRIC_test_redis_read_latency.Instantiate(entity);
+  google::protobuf::RepeatedPtrField<RedisResponsePB> responses;
+  ASSERT_OK(ExecuteRedisPointReads(
+      requests, doc_db(), CoarseTimePoint::max(), read_time, &responses, read_latency.get()));
+  ASSERT_EQ(requests.size(), responses.size());
+  // Each read is recorded separately.
+  ASSERT_EQ(requests.size(), read_latency->TotalCount());
+  for (int i = 0; i != responses.size(); ++i) {
+    ASSERT_EQ(expected[i], responses.Get(i).ShortDebugString()) << "Request " << i;
+  }
+  ASSERT_EQ("va", responses.Get(0).string_response());
+  ASSERT_EQ(RedisResponsePB::WRONG_TYPE, responses.Get(1).code());
+  ASSERT_EQ(RedisResponsePB::NIL, responses.Get(2).code());
+  ASSERT_EQ("vf", responses.Get(3).string_response());
+  ASSERT_EQ(RedisResponsePB::WRONG_TYPE, responses.Get(4).code());
+  ASSERT_EQ("vb", responses.Get(5).string_response());
+  ASSERT_EQ("va", responses.Get(6).string_response());
+}
+
+TEST_F(DocOperationTest, RedisPointReadsBatchThreshold) {
+  constexpr int kThreshold = 4;
+  google::protobuf::RepeatedPtrField<RedisReadRequestPB> requests;
+  for (int i = 0; i != kThreshold - 1; ++i) {
+    AddRedisGetRequest(i, Format("k$0", i), RedisGetRequestPB::GET, "", &requests);
+  }
+  ASSERT_FALSE(ShouldExecuteRedisPointReadsInBatch(requests, kThreshold));
+
+  AddRedisGetRequest(kThreshold, "h", RedisGetRequestPB::HGET, "f", &requests);
+  ASSERT_TRUE(ShouldExecuteRedisPointReadsInBatch(requests, kThreshold));
+  ASSERT_FALSE(ShouldExecuteRedisPointReadsInBatch(requests, kThreshold + 1));
+  ASSERT_FALSE(ShouldExecuteRedisPointReadsInBatch(requests, 0));
+
+  // Any request, that is not a point read, disables batching.
+  AddRedisGetRequest(kThreshold + 1, "h", RedisGetRequestPB::HGETALL, "", &requests);
+  ASSERT_FALSE(ShouldExecuteRedisPointReadsInBatch(requests, kThreshold));
+}
+
 TEST_F(DocOperationTest, TestQLInsertWithTTL) {
   RunTestQLInsertUpdate(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, 2000);
 }
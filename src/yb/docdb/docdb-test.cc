@@ -18,6 +18,7 @@
 
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/status.h"
+#include "yb/rocksdb/write_batch.h"
 #include "yb/rocksdb/util/statistics.h"
 
 #include "yb/common/hybrid_time.h"
@@ -61,6 +62,8 @@ using namespace std::chrono_literals;
 DECLARE_bool(use_docdb_aware_bloom_filter);
 DECLARE_int32(max_nexts_to_avoid_seek);
 DECLARE_bool(docdb_sort_weak_intents_in_tests);
+DECLARE_int32(docdb_shadowed_records_before_skipping_files);
+DECLARE_bool(rocksdb_hybrid_compaction);
 
 #define ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(str) ASSERT_NO_FATALS(AssertDocDbDebugDumpStrEq(str))
 
@@ -2009,6 +2012,24 @@ SubDocKey(DocKey([], ["k"]), [HT{ physical: 5000 }]) -> "v5"  // file 11
       )#");
 }
 
+TEST_F(DocDBTest, SubcompactionBoundaryPrefix) {
+  DocDBCompactionFilterFactory factory(
+      std::make_shared<ManualHistoryRetentionPolicy>(), /* key_bounds= */ nullptr);
+  const DocKey doc_key(PrimitiveValues("k"));
+  const KeyBytes encoded_doc_key(doc_key.Encode());
+
+  // All records of the document should be processed by the same subcompaction.
+  for (const auto& sub_doc_key : {
+      SubDocKey(doc_key, 1000_usec_ht),
+      SubDocKey(doc_key, PrimitiveValue("a"), 2000_usec_ht),
+      SubDocKey(doc_key, PrimitiveValue("a"), PrimitiveValue("b"), 3000_usec_ht)}) {
+    const KeyBytes encoded_sub_doc_key(sub_doc_key.Encode());
+    ASSERT_EQ(encoded_doc_key.size(),
+              factory.SubcompactionBoundaryPrefixSize(encoded_sub_doc_key.AsSlice()))
+        << sub_doc_key.ToString();
+  }
+}
+
 TEST_F(DocDBTest, MinorCompactionWithDeletions) {
   ASSERT_OK(DisableCompactions());
   const DocKey doc_key(PrimitiveValues("k"));
@@ -2084,6 +2105,126 @@ SubDocKey(DocKey([], ["k"]), [HT{ physical: 6000 }]) -> "v6"  // file 11
       )#");
 }
 
+class DocDBBottommostCompactionTest : public DocDBTest {
+ protected:
+  // Writes the two oldest files, that are compacted by CompactOldestFiles, and leaves writing of
+  // the newer overlapping files to the test.
+  void WriteOldestFiles() {
+    ASSERT_OK(DisableCompactions());
+    // Enable frontiers, so compaction knows hybrid times of the overlapping files.
+    op_id_ = {1, 1};
+    ASSERT_OK(SetPrimitive(DocPath(kDocKey.Encode()), Value(PrimitiveValue("v1")), 1000_usec_ht));
+    ASSERT_OK(SetPrimitive(DocPath(kOtherDocKey.Encode()), Value(PrimitiveValue("w1")),
+                           1000_usec_ht));
+    ASSERT_OK(FlushRocksDbAndWait());
+    ASSERT_OK(SetPrimitive(DocPath(kDocKey.Encode()), Value(PrimitiveValue::kTombstone),
+                           2000_usec_ht));
+    ASSERT_OK(FlushRocksDbAndWait());
+  }
+
+  // Compacts the two oldest files, so the compaction is bottommost, but not full.
+  void CompactOldestFiles() {
+    MinorCompaction(5000_usec_ht, /* num_files_to_compact */ 2, /* start_index */ 0);
+  }
+
+  const DocKey kDocKey{PrimitiveValues("k")};
+  const DocKey kOtherDocKey{PrimitiveValues("k2")};
+};
+
+TEST_F_EX(DocDBTest, BottommostCompactionDropsTombstone, DocDBBottommostCompactionTest) {
+  FLAGS_rocksdb_hybrid_compaction = true;
+  WriteOldestFiles();
+  ASSERT_OK(SetPrimitive(DocPath(kDocKey.Encode()), Value(PrimitiveValue("v3")), 3000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  CompactOldestFiles();
+  ASSERT_EQ(2, NumSSTableFiles());
+  // Both the tombstone and the value overwritten by it are older than anything in the overlapping
+  // newer file, so they are removed.
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(
+      R"#(
+SubDocKey(DocKey([], ["k"]), [HT{ physical: 3000 }]) -> "v3"  // file 3
+SubDocKey(DocKey([], ["k2"]), [HT{ physical: 1000 }]) -> "w1" // file 4
+      )#");
+}
+
+TEST_F_EX(DocDBTest, BottommostCompactionWithoutHybridCompaction, DocDBBottommostCompactionTest) {
+  FLAGS_rocksdb_hybrid_compaction = false;
+  WriteOldestFiles();
+  ASSERT_OK(SetPrimitive(DocPath(kDocKey.Encode()), Value(PrimitiveValue("v3")), 3000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  CompactOldestFiles();
+  ASSERT_EQ(2, NumSSTableFiles());
+  // Regular minor compaction drops the overwritten history, but keeps the tombstone.
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(
+      R"#(
+SubDocKey(DocKey([], ["k"]), [HT{ physical: 3000 }]) -> "v3"  // file 3
+SubDocKey(DocKey([], ["k"]), [HT{ physical: 2000 }]) -> DEL   // file 4
+SubDocKey(DocKey([], ["k2"]), [HT{ physical: 1000 }]) -> "w1" // file 4
+      )#");
+}
+
+TEST_F_EX(DocDBTest, BottommostCompactionOverlappingOlderRecords, DocDBBottommostCompactionTest) {
+  FLAGS_rocksdb_hybrid_compaction = true;
+  WriteOldestFiles();
+  // The newer file contains a record, that is older than the tombstone, so removing the tombstone
+  // would resurrect it.
+  ASSERT_OK(SetPrimitive(DocPath(kDocKey.Encode()), Value(PrimitiveValue("v15")), 1500_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  CompactOldestFiles();
+  ASSERT_EQ(2, NumSSTableFiles());
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(
+      R"#(
+SubDocKey(DocKey([], ["k"]), [HT{ physical: 2000 }]) -> DEL   // file 4
+SubDocKey(DocKey([], ["k"]), [HT{ physical: 1500 }]) -> "v15" // file 3
+SubDocKey(DocKey([], ["k2"]), [HT{ physical: 1000 }]) -> "w1" // file 4
+      )#");
+}
+
+TEST_F_EX(DocDBTest, BottommostCompactionMissingFrontier, DocDBBottommostCompactionTest) {
+  FLAGS_rocksdb_hybrid_compaction = true;
+  WriteOldestFiles();
+  // The newer file is written without frontiers, so hybrid times of its records are unknown.
+  op_id_ = rocksdb::OpId();
+  ASSERT_OK(SetPrimitive(DocPath(kDocKey.Encode()), Value(PrimitiveValue("v3")), 3000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  CompactOldestFiles();
+  ASSERT_EQ(2, NumSSTableFiles());
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(
+      R"#(
+SubDocKey(DocKey([], ["k"]), [HT{ physical: 3000 }]) -> "v3"  // file 3
+SubDocKey(DocKey([], ["k"]), [HT{ physical: 2000 }]) -> DEL   // file 4
+SubDocKey(DocKey([], ["k2"]), [HT{ physical: 1000 }]) -> "w1" // file 4
+      )#");
+}
+
+TEST_F_EX(DocDBTest, BottommostCompactionInvalidFrontier, DocDBBottommostCompactionTest) {
+  FLAGS_rocksdb_hybrid_compaction = true;
+  WriteOldestFiles();
+  // The newer file has frontiers with op id only, so its smallest hybrid time is invalid.
+  op_id_ = rocksdb::OpId();
+  ConsensusFrontiers frontiers;
+  set_op_id({1, 10}, &frontiers);
+  rocksdb::WriteBatch batch;
+  batch.SetFrontiers(&frontiers);
+  batch.Put(SubDocKey(kDocKey, 3000_usec_ht).Encode().AsSlice(),
+            Value(PrimitiveValue("v3")).Encode());
+  ASSERT_OK(rocksdb_->Write(write_options(), &batch));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  CompactOldestFiles();
+  ASSERT_EQ(2, NumSSTableFiles());
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(
+      R"#(
+SubDocKey(DocKey([], ["k"]), [HT{ physical: 3000 }]) -> "v3"  // file 3
+SubDocKey(DocKey([], ["k"]), [HT{ physical: 2000 }]) -> DEL   // file 4
+SubDocKey(DocKey([], ["k2"]), [HT{ physical: 1000 }]) -> "w1" // file 4
+      )#");
+}
+
 TEST_F(DocDBTest, BasicTest) {
   // A few points to make it easier to understand the expected binary representations here:
   // - Initial bytes such as 'S' (kString), 'I' (kInt64) correspond to members of the enum
@@ -2570,6 +2711,85 @@ TEST_F(DocDBTest, MergingIterator) {
   VerifySubDocument(SubDocKey(key2), ht, "\"value2\"");
 }
 
+TEST_F(DocDBTest, SkipFilesWithShadowedRecords) {
+  constexpr int kNumSubKeys = 10;
+  const DocKey doc_key(PrimitiveValues("key"));
+  KeyBytes encoded_doc_key(doc_key.Encode());
+
+  // file1: old subkeys at 1000, all of them are shadowed by the tombstone.
+  auto dwb = MakeDocWriteBatch();
+  for (int i = 0; i != kNumSubKeys; ++i) {
+    ASSERT_OK(dwb.SetPrimitive(
+        DocPath(encoded_doc_key, PrimitiveValue(Format("k$0", i))),
+        PrimitiveValue(Format("old$0", i))));
+  }
+  ASSERT_OK(WriteToRocksDB(dwb, 1000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  // file2: tombstone at 2000 and new values of k7 and k9 at 3000.
+  dwb.Clear();
+  ASSERT_OK(dwb.DeleteSubDoc(DocPath(encoded_doc_key)));
+  ASSERT_OK(WriteToRocksDB(dwb, 2000_usec_ht));
+  dwb.Clear();
+  for (int i : {7, 9}) {
+    ASSERT_OK(dwb.SetPrimitive(
+        DocPath(encoded_doc_key, PrimitiveValue(Format("k$0", i))),
+        PrimitiveValue(Format("new$0", i))));
+  }
+  ASSERT_OK(WriteToRocksDB(dwb, 3000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  // Memtable: new value of k8 at 4000.
+  dwb.Clear();
+  ASSERT_OK(dwb.SetPrimitive(
+      DocPath(encoded_doc_key, PrimitiveValue("k8")), PrimitiveValue("new8")));
+  ASSERT_OK(WriteToRocksDB(dwb, 4000_usec_ht));
+
+  const auto expected_new = R"#(
+{
+  "k7": "new7",
+  "k8": "new8",
+  "k9": "new9"
+}
+      )#";
+  auto table_iterators = [this] {
+    return options().statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS);
+  };
+
+  std::vector<uint64_t> table_iterators_used;
+  for (int shadowed_records : {0, 3}) {
+    SCOPED_TRACE(Format("Shadowed records before skipping files: $0", shadowed_records));
+    FLAGS_docdb_shadowed_records_before_skipping_files = shadowed_records;
+    auto table_iterators_before = table_iterators();
+    VerifySubDocument(SubDocKey(doc_key), 4500_usec_ht, expected_new);
+    table_iterators_used.push_back(table_iterators() - table_iterators_before);
+
+    VerifySubDocument(SubDocKey(doc_key), 3500_usec_ht, R"#(
+{
+  "k7": "new7",
+  "k9": "new9"
+}
+      )#");
+    VerifySubDocument(SubDocKey(doc_key), 1500_usec_ht, R"#(
+{
+  "k0": "old0",
+  "k1": "old1",
+  "k2": "old2",
+  "k3": "old3",
+  "k4": "old4",
+  "k5": "old5",
+  "k6": "old6",
+  "k7": "old7",
+  "k8": "old8",
+  "k9": "old9"
+}
+      )#");
+  }
+  // After 3 shadowed records, the rest of the document is read by one more iterator, that does
+  // not read file1.
+  ASSERT_EQ(table_iterators_used[0] + 1, table_iterators_used[1]);
+}
+
 TEST_F(DocDBTest, SetPrimitiveWithInitMarker) {
   // Both required and optional init marker should be ok.
   for (auto init_marker_behavior : kInitMarkerBehaviorList) {
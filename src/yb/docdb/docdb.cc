@@ -72,6 +72,12 @@ using namespace std::placeholders;
 DEFINE_test_flag(bool, docdb_sort_weak_intents_in_tests, false,
                 "Sort weak intents to make their order deterministic.");
 
+DEFINE_int32(docdb_shadowed_records_before_skipping_files, 100,
+             "Number of records shadowed by a tombstone or an overwrite of a subdocument, that "
+             "are skipped one by one while reading it. After that the rest of the subdocument "
+             "is read with an iterator that ignores SST files containing only older records. "
+             "0 disables such switching.");
+
 namespace yb {
 namespace docdb {
 
@@ -710,6 +716,7 @@ CHECKED_STATUS BuildSubDocument(
     int64* num_values_observed) {
   VLOG(3) << "BuildSubDocument data: " << data << " read_time: " << iter->read_time()
           << " low_ts: " << low_ts;
+  int num_shadowed_records = 0;
   while (iter->valid()) {
     if (data.deadline_info && data.deadline_info->CheckAndSetDeadlinePassed()) {
       return STATUS(Expired, "Deadline for query passed.");
@@ -737,6 +744,25 @@ CHECKED_STATUS BuildSubDocument(
         << ", write time: " << write_time.hybrid_time();
 
     if (low_ts > write_time) {
+      if (++num_shadowed_records == FLAGS_docdb_shadowed_records_before_skipping_files) {
+        // Records before low_ts are shadowed, so the rest of the subdocument could be read without
+        // SST files that contain only such records.
+        auto records_since_iter = iter->CreateIteratorForRecordsSince(low_ts);
+        if (records_since_iter) {
+          VLOG(3) << "Reading records since " << low_ts << " from: "
+                  << SubDocKey::DebugSliceToString(key);
+          {
+            IntentAwareIteratorPrefixScope prefix_scope(
+                data.subdocument_key, records_since_iter.get());
+            records_since_iter->Seek(key);
+            RETURN_NOT_OK(BuildSubDocument(
+                records_since_iter.get(), data, low_ts, num_values_observed));
+          }
+          iter->UpdateMaxSeenHt(records_since_iter->max_seen_ht());
+          iter->SeekOutOfSubDoc(data.subdocument_key);
+          return Status::OK();
+        }
+      }
       VLOG(3) << "SeekPastSubKey: " << SubDocKey::DebugSliceToString(key);
       iter->SeekPastSubKey(key);
       continue;
@@ -835,6 +861,16 @@ CHECKED_STATUS BuildSubDocument(
         return Status::OK();
       }
     }
+    // Check the lower bound before building the descendant, so values filtered by low_subkey are
+    // not counted in num_values_observed, i.e. low_index is counted from low_subkey.
+    if (!data.low_subkey->CanInclude(key)) {
+      VLOG(3) << "Filtered by low_subkey: " << data.low_subkey->ToString()
+              << ", key: " << SubDocKey::DebugSliceToString(key);
+      // The value provided is lower than what we are looking for, seek to the lower bound.
+      SeekToLowerBound(*data.low_subkey, iter);
+      continue;
+    }
+
     SubDocument descendant{PrimitiveValue(ValueType::kInvalid)};
     // TODO: what if the key we found is the same as before?
     //       We'll get into an infinite recursion then.
@@ -850,14 +886,6 @@ CHECKED_STATUS BuildSubDocument(
       continue;
     }
 
-    if (!data.low_subkey->CanInclude(key)) {
-      VLOG(3) << "Filtered by low_subkey: " << data.low_subkey->ToString()
-              << ", key: " << SubDocKey::DebugSliceToString(key);
-      // The value provided is lower than what we are looking for, seek to the lower bound.
-      SeekToLowerBound(*data.low_subkey, iter);
-      continue;
-    }
-
     // We use num_values_observed as a conservative figure for lower bound and
     // current_values_observed for upper bound so we don't lose any data we should be including.
     if (!data.low_index->CanInclude(*num_values_observed)) {
@@ -15,8 +15,10 @@
 
 #include <memory>
 
+#include <gflags/gflags.h>
 #include <glog/logging.h>
 
+#include "yb/gutil/casts.h"
 #include "yb/rocksdb/compaction_filter.h"
 #include "yb/util/string_util.h"
 
@@ -34,6 +36,8 @@ using rocksdb::CompactionFilter;
 using rocksdb::VectorToString;
 using rocksdb::FilterDecision;
 
+DECLARE_bool(rocksdb_hybrid_compaction);
+
 namespace yb {
 namespace docdb {
 
@@ -42,10 +46,12 @@ namespace docdb {
 DocDBCompactionFilter::DocDBCompactionFilter(
     HistoryRetentionDirective retention,
     IsMajorCompaction is_major_compaction,
-    const KeyBounds* key_bounds)
+    const KeyBounds* key_bounds,
+    HybridTime major_compaction_max_ht)
     : retention_(std::move(retention)),
       key_bounds_(key_bounds),
-      is_major_compaction_(is_major_compaction) {
+      is_major_compaction_(is_major_compaction),
+      major_compaction_max_ht_(major_compaction_max_ht) {
 }
 
 DocDBCompactionFilter::~DocDBCompactionFilter() {
@@ -73,7 +79,8 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
     // TODO: switch this to VLOG if it becomes too chatty.
     LOG(INFO) << "DocDB compaction filter is being used for a "
               << (is_major_compaction_ ? "major" : "minor") << " compaction"
-              << ", history_cutoff=" << history_cutoff;
+              << ", history_cutoff=" << history_cutoff
+              << ", major_compaction_max_ht=" << major_compaction_max_ht_;
     filter_usage_logged_ = true;
   }
 
@@ -256,7 +263,7 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
   if (has_expired) {
     // This is consistent with the condition we're testing for deletes at the bottom of the function
     // because ht_at_or_below_cutoff is implied by has_expired.
-    if (is_major_compaction_) {
+    if (CanRemoveDeleted(ht.hybrid_time())) {
       return FilterDecision::kDiscard;
     }
 
@@ -288,8 +295,8 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
   // compactions. However, we do need to update the overwrite hybrid time stack in this case (as we
   // just did), because this deletion (tombstone) entry might be the only reason for cleaning up
   // more entries appearing at earlier hybrid times.
-  return value_type == ValueType::kTombstone && is_major_compaction_ ? FilterDecision::kDiscard
-                                                                     : FilterDecision::kKeep;
+  return value_type == ValueType::kTombstone && CanRemoveDeleted(ht.hybrid_time())
+      ? FilterDecision::kDiscard : FilterDecision::kKeep;
 }
 
 void DocDBCompactionFilter::AssignPrevSubDocKey(
@@ -322,10 +329,35 @@ DocDBCompactionFilterFactory::~DocDBCompactionFilterFactory() {
 
 unique_ptr<CompactionFilter> DocDBCompactionFilterFactory::CreateCompactionFilter(
     const CompactionFilter::Context& context) {
+  IsMajorCompaction is_major_compaction(context.is_full_compaction);
+  HybridTime major_compaction_max_ht = HybridTime::kMax;
+  if (!is_major_compaction && context.is_bottommost_level && FLAGS_rocksdb_hybrid_compaction) {
+    // All older data for the key range of this compaction is included into it, so it could be
+    // treated as major one for values that are older than any value in other overlapping files.
+    // Only hybrid compaction picks such compactions of cold data on purpose, so other compaction
+    // styles keep the regular minor compaction behavior.
+    is_major_compaction = IsMajorCompaction::kTrue;
+    if (context.overlapping_files_smallest_frontier) {
+      major_compaction_max_ht = down_cast<const ConsensusFrontier&>(
+          *context.overlapping_files_smallest_frontier).hybrid_time();
+      if (!major_compaction_max_ht.is_valid()) {
+        is_major_compaction = IsMajorCompaction::kFalse;
+      }
+    }
+  }
   return std::make_unique<DocDBCompactionFilter>(
       retention_policy_->GetRetentionDirective(),
-      IsMajorCompaction(context.is_full_compaction),
-      key_bounds_);
+      is_major_compaction,
+      key_bounds_,
+      major_compaction_max_ht);
+}
+
+size_t DocDBCompactionFilterFactory::SubcompactionBoundaryPrefixSize(
+    const Slice& user_key) const {
+  // DocDBCompactionFilter keeps state between subdocuments of the same document, so subcompaction
+  // boundaries should be placed between documents.
+  auto doc_key_size = DocKey::EncodedSize(user_key, DocKeyPart::WHOLE_DOC_KEY);
+  return doc_key_size.ok() ? *doc_key_size : user_key.size();
 }
 
 const char* DocDBCompactionFilterFactory::Name() const {
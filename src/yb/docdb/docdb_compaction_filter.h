@@ -57,10 +57,14 @@ struct HistoryRetentionDirective {
 // DocDB compaction filter. A new instance of this class is created for every compaction.
 class DocDBCompactionFilter : public rocksdb::CompactionFilter {
  public:
+  // In major compaction tombstones and expired values are removed only when they were written at
+  // hybrid time not higher than major_compaction_max_ht. Because files that are not part of this
+  // compaction could contain values of the same keys written after it.
   DocDBCompactionFilter(
       HistoryRetentionDirective retention,
       IsMajorCompaction is_major_compaction,
-      const KeyBounds* key_bounds);
+      const KeyBounds* key_bounds,
+      HybridTime major_compaction_max_ht = HybridTime::kMax);
 
   ~DocDBCompactionFilter() override;
   rocksdb::FilterDecision Filter(
@@ -87,9 +91,15 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
       int level, const Slice& key, const Slice& existing_value, std::string* new_value,
       bool* value_changed);
 
+  // Whether tombstone or expired value written at the specified hybrid time could be removed.
+  bool CanRemoveDeleted(HybridTime ht) const {
+    return is_major_compaction_ && ht <= major_compaction_max_ht_;
+  }
+
   const HistoryRetentionDirective retention_;
   const KeyBounds* key_bounds_;
   const IsMajorCompaction is_major_compaction_;
+  const HybridTime major_compaction_max_ht_;
 
   std::vector<char> prev_subdoc_key_;
 
@@ -160,6 +170,7 @@ class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
   ~DocDBCompactionFilterFactory() override;
   std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
       const rocksdb::CompactionFilter::Context& context) override;
+  size_t SubcompactionBoundaryPrefixSize(const Slice& user_key) const override;
   const char* Name() const override;
 
  private:
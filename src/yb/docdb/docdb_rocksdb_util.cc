@@ -20,6 +20,7 @@
 
 #include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/rate_limiter.h"
+#include "yb/rocksdb/slice_transform.h"
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/util/compression.h"
 
@@ -63,6 +64,34 @@ DEFINE_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024
              "Threshold beyond which compaction is considered large.");
 DEFINE_uint64(rocksdb_max_file_size_for_compaction, 0,
              "Maximal allowed file size to participate in RocksDB compaction. 0 - unlimited.");
+DEFINE_bool(rocksdb_hybrid_compaction, false,
+            "Use hybrid compaction. Recent data is compacted universal style in level-0, older "
+            "data is compacted level by level, so the size of a single compaction is bounded "
+            "instead of rewriting the whole tablet. Tablets that have data in multiple levels "
+            "could not be opened after turning this flag off.");
+DEFINE_int32(rocksdb_hybrid_compaction_num_levels, 5,
+             "Number of RocksDB levels used by hybrid compaction.");
+DEFINE_uint64(rocksdb_hybrid_compaction_level0_size_bytes, 1_GB,
+              "Size of level-0 in hybrid compaction, after which it is merged into next level.");
+DEFINE_uint64(rocksdb_hybrid_compaction_target_file_size_bytes, 128_MB,
+              "Size of files produced by hybrid compaction outside of level-0.");
+DEFINE_int32(rocksdb_max_subcompactions, 1,
+             "Maximal number of key range subcompactions executed in parallel for a single "
+             "compaction. When greater than 1, universal compactions of the oldest data output to "
+             "a separate range partitioned level, so they could be split. Tablets that have data in "
+             "this level could not be opened after setting it back to 1.");
+DEFINE_uint64(rocksdb_subcompaction_target_file_size_bytes, 1_GB,
+              "Size of files produced by universal compactions that could be split into "
+              "subcompactions. Compaction is not split into more subcompactions than the number "
+              "of such files it produces.");
+
+DEFINE_bool(use_docdb_memtable_hash_index, false,
+            "Index regular DB memtable entries by DocKey, so seeks to a document start from its "
+            "first entry instead of traversing the skip list.");
+
+DEFINE_uint64(docdb_memtable_hash_index_max_buckets, 1ULL << 16,
+              "Maximum number of DocKey hash index buckets of a regular DB memtable. The number "
+              "of buckets is proportional to the memtable size up to this limit.");
 
 DEFINE_int64(db_block_size_bytes, 32_KB,
              "Size of RocksDB data block (in bytes).");
@@ -399,6 +428,30 @@ namespace {
 
 std::mutex rocksdb_flags_mutex;
 
+// Memtable size per DocKey hash index bucket.
+constexpr size_t kMemTableBytesPerIndexBucket = 512;
+
+// Extracts DocKey from the key of a regular DB record.
+class DocKeyPrefixTransform : public rocksdb::SliceTransform {
+ public:
+  const char* Name() const override {
+    return "DocKeyPrefixTransform";
+  }
+
+  Slice Transform(const Slice& src) const override {
+    auto doc_key_size = DocKey::EncodedSize(src, DocKeyPart::WHOLE_DOC_KEY);
+    return Slice(src.data(), doc_key_size.ok() ? *doc_key_size : src.size());
+  }
+
+  bool InDomain(const Slice& src) const override {
+    return DocKey::EncodedSize(src, DocKeyPart::WHOLE_DOC_KEY).ok();
+  }
+
+  bool InRange(const Slice& dst) const override {
+    return InDomain(dst);
+  }
+};
+
 // Auto initialize some of the RocksDB flags that are defaulted to -1.
 void AutoInitRocksDBFlags(rocksdb::Options* options) {
   const int kNumCpus = base::NumCPUs();
@@ -547,6 +600,21 @@ void InitRocksDBOptions(
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
+    if (FLAGS_rocksdb_hybrid_compaction) {
+      // Universal compaction options above are used for level-0.
+      options->compaction_style = rocksdb::CompactionStyle::kCompactionStyleLevel;
+      options->level0_universal_compaction = true;
+      options->num_levels = FLAGS_rocksdb_hybrid_compaction_num_levels;
+      // Keep most of the data in the last level, so space amplification is predictable.
+      options->level_compaction_dynamic_level_bytes = true;
+      options->max_bytes_for_level_base = FLAGS_rocksdb_hybrid_compaction_level0_size_bytes;
+      options->target_file_size_base = FLAGS_rocksdb_hybrid_compaction_target_file_size_bytes;
+    }
+    if (FLAGS_rocksdb_max_subcompactions > 1) {
+      // Universal compaction is split only when it writes to the level above level-0, that is
+      // enabled by InitRegularDBOptions.
+      options->max_subcompactions = FLAGS_rocksdb_max_subcompactions;
+    }
     if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec > 0) {
       options->rate_limiter.reset(
           rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec));
@@ -561,8 +629,40 @@ void InitRocksDBOptions(
     options->max_file_size_for_compaction = max_file_size_for_compaction;
   }
 
-  options->memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
-      0 /* lookahead */, rocksdb::ConcurrentWrites::kFalse);
+  if (FLAGS_use_docdb_memtable_hash_index) {
+    const size_t bucket_count = std::max<size_t>(std::min<size_t>(
+        options->write_buffer_size / kMemTableBytesPerIndexBucket,
+        FLAGS_docdb_memtable_hash_index_max_buckets), 1);
+    options->memtable_factory = std::make_shared<rocksdb::HashIndexedSkipListFactory>(
+        std::make_shared<DocKeyPrefixTransform>(), bucket_count);
+  } else {
+    options->memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
+        0 /* lookahead */, rocksdb::ConcurrentWrites::kFalse);
+  }
+}
+
+void InitRegularDBOptions(rocksdb::Options* options) {
+  if (options->compaction_style == rocksdb::CompactionStyle::kCompactionStyleUniversal &&
+      FLAGS_rocksdb_max_subcompactions > 1) {
+    // Universal compaction writes to the last level only when it includes the oldest sorted
+    // run, so level-0 files stay ordered by sequence numbers, while the last level is range
+    // partitioned.
+    options->num_levels = 2;
+    options->target_file_size_base = FLAGS_rocksdb_subcompaction_target_file_size_bytes;
+  }
+}
+
+void SetNumLevelsForExistingDB(const std::string& db_dir, rocksdb::Options* options) {
+  int max_level = 0;
+  // There is nothing to adjust for a new DB, and other errors are reported when it is opened.
+  if (!rocksdb::DB::GetMaxLevel(*options, db_dir, &max_level).ok() ||
+      max_level < options->num_levels) {
+    return;
+  }
+  LOG(INFO) << "RocksDB at " << db_dir << " has files at level " << max_level
+            << ", opening it with " << max_level + 1 << " levels instead of "
+            << options->num_levels;
+  options->num_levels = max_level + 1;
 }
 
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix) {
@@ -139,6 +139,16 @@ void InitRocksDBOptions(
     const std::shared_ptr<rocksdb::Statistics>& statistics,
     const tablet::TabletOptions& tablet_options);
 
+// Sets options used only by the regular DB, on top of InitRocksDBOptions. Universal compaction
+// with parallel subcompactions keeps range partitioned files above level-0, while the intents DB
+// keeps all its files at level-0.
+void InitRegularDBOptions(rocksdb::Options* options);
+
+// RocksDB does not persist the level count, so a DB written with more levels, e.g. before the flags
+// that enabled them were changed, could not be opened with fewer levels. Raises
+// options->num_levels to the level count used by the files of the DB located in db_dir, if any.
+void SetNumLevelsForExistingDB(const std::string& db_dir, rocksdb::Options* options);
+
 // Sets logs prefix for RocksDB options. This will also reinitialize options->info_log.
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix);
 
@@ -38,6 +38,9 @@ DEFINE_bool(transaction_allow_rerequest_status_in_tests, true,
 namespace yb {
 namespace docdb {
 
+std::shared_ptr<rocksdb::ReadFileFilter> CreateFileFilterForRecordsSince(
+    std::shared_ptr<rocksdb::ReadFileFilter> base_filter, const DocHybridTime& min_write_time);
+
 namespace {
 
 void GetIntentPrefixForKeyWithoutHt(const Slice& key, KeyBytes* out) {
@@ -232,8 +235,13 @@ IntentAwareIterator::IntentAwareIterator(
     const rocksdb::ReadOptions& read_opts,
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
-    const TransactionOperationContextOpt& txn_op_context)
-    : read_time_(read_time),
+    const TransactionOperationContextOpt& txn_op_context,
+    const DocHybridTime& min_write_time)
+    : doc_db_(doc_db),
+      read_opts_(read_opts),
+      deadline_(deadline),
+      min_write_time_(min_write_time),
+      read_time_(read_time),
       encoded_read_time_local_limit_(
           DocHybridTime(read_time_.local_limit, kMaxWriteId).EncodedInDocDbFormat()),
       encoded_read_time_global_limit_(
@@ -263,6 +271,19 @@ IntentAwareIterator::IntentAwareIterator(
   iter_ = BoundedRocksDbIterator(doc_db.regular, read_opts, doc_db.key_bounds);
 }
 
+std::unique_ptr<IntentAwareIterator> IntentAwareIterator::CreateIteratorForRecordsSince(
+    const DocHybridTime& min_write_time) {
+  if (min_write_time <= min_write_time_) {
+    return nullptr;
+  }
+  auto read_opts = read_opts_;
+  read_opts.file_filter = CreateFileFilterForRecordsSince(read_opts_.file_filter, min_write_time);
+  std::unique_ptr<IntentAwareIterator> result(new IntentAwareIterator(
+      doc_db_, read_opts, deadline_, read_time_, txn_op_context_, min_write_time));
+  result->SetUpperbound(upperbound_);
+  return result;
+}
+
 void IntentAwareIterator::Seek(const DocKey &doc_key) {
   Seek(doc_key.Encode());
 }
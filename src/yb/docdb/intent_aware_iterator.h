@@ -16,6 +16,7 @@
 
 #include <boost/optional/optional.hpp>
 
+#include "yb/common/doc_hybrid_time.h"
 #include "yb/common/read_hybrid_time.h"
 #include "yb/util/trilean.h"
 
@@ -92,7 +93,9 @@ class IntentAwareIterator {
       const rocksdb::ReadOptions& read_opts,
       CoarseTimePoint deadline,
       const ReadHybridTime& read_time,
-      const TransactionOperationContextOpt& txn_op_context);
+      const TransactionOperationContextOpt& txn_op_context)
+      : IntentAwareIterator(
+            doc_db, read_opts, deadline, read_time, txn_op_context, DocHybridTime::kMin) {}
 
   IntentAwareIterator(const IntentAwareIterator& other) = delete;
   void operator=(const IntentAwareIterator& other) = delete;
@@ -174,9 +177,30 @@ class IntentAwareIterator {
     upperbound_ = upperbound;
   }
 
+  // Creates an iterator over the same data at the same read time, that does not read SST files
+  // containing only records written before min_write_time. It is used to read the rest of a
+  // subdocument that was deleted or overwritten at min_write_time, since all older records of
+  // this subdocument are shadowed. The new iterator is not positioned and has an empty prefix
+  // stack. Returns nullptr if this iterator already skips such files.
+  std::unique_ptr<IntentAwareIterator> CreateIteratorForRecordsSince(
+      const DocHybridTime& min_write_time);
+
+  // Updates max_seen_ht with records seen by other iterator, that was used instead of this one.
+  void UpdateMaxSeenHt(HybridTime ht) {
+    max_seen_ht_.MakeAtLeast(ht);
+  }
+
   void DebugDump();
 
  private:
+  IntentAwareIterator(
+      const DocDB& doc_db,
+      const rocksdb::ReadOptions& read_opts,
+      CoarseTimePoint deadline,
+      const ReadHybridTime& read_time,
+      const TransactionOperationContextOpt& txn_op_context,
+      const DocHybridTime& min_write_time);
+
   // Seek forward on regular sub-iterator.
   void SeekForwardRegular(const Slice& slice);
 
@@ -267,6 +291,12 @@ class IntentAwareIterator {
                                                :  resolved_intent_txn_dht_;
   }
 
+  // Kept to create iterators over the same data, see CreateIteratorForRecordsSince.
+  const DocDB doc_db_;
+  const rocksdb::ReadOptions read_opts_;
+  const CoarseTimePoint deadline_;
+  const DocHybridTime min_write_time_;
+
   const ReadHybridTime read_time_;
   const string encoded_read_time_local_limit_;
   const string encoded_read_time_global_limit_;
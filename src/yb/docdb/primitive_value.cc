@@ -105,6 +105,8 @@ string PrimitiveValue::ToString() const {
       return "SSforward";
     case ValueType::kSSReverse:
       return "SSreverse";
+    case ValueType::kSSBlockCounts:
+      return "SSblockcounts";
     case ValueType::kFalse: FALLTHROUGH_INTENDED;
     case ValueType::kFalseDescending:
       return "false";
@@ -244,6 +246,7 @@ void PrimitiveValue::AppendToKey(KeyBytes* key_bytes) const {
     case ValueType::kCounter: return;
     case ValueType::kSSForward: return;
     case ValueType::kSSReverse: return;
+    case ValueType::kSSBlockCounts: return;
     case ValueType::kFalse: return;
     case ValueType::kTrue: return;
     case ValueType::kFalseDescending: return;
@@ -416,6 +419,7 @@ string PrimitiveValue::ToValue() const {
     case ValueType::kCounter: FALLTHROUGH_INTENDED;
     case ValueType::kSSForward: FALLTHROUGH_INTENDED;
     case ValueType::kSSReverse: FALLTHROUGH_INTENDED;
+    case ValueType::kSSBlockCounts: FALLTHROUGH_INTENDED;
     case ValueType::kFalse: FALLTHROUGH_INTENDED;
     case ValueType::kTrue: FALLTHROUGH_INTENDED;
     case ValueType::kFalseDescending: FALLTHROUGH_INTENDED;
@@ -589,6 +593,7 @@ Status PrimitiveValue::DecodeKey(rocksdb::Slice* slice, PrimitiveValue* out) {
     case ValueType::kCounter: FALLTHROUGH_INTENDED;
     case ValueType::kSSForward: FALLTHROUGH_INTENDED;
     case ValueType::kSSReverse: FALLTHROUGH_INTENDED;
+    case ValueType::kSSBlockCounts: FALLTHROUGH_INTENDED;
     case ValueType::kFalse: FALLTHROUGH_INTENDED;
     case ValueType::kTrue: FALLTHROUGH_INTENDED;
     case ValueType::kFalseDescending: FALLTHROUGH_INTENDED;
@@ -955,6 +960,7 @@ Status PrimitiveValue::DecodeFromValue(const rocksdb::Slice& rocksdb_slice) {
     case ValueType::kCounter: FALLTHROUGH_INTENDED;
     case ValueType::kSSForward: FALLTHROUGH_INTENDED;
     case ValueType::kSSReverse: FALLTHROUGH_INTENDED;
+    case ValueType::kSSBlockCounts: FALLTHROUGH_INTENDED;
     case ValueType::kFalse: FALLTHROUGH_INTENDED;
     case ValueType::kTrue: FALLTHROUGH_INTENDED;
     case ValueType::kFalseDescending: FALLTHROUGH_INTENDED;
@@ -1284,6 +1290,7 @@ bool PrimitiveValue::operator==(const PrimitiveValue& other) const {
     case ValueType::kFalseDescending: FALLTHROUGH_INTENDED;
     case ValueType::kSSForward: FALLTHROUGH_INTENDED;
     case ValueType::kSSReverse: FALLTHROUGH_INTENDED;
+    case ValueType::kSSBlockCounts: FALLTHROUGH_INTENDED;
     case ValueType::kTrue: FALLTHROUGH_INTENDED;
     case ValueType::kTrueDescending: FALLTHROUGH_INTENDED;
     case ValueType::kLowest: FALLTHROUGH_INTENDED;
@@ -1361,6 +1368,7 @@ int PrimitiveValue::CompareTo(const PrimitiveValue& other) const {
     case ValueType::kCounter: FALLTHROUGH_INTENDED;
     case ValueType::kSSForward: FALLTHROUGH_INTENDED;
     case ValueType::kSSReverse: FALLTHROUGH_INTENDED;
+    case ValueType::kSSBlockCounts: FALLTHROUGH_INTENDED;
     case ValueType::kFalse: FALLTHROUGH_INTENDED;
     case ValueType::kTrue: FALLTHROUGH_INTENDED;
     case ValueType::kFalseDescending: FALLTHROUGH_INTENDED;
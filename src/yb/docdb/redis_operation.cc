@@ -13,6 +13,9 @@
 
 #include "yb/docdb/redis_operation.h"
 
+#include <algorithm>
+#include <map>
+
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/doc_write_batch.h"
 #include "yb/docdb/doc_write_batch_cache.h"
@@ -20,6 +23,8 @@
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/subdocument.h"
 
+#include "yb/util/kv_util.h"
+#include "yb/util/metrics.h"
 #include "yb/util/stol_utils.h"
 #include "yb/util/redis_util.h"
 
@@ -30,6 +35,12 @@ DEFINE_bool(emulate_redis_responses,
     "and HDEL. If emulate_redis_responses is true, we read the required records to compute the "
     "response as specified by the official Redis API documentation. https://redis.io/commands");
 
+DEFINE_bool(redis_sorted_set_block_counts,
+    false,
+    "Whether to maintain counts of sorted set members per score block, so ZRANK, ZREVRANK, ZCOUNT "
+    "and ZRANGE could skip whole blocks. Maintaining them costs ZADD and ZREM a read of every "
+    "touched block count, and counts of a set are rebuilt by its first write after enabling.");
+
 namespace yb {
 namespace docdb {
 
@@ -428,6 +439,243 @@ Result<int64_t> GetCardinality(IntentAwareIterator* iterator, const RedisKeyValu
   return subdoc_card_found ? subdoc_card.GetInt64() : 0;
 }
 
+// Sorted set members are grouped into blocks by the leading bits of the order preserving encoding
+// of their scores, and number of members in each nonempty block is stored under kSSBlockCounts.
+// So rank queries could skip whole blocks using those counts, and iterate only members of the
+// boundary blocks.
+constexpr int kSortedSetBlockBits = 20;
+constexpr int64_t kSortedSetMaxBlock = (1LL << kSortedSetBlockBits) - 1;
+// Pseudo block, that holds the total number of members counted in blocks. Its presence tells that
+// counts were maintained for every member of the set.
+constexpr int64_t kSortedSetTotalBlock = -1;
+
+int64_t SortedSetBlock(double score) {
+  uint64_t bits;
+  memcpy(&bits, &score, sizeof(bits));
+  // The same transformation as in AppendDoubleToKey, so blocks are ordered in the same way as
+  // forward mapping keys.
+  bits = (bits >> 63) ? ~bits : bits ^ util::kInt64SignBitFlipMask;
+  return bits >> (64 - kSortedSetBlockBits);
+}
+
+// Appends the lowest forward mapping subkey that could belong to the specified block.
+void AppendSortedSetBlockStart(int64_t block, KeyBytes* key) {
+  key->AppendValueType(ValueType::kDouble);
+  key->AppendUInt64(static_cast<uint64_t>(block) << (64 - kSortedSetBlockBits));
+}
+
+KeyBytes SortedSetBlockCountsKey(const RedisKeyValuePB& kv) {
+  auto result = DocKey::EncodedFromRedisKey(kv.hash_code(), kv.key());
+  PrimitiveValue(ValueType::kSSBlockCounts).AppendToKey(&result);
+  return result;
+}
+
+KeyBytes SortedSetForwardKey(const RedisKeyValuePB& kv) {
+  auto result = DocKey::EncodedFromRedisKey(kv.hash_code(), kv.key());
+  PrimitiveValue(ValueType::kSSForward).AppendToKey(&result);
+  return result;
+}
+
+// Returns stored count of the specified block, or none if it is not stored.
+Result<boost::optional<int64_t>> GetSortedSetBlockCount(
+    IntentAwareIterator* iterator, const KeyBytes& prefix, int64_t block) {
+  auto key = prefix;
+  PrimitiveValue(block).AppendToKey(&key);
+  SubDocument subdoc_count;
+  bool subdoc_count_found = false;
+  GetSubDocumentData data = { key, &subdoc_count, &subdoc_count_found };
+  RETURN_NOT_OK(GetSubDocument(iterator, data, /* projection */ nullptr,
+                               SeekFwdSuffices::kFalse));
+  if (!subdoc_count_found) {
+    return boost::none;
+  }
+  return subdoc_count.GetInt64();
+}
+
+// Counts members of each block by iterating the forward mapping of the set.
+CHECKED_STATUS CountSortedSetMembersPerBlock(
+    IntentAwareIterator* iterator, const RedisKeyValuePB& kv, std::map<int64_t, int64_t>* counts) {
+  auto forward_key = SortedSetForwardKey(kv);
+  SubDocument doc;
+  bool doc_found = false;
+  GetSubDocumentData data = { forward_key, &doc, &doc_found };
+  RETURN_NOT_OK(GetSubDocument(iterator, data, /* projection */ nullptr, SeekFwdSuffices::kFalse));
+  if (!doc_found || !IsObjectType(doc.value_type())) {
+    return Status::OK();
+  }
+  for (const auto& score_and_members : doc.object_container()) {
+    (*counts)[SortedSetBlock(score_and_members.first.GetDouble())] +=
+        score_and_members.second.object_num_keys();
+  }
+  return Status::OK();
+}
+
+// Fills block_counts with changes of the stored block counts, that apply the specified deltas.
+// Returns false when there is nothing to write.
+//
+// When block counts are disabled, counts of an existing set are deleted, so counts that missed
+// some changes are never used after enabling them again. When counts are enabled but missing for
+// an existing set, e.g. because it was modified while they were disabled, they are rebuilt from
+// the forward mapping.
+Result<bool> UpdateSortedSetBlockCounts(
+    IntentAwareIterator* iterator, const RedisKeyValuePB& kv, bool set_exists,
+    const std::map<int64_t, int64_t>& block_deltas, SubDocument* block_counts) {
+  if (!FLAGS_redis_sorted_set_block_counts) {
+    if (!set_exists) {
+      return false;
+    }
+    *block_counts = SubDocument(ValueType::kTombstone);
+    return true;
+  }
+
+  const auto prefix = SortedSetBlockCountsKey(kv);
+  boost::optional<int64_t> total = 0;
+  if (set_exists) {
+    total = VERIFY_RESULT(GetSortedSetBlockCount(iterator, prefix, kSortedSetTotalBlock));
+  }
+  std::map<int64_t, int64_t> counts;
+  if (!total) {
+    VLOG(1) << "Rebuilding block counts of sorted set " << kv.key();
+    RETURN_NOT_OK(CountSortedSetMembersPerBlock(iterator, kv, &counts));
+    total = 0;
+    for (const auto& block_and_count : counts) {
+      *total += block_and_count.second;
+    }
+    for (const auto& block_and_delta : block_deltas) {
+      counts[block_and_delta.first] += block_and_delta.second;
+    }
+  } else {
+    for (const auto& block_and_delta : block_deltas) {
+      if (block_and_delta.second == 0) {
+        continue;
+      }
+      boost::optional<int64_t> count;
+      if (set_exists) {
+        count = VERIFY_RESULT(GetSortedSetBlockCount(iterator, prefix, block_and_delta.first));
+      }
+      counts[block_and_delta.first] = count.get_value_or(0) + block_and_delta.second;
+    }
+    if (counts.empty()) {
+      return false;
+    }
+  }
+
+  for (const auto& block_and_count : counts) {
+    PrimitiveValue block(block_and_count.first);
+    if (block_and_count.second > 0) {
+      block_counts->SetChild(block, SubDocument(PrimitiveValue(block_and_count.second)));
+    } else {
+      block_counts->SetChild(block, SubDocument(ValueType::kTombstone));
+    }
+  }
+  for (const auto& block_and_delta : block_deltas) {
+    *total += block_and_delta.second;
+  }
+  block_counts->SetChild(PrimitiveValue(kSortedSetTotalBlock), SubDocument(PrimitiveValue(*total)));
+  return true;
+}
+
+struct SortedSetBlockCounts {
+  // Block counts could be used only when they are enabled and were maintained for all members of
+  // the set.
+  bool valid = false;
+  // Pairs of block and number of members in it, ordered by block.
+  std::vector<std::pair<int64_t, int64_t>> blocks;
+};
+
+Result<SortedSetBlockCounts> GetSortedSetBlockCounts(
+    IntentAwareIterator* iterator, const RedisKeyValuePB& kv, int64_t card,
+    DeadlineInfo* deadline_info) {
+  SortedSetBlockCounts result;
+  if (!FLAGS_redis_sorted_set_block_counts) {
+    return result;
+  }
+
+  auto key = SortedSetBlockCountsKey(kv);
+  SubDocument doc;
+  bool doc_found = false;
+  GetSubDocumentData data = { key, &doc, &doc_found };
+  data.deadline_info = deadline_info;
+  RETURN_NOT_OK(GetSubDocument(iterator, data, /* projection */ nullptr, SeekFwdSuffices::kFalse));
+
+  if (!doc_found || !IsObjectType(doc.value_type())) {
+    result.valid = card == 0;
+    return result;
+  }
+  bool total_matches = false;
+  int64_t total = 0;
+  result.blocks.reserve(doc.object_num_keys());
+  for (const auto& entry : doc.object_container()) {
+    const auto block = entry.first.GetInt64();
+    const auto count = entry.second.GetInt64();
+    if (block == kSortedSetTotalBlock) {
+      total_matches = count == card;
+      continue;
+    }
+    result.blocks.emplace_back(block, count);
+    total += count;
+  }
+  result.valid = total_matches && total == card;
+  return result;
+}
+
+// Returns number of sorted set members whose forward mapping keys satisfy both bounds.
+Result<int64_t> CountSortedSetMembers(
+    IntentAwareIterator* iterator, const KeyBytes& forward_key, const SliceKeyBound& low_subkey,
+    const SliceKeyBound& high_subkey, DeadlineInfo* deadline_info) {
+  SubDocument doc;
+  bool doc_found = false;
+  GetSubDocumentData data = { forward_key, &doc, &doc_found };
+  data.deadline_info = deadline_info;
+  data.low_subkey = &low_subkey;
+  data.high_subkey = &high_subkey;
+  RETURN_NOT_OK(GetSubDocument(iterator, data, /* projection */ nullptr, SeekFwdSuffices::kFalse));
+
+  if (!doc_found || !IsObjectType(doc.value_type())) {
+    return 0;
+  }
+  int64_t result = 0;
+  for (const auto& score_and_members : doc.object_container()) {
+    result += score_and_members.second.object_num_keys();
+  }
+  return result;
+}
+
+// The same as above, but members of blocks lying strictly between low_block and high_block are
+// not iterated, their counts are taken from block_counts instead.
+Result<int64_t> CountSortedSetMembers(
+    IntentAwareIterator* iterator, const KeyBytes& forward_key,
+    const SortedSetBlockCounts& block_counts,
+    const SliceKeyBound& low_subkey, int64_t low_block,
+    const SliceKeyBound& high_subkey, int64_t high_block,
+    DeadlineInfo* deadline_info) {
+  if (low_block > high_block) {
+    return 0;
+  }
+  if (!block_counts.valid || low_block == high_block) {
+    return CountSortedSetMembers(iterator, forward_key, low_subkey, high_subkey, deadline_info);
+  }
+
+  KeyBytes low_block_end = forward_key;
+  AppendSortedSetBlockStart(low_block + 1, &low_block_end);
+  int64_t result = VERIFY_RESULT(CountSortedSetMembers(
+      iterator, forward_key, low_subkey,
+      SliceKeyBound(low_block_end, BoundType::kExclusiveUpper), deadline_info));
+
+  for (const auto& block_and_count : block_counts.blocks) {
+    if (block_and_count.first > low_block && block_and_count.first < high_block) {
+      result += block_and_count.second;
+    }
+  }
+
+  KeyBytes high_block_start = forward_key;
+  AppendSortedSetBlockStart(high_block, &high_block_start);
+  result += VERIFY_RESULT(CountSortedSetMembers(
+      iterator, forward_key, SliceKeyBound(high_block_start, BoundType::kInclusiveLower),
+      high_subkey, deadline_info));
+  return result;
+}
+
 template <typename AddResponseValues>
 CHECKED_STATUS GetAndPopulateResponseValues(
     IntentAwareIterator* iterator,
@@ -613,6 +861,8 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
 
         int new_elements_added = 0;
         int return_value = 0;
+        // Changes of member counts per score block.
+        std::map<int64_t, int64_t> block_deltas;
         for (int i = 0; i < kv.subkey_size(); i++) {
           // Check whether the value is already in the document, if so delete it.
           SubDocKey key_reverse = SubDocKey(DocKey::FromRedisKey(kv.hash_code(), kv.key()),
@@ -679,6 +929,7 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
 
           if (should_remove_existing_entry) {
             double score_to_remove = subdoc_reverse.GetDouble();
+            --block_deltas[SortedSetBlock(score_to_remove)];
             SubDocument subdoc_forward_tombstone;
             subdoc_forward_tombstone.SetChild(PrimitiveValue(kv.value(i)),
                                               SubDocument(ValueType::kTombstone));
@@ -702,6 +953,10 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
             // Add the reverse mapping to the entries.
             kv_entries_reverse.SetChild(PrimitiveValue(kv.value(i)),
                                         SubDocument(PrimitiveValue::Double(score_to_add)));
+
+            if (!subdoc_reverse_found || should_remove_existing_entry) {
+              ++block_deltas[SortedSetBlock(score_to_add)];
+            }
           }
         }
 
@@ -722,6 +977,14 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
                               SubDocument(kv_entries_reverse));
         }
 
+        SubDocument kv_entries_blocks;
+        if (VERIFY_RESULT(UpdateSortedSetBlockCounts(
+                iterator_.get(), kv, data_type != REDIS_TYPE_NONE, block_deltas,
+                &kv_entries_blocks))) {
+          kv_entries.SetChild(PrimitiveValue(ValueType::kSSBlockCounts),
+                              std::move(kv_entries_blocks));
+        }
+
         if (kv_entries.object_num_keys() > 0) {
           RETURN_NOT_OK(kv_entries.ConvertToRedisSortedSet());
           if (data_type == REDIS_TYPE_NONE) {
@@ -942,6 +1205,8 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
       SubDocument values_card;
       SubDocument values_forward;
       SubDocument values_reverse;
+      SubDocument values_blocks;
+      std::map<int64_t, int64_t> block_deltas;
       num_keys = kv.subkey_size();
       for (int i = 0; i < kv.subkey_size(); i++) {
         // Check whether the value is already in the document.
@@ -970,6 +1235,7 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
                                SubDocument(ValueType::kTombstone));
           values_forward.SetChild(PrimitiveValue::Double(doc_reverse.GetDouble()),
                           SubDocument(doc_forward));
+          --block_deltas[SortedSetBlock(doc_reverse.GetDouble())];
         } else {
           // If the key is absent, it doesn't contribute to the count of keys being deleted.
           num_keys--;
@@ -982,6 +1248,10 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
       values.SetChild(PrimitiveValue(ValueType::kCounter), SubDocument(values_card));
       values.SetChild(PrimitiveValue(ValueType::kSSForward), SubDocument(values_forward));
       values.SetChild(PrimitiveValue(ValueType::kSSReverse), SubDocument(values_reverse));
+      if (num_keys != 0 && VERIFY_RESULT(UpdateSortedSetBlockCounts(
+              iterator_.get(), kv, data_type != REDIS_TYPE_NONE, block_deltas, &values_blocks))) {
+        values.SetChild(PrimitiveValue(ValueType::kSSBlockCounts), std::move(values_blocks));
+      }
 
       break;
     }
@@ -1267,11 +1537,10 @@ Status RedisReadOperation::Execute() {
   SimulateTimeoutIfTesting(&deadline_);
   SubDocKey doc_key(
       DocKey::FromRedisKey(request_.key_value().hash_code(), request_.key_value().key()));
-  auto iter = yb::docdb::CreateIntentAwareIterator(
+  iterator_ = yb::docdb::CreateIntentAwareIterator(
       doc_db_, BloomFilterMode::USE_BLOOM_FILTER,
       doc_key.Encode().AsSlice(),
       redis_query_id(), /* txn_op_context */ boost::none, deadline_, read_time_);
-  iterator_ = std::move(iter);
   deadline_info_.emplace(deadline_);
 
   switch (request_.request_case()) {
@@ -1297,6 +1566,24 @@ Status RedisReadOperation::Execute() {
   }
 }
 
+bool RedisReadOperation::IsPointRead(const RedisReadRequestPB& request) {
+  if (request.request_case() != RedisReadRequestPB::kGetRequest) {
+    return false;
+  }
+  switch (request.get_request().request_type()) {
+    case RedisGetRequestPB::GET: FALLTHROUGH_INTENDED;
+    case RedisGetRequestPB::TSGET: FALLTHROUGH_INTENDED;
+    case RedisGetRequestPB::HGET: FALLTHROUGH_INTENDED;
+    case RedisGetRequestPB::HEXISTS: FALLTHROUGH_INTENDED;
+    case RedisGetRequestPB::HSTRLEN: FALLTHROUGH_INTENDED;
+    case RedisGetRequestPB::SISMEMBER: FALLTHROUGH_INTENDED;
+    case RedisGetRequestPB::ZSCORE:
+      return true;
+    default:
+      return false;
+  }
+}
+
 int RedisReadOperation::ApplyIndex(int32_t index, const int32_t len) {
   if (index < 0) index += len;
   if (index < 0) index = 0;
@@ -1504,6 +1791,14 @@ Status RedisReadOperation::ExecuteCollectionGetRange() {
       const bool add_keys = request_.get_collection_range_request().with_scores();
       return ExecuteCollectionGetRangeByBounds(request_type, lower_bound, upper_bound, add_keys);
     }
+    case RedisCollectionGetRangeRequestPB::ZCOUNT: {
+      if(!request_.has_subkey_range() || !request_.subkey_range().has_lower_bound() ||
+          !request_.subkey_range().has_upper_bound()) {
+        return STATUS(InvalidArgument, "Need to specify the subkey range");
+      }
+      return ExecuteSortedSetCount(
+          request_.subkey_range().lower_bound(), request_.subkey_range().upper_bound());
+    }
     case RedisCollectionGetRangeRequestPB::ZRANGE: FALLTHROUGH_INTENDED;
     case RedisCollectionGetRangeRequestPB::ZREVRANGE: {
       if(!request_.has_index_range() || !request_.index_range().has_lower_bound() ||
@@ -1551,13 +1846,40 @@ Status RedisReadOperation::ExecuteCollectionGetRange() {
 
       bool add_keys = request_.get_collection_range_request().with_scores();
 
-      IndexBound low_bound = IndexBound(low_idx_normalized, true /* is_lower */);
-      IndexBound high_bound = IndexBound(high_idx_normalized, false /* is_lower */);
+      // Skip whole blocks that precede the requested range, so only members of the block
+      // containing low index are iterated before the range.
+      auto block_counts = VERIFY_RESULT(GetSortedSetBlockCounts(
+          iterator_.get(), request_.key_value(), card, deadline_info_.get_ptr()));
+      int64 skipped_members = 0;
+      KeyBytes low_sub_key_bound;
+      SliceKeyBound low_subkey;
+      if (block_counts.valid) {
+        for (const auto& block_and_count : block_counts.blocks) {
+          if (skipped_members + block_and_count.second > low_idx_normalized) {
+            if (skipped_members > 0) {
+              low_sub_key_bound = encoded_doc_key;
+              AppendSortedSetBlockStart(block_and_count.first, &low_sub_key_bound);
+              low_subkey = SliceKeyBound(low_sub_key_bound, BoundType::kInclusiveLower);
+            }
+            break;
+          }
+          skipped_members += block_and_count.second;
+        }
+        if (!low_subkey.is_valid()) {
+          skipped_members = 0;
+        }
+      }
+
+      IndexBound low_bound = IndexBound(
+          low_idx_normalized - skipped_members, true /* is_lower */);
+      IndexBound high_bound = IndexBound(
+          high_idx_normalized - skipped_members, false /* is_lower */);
 
       SubDocument doc;
       bool doc_found = false;
       GetSubDocumentData data = { encoded_doc_key, &doc, &doc_found};
       data.deadline_info = deadline_info_.get_ptr();
+      data.low_subkey = &low_subkey;
       data.low_index = &low_bound;
       data.high_index = &high_bound;
 
@@ -1573,6 +1895,99 @@ Status RedisReadOperation::ExecuteCollectionGetRange() {
   return Status::OK();
 }
 
+Status RedisReadOperation::ExecuteSortedSetRank(bool reverse) {
+  RedisDataType type = VERIFY_RESULT(GetValueType());
+  if (!VerifyTypeAndSetCode(REDIS_TYPE_SORTEDSET, type, &response_,
+                            VerifySuccessIfMissing::kTrue)) {
+    return Status::OK();
+  }
+
+  const auto& kv = request_.key_value();
+  const auto& member = kv.subkey(0).string_subkey();
+  auto encoded_key_reverse = DocKey::EncodedFromRedisKey(kv.hash_code(), kv.key());
+  PrimitiveValue(ValueType::kSSReverse).AppendToKey(&encoded_key_reverse);
+  PrimitiveValue(member).AppendToKey(&encoded_key_reverse);
+  SubDocument subdoc_reverse;
+  bool subdoc_reverse_found = false;
+  GetSubDocumentData get_data = { encoded_key_reverse, &subdoc_reverse, &subdoc_reverse_found };
+  RETURN_NOT_OK(GetSubDocument(iterator_.get(), get_data, /* projection */ nullptr,
+                               SeekFwdSuffices::kFalse));
+  if (!subdoc_reverse_found) {
+    response_.set_code(RedisResponsePB::NIL);
+    return Status::OK();
+  }
+  double score = subdoc_reverse.GetDouble();
+
+  int64_t card = VERIFY_RESULT(GetCardinality(iterator_.get(), kv));
+  auto block_counts = VERIFY_RESULT(GetSortedSetBlockCounts(
+      iterator_.get(), kv, card, deadline_info_.get_ptr()));
+
+  auto encoded_key_forward = DocKey::EncodedFromRedisKey(kv.hash_code(), kv.key());
+  PrimitiveValue(ValueType::kSSForward).AppendToKey(&encoded_key_forward);
+  // Rank is the number of members that precede (score, member) in the forward mapping.
+  KeyBytes member_key = encoded_key_forward;
+  PrimitiveValue::Double(score).AppendToKey(&member_key);
+  PrimitiveValue(member).AppendToKey(&member_key);
+  int64_t rank = VERIFY_RESULT(CountSortedSetMembers(
+      iterator_.get(), encoded_key_forward, block_counts,
+      SliceKeyBound::Invalid(), /* low_block */ 0,
+      SliceKeyBound(member_key, BoundType::kExclusiveUpper), SortedSetBlock(score),
+      deadline_info_.get_ptr()));
+
+  response_.set_code(RedisResponsePB::OK);
+  response_.set_int_response(reverse ? card - 1 - rank : rank);
+  return Status::OK();
+}
+
+Status RedisReadOperation::ExecuteSortedSetCount(
+    const RedisSubKeyBoundPB& lower_bound, const RedisSubKeyBoundPB& upper_bound) {
+  RedisDataType type = VERIFY_RESULT(GetValueType());
+  if (!VerifyTypeAndSetCode(REDIS_TYPE_SORTEDSET, type, &response_,
+                            VerifySuccessIfMissing::kTrue)) {
+    return Status::OK();
+  }
+  response_.set_code(RedisResponsePB::OK);
+  if (type == REDIS_TYPE_NONE ||
+      lower_bound.infinity_type() == RedisSubKeyBoundPB::POSITIVE ||
+      upper_bound.infinity_type() == RedisSubKeyBoundPB::NEGATIVE) {
+    response_.set_int_response(0);
+    return Status::OK();
+  }
+
+  const auto& kv = request_.key_value();
+  auto encoded_key_forward = DocKey::EncodedFromRedisKey(kv.hash_code(), kv.key());
+  PrimitiveValue(ValueType::kSSForward).AppendToKey(&encoded_key_forward);
+
+  KeyBytes low_sub_key_bound;
+  SliceKeyBound low_subkey;
+  int64_t low_block = 0;
+  if (!lower_bound.has_infinity_type()) {
+    double low_double = lower_bound.subkey_bound().double_subkey();
+    low_sub_key_bound = encoded_key_forward;
+    PrimitiveValue::Double(low_double).AppendToKey(&low_sub_key_bound);
+    low_subkey = SliceKeyBound(low_sub_key_bound, LowerBound(lower_bound.is_exclusive()));
+    low_block = SortedSetBlock(low_double);
+  }
+  KeyBytes high_sub_key_bound;
+  SliceKeyBound high_subkey;
+  int64_t high_block = kSortedSetMaxBlock;
+  if (!upper_bound.has_infinity_type()) {
+    double high_double = upper_bound.subkey_bound().double_subkey();
+    high_sub_key_bound = encoded_key_forward;
+    PrimitiveValue::Double(high_double).AppendToKey(&high_sub_key_bound);
+    high_subkey = SliceKeyBound(high_sub_key_bound, UpperBound(upper_bound.is_exclusive()));
+    high_block = SortedSetBlock(high_double);
+  }
+
+  int64_t card = VERIFY_RESULT(GetCardinality(iterator_.get(), kv));
+  auto block_counts = VERIFY_RESULT(GetSortedSetBlockCounts(
+      iterator_.get(), kv, card, deadline_info_.get_ptr()));
+  response_.set_int_response(VERIFY_RESULT(CountSortedSetMembers(
+      iterator_.get(), encoded_key_forward, block_counts, low_subkey, low_block, high_subkey,
+      high_block, deadline_info_.get_ptr())));
+  return Status::OK();
+}
+
 Result<RedisDataType> RedisReadOperation::GetValueType(int subkey_index) {
   return GetRedisValueType(iterator_.get(), request_.key_value(),
                            nullptr /* doc_write_batch */, subkey_index);
@@ -1823,6 +2238,10 @@ Status RedisReadOperation::ExecuteGet(const RedisGetRequestPB& get_request) {
       return ExecuteHGetAllLikeCommands(ValueType::kRedisTS, false, false);
     case RedisGetRequestPB::ZCARD:
       return ExecuteHGetAllLikeCommands(ValueType::kRedisSortedSet, false, false);
+    case RedisGetRequestPB::ZRANK:
+      return ExecuteSortedSetRank(/* reverse */ false);
+    case RedisGetRequestPB::ZREVRANK:
+      return ExecuteSortedSetRank(/* reverse */ true);
     case RedisGetRequestPB::LLEN:
       return ExecuteHGetAllLikeCommands(ValueType::kRedisList, false, false);
     case RedisGetRequestPB::UNKNOWN: {
@@ -1941,5 +2360,55 @@ const RedisResponsePB& RedisReadOperation::response() {
   return response_;
 }
 
+bool ShouldExecuteRedisPointReadsInBatch(
+    const google::protobuf::RepeatedPtrField<RedisReadRequestPB>& batch, int threshold) {
+  if (threshold <= 0 || batch.size() < threshold) {
+    return false;
+  }
+  for (const auto& request : batch) {
+    if (!RedisReadOperation::IsPointRead(request)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status ExecuteRedisPointReads(
+    const google::protobuf::RepeatedPtrField<RedisReadRequestPB>& requests,
+    const DocDB& doc_db,
+    CoarseTimePoint deadline,
+    const ReadHybridTime& read_time,
+    google::protobuf::RepeatedPtrField<RedisResponsePB>* responses,
+    Histogram* read_latency) {
+  // Order requests by their keys, so adjacent keys are read from the same cached blocks.
+  std::vector<std::pair<KeyBytes, int>> order;
+  order.reserve(requests.size());
+  for (int idx = 0; idx != requests.size(); ++idx) {
+    const auto& key_value = requests.Get(idx).key_value();
+    order.emplace_back(DocKey::EncodedFromRedisKey(key_value.hash_code(), key_value.key()), idx);
+  }
+  std::sort(order.begin(), order.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first.AsSlice().compare(rhs.first.AsSlice()) < 0;
+  });
+
+  responses->Clear();
+  responses->Reserve(requests.size());
+  for (int idx = 0; idx != requests.size(); ++idx) {
+    responses->Add();
+  }
+
+  for (const auto& entry : order) {
+    auto start_time = MonoTime::Now();
+    // Each read uses its own iterator, so the bloom filter of its key could skip SST files.
+    RedisReadOperation operation(requests.Get(entry.second), doc_db, deadline, read_time);
+    RETURN_NOT_OK(operation.Execute());
+    responses->Mutable(entry.second)->Swap(operation.mutable_response());
+    if (read_latency) {
+      read_latency->Increment(MonoTime::Now().GetDeltaSince(start_time).ToMicroseconds());
+    }
+  }
+  return Status::OK();
+}
+
 }  // namespace docdb
 }  // namespace yb
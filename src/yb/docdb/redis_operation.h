@@ -24,6 +24,9 @@
 #include "yb/rocksdb/cache.h"
 
 namespace yb {
+
+class Histogram;
+
 namespace docdb {
 
 // Redis value data with attached type of this value.
@@ -96,6 +99,14 @@ class RedisReadOperation {
 
   const RedisResponsePB &response();
 
+  RedisResponsePB* mutable_response() {
+    return &response_;
+  }
+
+  // Returns true if request reads only a single key, so it could be executed in a batch with
+  // other point reads.
+  static bool IsPointRead(const RedisReadRequestPB& request);
+
  private:
   Result<RedisDataType> GetValueType(int subkey_index = kNilSubkeyIndex);
 
@@ -128,6 +139,11 @@ class RedisReadOperation {
   CHECKED_STATUS ExecuteCollectionGetRangeByBounds(
       RedisCollectionGetRangeRequestPB::GetRangeRequestType request_type,
       const RedisSubKeyBoundPB& lower_bound, const RedisSubKeyBoundPB& upper_bound, bool add_keys);
+  // Used to implement ZRANK and ZREVRANK.
+  CHECKED_STATUS ExecuteSortedSetRank(bool reverse);
+  // Used to implement ZCOUNT.
+  CHECKED_STATUS ExecuteSortedSetCount(
+      const RedisSubKeyBoundPB& lower_bound, const RedisSubKeyBoundPB& upper_bound);
   CHECKED_STATUS ExecuteKeys();
 
   rocksdb::QueryId redis_query_id() { return reinterpret_cast<rocksdb::QueryId> (&request_); }
@@ -146,6 +162,21 @@ class RedisReadOperation {
   boost::optional<DeadlineInfo> deadline_info_;
 };
 
+// Returns true if batch contains at least threshold requests, all of them are point reads.
+bool ShouldExecuteRedisPointReadsInBatch(
+    const google::protobuf::RepeatedPtrField<RedisReadRequestPB>& batch, int threshold);
+
+// Executes point read requests of the same tablet in the order of their keys, so adjacent keys are
+// read from the same cached blocks. Responses are stored in the order of requests.
+// Latency of each read is recorded to read_latency, when it is specified.
+CHECKED_STATUS ExecuteRedisPointReads(
+    const google::protobuf::RepeatedPtrField<RedisReadRequestPB>& requests,
+    const DocDB& doc_db,
+    CoarseTimePoint deadline,
+    const ReadHybridTime& read_time,
+    google::protobuf::RepeatedPtrField<RedisResponsePB>* responses,
+    Histogram* read_latency = nullptr);
+
 }  // namespace docdb
 }  // namespace yb
 
@@ -70,6 +70,8 @@ namespace docdb {
     ((kSSReverse, '\'')) /* ASCII code 39 */ \
     ((kRedisSet, '(')) /* ASCII code 40 */ \
     ((kRedisList, ')')) /* ASCII code 41*/ \
+    /* Number of sorted set members per score block, used for rank queries. */ \
+    ((kSSBlockCounts, '*')) /* ASCII code 42 */ \
     /* This is the redis timeseries type. */ \
     ((kRedisTS, '+')) /* ASCII code 43 */ \
     ((kRedisSortedSet, ',')) /* ASCII code 44 */ \
@@ -66,6 +66,8 @@
 #include "yb/server/server_base.pb.h"
 #include "yb/server/hybrid_clock.h"
 
+#include "yb/util/env.h"
+#include "yb/util/os-util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/stopwatch.h"
@@ -82,10 +84,14 @@ DECLARE_int32(consensus_rpc_timeout_ms);
 DECLARE_int32(leader_lease_duration_ms);
 DECLARE_int32(ht_lease_duration_ms);
 DECLARE_int32(rpc_timeout);
+DECLARE_int32(raft_heartbeat_interval_ms);
 
 METRIC_DECLARE_entity(tablet);
 METRIC_DECLARE_counter(not_leader_rejections);
 METRIC_DECLARE_gauge_int64(raft_term);
+METRIC_DECLARE_entity(server);
+METRIC_DECLARE_histogram(handler_latency_yb_consensus_ConsensusService_UpdateConsensus);
+METRIC_DECLARE_histogram(handler_latency_yb_consensus_ConsensusService_MultiRaftUpdateConsensus);
 
 namespace yb {
 namespace tserver {
@@ -2894,5 +2900,161 @@ TEST_F(RaftConsensusITest, TestRemovePreVoterServerSucceeds) {
   TestRemoveTserverInTransitionSucceeds(RaftPeerPB::PRE_OBSERVER);
 }
 
+// Measures heartbeat RPCs received and CPU consumed by tablet servers of an idle cluster with many
+// tablets, with and without coalescing heartbeats of different tablets into a single RPC.
+TEST_F(RaftConsensusITest, MultiRaftHeartbeatsOnIdleCluster) {
+  constexpr int kNumTablets = 60;
+  const auto kMeasureTime = 10s;
+
+  ASSERT_NO_FATALS(CreateCluster(
+      "raft_consensus-itest-cluster",
+      {"--enable_multi_raft_heartbeat_batcher=true", "--multi_raft_heartbeat_window_ms=200"}, {}));
+  client_ = ASSERT_RESULT(CreateClient());
+  ASSERT_OK(client_->CreateNamespaceIfNotExists(kTableName.namespace_name()));
+  ASSERT_OK(table_.Create(kTableName, kNumTablets, client::YBSchema(schema_), client_.get()));
+  WaitForTSAndReplicas();
+
+  struct Stats {
+    int64_t rpcs = 0;
+    int64_t cpu_ns = 0;
+  };
+
+  auto collect_stats = [this]() -> Result<Stats> {
+    Stats result;
+    for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      auto* ts = cluster_->tablet_server(i);
+      for (const auto* metric : {
+          &METRIC_handler_latency_yb_consensus_ConsensusService_UpdateConsensus,
+          &METRIC_handler_latency_yb_consensus_ConsensusService_MultiRaftUpdateConsensus}) {
+        int64_t value = 0;
+        RETURN_NOT_OK(ts->GetInt64Metric(
+            &METRIC_ENTITY_server, "yb.tabletserver", metric, "total_count", &value));
+        result.rpcs += value;
+      }
+      std::string stat;
+      RETURN_NOT_OK(ReadFileToString(
+          Env::Default(), Format("/proc/$0/stat", ts->pid()), &stat));
+      ThreadStats thread_stats;
+      RETURN_NOT_OK(ParseStat(stat, nullptr, &thread_stats));
+      result.cpu_ns += thread_stats.user_ns + thread_stats.kernel_ns;
+    }
+    return result;
+  };
+
+  auto measure = [&collect_stats, kMeasureTime]() -> Result<Stats> {
+    // Let heartbeats sent in the previous mode complete.
+    SleepFor(1s);
+    auto start = VERIFY_RESULT(collect_stats());
+    SleepFor(kMeasureTime);
+    auto finish = VERIFY_RESULT(collect_stats());
+    return Stats{finish.rpcs - start.rpcs, finish.cpu_ns - start.cpu_ns};
+  };
+
+  auto batched = ASSERT_RESULT(measure());
+  ASSERT_OK(cluster_->SetFlagOnTServers("enable_multi_raft_heartbeat_batcher", "false"));
+  auto separate = ASSERT_RESULT(measure());
+
+  LOG(INFO) << "Batched heartbeats, RPCs: " << batched.rpcs << ", CPU: "
+            << batched.cpu_ns / 1000000 << "ms";
+  LOG(INFO) << "Separate heartbeats, RPCs: " << separate.rpcs << ", CPU: "
+            << separate.cpu_ns / 1000000 << "ms";
+
+  ASSERT_GT(batched.rpcs, 0);
+  ASSERT_LT(batched.rpcs * 3, separate.rpcs);
+}
+
+TEST_F(RaftConsensusITest, QuiescentRaftGroups) {
+  constexpr int kNumTablets = 20;
+  constexpr int kIdleHeartbeatPeriods = 4;
+  constexpr int kNumRows = 200;
+  const auto kMeasureTime = 10s;
+
+  ASSERT_NO_FATALS(CreateCluster(
+      "raft_consensus-itest-cluster",
+      {"--enable_multi_raft_heartbeat_batcher=true",
+       Format("--raft_quiescence_idle_heartbeat_periods=$0", kIdleHeartbeatPeriods)}, {}));
+  client_ = ASSERT_RESULT(CreateClient());
+  ASSERT_OK(client_->CreateNamespaceIfNotExists(kTableName.namespace_name()));
+  ASSERT_OK(table_.Create(kTableName, kNumTablets, client::YBSchema(schema_), client_.get()));
+  WaitForTSAndReplicas();
+
+  auto write_rows = [this](int first_row) {
+    auto session = client_->NewSession();
+    session->SetTimeout(60s);
+    for (int i = first_row; i != first_row + kNumRows; ++i) {
+      auto op = table_.NewWriteOp(QLWriteRequestPB::QL_STMT_INSERT);
+      auto* const req = op->mutable_request();
+      QLAddInt32HashValue(req, i);
+      table_.AddInt32ColumnValue(req, "int_val", i * 2);
+      table_.AddStringColumnValue(req, "string_val", Format("hello $0", i));
+      RETURN_NOT_OK(session->Apply(op));
+    }
+    return session->Flush();
+  };
+
+  // Sum of terms of all replicas, changes when any election happens.
+  auto sum_terms = [this]() -> Result<int64_t> {
+    int64_t result = 0;
+    for (const auto& entry : tablet_servers_) {
+      std::vector<TabletId> tablet_ids;
+      RETURN_NOT_OK(itest::ListRunningTabletIds(
+          entry.second.get(), MonoDelta::FromSeconds(10), &tablet_ids));
+      auto* ts = cluster_->tablet_server_by_uuid(entry.first);
+      for (const auto& tablet_id : tablet_ids) {
+        int64_t term = 0;
+        RETURN_NOT_OK(ts->GetInt64Metric(
+            &METRIC_ENTITY_tablet, tablet_id.c_str(), &METRIC_raft_term, "value", &term));
+        result += term;
+      }
+    }
+    return result;
+  };
+
+  // Pings of quiescent groups and batched heartbeats are both sent as MultiRaftUpdateConsensus,
+  // so all consensus RPCs are counted.
+  auto measure_rpcs = [this, kMeasureTime]() -> Result<int64_t> {
+    auto collect = [this]() -> Result<int64_t> {
+      int64_t result = 0;
+      for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+        for (const auto* metric : {
+            &METRIC_handler_latency_yb_consensus_ConsensusService_UpdateConsensus,
+            &METRIC_handler_latency_yb_consensus_ConsensusService_MultiRaftUpdateConsensus}) {
+          int64_t value = 0;
+          RETURN_NOT_OK(cluster_->tablet_server(i)->GetInt64Metric(
+              &METRIC_ENTITY_server, "yb.tabletserver", metric, "total_count", &value));
+          result += value;
+        }
+      }
+      return result;
+    };
+    auto start = VERIFY_RESULT(collect());
+    SleepFor(kMeasureTime);
+    return VERIFY_RESULT(collect()) - start;
+  };
+
+  ASSERT_OK(write_rows(0));
+
+  // Let all Raft groups become quiescent.
+  SleepFor(MonoDelta::FromMilliseconds(
+      (kIdleHeartbeatPeriods + 4) * FLAGS_raft_heartbeat_interval_ms));
+  auto terms_before = ASSERT_RESULT(sum_terms());
+  auto quiescent_rpcs = ASSERT_RESULT(measure_rpcs());
+
+  // Followers did not start elections while their leaders were quiescent, and writes wake the
+  // groups.
+  ASSERT_OK(write_rows(kNumRows));
+  ASSERT_EQ(terms_before, ASSERT_RESULT(sum_terms()));
+
+  ASSERT_OK(cluster_->SetFlagOnTServers("raft_quiescence_idle_heartbeat_periods", "0"));
+  ASSERT_OK(write_rows(kNumRows * 2));
+  SleepFor(1s);
+  auto active_rpcs = ASSERT_RESULT(measure_rpcs());
+
+  LOG(INFO) << "Consensus RPCs, quiescent: " << quiescent_rpcs << ", active: " << active_rpcs;
+
+  ASSERT_LT(quiescent_rpcs * 2, active_rpcs);
+  ASSERT_EQ(terms_before, ASSERT_RESULT(sum_terms()));
+}
+
     }  // namespace tserver
 }  // namespace yb
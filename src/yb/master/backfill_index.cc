@@ -0,0 +1,257 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+#include "yb/master/backfill_index.h"
+
+#include <algorithm>
+
+#include "yb/common/wire_protocol.h"
+
+#include "yb/master/master.h"
+#include "yb/master/ts_descriptor.h"
+#include "yb/master/catalog_manager.h"
+
+#include "yb/tserver/tserver_admin.proxy.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/format.h"
+#include "yb/util/logging.h"
+
+DEFINE_int32(index_backfill_max_concurrent_tablets, 8,
+             "Maximum number of tablets of a single indexed table, that are backfilled in "
+             "parallel.");
+TAG_FLAG(index_backfill_max_concurrent_tablets, advanced);
+TAG_FLAG(index_backfill_max_concurrent_tablets, runtime);
+
+namespace yb {
+namespace master {
+
+using std::string;
+using tserver::TabletServerErrorPB;
+
+////////////////////////////////////////////////////////////
+// BackfillTable
+////////////////////////////////////////////////////////////
+BackfillTable::BackfillTable(Master* master,
+                             ThreadPool* callback_pool,
+                             const scoped_refptr<TableInfo>& indexed_table,
+                             std::vector<IndexInfoPB> indexes,
+                             uint32_t schema_version,
+                             int64_t leader_term)
+    : master_(master),
+      callback_pool_(callback_pool),
+      indexed_table_(indexed_table),
+      indexes_(std::move(indexes)),
+      schema_version_(schema_version),
+      leader_term_(leader_term) {
+}
+
+string BackfillTable::ToString() const {
+  std::vector<TableId> index_ids;
+  for (const auto& index : indexes_) {
+    index_ids.push_back(index.table_id());
+  }
+  return Format("Backfill of indexes $0 of table $1", index_ids, indexed_table_->ToString());
+}
+
+void BackfillTable::Launch() {
+  TabletInfos tablets;
+  indexed_table_->GetAllTablets(&tablets);
+  const size_t num_tablets = tablets.size();
+  // A tablet, that was empty when it already had the indexes, has nothing to backfill. Rows written
+  // to it after that were added to the indexes by the writes themselves.
+  tablets.erase(std::remove_if(tablets.begin(), tablets.end(), [this](const auto& tablet) {
+    return tablet->WasEmptyAtSchemaVersion(schema_version_);
+  }), tablets.end());
+  LOG(INFO) << "Starting " << ToString() << ", schema version " << schema_version_ << ", "
+            << tablets.size() << " of " << num_tablets << " tablets are not empty";
+
+  if (tablets.empty()) {
+    Finish(Status::OK());
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    waiting_tablets_.assign(tablets.begin(), tablets.end());
+  }
+  LaunchWaitingTablets();
+}
+
+void BackfillTable::LaunchWaitingTablets() {
+  std::vector<scoped_refptr<TabletInfo>> tablets_to_launch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t max_running = std::max(FLAGS_index_backfill_max_concurrent_tablets, 1);
+    while (!finished_ && running_tablets_ < max_running && !waiting_tablets_.empty()) {
+      tablets_to_launch.push_back(std::move(waiting_tablets_.front()));
+      waiting_tablets_.pop_front();
+      ++running_tablets_;
+    }
+  }
+
+  for (const auto& tablet : tablets_to_launch) {
+    LaunchChunk(tablet, std::string());
+  }
+}
+
+void BackfillTable::LaunchChunk(const scoped_refptr<TabletInfo>& tablet, const string& start_key) {
+  auto call = std::make_shared<BackfillChunk>(shared_from_this(), tablet, start_key);
+  indexed_table_->AddTask(call);
+  WARN_NOT_OK(call->Run(), "Failed to send backfill index request");
+}
+
+void BackfillTable::ChunkDone(const scoped_refptr<TabletInfo>& tablet,
+                              const Status& status,
+                              const string& backfilled_until,
+                              uint64_t num_rows) {
+  num_rows_.fetch_add(num_rows, std::memory_order_acq_rel);
+
+  if (!status.ok()) {
+    LOG(WARNING) << ToString() << " failed on tablet " << tablet->ToString() << ": " << status;
+    Finish(status);
+    return;
+  }
+
+  if (!backfilled_until.empty()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (finished_) {
+        return;
+      }
+    }
+    LaunchChunk(tablet, backfilled_until);
+    return;
+  }
+
+  VLOG(1) << ToString() << " completed tablet " << tablet->ToString();
+  bool done;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --running_tablets_;
+    done = running_tablets_ == 0 && waiting_tablets_.empty();
+  }
+
+  if (done) {
+    Finish(Status::OK());
+  } else {
+    LaunchWaitingTablets();
+  }
+}
+
+void BackfillTable::Finish(const Status& status) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (finished_) {
+      return;
+    }
+    finished_ = true;
+  }
+
+  if (status.ok()) {
+    LOG(INFO) << ToString() << " completed, " << num_rows_.load(std::memory_order_acquire)
+              << " rows processed";
+  }
+  master_->catalog_manager()->HandleBackfillTableDone(shared_from_this(), status);
+}
+
+////////////////////////////////////////////////////////////
+// BackfillChunk
+////////////////////////////////////////////////////////////
+BackfillChunk::BackfillChunk(std::shared_ptr<BackfillTable> backfill_table,
+                             const scoped_refptr<TabletInfo>& tablet,
+                             std::string start_key)
+    : RetryingTSRpcTask(backfill_table->master(),
+                        backfill_table->callback_pool(),
+                        gscoped_ptr<TSPicker>(new PickLeaderReplica(tablet)),
+                        backfill_table->indexed_table()),
+      backfill_table_(std::move(backfill_table)),
+      tablet_(tablet),
+      start_key_(std::move(start_key)) {
+}
+
+string BackfillChunk::description() const {
+  return Format("$0 Backfill Index RPC from $1",
+                tablet_->ToString(), Slice(start_key_).ToDebugHexString());
+}
+
+TabletId BackfillChunk::tablet_id() const {
+  return tablet_->tablet_id();
+}
+
+TabletServerId BackfillChunk::permanent_uuid() const {
+  return target_ts_desc_ != nullptr ? target_ts_desc_->permanent_uuid() : "";
+}
+
+void BackfillChunk::HandleResponse(int attempt) {
+  server::UpdateClock(resp_, master_->clock());
+
+  if (resp_.has_error()) {
+    Status status = StatusFromPB(resp_.error().status());
+
+    // Do not retry on a fatal error.
+    switch (resp_.error().code()) {
+      case TabletServerErrorPB::TABLET_NOT_FOUND:
+        LOG(WARNING) << "TS " << permanent_uuid() << ": backfill failed for tablet "
+                     << tablet_->ToString() << " no further retry: " << status;
+        TransitionToTerminalState(MonitoredTaskState::kRunning, MonitoredTaskState::kFailed);
+        break;
+      default:
+        LOG(WARNING) << "TS " << permanent_uuid() << ": backfill failed for tablet "
+                     << tablet_->ToString() << ": " << status;
+        break;
+    }
+  } else {
+    TransitionToTerminalState(MonitoredTaskState::kRunning, MonitoredTaskState::kComplete);
+    VLOG(1) << "TS " << permanent_uuid() << ": backfilled " << resp_.num_rows()
+            << " rows of tablet " << tablet_->ToString();
+  }
+}
+
+bool BackfillChunk::SendRequest(int attempt) {
+  tserver::BackfillIndexRequestPB req;
+  req.set_dest_uuid(permanent_uuid());
+  req.set_tablet_id(tablet_->tablet_id());
+  for (const auto& index : backfill_table_->indexes()) {
+    *req.add_indexes() = index;
+  }
+  req.set_schema_version(backfill_table_->schema_version());
+  req.set_start_key(start_key_);
+  req.set_propagated_hybrid_time(master_->clock()->Now().ToUint64());
+
+  ts_admin_proxy_->BackfillIndexAsync(req, &resp_, &rpc_, BindRpcCallback());
+  VLOG(1) << "Send backfill index request to " << permanent_uuid()
+          << " (attempt " << attempt << "):\n"
+          << req.DebugString();
+  return true;
+}
+
+void BackfillChunk::UnregisterAsyncTaskCallback() {
+  if (reported_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+
+  Status status;
+  if (state() != MonitoredTaskState::kComplete) {
+    if (resp_.has_error()) {
+      status = StatusFromPB(resp_.error().status());
+    } else if (!rpc_.status().ok()) {
+      status = rpc_.status();
+    } else {
+      status = STATUS_FORMAT(Aborted, "Backfill chunk task finished in state $0", state());
+    }
+  }
+  backfill_table_->ChunkDone(tablet_, status, resp_.backfilled_until(), resp_.num_rows());
+}
+
+} // namespace master
+} // namespace yb
@@ -0,0 +1,126 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+#ifndef YB_MASTER_BACKFILL_INDEX_H
+#define YB_MASTER_BACKFILL_INDEX_H
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "yb/common/common.pb.h"
+
+#include "yb/master/async_rpc_tasks.h"
+#include "yb/master/catalog_entity_info.h"
+
+namespace yb {
+namespace master {
+
+// Backfills secondary indexes of a single indexed table with rows that existed before the indexes
+// were created. Each tablet of the indexed table is processed by a chain of BackfillChunk tasks,
+// up to index_backfill_max_concurrent_tablets tablets in parallel. When all tablets are done, the
+// indexes are marked readable.
+//
+// Tablets reported empty at the backfill schema version are skipped.
+//
+// Progress is kept in memory only. If any tablet fails, or master leadership changes, the whole
+// backfill is started again. It is safe, because index entries are written idempotently. Failed
+// backfills are retried with backoff, up to index_backfill_max_attempts times.
+class BackfillTable : public std::enable_shared_from_this<BackfillTable> {
+ public:
+  BackfillTable(Master* master,
+                ThreadPool* callback_pool,
+                const scoped_refptr<TableInfo>& indexed_table,
+                std::vector<IndexInfoPB> indexes,
+                uint32_t schema_version,
+                int64_t leader_term);
+
+  // Starts processing of tablets.
+  void Launch();
+
+  // Called when the chunk task for the tablet finishes. backfilled_until is the key of the row to
+  // continue from, empty when the whole tablet was processed.
+  void ChunkDone(const scoped_refptr<TabletInfo>& tablet,
+                 const Status& status,
+                 const std::string& backfilled_until,
+                 uint64_t num_rows);
+
+  Master* master() const { return master_; }
+  ThreadPool* callback_pool() const { return callback_pool_; }
+  const scoped_refptr<TableInfo>& indexed_table() const { return indexed_table_; }
+  const std::vector<IndexInfoPB>& indexes() const { return indexes_; }
+  uint32_t schema_version() const { return schema_version_; }
+  int64_t leader_term() const { return leader_term_; }
+
+  std::string ToString() const;
+
+ private:
+  void LaunchChunk(const scoped_refptr<TabletInfo>& tablet, const std::string& start_key);
+
+  // Launches chunks for waiting tablets while there are free slots.
+  void LaunchWaitingTablets();
+
+  void Finish(const Status& status);
+
+  Master* const master_;
+  ThreadPool* const callback_pool_;
+  const scoped_refptr<TableInfo> indexed_table_;
+  const std::vector<IndexInfoPB> indexes_;
+  const uint32_t schema_version_;
+  const int64_t leader_term_;
+
+  std::mutex mutex_;
+  std::deque<scoped_refptr<TabletInfo>> waiting_tablets_;
+  size_t running_tablets_ = 0;
+  bool finished_ = false;
+
+  std::atomic<uint64_t> num_rows_{0};
+};
+
+// Sends a single BackfillIndex RPC to the leader of the tablet, that processes a chunk of rows
+// starting from start_key.
+class BackfillChunk : public RetryingTSRpcTask {
+ public:
+  BackfillChunk(std::shared_ptr<BackfillTable> backfill_table,
+                const scoped_refptr<TabletInfo>& tablet,
+                std::string start_key);
+
+  Type type() const override { return ASYNC_BACKFILL_TABLET_CHUNK; }
+
+  std::string type_name() const override { return "Backfill Index Chunk"; }
+
+  std::string description() const override;
+
+ private:
+  TabletId tablet_id() const override;
+
+  TabletServerId permanent_uuid() const;
+
+  void HandleResponse(int attempt) override;
+  bool SendRequest(int attempt) override;
+  void UnregisterAsyncTaskCallback() override;
+
+  const std::shared_ptr<BackfillTable> backfill_table_;
+  const scoped_refptr<TabletInfo> tablet_;
+  const std::string start_key_;
+  tserver::BackfillIndexResponsePB resp_;
+
+  // Unregister could happen more than once, e.g. when a completed task is aborted.
+  std::atomic<bool> reported_{false};
+};
+
+} // namespace master
+} // namespace yb
+
+#endif // YB_MASTER_BACKFILL_INDEX_H
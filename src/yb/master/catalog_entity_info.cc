@@ -182,6 +182,18 @@ uint32_t TabletInfo::reported_schema_version() const {
   return reported_schema_version_;
 }
 
+void TabletInfo::set_empty_at_schema_version(uint32_t version) {
+  std::lock_guard<simple_spinlock> l(lock_);
+  if (!empty_at_schema_version_ || version > *empty_at_schema_version_) {
+    empty_at_schema_version_ = version;
+  }
+}
+
+bool TabletInfo::WasEmptyAtSchemaVersion(uint32_t version) const {
+  std::lock_guard<simple_spinlock> l(lock_);
+  return empty_at_schema_version_ && *empty_at_schema_version_ >= version;
+}
+
 std::string TabletInfo::ToString() const {
   return Substitute("$0 (table $1)", tablet_id_,
                     (table_ != nullptr ? table_->ToString() : "MISSING"));
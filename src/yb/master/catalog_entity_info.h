@@ -37,6 +37,8 @@
 
 #include <mutex>
 
+#include <boost/optional.hpp>
+
 #include "yb/master/ts_descriptor.h"
 #include "yb/master/master.pb.h"
 #include "yb/master/tasks_tracker.h"
@@ -205,6 +207,11 @@ class TabletInfo : public RefCountedThreadSafe<TabletInfo>,
   bool set_reported_schema_version(uint32_t version);
   uint32_t reported_schema_version() const;
 
+  // Accessors for the schema version, at which the tablet leader reported that the tablet is empty.
+  void set_empty_at_schema_version(uint32_t version);
+  // Whether the tablet was reported empty at the given or a later schema version.
+  bool WasEmptyAtSchemaVersion(uint32_t version) const;
+
   // No synchronization needed.
   std::string ToString() const override;
 
@@ -246,6 +253,9 @@ class TabletInfo : public RefCountedThreadSafe<TabletInfo>,
   // Reported schema version (in-memory only).
   uint32_t reported_schema_version_ = 0;
 
+  // Latest schema version, at which the tablet was reported empty (in-memory only).
+  boost::optional<uint32_t> empty_at_schema_version_;
+
   LeaderStepDownFailureTimes leader_stepdown_failure_times_;
 
   DISALLOW_COPY_AND_ASSIGN(TabletInfo);
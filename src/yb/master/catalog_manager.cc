@@ -94,9 +94,11 @@
 #include "yb/master/master_util.h"
 #include "yb/master/system_tablet.h"
 #include "yb/master/sys_catalog.h"
+#include "yb/master/tablet_split_manager.h"
 #include "yb/master/ts_descriptor.h"
 #include "yb/master/ts_manager.h"
 #include "yb/master/async_rpc_tasks.h"
+#include "yb/master/backfill_index.h"
 #include "yb/master/yql_auth_roles_vtable.h"
 #include "yb/master/yql_auth_role_permissions_vtable.h"
 #include "yb/master/yql_auth_resource_role_permissions_index.h"
@@ -212,6 +214,11 @@ METRIC_DEFINE_gauge_uint32(cluster, num_tablet_servers_dead,
                            "heartbeat in the time interval defined by the gflag "
                            "FLAGS_tserver_unresponsive_timeout_ms.");
 
+METRIC_DEFINE_gauge_uint32(cluster, num_tablet_split_candidates,
+                           "Number of tablet split candidates", yb::MetricUnit::kUnits,
+                           "The number of tablets, whose leaders reported load above the "
+                           "thresholds defined by the gflags FLAGS_tablet_split_*_threshold*.");
+
 DEFINE_test_flag(uint64, inject_latency_during_remote_bootstrap_secs, 0,
                  "Number of seconds to sleep during a remote bootstrap.");
 
@@ -256,6 +263,29 @@ DEFINE_test_flag(int32, simulate_slow_system_tablet_bootstrap_secs, 0,
 DEFINE_test_flag(bool, return_error_if_namespace_not_found, false,
     "Return an error from ListTables if a namespace id is not found in the map");
 
+DEFINE_bool(enable_index_backfill, false,
+            "Whether non-unique secondary indexes created on YCQL tables with existing rows are "
+            "backfilled by tablet servers. Such an index is not used for reads until the "
+            "backfill completes.");
+TAG_FLAG(enable_index_backfill, evolving);
+
+DEFINE_int32(index_backfill_max_attempts, 5,
+             "Maximum number of attempts to backfill indexes of a table. When all of them fail, "
+             "the indexes are marked as failed to backfill and are never used for reads.");
+TAG_FLAG(index_backfill_max_attempts, advanced);
+TAG_FLAG(index_backfill_max_attempts, runtime);
+
+DEFINE_int32(index_backfill_retry_delay_ms, 1000,
+             "Delay before index backfill is started again after the first failed attempt. "
+             "Doubled after each failed attempt, up to index_backfill_max_retry_delay_ms.");
+TAG_FLAG(index_backfill_retry_delay_ms, advanced);
+TAG_FLAG(index_backfill_retry_delay_ms, runtime);
+
+DEFINE_int32(index_backfill_max_retry_delay_ms, 60000,
+             "Maximum delay before failed index backfill is started again.");
+TAG_FLAG(index_backfill_max_retry_delay_ms, advanced);
+TAG_FLAG(index_backfill_max_retry_delay_ms, runtime);
+
 namespace yb {
 namespace master {
 
@@ -483,6 +513,9 @@ Status CatalogManager::Init(bool is_first_run) {
   metric_num_tablet_servers_dead_ =
     METRIC_num_tablet_servers_dead.Instantiate(master_->metric_entity_cluster(), 0);
 
+  metric_num_tablet_split_candidates_ =
+    METRIC_num_tablet_split_candidates.Instantiate(master_->metric_entity_cluster(), 0);
+
   RETURN_NOT_OK_PREPEND(InitSysCatalogAsync(is_first_run),
                         "Failed to initialize sys tables async");
 
@@ -1405,6 +1438,53 @@ Status CatalogManager::AddIndexInfoToTable(const scoped_refptr<TableInfo>& index
   return Status::OK();
 }
 
+Status CatalogManager::SetBackfilledIndexPermissions(
+    const scoped_refptr<TableInfo>& indexed_table,
+    const std::vector<IndexInfoPB>& indexes,
+    IndexPermissions permissions,
+    int64_t leader_term) {
+  TRACE("Locking indexed table");
+  auto l = indexed_table->LockForWrite();
+  if (l->data().started_deleting()) {
+    return STATUS_FORMAT(NotFound, "Table $0 is being deleted", indexed_table->ToString());
+  }
+
+  bool updated = false;
+  for (auto& index : *l->mutable_data()->pb.mutable_indexes()) {
+    if (index.index_permissions() != INDEX_PERM_WRITE_AND_DELETE) {
+      continue;
+    }
+    for (const auto& backfilled_index : indexes) {
+      if (index.table_id() == backfilled_index.table_id()) {
+        index.set_index_permissions(permissions);
+        updated = true;
+        break;
+      }
+    }
+  }
+  if (!updated) {
+    // Indexes were dropped during backfill.
+    return Status::OK();
+  }
+
+  // Increment schema version, so clients refresh cached table metadata.
+  l->mutable_data()->pb.set_version(l->mutable_data()->pb.version() + 1);
+  l->mutable_data()->set_state(SysTablesEntryPB::ALTERING,
+                               Substitute("Alter table version=$0 ts=$1",
+                                          l->mutable_data()->pb.version(),
+                                          LocalTimeAsString()));
+
+  TRACE("Updating indexed table metadata on disk");
+  RETURN_NOT_OK(sys_catalog_->UpdateItem(indexed_table.get(), leader_term));
+
+  TRACE("Committing in-memory state");
+  l->Commit();
+
+  SendAlterTableRequest(indexed_table);
+
+  return Status::OK();
+}
+
 Status CatalogManager::CreateCopartitionedTable(const CreateTableRequestPB req,
                                                 CreateTableResponsePB* resp,
                                                 rpc::RpcContext* rpc,
@@ -1984,6 +2064,12 @@ Status CatalogManager::CreateTable(const CreateTableRequestPB* orig_req,
 
   // For index table, insert index info in the indexed table.
   if ((req.has_index_info() || req.has_indexed_table_id()) && !is_pg_table) {
+    if (FLAGS_enable_index_backfill && !index_info.is_unique()) {
+      // Keep the index write-only until the existing rows are backfilled, see
+      // StartPendingIndexBackfills. Tablets reported empty after they got the index are not
+      // scanned, so an index of an empty table becomes readable without backfill.
+      index_info.set_index_permissions(INDEX_PERM_WRITE_AND_DELETE);
+    }
     s = AddIndexInfoToTable(indexed_table, index_info);
     if (PREDICT_FALSE(!s.ok())) {
       return AbortTableCreation(table.get(), tablets,
@@ -2924,6 +3010,132 @@ void CatalogManager::CleanUpDeletedTables() {
   // TODO: Check if we want to delete the totally deleted table from the sys_catalog here.
 }
 
+void CatalogManager::StartPendingIndexBackfills() {
+  const int64_t term = leader_ready_term();
+  std::vector<std::shared_ptr<BackfillTable>> new_jobs;
+  {
+    SharedLock<LockType> l(lock_);
+    std::lock_guard<std::mutex> backfill_lock(backfill_mutex_);
+    backfill_pending_tables_.clear();
+    for (const auto& entry : table_ids_map_) {
+      const scoped_refptr<TableInfo>& table = entry.second;
+      auto table_lock = table->LockForRead();
+      const auto& pb = table_lock->data().pb;
+      std::vector<IndexInfoPB> indexes;
+      for (const auto& index : pb.indexes()) {
+        if (index.index_permissions() == INDEX_PERM_WRITE_AND_DELETE) {
+          indexes.push_back(index);
+        }
+      }
+      if (indexes.empty()) {
+        continue;
+      }
+      // Tablets start reporting whether they are empty while the new schema is still being
+      // propagated, so the reports could be ready by the time backfill starts.
+      backfill_pending_tables_.insert(table->id());
+
+      // Wait until all tablets have the new indexes in their schema, so every write to the table
+      // after that is also applied to the indexes.
+      if (pb.state() != SysTablesEntryPB::RUNNING) {
+        continue;
+      }
+
+      auto it = backfill_jobs_.find(table->id());
+      if (it != backfill_jobs_.end() && it->second->leader_term() == term) {
+        continue;
+      }
+      auto retry_it = backfill_retries_.find(table->id());
+      if (retry_it != backfill_retries_.end()) {
+        if (retry_it->second.leader_term != term) {
+          backfill_retries_.erase(retry_it);
+        } else if (CoarseMonoClock::now() < retry_it->second.next_attempt_time) {
+          continue;
+        }
+      }
+      auto job = std::make_shared<BackfillTable>(
+          master_, worker_pool_.get(), table, std::move(indexes), pb.version(), term);
+      backfill_jobs_[table->id()] = job;
+      new_jobs.push_back(std::move(job));
+    }
+  }
+
+  for (const auto& job : new_jobs) {
+    job->Launch();
+  }
+}
+
+std::vector<TableId> CatalogManager::GetBackfillPendingTables() {
+  if (!FLAGS_enable_index_backfill) {
+    return std::vector<TableId>();
+  }
+  std::lock_guard<std::mutex> lock(backfill_mutex_);
+  return std::vector<TableId>(backfill_pending_tables_.begin(), backfill_pending_tables_.end());
+}
+
+void CatalogManager::HandleBackfillTableDone(const std::shared_ptr<BackfillTable>& backfill,
+                                             const Status& status) {
+  const auto& table_id = backfill->indexed_table()->id();
+  // Permissions to set for the backfilled indexes, none when backfill should be started again.
+  boost::optional<IndexPermissions> permissions;
+  {
+    std::lock_guard<std::mutex> lock(backfill_mutex_);
+    auto it = backfill_jobs_.find(table_id);
+    if (it != backfill_jobs_.end() && it->second == backfill) {
+      backfill_jobs_.erase(it);
+    }
+
+    if (status.ok()) {
+      backfill_retries_.erase(table_id);
+      permissions = INDEX_PERM_READ_WRITE_AND_DELETE;
+    } else {
+      auto& retry = backfill_retries_[table_id];
+      if (retry.leader_term != backfill->leader_term()) {
+        retry = BackfillRetryState{backfill->leader_term(), 0, CoarseTimePoint()};
+      }
+      ++retry.failed_attempts;
+      if (retry.failed_attempts >= FLAGS_index_backfill_max_attempts) {
+        LOG(ERROR) << backfill->ToString() << " failed " << retry.failed_attempts
+                   << " times, giving up: " << status;
+        backfill_retries_.erase(table_id);
+        permissions = INDEX_PERM_BACKFILL_FAILED;
+      } else {
+        // Exponential backoff, so a persistent failure does not restart backfill on every run of
+        // the background tasks.
+        const int shift = std::min(retry.failed_attempts - 1, 20);
+        const auto delay = std::chrono::milliseconds(std::min<int64_t>(
+            static_cast<int64_t>(FLAGS_index_backfill_retry_delay_ms) << shift,
+            FLAGS_index_backfill_max_retry_delay_ms));
+        retry.next_attempt_time = CoarseMonoClock::now() + delay;
+        LOG(WARNING) << backfill->ToString() << " failed, attempt " << retry.failed_attempts
+                     << " of " << FLAGS_index_backfill_max_attempts << ", retry in "
+                     << delay.count() << "ms: " << status;
+      }
+    }
+  }
+
+  if (permissions) {
+    const Status s = SetBackfilledIndexPermissions(
+        backfill->indexed_table(), backfill->indexes(), *permissions, backfill->leader_term());
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to set permissions " << IndexPermissions_Name(*permissions)
+                   << " for indexes after " << backfill->ToString() << ": " << s;
+    }
+  }
+}
+
+void CatalogManager::ProcessTabletLeaderMetrics(const TServerMetricsPB& metrics) {
+  SharedLock<LockType> l(lock_);
+  for (const auto& tablet_metrics : metrics.tablet_leader_metrics()) {
+    if (!tablet_metrics.has_empty_at_schema_version()) {
+      continue;
+    }
+    auto tablet = FindPtrOrNull(tablet_map_, tablet_metrics.tablet_id());
+    if (tablet) {
+      tablet->set_empty_at_schema_version(tablet_metrics.empty_at_schema_version());
+    }
+  }
+}
+
 Status CatalogManager::IsDeleteTableDone(const IsDeleteTableDoneRequestPB* req,
                                          IsDeleteTableDoneResponsePB* resp) {
   RETURN_NOT_OK(CheckOnline());
@@ -5933,6 +6145,13 @@ void CatalogManager::ReportMetrics() {
 
   master_->ts_manager()->GetAllDescriptors(&ts_descs);
   metric_num_tablet_servers_dead_->set_value(ts_descs.size() - num_live_servers);
+
+  // Also expires candidates, whose leaders stopped reporting them.
+  auto split_candidates = master_->tablet_split_manager()->GetSplitCandidates();
+  metric_num_tablet_split_candidates_->set_value(split_candidates.size());
+  if (!split_candidates.empty()) {
+    VLOG(1) << "Most loaded tablet split candidate: " << split_candidates.front().ToString();
+  }
 }
 
 std::string CatalogManager::LogPrefix() const {
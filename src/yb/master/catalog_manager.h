@@ -88,6 +88,7 @@ struct TableInfo;
 
 namespace master {
 
+class BackfillTable;
 class CatalogManagerBgTasks;
 class ClusterLoadBalancer;
 class Master;
@@ -280,6 +281,9 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
                                      TabletReportUpdatesPB *report_update,
                                      rpc::RpcContext* rpc);
 
+  // Handle metrics of tablets led by a tablet server, reported in its heartbeat.
+  void ProcessTabletLeaderMetrics(const TServerMetricsPB& metrics);
+
   // Create a new Namespace with the specified attributes.
   //
   // The RPC context is provided for logging/tracing purposes,
@@ -426,6 +430,10 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // and that we either deleted the tablet successfully, or we received a fatal error.
   void NotifyTabletDeleteFinished(const TabletServerId& tserver_uuid, const TableId& table_id);
 
+  // Let the catalog manager know that the index backfill job has finished. On success the
+  // backfilled indexes are marked readable.
+  void HandleBackfillTableDone(const std::shared_ptr<BackfillTable>& backfill, const Status& status);
+
   // Used by ConsensusService to retrieve the TabletPeer for a system
   // table specified by 'tablet_id'.
   //
@@ -721,6 +729,13 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   CHECKED_STATUS AddIndexInfoToTable(const scoped_refptr<TableInfo>& indexed_table,
                                      const IndexInfoPB& index_info);
 
+  // Set permissions of the indexes of the indexed table, that are being backfilled in
+  // leader_term. E.g. allow reads from them when backfill completes.
+  CHECKED_STATUS SetBackfilledIndexPermissions(const scoped_refptr<TableInfo>& indexed_table,
+                                               const std::vector<IndexInfoPB>& indexes,
+                                               IndexPermissions permissions,
+                                               int64_t leader_term);
+
   // Delete index info from the indexed table.
   CHECKED_STATUS DeleteIndexInfoFromTable(const TableId& indexed_table_id,
                                           const TableId& index_table_id,
@@ -951,6 +966,15 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // This function should only be called from the bg_tasks thread, in a single threaded fashion!
   void CleanUpDeletedTables();
 
+  // Start backfill of indexes, that are not readable yet, for tables that have no backfill job
+  // running in the current leader term.
+  // This function should only be called from the bg_tasks thread.
+  void StartPendingIndexBackfills();
+
+  // Returns ids of tables with indexes waiting for backfill, as of the last run of
+  // StartPendingIndexBackfills. Empty when index backfill is disabled.
+  std::vector<TableId> GetBackfillPendingTables();
+
   // Called when a new table id is added to table_ids_map_.
   void HandleNewTableId(const TableId& id);
 
@@ -1012,6 +1036,23 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Mutex to avoid concurrent remote bootstrap sessions.
   std::mutex remote_bootstrap_mtx_;
 
+  // Index backfill jobs by indexed table id.
+  std::mutex backfill_mutex_;
+  std::unordered_map<TableId, std::shared_ptr<BackfillTable>> backfill_jobs_;
+
+  // Failed index backfill attempts of the indexed table, in the leader term.
+  struct BackfillRetryState {
+    int64_t leader_term;
+    int failed_attempts;
+    CoarseTimePoint next_attempt_time;
+  };
+
+  // Indexed table id to its failed backfill attempts, protected by backfill_mutex_.
+  std::unordered_map<TableId, BackfillRetryState> backfill_retries_;
+
+  // Tables with indexes waiting for backfill, protected by backfill_mutex_.
+  std::unordered_set<TableId> backfill_pending_tables_;
+
   // Set to true if this master has received at least the superblock from a remote master.
   bool tablet_exists_;
 
@@ -1075,6 +1116,9 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Number of dead tservers metric.
   scoped_refptr<AtomicGauge<uint32_t>> metric_num_tablet_servers_dead_;
 
+  // Number of tablet split candidates metric.
+  scoped_refptr<AtomicGauge<uint32_t>> metric_num_tablet_split_candidates_;
+
   friend class ClusterLoadBalancer;
 
   // Policy for load balancing tablets on tablet servers.
@@ -144,6 +144,9 @@ void CatalogManagerBgTasks::Run() {
       if (!to_delete.empty()) {
         catalog_manager_->CleanUpDeletedTables();
       }
+
+      // Backfill indexes, that are not readable yet.
+      catalog_manager_->StartPendingIndexBackfills();
     }
     // Wait for a notification or a timeout expiration.
     //  - CreateTable will call Wake() to notify about the tablets to add
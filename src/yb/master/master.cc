@@ -48,6 +48,7 @@
 #include "yb/master/master_util.h"
 #include "yb/master/master.pb.h"
 #include "yb/master/master.service.h"
+#include "yb/master/tablet_split_manager.h"
 #include "yb/master/master_service.h"
 #include "yb/master/master_tablet_service.h"
 #include "yb/master/master-path-handlers.h"
@@ -130,6 +131,7 @@ Master::Master(const MasterOptions& opts)
     catalog_manager_(new enterprise::CatalogManager(this)),
     path_handlers_(new MasterPathHandlers(this)),
     flush_manager_(new FlushManager(this, catalog_manager())),
+    tablet_split_manager_(new TabletSplitManager()),
     opts_(opts),
     registration_initialized_(false),
     maintenance_manager_(new MaintenanceManager(MaintenanceManager::DEFAULT_OPTIONS)),
@@ -43,6 +43,7 @@
 #include "yb/master/flush_manager.h"
 #include "yb/master/master_service_base-internal.h"
 #include "yb/master/master.h"
+#include "yb/master/tablet_split_manager.h"
 #include "yb/master/ts_descriptor.h"
 #include "yb/master/ts_manager.h"
 #include "yb/server/webserver.h"
@@ -176,6 +177,11 @@ void MasterServiceImpl::TSHeartbeat(const TSHeartbeatRequestPB* req,
   // Set the TServer metrics in TS Descriptor.
   if (req->has_metrics()) {
     ts_desc->UpdateMetrics(req->metrics());
+    if (TabletSplitManager::IsEnabled()) {
+      server_->tablet_split_manager()->ProcessTabletMetrics(
+          ts_desc->permanent_uuid(), req->metrics());
+    }
+    server_->catalog_manager()->ProcessTabletLeaderMetrics(req->metrics());
   }
 
   if (req->has_tablet_report()) {
@@ -202,6 +208,12 @@ void MasterServiceImpl::TSHeartbeat(const TSHeartbeatRequestPB* req,
   uint64_t version = server_->catalog_manager()->GetYsqlCatalogVersion();
   resp->set_ysql_catalog_version(version);
 
+  resp->set_tablet_split_enabled(TabletSplitManager::IsEnabled());
+
+  for (const auto& table_id : server_->catalog_manager()->GetBackfillPendingTables()) {
+    resp->add_backfill_pending_table_ids(table_id);
+  }
+
   rpc.RespondSuccess();
 }
 
@@ -54,6 +54,8 @@ class MasterTabletServer : public tserver::TabletServerIf,
 
   uint64_t ysql_catalog_version() const override;
 
+  tserver::PgTableCache* pg_table_cache() override { return nullptr; }
+
  private:
   Master* master_ = nullptr;
   scoped_refptr<MetricEntity> metric_entity_;
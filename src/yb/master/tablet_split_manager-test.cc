@@ -0,0 +1,107 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/master/tablet_split_manager.h"
+
+#include "yb/util/test_util.h"
+
+DECLARE_uint64(tablet_split_size_threshold_bytes);
+DECLARE_double(tablet_split_ops_per_sec_threshold);
+DECLARE_int32(tablet_split_candidate_expiration_ms);
+
+using namespace std::literals;
+
+namespace yb {
+namespace master {
+
+class TabletSplitManagerTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    FLAGS_tablet_split_size_threshold_bytes = 1000;
+    FLAGS_tablet_split_ops_per_sec_threshold = 100;
+    FLAGS_tablet_split_candidate_expiration_ms = 10000;
+  }
+
+  void AddTablet(
+      TServerMetricsPB* metrics, const TabletId& tablet_id, uint64_t size, double ops_per_sec,
+      bool has_split_key = true) {
+    auto* tablet_metrics = metrics->add_tablet_leader_metrics();
+    tablet_metrics->set_tablet_id(tablet_id);
+    tablet_metrics->set_sst_files_size(size);
+    tablet_metrics->set_read_ops_per_sec(ops_per_sec / 2);
+    tablet_metrics->set_write_ops_per_sec(ops_per_sec / 2);
+    if (has_split_key) {
+      tablet_metrics->set_split_partition_key("\x80\x00"s);
+    }
+  }
+
+  std::vector<TabletId> CandidateIds(CoarseTimePoint now) {
+    std::vector<TabletId> result;
+    for (const auto& candidate : manager_.GetSplitCandidates(now)) {
+      result.push_back(candidate.tablet_id);
+    }
+    return result;
+  }
+
+  TabletSplitManager manager_;
+};
+
+TEST_F(TabletSplitManagerTest, PickCandidates) {
+  auto now = CoarseMonoClock::Now();
+  TServerMetricsPB metrics;
+  AddTablet(&metrics, "small", 10, 1);
+  AddTablet(&metrics, "large", 2000, 1);
+  AddTablet(&metrics, "hot", 10, 200);
+  AddTablet(&metrics, "no_split_key", 2000, 200, false /* has_split_key */);
+  AddTablet(&metrics, "huge", 5000, 1);
+  manager_.ProcessTabletMetrics("ts1", metrics, now);
+
+  ASSERT_EQ(CandidateIds(now), std::vector<TabletId>({"huge", "large", "hot"}));
+
+  // Load dropped and tablet is not split candidate anymore.
+  metrics.Clear();
+  AddTablet(&metrics, "huge", 5000, 1);
+  AddTablet(&metrics, "hot", 10, 20);
+  manager_.ProcessTabletMetrics("ts1", metrics, now + 5s);
+
+  // Leadership of "large" moved to ts2, so ts1 does not report it.
+  ASSERT_EQ(CandidateIds(now + 5s), std::vector<TabletId>({"huge"}));
+
+  metrics.Clear();
+  AddTablet(&metrics, "large", 2000, 1);
+  manager_.ProcessTabletMetrics("ts2", metrics, now + 6s);
+  auto candidates = manager_.GetSplitCandidates(now + 6s);
+  ASSERT_EQ(candidates.size(), 2);
+  ASSERT_EQ(candidates[1].tablet_id, "large");
+  ASSERT_EQ(candidates[1].leader_uuid, "ts2");
+
+  // ts1 stopped heartbeating, so its candidates expire.
+  ASSERT_EQ(CandidateIds(now + 16s), std::vector<TabletId>({"large"}));
+  ASSERT_EQ(CandidateIds(now + 20s), std::vector<TabletId>());
+}
+
+TEST_F(TabletSplitManagerTest, Enabled) {
+  ASSERT_TRUE(TabletSplitManager::IsEnabled());
+  FLAGS_tablet_split_size_threshold_bytes = 0;
+  ASSERT_TRUE(TabletSplitManager::IsEnabled());
+  FLAGS_tablet_split_ops_per_sec_threshold = 0;
+  ASSERT_FALSE(TabletSplitManager::IsEnabled());
+  FLAGS_tablet_split_size_threshold_bytes = 1000;
+  ASSERT_TRUE(TabletSplitManager::IsEnabled());
+}
+
+} // namespace master
+} // namespace yb
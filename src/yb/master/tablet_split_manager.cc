@@ -0,0 +1,124 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+#include "yb/master/tablet_split_manager.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/format.h"
+#include "yb/util/slice.h"
+
+DEFINE_uint64(tablet_split_size_threshold_bytes, 0,
+              "Tablet becomes split candidate when size of its SST files exceeds this value. "
+              "0 to disable size based split.");
+TAG_FLAG(tablet_split_size_threshold_bytes, runtime);
+
+DEFINE_double(tablet_split_ops_per_sec_threshold, 0,
+              "Tablet becomes split candidate when total number of read and write operations "
+              "per second reported by its leader exceeds this value. 0 to disable load based "
+              "split.");
+TAG_FLAG(tablet_split_ops_per_sec_threshold, runtime);
+
+DEFINE_int32(tablet_split_candidate_expiration_ms, 30000,
+             "Split candidate is forgotten when its leader does not report it for this amount "
+             "of time.");
+TAG_FLAG(tablet_split_candidate_expiration_ms, advanced);
+
+namespace yb {
+namespace master {
+
+std::string TabletSplitCandidate::ToString() const {
+  return Format(
+      "{ tablet_id: $0 leader_uuid: $1 split_partition_key: $2 sst_files_size: $3 "
+          "ops_per_sec: $4 }",
+      tablet_id, leader_uuid, Slice(split_partition_key).ToDebugHexString(), sst_files_size,
+      ops_per_sec);
+}
+
+bool TabletSplitManager::IsEnabled() {
+  return FLAGS_tablet_split_size_threshold_bytes != 0 ||
+         FLAGS_tablet_split_ops_per_sec_threshold > 0;
+}
+
+bool TabletSplitManager::ShouldSplit(const TabletLeaderMetricsPB& metrics) {
+  if (!metrics.has_split_partition_key()) {
+    return false;
+  }
+  auto size_threshold = FLAGS_tablet_split_size_threshold_bytes;
+  if (size_threshold != 0 && metrics.sst_files_size() > size_threshold) {
+    return true;
+  }
+  auto ops_threshold = FLAGS_tablet_split_ops_per_sec_threshold;
+  return ops_threshold > 0 &&
+         metrics.read_ops_per_sec() + metrics.write_ops_per_sec() > ops_threshold;
+}
+
+void TabletSplitManager::ProcessTabletMetrics(
+    const TabletServerId& ts_uuid, const TServerMetricsPB& metrics, CoarseTimePoint now) {
+  std::unordered_set<TabletId> reported_tablets;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& tablet_metrics : metrics.tablet_leader_metrics()) {
+    reported_tablets.insert(tablet_metrics.tablet_id());
+    if (!ShouldSplit(tablet_metrics)) {
+      candidates_.erase(tablet_metrics.tablet_id());
+      continue;
+    }
+    auto& candidate = candidates_[tablet_metrics.tablet_id()];
+    bool is_new = candidate.tablet_id.empty();
+    candidate.tablet_id = tablet_metrics.tablet_id();
+    candidate.leader_uuid = ts_uuid;
+    candidate.split_partition_key = tablet_metrics.split_partition_key();
+    candidate.sst_files_size = tablet_metrics.sst_files_size();
+    candidate.ops_per_sec = tablet_metrics.read_ops_per_sec() + tablet_metrics.write_ops_per_sec();
+    candidate.last_report_time = now;
+    LOG_IF(INFO, is_new) << "New tablet split candidate: " << candidate.ToString();
+  }
+
+  // Tablets that were led by this server, but are not reported anymore, lost their leader here.
+  for (auto it = candidates_.begin(); it != candidates_.end();) {
+    if (it->second.leader_uuid == ts_uuid && reported_tablets.count(it->first) == 0) {
+      it = candidates_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+std::vector<TabletSplitCandidate> TabletSplitManager::GetSplitCandidates(CoarseTimePoint now) {
+  std::vector<TabletSplitCandidate> result;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto expiration = std::chrono::milliseconds(FLAGS_tablet_split_candidate_expiration_ms);
+    for (auto it = candidates_.begin(); it != candidates_.end();) {
+      if (it->second.last_report_time + expiration < now) {
+        VLOG(1) << "Tablet split candidate expired: " << it->second.ToString();
+        it = candidates_.erase(it);
+      } else {
+        result.push_back(it->second);
+        ++it;
+      }
+    }
+  }
+  std::sort(result.begin(), result.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.sst_files_size != rhs.sst_files_size ? lhs.sst_files_size > rhs.sst_files_size
+                                                    : lhs.ops_per_sec > rhs.ops_per_sec;
+  });
+  return result;
+}
+
+} // namespace master
+} // namespace yb
@@ -0,0 +1,71 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_MASTER_TABLET_SPLIT_MANAGER_H
+#define YB_MASTER_TABLET_SPLIT_MANAGER_H
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/common/entity_ids.h"
+#include "yb/master/master.pb.h"
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace master {
+
+struct TabletSplitCandidate {
+  TabletId tablet_id;
+  // Tablet server that hosts leader of the tablet.
+  TabletServerId leader_uuid;
+  // Partition key that splits tablet into two halves of approximately the same size.
+  std::string split_partition_key;
+  uint64_t sst_files_size = 0;
+  double ops_per_sec = 0;
+  CoarseTimePoint last_report_time;
+
+  std::string ToString() const;
+};
+
+// Picks tablets that should be split, based on load reported by tablet leaders in heartbeats.
+//
+// Tablet becomes split candidate when its SST files size or number of operations per second
+// exceeds the configured threshold, and its leader was able to estimate the split key.
+// Candidate is forgotten when its leader reports that load dropped below thresholds or stops
+// reporting it at all, for instance because of leader change or tablet deletion.
+class TabletSplitManager {
+ public:
+  // Processes tablet leader metrics received in heartbeat from the specified tablet server.
+  void ProcessTabletMetrics(
+      const TabletServerId& ts_uuid, const TServerMetricsPB& metrics,
+      CoarseTimePoint now = CoarseMonoClock::Now());
+
+  // Returns current split candidates, the most loaded first.
+  std::vector<TabletSplitCandidate> GetSplitCandidates(
+      CoarseTimePoint now = CoarseMonoClock::Now());
+
+  static bool ShouldSplit(const TabletLeaderMetricsPB& metrics);
+
+  // Returns true when any of split thresholds is set.
+  static bool IsEnabled();
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<TabletId, TabletSplitCandidate> candidates_;
+};
+
+} // namespace master
+} // namespace yb
+
+#endif // YB_MASTER_TABLET_SPLIT_MANAGER_H
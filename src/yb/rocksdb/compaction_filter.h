@@ -60,6 +60,14 @@ class CompactionFilter {
     bool is_manual_compaction;
     // Which column family this compaction is for.
     uint32_t column_family_id;
+    // Does this compaction write to the bottommost level, i.e. all older data for its key range
+    // is included into this compaction. Set only when user frontiers of other files that overlap
+    // this key range are known.
+    bool is_bottommost_level = false;
+    // Smallest user frontier of files that overlap key range of this compaction, but are not
+    // included into it. Filled only for bottommost compactions that are not full, null when
+    // there are no such files.
+    UserFrontierPtr overlapping_files_smallest_frontier;
   };
 
   virtual ~CompactionFilter() {}
@@ -100,9 +108,9 @@ class CompactionFilter {
   // call does not need to be thread-safe.  However, multiple filters may be
   // in existence and operating concurrently.
   //
-  // The last paragraph is not true if you set max_subcompactions to more than
-  // 1. In that case, subcompaction from multiple threads may call a single
-  // CompactionFilter concurrently.
+  // If you set max_subcompactions to more than 1, each subcompaction creates
+  // its own filter, that sees only keys between subcompaction boundaries.
+  // See CompactionFilterFactory::SubcompactionBoundaryPrefixSize.
   virtual FilterDecision Filter(int level,
                                 const Slice& key,
                                 const Slice& existing_value,
@@ -155,6 +163,13 @@ class CompactionFilterFactory {
   virtual std::unique_ptr<CompactionFilter> CreateCompactionFilter(
       const CompactionFilter::Context& context) = 0;
 
+  // Returns size of the user key prefix that could be used as a subcompaction boundary.
+  // Filters that keep state between adjacent keys could use it to guarantee that keys sharing
+  // this state are processed by the same subcompaction.
+  virtual size_t SubcompactionBoundaryPrefixSize(const Slice& user_key) const {
+    return user_key.size();
+  }
+
   // Returns a name that identifies this compaction filter factory.
   virtual const char* Name() const = 0;
 };
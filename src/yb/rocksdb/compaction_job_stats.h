@@ -45,6 +45,9 @@ struct CompactionJobStats {
   // the number of compaction output files.
   size_t num_output_files;
 
+  // the number of subcompactions this compaction was split into.
+  size_t num_subcompactions;
+
   // true if the compaction is a manual compaction
   bool is_manual_compaction;
 
@@ -176,6 +176,13 @@ class DB {
                                    const std::string& name,
                                    std::vector<std::string>* column_families);
 
+  // GetMaxLevel reads the manifest of the DB specified by argument name and returns the highest
+  // level that files were added to through max_level argument. Level count is not persisted,
+  // so it is used to open a DB that was written with more levels.
+  static Status GetMaxLevel(const DBOptions& db_options,
+                            const std::string& name,
+                            int* max_level);
+
   DB() { }
   virtual ~DB();
 
@@ -889,7 +896,13 @@ class DB {
   // Needed for StackableDB
   virtual DB* GetRootDB() { return this; }
 
-  virtual CHECKED_STATUS Import(const std::string& source_dir) {
+  // Links files of RocksDB located in source_dir into this DB.
+  // When flushed_frontier is specified, it is atomically updated with import.
+  // When file_frontiers is specified, it is used as boundaries of every imported file, otherwise
+  // imported files don't have user frontiers.
+  virtual CHECKED_STATUS Import(
+      const std::string& source_dir, const UserFrontierPtr& flushed_frontier = UserFrontierPtr(),
+      const UserFrontiers* file_frontiers = nullptr) {
     return STATUS(NotSupported, "");
   }
 
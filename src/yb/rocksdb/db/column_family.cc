@@ -396,7 +396,11 @@ ColumnFamilyData::ColumnFamilyData(
     internal_stats_.reset(
         new InternalStats(ioptions_.num_levels, db_options->env, this));
     table_cache_.reset(new TableCache(ioptions_, env_options, _table_cache));
-    if (ioptions_.compaction_style == kCompactionStyleLevel) {
+    if (ioptions_.compaction_style == kCompactionStyleLevel &&
+        options_.level0_universal_compaction) {
+      compaction_picker_.reset(
+          new HybridCompactionPicker(ioptions_, internal_comparator_.get()));
+    } else if (ioptions_.compaction_style == kCompactionStyleLevel) {
       compaction_picker_.reset(
           new LevelCompactionPicker(ioptions_, internal_comparator_.get()));
 #ifndef ROCKSDB_LITE
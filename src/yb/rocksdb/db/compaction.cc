@@ -30,6 +30,7 @@
 #include <inttypes.h>
 
 #include <algorithm>
+#include <unordered_set>
 #include <vector>
 
 #include "yb/rocksdb/compaction_filter.h"
@@ -253,6 +254,37 @@ Compaction::Compaction(VersionStorageInfo* vstorage,
 
   Slice smallest_user_key;
   GetBoundaryKeys(vstorage, inputs_, &smallest_user_key, &largest_user_key_);
+
+  if (bottommost_level_ && !is_full_compaction_) {
+    overlapping_files_frontier_known_ = CollectOverlappingFilesSmallestFrontier(
+        vstorage, smallest_user_key);
+  }
+}
+
+bool Compaction::CollectOverlappingFilesSmallestFrontier(
+    VersionStorageInfo* vstorage, const Slice& smallest_user_key) {
+  std::unordered_set<const FileMetaData*> input_files;
+  for (const auto& input_level : inputs_) {
+    input_files.insert(input_level.files.begin(), input_level.files.end());
+  }
+
+  const Comparator* ucmp = vstorage->InternalComparator()->user_comparator();
+  for (int level = 0; level < vstorage->num_levels(); ++level) {
+    for (const auto* f : vstorage->LevelFiles(level)) {
+      if (input_files.count(f) ||
+          ucmp->Compare(f->largest.key.user_key(), smallest_user_key) < 0 ||
+          ucmp->Compare(f->smallest.key.user_key(), largest_user_key_) > 0) {
+        continue;
+      }
+      if (!f->smallest.user_frontier) {
+        return false;
+      }
+      UserFrontier::Update(
+          f->smallest.user_frontier.get(), UpdateUserValueType::kSmallest,
+          &overlapping_files_smallest_frontier_);
+    }
+  }
+  return true;
 }
 
 Compaction::~Compaction() {
@@ -494,7 +526,8 @@ void Compaction::Summary(char* output, int len) {
 uint64_t Compaction::OutputFilePreallocationSize() {
   uint64_t preallocation_size = 0;
 
-  if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel ||
+  if ((cfd_->ioptions()->compaction_style == kCompactionStyleLevel &&
+       !mutable_cf_options_.level0_universal_compaction) ||
       output_level() > 0) {
     preallocation_size = max_output_file_size_;
   } else {
@@ -519,6 +552,9 @@ std::unique_ptr<CompactionFilter> Compaction::CreateCompactionFilter() const {
   context.is_full_compaction = is_full_compaction_;
   context.is_manual_compaction = is_manual_compaction_;
   context.column_family_id = cfd_->GetID();
+  context.is_bottommost_level =
+      bottommost_level_ && (is_full_compaction_ || overlapping_files_frontier_known_);
+  context.overlapping_files_smallest_frontier = overlapping_files_smallest_frontier_;
   return cfd_->ioptions()->compaction_filter_factory->CreateCompactionFilter(
       context);
 }
@@ -532,7 +568,8 @@ bool Compaction::ShouldFormSubcompactions() const {
     return false;
   }
   if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel) {
-    return start_level_ == 0 && !IsOutputLevelEmpty();
+    // Level-0 output is never split, since level-0 files are ordered by sequence numbers.
+    return start_level_ == 0 && output_level_ > 0 && !IsOutputLevelEmpty();
   } else if (IsCompactionStyleUniversal()) {
     return number_levels_ > 1 && output_level_ > 0;
   } else {
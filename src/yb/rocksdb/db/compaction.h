@@ -300,6 +300,10 @@ class Compaction {
   yb::PriorityThreadPoolSuspender* suspender() { return suspender_; }
   void SetSuspender(yb::PriorityThreadPoolSuspender* value) { suspender_ = value; }
 
+  // Priority of the thread pool task that runs this compaction, used for its subcompactions.
+  int priority() const { return priority_; }
+  void SetPriority(int value) { priority_ = value; }
+
  private:
   // mark (or clear) all files that are being compacted
   void MarkFilesBeingCompacted(bool mark_as_compacted);
@@ -318,6 +322,11 @@ class Compaction {
   static bool IsFullCompaction(VersionStorageInfo* vstorage,
                                const std::vector<CompactionInputFiles>& inputs);
 
+  // Collects smallest user frontier of files that overlap key range of this compaction, but are
+  // not included into it. Returns false if some of those files do not have user frontier.
+  bool CollectOverlappingFilesSmallestFrontier(
+      VersionStorageInfo* vstorage, const Slice& smallest_user_key);
+
   const int start_level_;    // the lowest level to be compacted
   const int output_level_;  // levels to which output files are stored
   uint64_t max_output_file_size_;
@@ -357,6 +366,10 @@ class Compaction {
   // Does this compaction include all sst files?
   const bool is_full_compaction_;
 
+  // See CompactionFilter::Context::overlapping_files_smallest_frontier.
+  UserFrontierPtr overlapping_files_smallest_frontier_;
+  bool overlapping_files_frontier_known_ = false;
+
   // Is this compaction requested by the client?
   const bool is_manual_compaction_;
 
@@ -379,6 +392,8 @@ class Compaction {
   CompactionReason compaction_reason_;
 
   yb::PriorityThreadPoolSuspender* suspender_ = nullptr;
+
+  int priority_ = 0;
 };
 
 // Utility function
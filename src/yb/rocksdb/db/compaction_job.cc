@@ -33,6 +33,7 @@
 #include <vector>
 #include <memory>
 #include <list>
+#include <mutex>
 #include <set>
 #include <thread>
 #include <utility>
@@ -72,6 +73,7 @@
 #include "yb/rocksdb/util/sync_point.h"
 #include "yb/rocksdb/util/thread_status_util.h"
 
+#include "yb/util/format.h"
 #include "yb/util/stats/iostats_context_imp.h"
 #include "yb/util/string_util.h"
 
@@ -122,6 +124,12 @@ struct CompactionJob::SubcompactionState {
   CompactionJobStats compaction_job_stats;
   uint64_t approx_size;
 
+  // Suspender of the thread that runs this subcompaction.
+  yb::PriorityThreadPoolSuspender* suspender = nullptr;
+
+  // Frontier provided by the compaction filter of this subcompaction.
+  UserFrontierPtr largest_user_frontier;
+
   SubcompactionState(Compaction* c, Slice* _start, Slice* _end,
                      uint64_t size = 0)
       : compaction(c),
@@ -153,6 +161,8 @@ struct CompactionJob::SubcompactionState {
     num_output_records = std::move(o.num_output_records);
     compaction_job_stats = std::move(o.compaction_job_stats);
     approx_size = std::move(o.approx_size);
+    suspender = o.suspender;
+    largest_user_frontier = std::move(o.largest_user_frontier);
     return *this;
   }
 
@@ -473,12 +483,68 @@ void CompactionJob::GenSubcompactionBoundaries() {
       }
     }
     sizes_.emplace_back(sum + ranges.back().size);
+    AlignSubcompactionBoundaries();
   } else {
     // Only one range so its size is the total sum of sizes computed above
     sizes_.emplace_back(sum);
   }
 }
 
+// Cuts boundaries to the prefix provided by the compaction filter factory, so keys sharing this
+// prefix are processed by the same subcompaction. Subcompactions that become empty are merged with
+// previous ones.
+void CompactionJob::AlignSubcompactionBoundaries() {
+  auto* cfd = compact_->compaction->column_family_data();
+  auto* factory = cfd->ioptions()->compaction_filter_factory;
+  if (!factory) {
+    return;
+  }
+  const Comparator* cfd_comparator = cfd->user_comparator();
+  std::vector<Slice> boundaries;
+  std::vector<uint64_t> sizes;
+  boundaries.reserve(boundaries_.size());
+  sizes.reserve(sizes_.size());
+  sizes.push_back(sizes_[0]);
+  for (size_t i = 0; i != boundaries_.size(); ++i) {
+    Slice boundary = boundaries_[i];
+    boundary.remove_suffix(boundary.size() - factory->SubcompactionBoundaryPrefixSize(boundary));
+    if (!boundary.empty() &&
+        (boundaries.empty() || cfd_comparator->Compare(boundary, boundaries.back()) > 0)) {
+      boundaries.push_back(boundary);
+      sizes.push_back(sizes_[i + 1]);
+    } else {
+      sizes.back() += sizes_[i + 1];
+    }
+  }
+  boundaries_ = std::move(boundaries);
+  sizes_ = std::move(sizes);
+}
+
+bool SubcompactionRunner::TryRun(yb::PriorityThreadPoolSuspender* suspender) {
+  if (claimed_.exchange(true, std::memory_order_acq_rel)) {
+    return false;
+  }
+  action_(suspender);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_ = true;
+  }
+  cond_.notify_all();
+  return true;
+}
+
+void SubcompactionRunner::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cond_.wait(lock, [this] { return done_; });
+}
+
+void SubcompactionTask::Run(const Status& status, yb::PriorityThreadPoolSuspender* suspender) {
+  // Aborted subcompaction is executed by the compaction thread.
+  if (status.ok()) {
+    runner_->TryRun(suspender);
+  }
+}
+
 Result<FileNumbersHolder> CompactionJob::Run() {
   AutoThreadOperationStageUpdater stage_updater(
       ThreadStatus::STAGE_COMPACTION_RUN);
@@ -493,24 +559,67 @@ Result<FileNumbersHolder> CompactionJob::Run() {
   assert(num_threads > 0);
   const uint64_t start_micros = env_->NowMicros();
 
-  // Launch a thread for each of subcompactions 1...num_threads-1
-  std::vector<std::thread> thread_pool;
-  thread_pool.reserve(num_threads - 1);
   FileNumbersHolder file_numbers_holder(file_numbers_provider_->CreateHolder());
   file_numbers_holder.Reserve(num_threads);
-  for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
-    thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this, &file_numbers_holder,
-                             &compact_->sub_compact_states[i]);
+
+  // Schedule each of subcompactions 1...num_threads-1 on the priority thread pool, or launch a
+  // thread for each of them when there is no pool.
+  auto* priority_thread_pool = db_options_.priority_thread_pool_for_compactions_and_flushes;
+  std::vector<std::shared_ptr<SubcompactionRunner>> runners;
+  std::vector<std::thread> threads;
+  runners.reserve(num_threads - 1);
+  for (size_t i = 1; i < num_threads; i++) {
+    auto* sub_compact = &compact_->sub_compact_states[i];
+    runners.push_back(std::make_shared<SubcompactionRunner>(
+        [this, &file_numbers_holder, sub_compact](yb::PriorityThreadPoolSuspender* suspender) {
+      sub_compact->suspender = suspender;
+      ProcessKeyValueCompaction(&file_numbers_holder, sub_compact);
+    }));
+    if (priority_thread_pool) {
+      auto task = std::make_unique<SubcompactionTask>(
+          runners.back(), this, yb::Format("{ subcompaction $0 of job $1 }", i, job_id_));
+      auto status = priority_thread_pool->Submit(compact_->compaction->priority(), &task);
+      if (!status.ok()) {
+        // It will be executed by the current thread.
+        RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+            "[%s] [JOB %d] Failed to schedule subcompaction: %s",
+            compact_->compaction->column_family_data()->GetName().c_str(), job_id_,
+            status.ToString().c_str());
+      }
+    } else {
+      threads.emplace_back(&SubcompactionRunner::TryRun, runners.back().get(), nullptr);
+    }
   }
 
   // Always schedule the first subcompaction (whether or not there are also
   // others) in the current thread to be efficient with resources
+  compact_->sub_compact_states[0].suspender = compact_->compaction->suspender();
   ProcessKeyValueCompaction(&file_numbers_holder, &compact_->sub_compact_states[0]);
 
-  // Wait for all other threads (if there are any) to finish execution
-  for (auto& thread : thread_pool) {
+  // Subcompactions that were not picked by the pool yet are executed by the current thread, so
+  // compaction does not wait for a free worker, while it occupies one of them.
+  for (const auto& runner : runners) {
+    runner->TryRun(compact_->compaction->suspender());
+  }
+  if (priority_thread_pool && !runners.empty()) {
+    priority_thread_pool->Remove(this);
+  }
+
+  // Wait for all other subcompactions (if there are any) to finish execution
+  for (auto& thread : threads) {
     thread.join();
   }
+  for (const auto& runner : runners) {
+    runner->Wait();
+  }
+
+  for (const auto& state : compact_->sub_compact_states) {
+    // Subcompactions could pick different history cutoffs, so the smallest one is persisted.
+    if (state.largest_user_frontier) {
+      UpdateUserFrontier(
+          &largest_user_frontier_, state.largest_user_frontier, UpdateUserValueType::kSmallest);
+    }
+  }
 
   if (output_directory_ && !db_options_.disableDataSync) {
     output_directory_->Fsync();
@@ -572,7 +681,7 @@ Status CompactionJob::Install(const MutableCFOptions& mutable_cf_options) {
       "[%s] compacted to: %s, MB/sec: %.1f rd, %.1f wr, level %d, "
       "files in(%d, %d) out(%d) "
       "MB in(%.1f, %.1f) out(%.1f), read-write-amplify(%.1f) "
-      "write-amplify(%.1f) %s, records in: %d, records dropped: %d\n",
+      "write-amplify(%.1f) %s, records in: %d, records dropped: %d, subcompactions: %zu\n",
       cfd->GetName().c_str(), vstorage->LevelSummary(&tmp),
       (stats.bytes_read_non_output_levels + stats.bytes_read_output_level) /
           static_cast<double>(stats.micros),
@@ -588,7 +697,7 @@ Status CompactionJob::Install(const MutableCFOptions& mutable_cf_options) {
           bytes_read_non_output_levels,
       stats.bytes_written / bytes_read_non_output_levels,
       status.ToString().c_str(), stats.num_input_records,
-      stats.num_dropped_records);
+      stats.num_dropped_records, compact_->sub_compact_states.size());
 
   UpdateCompactionJobStats(stats);
 
@@ -660,7 +769,7 @@ void CompactionJob::ProcessKeyValueCompaction(
   if (compaction_filter) {
     // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
     // filter.
-    largest_user_frontier_ = compaction_filter->GetLargestUserFrontier();
+    sub_compact->largest_user_frontier = compaction_filter->GetLargestUserFrontier();
   }
 
   MergeHelper merge(
@@ -1051,7 +1160,7 @@ Status CompactionJob::OpenCompactionOutputFile(
         (*writable_file)->SetPreallocationBlockSize(preallocation_block_size);
       }
       writer->reset(new WritableFileWriter(
-          std::move(*writable_file), env_options_, sub_compact->compaction->suspender()));
+          std::move(*writable_file), env_options_, sub_compact->suspender));
     };
 
     const bool is_split_sst = cfd->ioptions()->table_factory->IsSplitSstForWriteSupported();
@@ -1201,6 +1310,7 @@ void CompactionJob::UpdateCompactionJobStats(
     compaction_job_stats_->num_output_records =
         compact_->num_output_records;
     compaction_job_stats_->num_output_files = stats.num_output_files;
+    compaction_job_stats_->num_subcompactions = compact_->sub_compact_states.size();
 
     if (compact_->NumOutputFiles() > 0U) {
       CopyPrefix(
@@ -27,9 +27,11 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <deque>
 #include <functional>
 #include <limits>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -61,6 +63,8 @@
 #include "yb/rocksdb/util/stop_watch.h"
 #include "yb/rocksdb/util/thread_local.h"
 
+#include "yb/util/priority_thread_pool.h"
+
 namespace rocksdb {
 
 using yb::Result;
@@ -74,6 +78,51 @@ class Arena;
 class FileNumbersProvider;
 class FileNumbersHolder;
 
+// Subcompaction that could be executed either by a priority thread pool worker or by the thread
+// that runs the whole compaction, whichever claims it first.
+class SubcompactionRunner {
+ public:
+  typedef std::function<void(yb::PriorityThreadPoolSuspender*)> Action;
+
+  explicit SubcompactionRunner(Action action) : action_(std::move(action)) {}
+
+  // Executes subcompaction if it was not claimed yet, returns true in this case.
+  bool TryRun(yb::PriorityThreadPoolSuspender* suspender);
+
+  // Waits until claimed subcompaction is complete.
+  void Wait();
+
+ private:
+  Action action_;
+  std::atomic<bool> claimed_{false};
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool done_ = false;
+};
+
+// Priority thread pool task, that tries to run subcompaction owned by the specified compaction job.
+class SubcompactionTask : public yb::PriorityThreadPoolTask {
+ public:
+  SubcompactionTask(
+      std::shared_ptr<SubcompactionRunner> runner, void* owner, std::string description)
+      : runner_(std::move(runner)), owner_(owner), description_(std::move(description)) {}
+
+  void Run(const Status& status, yb::PriorityThreadPoolSuspender* suspender) override;
+
+  bool BelongsTo(void* key) override {
+    return key == owner_;
+  }
+
+  std::string ToString() const override {
+    return description_;
+  }
+
+ private:
+  std::shared_ptr<SubcompactionRunner> runner_;
+  void* const owner_;
+  const std::string description_;
+};
+
 class CompactionJob {
  public:
   CompactionJob(int job_id, Compaction* compaction, const DBOptions& db_options,
@@ -110,6 +159,7 @@ class CompactionJob {
 
   void AggregateStatistics();
   void GenSubcompactionBoundaries();
+  void AlignSubcompactionBoundaries();
 
   // update the thread status for starting a compaction.
   void ReportStartedCompaction(Compaction* compaction);
@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <map>
 #include <string>
+#include <thread>
 #include <tuple>
 
 #include "yb/rocksdb/db/compaction_job.h"
@@ -38,6 +39,8 @@
 #include "yb/rocksdb/util/testharness.h"
 #include "yb/rocksdb/util/testutil.h"
 #include "yb/rocksdb/utilities/merge_operators.h"
+#include "yb/util/countdown_latch.h"
+#include "yb/util/priority_thread_pool.h"
 #include "yb/util/string_util.h"
 
 namespace rocksdb {
@@ -1032,6 +1035,116 @@ TEST_F(CompactionJobTest, CorruptionAfterDeletion) {
   RunCompaction({files}, expected_results);
 }
 
+namespace {
+
+// Occupies priority thread pool worker until released.
+class BlockingTask : public yb::PriorityThreadPoolTask {
+ public:
+  BlockingTask(yb::CountDownLatch* started, yb::CountDownLatch* release)
+      : started_(started), release_(release) {}
+
+  void Run(const Status& status, yb::PriorityThreadPoolSuspender* suspender) override {
+    started_->CountDown();
+    release_->Wait();
+  }
+
+  bool BelongsTo(void* key) override {
+    return false;
+  }
+
+  std::string ToString() const override {
+    return "BlockingTask";
+  }
+
+ private:
+  yb::CountDownLatch* started_;
+  yb::CountDownLatch* release_;
+};
+
+} // namespace
+
+TEST(SubcompactionRunnerTest, ClaimedOnce) {
+  constexpr int kNumThreads = 8;
+  std::atomic<int> num_runs{0};
+  SubcompactionRunner runner([&num_runs](yb::PriorityThreadPoolSuspender* suspender) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ++num_runs;
+  });
+
+  std::atomic<int> num_claims{0};
+  std::atomic<int> num_early_wakeups{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i != kNumThreads; ++i) {
+    threads.emplace_back([&runner, &num_runs, &num_claims, &num_early_wakeups] {
+      if (runner.TryRun(/* suspender= */ nullptr)) {
+        ++num_claims;
+      }
+      runner.Wait();
+      if (num_runs.load() != 1) {
+        ++num_early_wakeups;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(1, num_runs.load());
+  ASSERT_EQ(1, num_claims.load());
+  ASSERT_EQ(0, num_early_wakeups.load());
+}
+
+TEST(SubcompactionRunnerTest, RunByThreadPool) {
+  yb::PriorityThreadPool thread_pool(1);
+  std::atomic<int> num_runs{0};
+  std::atomic<bool> has_suspender{false};
+  auto runner = std::make_shared<SubcompactionRunner>(
+      [&num_runs, &has_suspender](yb::PriorityThreadPoolSuspender* suspender) {
+    has_suspender = suspender != nullptr;
+    ++num_runs;
+  });
+  std::unique_ptr<yb::PriorityThreadPoolTask> task = std::make_unique<SubcompactionTask>(
+      runner, &thread_pool, "subcompaction");
+  ASSERT_OK(thread_pool.Submit(/* priority= */ 0, &task));
+
+  runner->Wait();
+  // Subcompaction was already claimed by the pool.
+  ASSERT_FALSE(runner->TryRun(/* suspender= */ nullptr));
+  thread_pool.Shutdown();
+
+  ASSERT_EQ(1, num_runs.load());
+  ASSERT_TRUE(has_suspender.load());
+}
+
+TEST(SubcompactionRunnerTest, RunByCompactionThread) {
+  yb::PriorityThreadPool thread_pool(1);
+  yb::CountDownLatch started(1);
+  yb::CountDownLatch release(1);
+  std::unique_ptr<yb::PriorityThreadPoolTask> blocking_task =
+      std::make_unique<BlockingTask>(&started, &release);
+  ASSERT_OK(thread_pool.Submit(/* priority= */ 1, &blocking_task));
+  started.Wait();
+
+  std::atomic<int> num_runs{0};
+  auto runner = std::make_shared<SubcompactionRunner>(
+      [&num_runs](yb::PriorityThreadPoolSuspender* suspender) {
+    ++num_runs;
+  });
+  std::unique_ptr<yb::PriorityThreadPoolTask> task = std::make_unique<SubcompactionTask>(
+      runner, &thread_pool, "subcompaction");
+  ASSERT_OK(thread_pool.Submit(/* priority= */ 0, &task));
+
+  // The only worker is busy, so subcompaction is executed by the compaction thread, and the task
+  // left in the pool is aborted without running it again.
+  ASSERT_TRUE(runner->TryRun(/* suspender= */ nullptr));
+  thread_pool.Remove(&thread_pool);
+  runner->Wait();
+  release.CountDown();
+  thread_pool.Shutdown();
+
+  ASSERT_EQ(1, num_runs.load());
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -1144,6 +1144,106 @@ bool LevelCompactionPicker::PickCompactionBySize(VersionStorageInfo* vstorage,
   return inputs->size() > 0;
 }
 
+std::unique_ptr<Compaction> HybridCompactionPicker::PickCompaction(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage, LogBuffer* log_buffer) {
+  auto c = PickLevel0Compaction(cf_name, mutable_cf_options, vstorage, log_buffer);
+  if (c) {
+    return c;
+  }
+  return LevelCompactionPicker::PickCompaction(cf_name, mutable_cf_options, vstorage, log_buffer);
+}
+
+std::unique_ptr<Compaction> HybridCompactionPicker::PickLevel0Compaction(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage, LogBuffer* log_buffer) {
+  // Level-0 files overlap, so only one compaction could use them.
+  if (!level0_compactions_in_progress_.empty()) {
+    return nullptr;
+  }
+
+  // Files are sorted from newest to oldest.
+  const std::vector<FileMetaData*>& files = vstorage->LevelFiles(0);
+  if (files.size() < static_cast<size_t>(mutable_cf_options.level0_file_num_compaction_trigger)) {
+    return nullptr;
+  }
+
+  // When level-0 is too big, it should be merged into the base level instead.
+  const uint64_t level0_size = TotalCompensatedFileSize(files);
+  if (level0_size >= mutable_cf_options.max_bytes_for_level_base) {
+    RDEBUG(ioptions_.info_log,
+           "[%s] Hybrid: level-0 size %" PRIu64 " exceeds %" PRIu64 ", merge into base level\n",
+           cf_name.c_str(), level0_size, mutable_cf_options.max_bytes_for_level_base);
+    return nullptr;
+  }
+
+  const auto& universal_options = ioptions_.compaction_options_universal;
+  const size_t min_merge_width = std::max(universal_options.min_merge_width, 2U);
+  const size_t max_merge_width = universal_options.max_merge_width;
+  const uint64_t ratio = universal_options.size_ratio;
+
+  // Same rule as universal compaction uses to limit read amplification: starting from the newest
+  // file, pick following files while each next file is not larger than total size picked so far,
+  // increased by size_ratio percent.
+  size_t start_index = 0;
+  size_t candidate_count = 0;
+  for (; start_index < files.size(); ++start_index) {
+    if (files[start_index]->being_compacted) {
+      continue;
+    }
+    uint64_t candidate_size = files[start_index]->compensated_file_size;
+    candidate_count = 1;
+    for (size_t i = start_index + 1; i < files.size() && candidate_count < max_merge_width; ++i) {
+      auto* f = files[i];
+      if (f->being_compacted) {
+        break;
+      }
+      const uint64_t file_size = f->fd.GetTotalFileSize();
+      if (candidate_size * (100 + ratio) < file_size * 100 &&
+          file_size > universal_options.always_include_size_threshold) {
+        break;
+      }
+      candidate_size += f->compensated_file_size;
+      ++candidate_count;
+    }
+    if (candidate_count >= min_merge_width) {
+      break;
+    }
+  }
+  if (start_index == files.size()) {
+    return nullptr;
+  }
+
+  CompactionInputFiles inputs;
+  inputs.level = 0;
+  for (size_t i = start_index; i != start_index + candidate_count; ++i) {
+    auto* f = files[i];
+    inputs.files.push_back(f);
+    char file_num_buf[kFormatFileNumberBufSize];
+    FormatFileNumber(f->fd.GetNumber(), f->fd.GetPathId(), file_num_buf, sizeof(file_num_buf));
+    LOG_TO_BUFFER(log_buffer, "[%s] Hybrid: picking level-0 file %s with size %" PRIu64,
+                  cf_name.c_str(), file_num_buf, f->fd.GetTotalFileSize());
+  }
+
+  // Output is not split, because level-0 files are ordered by sequence numbers.
+  auto c = std::make_unique<Compaction>(
+      vstorage, mutable_cf_options, std::vector<CompactionInputFiles>{std::move(inputs)},
+      0 /* output_level */, std::numeric_limits<uint64_t>::max() /* target_file_size */,
+      LLONG_MAX /* max_grandparent_overlap_bytes */,
+      GetPathId(ioptions_, mutable_cf_options, 0),
+      GetCompressionType(ioptions_, 0, vstorage->base_level()),
+      /* grandparents */ std::vector<FileMetaData*>(), /* is manual */ false,
+      vstorage->CompactionScore(0), false /* deletion_compaction */,
+      CompactionReason::kUniversalSizeRatio);
+  level0_compactions_in_progress_.insert(c.get());
+
+  // Recompute scores, since files of this compaction are not taken into account anymore.
+  CompactionOptionsFIFO dummy_compaction_options_fifo;
+  vstorage->ComputeCompactionScore(mutable_cf_options, dummy_compaction_options_fifo);
+
+  return c;
+}
+
 #ifndef ROCKSDB_LITE
 bool UniversalCompactionPicker::NeedsCompaction(
     const VersionStorageInfo* vstorage) const {
@@ -243,6 +243,33 @@ class LevelCompactionPicker : public CompactionPicker {
                                                 int* level, int* output_level);
 };
 
+// Picker for level compaction with level0_universal_compaction enabled.
+// Recent data is kept in level-0, where files are merged with each other using universal
+// compaction rules, so the number of level-0 files stays small without rewriting older data.
+// When total size of level-0 exceeds max_bytes_for_level_base, it is merged into the base level,
+// and older data is compacted level by level. So the size of any single compaction is bounded,
+// instead of rewriting the whole DB as universal compaction does.
+class HybridCompactionPicker : public LevelCompactionPicker {
+ public:
+  HybridCompactionPicker(const ImmutableCFOptions& ioptions,
+                         const InternalKeyComparator* icmp)
+      : LevelCompactionPicker(ioptions, icmp) {}
+
+  std::unique_ptr<Compaction> PickCompaction(
+      const std::string& cf_name,
+      const MutableCFOptions& mutable_cf_options,
+      VersionStorageInfo* vstorage,
+      LogBuffer* log_buffer) override;
+
+ private:
+  // Picks compaction of contiguous level-0 files of similar size, with output to level-0.
+  std::unique_ptr<Compaction> PickLevel0Compaction(
+      const std::string& cf_name,
+      const MutableCFOptions& mutable_cf_options,
+      VersionStorageInfo* vstorage,
+      LogBuffer* log_buffer);
+};
+
 #ifndef ROCKSDB_LITE
 class UniversalCompactionPicker : public CompactionPicker {
  public:
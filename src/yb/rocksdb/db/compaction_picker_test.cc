@@ -393,6 +393,67 @@ TEST_F(CompactionPickerTest, LevelTriggerDynamic4) {
   ASSERT_EQ(num_levels - 1, compaction->output_level());
 }
 
+TEST_F(CompactionPickerTest, HybridLevel0Compaction) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  mutable_cf_options_.level0_universal_compaction = true;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 4;
+  HybridCompactionPicker hybrid_compaction_picker(ioptions_, icmp_.get());
+
+  // Files are added from newest to oldest.
+  Add(0, 1U, "150", "300", 100000, 0, 400, 450);
+  Add(0, 2U, "150", "300", 100000, 0, 300, 350);
+  Add(0, 3U, "150", "300", 100000, 0, 200, 250);
+  Add(0, 4U, "150", "300", 5000000, 0, 100, 150);
+  Add(1, 5U, "100", "400", 5000000, 0, 10, 50);
+  UpdateVersionStorageInfo();
+  ASSERT_TRUE(hybrid_compaction_picker.NeedsCompaction(vstorage_.get()));
+
+  // Recent files of similar size are merged with each other, without touching older data.
+  std::unique_ptr<Compaction> compaction(hybrid_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(0, compaction->start_level());
+  ASSERT_EQ(0, compaction->output_level());
+  ASSERT_EQ(1U, compaction->num_input_levels());
+  ASSERT_EQ(3U, compaction->num_input_files(0));
+  ASSERT_EQ(1U, compaction->input(0, 0)->fd.GetNumber());
+  ASSERT_EQ(3U, compaction->input(0, 2)->fd.GetNumber());
+
+  // Only one level-0 compaction could run at a time.
+  std::unique_ptr<Compaction> compaction2(hybrid_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction2.get() == nullptr);
+  hybrid_compaction_picker.ReleaseCompactionFiles(compaction.get(), Status::OK());
+}
+
+TEST_F(CompactionPickerTest, HybridLevel0MergedIntoBaseLevel) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  mutable_cf_options_.level0_universal_compaction = true;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 4;
+  mutable_cf_options_.max_bytes_for_level_base = 1000000;
+  HybridCompactionPicker hybrid_compaction_picker(ioptions_, icmp_.get());
+
+  Add(0, 1U, "150", "300", 300000, 0, 400, 450);
+  Add(0, 2U, "150", "300", 300000, 0, 300, 350);
+  Add(0, 3U, "150", "300", 300000, 0, 200, 250);
+  Add(0, 4U, "150", "300", 300000, 0, 100, 150);
+  Add(1, 5U, "100", "200", 300000, 0, 10, 50);
+  Add(1, 6U, "400", "500", 300000, 0, 10, 50);
+  UpdateVersionStorageInfo();
+
+  // Level-0 exceeds max_bytes_for_level_base, so it is merged into overlapping files of the base
+  // level.
+  std::unique_ptr<Compaction> compaction(hybrid_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(0, compaction->start_level());
+  ASSERT_EQ(1, compaction->output_level());
+  ASSERT_EQ(4U, compaction->num_input_files(0));
+  ASSERT_EQ(1U, compaction->num_input_files(1));
+  ASSERT_EQ(5U, compaction->input(1, 0)->fd.GetNumber());
+  hybrid_compaction_picker.ReleaseCompactionFiles(compaction.get(), Status::OK());
+}
+
 // Universal and FIFO Compactions are not supported in ROCKSDB_LITE
 #ifndef ROCKSDB_LITE
 TEST_F(CompactionPickerTest, NeedsCompactionUniversal) {
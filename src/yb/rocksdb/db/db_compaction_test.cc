@@ -30,6 +30,7 @@
 #include "yb/rocksdb/util/sync_point.h"
 #include "yb/rocksdb/util/testutil.h"
 
+#include "yb/util/priority_thread_pool.h"
 #include "yb/util/random_util.h"
 #include "yb/util/test_util.h"
 
@@ -2717,6 +2718,130 @@ TEST_P(DBCompactionTestWithParam, ForceBottommostLevelCompaction) {
   rocksdb::SyncPoint::GetInstance()->DisableProcessing();
 }
 
+namespace {
+
+// Reports frontier based on the first key seen by the filter, so each subcompaction provides its
+// own frontier.
+class FirstKeyFrontierFilter : public CompactionFilter {
+ public:
+  static constexpr uint64_t kFrontierBase = 1000;
+
+  FilterDecision Filter(int level, const Slice& key, const Slice& value,
+                        std::string* new_value, bool* value_changed) override {
+    if (!frontier_) {
+      // Keys are generated by DBTestBase::Key, i.e. "key" followed by the key index.
+      frontier_ = test::TestUserFrontier(kFrontierBase + std::stoi(key.ToString().substr(3)))
+          .Clone();
+    }
+    return FilterDecision::kKeep;
+  }
+
+  UserFrontierPtr GetLargestUserFrontier() const override {
+    return frontier_;
+  }
+
+  const char* Name() const override { return "FirstKeyFrontierFilter"; }
+
+ private:
+  UserFrontierPtr frontier_;
+};
+
+class FirstKeyFrontierFilterFactory : public CompactionFilterFactory {
+ public:
+  std::unique_ptr<CompactionFilter> CreateCompactionFilter(
+      const CompactionFilter::Context& context) override {
+    return std::make_unique<FirstKeyFrontierFilter>();
+  }
+
+  const char* Name() const override { return "FirstKeyFrontierFilterFactory"; }
+};
+
+class SubcompactionsCollector : public EventListener {
+ public:
+  void OnCompactionCompleted(DB* db, const CompactionJobInfo& ci) override {
+    num_subcompactions_.store(ci.stats.num_subcompactions);
+  }
+
+  size_t num_subcompactions() const { return num_subcompactions_.load(); }
+
+ private:
+  std::atomic<size_t> num_subcompactions_{0};
+};
+
+} // namespace
+
+TEST_F(DBCompactionTest, SubcompactionsPersistSmallestFrontier) {
+  constexpr int kNumFiles = 4;
+  constexpr int kKeysPerFile = 100;
+  constexpr int kValueSize = 1000;
+
+  yb::PriorityThreadPool thread_pool(kNumFiles);
+  auto collector = std::make_shared<SubcompactionsCollector>();
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 2;
+  options.max_subcompactions = kNumFiles;
+  options.target_file_size_base = kKeysPerFile * kValueSize / 4;
+  options.disable_auto_compactions = true;
+  options.compaction_filter_factory = std::make_shared<FirstKeyFrontierFilterFactory>();
+  options.listeners.push_back(collector);
+  options.priority_thread_pool_for_compactions_and_flushes = &thread_pool;
+  DestroyAndReopen(options);
+
+  // Files with disjoint key ranges, so compaction is split into several subcompactions.
+  Random rnd(301);
+  for (int i = 0; i != kNumFiles; ++i) {
+    for (int j = 0; j != kKeysPerFile; ++j) {
+      ASSERT_OK(Put(Key(i * kKeysPerFile + j), RandomString(&rnd, kValueSize)));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_GT(collector->num_subcompactions(), 1);
+
+  // Frontiers of all subcompactions are merged, and the smallest one is persisted, as for the
+  // history cutoff of DocDB.
+  auto frontier = db_->GetFlushedFrontier();
+  ASSERT_TRUE(frontier.get() != nullptr);
+  ASSERT_EQ(FirstKeyFrontierFilter::kFrontierBase,
+            down_cast<test::TestUserFrontier&>(*frontier).Value());
+
+  Close();
+  thread_pool.Shutdown();
+}
+
+// Level count is not persisted, so it should be taken from the manifest to open a DB that was
+// compacted into more levels than configured.
+TEST_F(DBCompactionTest, GetMaxLevel) {
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 2;
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+
+  int max_level = -1;
+  ASSERT_OK(DB::GetMaxLevel(options, dbname_, &max_level));
+  ASSERT_EQ(0, max_level);
+
+  for (int i = 0; i != 2; ++i) {
+    ASSERT_OK(Put(Key(i), "value"));
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(1, NumTableFilesAtLevel(1));
+  Close();
+
+  ASSERT_OK(DB::GetMaxLevel(options, dbname_, &max_level));
+  ASSERT_EQ(1, max_level);
+
+  options.num_levels = 1;
+  ASSERT_TRUE(TryReopen(options).IsInvalidArgument());
+
+  options.num_levels = max_level + 1;
+  ASSERT_OK(TryReopen(options));
+  ASSERT_EQ("value", Get(Key(0)));
+}
+
 INSTANTIATE_TEST_CASE_P(DBCompactionTestWithParam, DBCompactionTestWithParam,
                         ::testing::Values(std::make_tuple(1, true),
                                           std::make_tuple(1, false),
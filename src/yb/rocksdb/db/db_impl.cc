@@ -255,6 +255,7 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
 
   void DoRun(yb::PriorityThreadPoolSuspender* suspender) override {
     compaction_->SetSuspender(suspender);
+    compaction_->SetPriority(priority_);
     db_impl_->BackgroundCallCompaction(manual_compaction_, std::move(compaction_holder_), this);
   }
 
@@ -5603,15 +5604,24 @@ ColumnFamilyHandle* DBImpl::GetColumnFamilyHandleUnlocked(
   return cf_memtables->GetColumnFamilyHandle();
 }
 
-Status DBImpl::Import(const std::string& source_dir) {
+Status DBImpl::Import(const std::string& source_dir,
+                      const UserFrontierPtr& flushed_frontier,
+                      const UserFrontiers* file_frontiers) {
   const auto seqno = versions_->LastSequence();
   FlushOptions options;
-  Flush(options);
+  auto status = Flush(options);
+  if (!status.ok() && flushed_frontier) {
+    // Flushed frontier could be moved only when all previous writes are flushed.
+    return status;
+  }
   VersionEdit edit;
-  auto status = versions_->Import(source_dir, seqno, &edit);
+  status = versions_->Import(source_dir, seqno, file_frontiers, &edit);
   if (!status.ok()) {
     return status;
   }
+  if (flushed_frontier) {
+    edit.ModifyFlushedFrontier(flushed_frontier, FrontierModificationMode::kUpdate);
+  }
   return ApplyVersionEdit(&edit);
 }
 
@@ -6297,6 +6307,15 @@ Status DB::ListColumnFamilies(const DBOptions& db_options,
                                         db_options.env);
 }
 
+Status DB::GetMaxLevel(const DBOptions& db_options,
+                       const std::string& name,
+                       int* max_level) {
+  return VersionSet::GetMaxLevel(max_level,
+                                 name,
+                                 db_options.boundary_extractor.get(),
+                                 db_options.env);
+}
+
 Snapshot::~Snapshot() {
 }
 
@@ -466,7 +466,9 @@ class DBImpl : public DB {
   // Checks that source database has appropriate seqno.
   // I.e. seqno ranges of imported database does not overlap with seqno ranges of destination db.
   // And max seqno of imported database is less that active seqno of destination db.
-  CHECKED_STATUS Import(const std::string& source_dir) override;
+  CHECKED_STATUS Import(
+      const std::string& source_dir, const UserFrontierPtr& flushed_frontier,
+      const UserFrontiers* file_frontiers) override;
 
   bool AreWritesStopped();
   bool NeedsDelay() override;
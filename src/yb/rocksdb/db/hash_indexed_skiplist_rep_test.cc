@@ -0,0 +1,209 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <algorithm>
+#include <thread>
+
+#include "yb/rocksdb/comparator.h"
+#include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/db/memtable.h"
+#include "yb/rocksdb/db/writebuffer.h"
+#include "yb/rocksdb/memtablerep.h"
+#include "yb/rocksdb/slice_transform.h"
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/concurrent_arena.h"
+#include "yb/rocksdb/util/testharness.h"
+
+#include "yb/util/format.h"
+
+namespace rocksdb {
+
+namespace {
+
+constexpr size_t kPrefixSize = 4;
+constexpr int kNumDocuments = 100;
+constexpr int kSubKeysPerDocument = 10;
+constexpr int kNumThreads = 4;
+
+std::string DocumentKey(int document) {
+  // Produces kPrefixSize bytes for documents in [0, 900).
+  return yb::Format("d$0", 100 + document);
+}
+
+std::string SubKey(int document, int subkey) {
+  return DocumentKey(document) + yb::Format("/$0", 100 + subkey);
+}
+
+Slice EntryUserKey(const char* entry) {
+  return ExtractUserKey(GetLengthPrefixedSlice(entry));
+}
+
+struct CountingCallbackArgs {
+  int calls = 0;
+  std::string first_user_key;
+};
+
+bool CountingCallback(void* arg, const char* entry) {
+  auto* args = static_cast<CountingCallbackArgs*>(arg);
+  if (args->calls++ == 0) {
+    args->first_user_key = EntryUserKey(entry).ToBuffer();
+  }
+  return false;
+}
+
+} // namespace
+
+class HashIndexedSkipListRepTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    HashIndexedSkipListFactory factory(
+        std::shared_ptr<const SliceTransform>(NewFixedPrefixTransform(kPrefixSize)),
+        16 /* bucket_count */, 2 /* lookahead */);
+    rep_.reset(factory.CreateMemTableRep(key_comparator_, &allocator_, nullptr, nullptr));
+  }
+
+  void Insert(const std::string& user_key, SequenceNumber seq, bool concurrently) {
+    InternalKey internal_key(user_key, seq, kTypeValue);
+    auto encoded = internal_key.Encode();
+    char* buf = nullptr;
+    auto handle = rep_->Allocate(VarintLength(encoded.size()) + encoded.size(), &buf);
+    char* p = EncodeVarint32(buf, static_cast<uint32_t>(encoded.size()));
+    memcpy(p, encoded.data(), encoded.size());
+    if (concurrently) {
+      rep_->InsertConcurrently(handle);
+    } else {
+      rep_->Insert(handle);
+    }
+  }
+
+  // Seeks to the specified user key and checks that iterator is positioned at the same key as
+  // lower bound in sorted keys.
+  void CheckSeek(const std::vector<std::string>& sorted_keys, const std::string& target) {
+    std::unique_ptr<MemTableRep::Iterator> iter(rep_->GetIterator());
+    LookupKey lookup_key(target, kMaxSequenceNumber);
+    iter->Seek(lookup_key.internal_key(), nullptr);
+    auto it = std::lower_bound(sorted_keys.begin(), sorted_keys.end(), target);
+    if (it == sorted_keys.end()) {
+      ASSERT_FALSE(iter->Valid()) << target;
+    } else {
+      ASSERT_TRUE(iter->Valid()) << target;
+      ASSERT_EQ(*it, EntryUserKey(iter->key()).ToBuffer()) << target;
+    }
+  }
+
+  InternalKeyComparator internal_key_comparator_{BytewiseComparator()};
+  MemTable::KeyComparator key_comparator_{internal_key_comparator_};
+  ConcurrentArena arena_;
+  WriteBuffer write_buffer_{1 << 20};
+  MemTableAllocator allocator_{&arena_, &write_buffer_};
+  std::unique_ptr<MemTableRep> rep_;
+};
+
+TEST_F(HashIndexedSkipListRepTest, ConcurrentInsertAndSeek) {
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kNumThreads; ++t) {
+    threads.emplace_back([this, t] {
+      for (int document = t; document < kNumDocuments; document += kNumThreads) {
+        // Insert subkeys in reverse order, so first entry of the document changes.
+        for (int subkey = kSubKeysPerDocument; subkey-- > 0;) {
+          Insert(SubKey(document, subkey), document * kSubKeysPerDocument + subkey + 1, true);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  // Key that is not in the prefix extractor domain.
+  Insert("x", kNumDocuments * kSubKeysPerDocument + 1, false);
+
+  std::vector<std::string> sorted_keys;
+  for (int document = 0; document != kNumDocuments; ++document) {
+    for (int subkey = 0; subkey != kSubKeysPerDocument; ++subkey) {
+      sorted_keys.push_back(SubKey(document, subkey));
+    }
+  }
+  sorted_keys.push_back("x");
+
+  {
+    std::unique_ptr<MemTableRep::Iterator> iter(rep_->GetIterator());
+    size_t idx = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++idx) {
+      ASSERT_LT(idx, sorted_keys.size());
+      ASSERT_EQ(sorted_keys[idx], EntryUserKey(iter->key()).ToBuffer());
+    }
+    ASSERT_EQ(sorted_keys.size(), idx);
+  }
+
+  for (int document = 0; document != kNumDocuments; ++document) {
+    ASSERT_NO_FATALS(CheckSeek(sorted_keys, DocumentKey(document)));
+    for (int subkey = 0; subkey <= kSubKeysPerDocument; ++subkey) {
+      ASSERT_NO_FATALS(CheckSeek(sorted_keys, SubKey(document, subkey)));
+    }
+    ASSERT_NO_FATALS(CheckSeek(sorted_keys, SubKey(document, 5) + "0"));
+  }
+  ASSERT_NO_FATALS(CheckSeek(sorted_keys, DocumentKey(kNumDocuments)));
+  ASSERT_NO_FATALS(CheckSeek(sorted_keys, "a"));
+  ASSERT_NO_FATALS(CheckSeek(sorted_keys, "x"));
+  ASSERT_NO_FATALS(CheckSeek(sorted_keys, "y"));
+}
+
+TEST_F(HashIndexedSkipListRepTest, Get) {
+  for (int document = 0; document != kNumDocuments; document += 2) {
+    for (int subkey = 0; subkey != kSubKeysPerDocument; ++subkey) {
+      Insert(SubKey(document, subkey), document * kSubKeysPerDocument + subkey + 1, false);
+    }
+  }
+
+  for (int document = 0; document != kNumDocuments; ++document) {
+    CountingCallbackArgs args;
+    rep_->Get(LookupKey(SubKey(document, 3), kMaxSequenceNumber), &args, &CountingCallback);
+    if (document % 2 == 0) {
+      ASSERT_EQ(1, args.calls);
+      ASSERT_EQ(SubKey(document, 3), args.first_user_key);
+    } else {
+      // Document is absent, so the skip list is not touched.
+      ASSERT_EQ(0, args.calls);
+    }
+  }
+}
+
+// Hash index is allocated by the first insert, so empty memtables don't hold it.
+TEST_F(HashIndexedSkipListRepTest, LazyIndex) {
+  constexpr size_t kBucketCount = 1 << 16;
+  constexpr size_t kIndexSize = kBucketCount * sizeof(void*);
+  HashIndexedSkipListFactory factory(
+      std::shared_ptr<const SliceTransform>(NewFixedPrefixTransform(kPrefixSize)), kBucketCount);
+  const auto initial_usage = write_buffer_.memory_usage();
+  rep_.reset(factory.CreateMemTableRep(key_comparator_, &allocator_, nullptr, nullptr));
+  ASSERT_LT(write_buffer_.memory_usage(), initial_usage + kIndexSize);
+
+  CountingCallbackArgs args;
+  rep_->Get(LookupKey(SubKey(0, 0), kMaxSequenceNumber), &args, &CountingCallback);
+  ASSERT_EQ(0, args.calls);
+  ASSERT_NO_FATALS(CheckSeek({}, SubKey(0, 0)));
+  ASSERT_LT(write_buffer_.memory_usage(), initial_usage + kIndexSize);
+
+  Insert(SubKey(0, 0), 1, false);
+  ASSERT_GE(write_buffer_.memory_usage(), initial_usage + kIndexSize);
+  rep_->Get(LookupKey(SubKey(0, 0), kMaxSequenceNumber), &args, &CountingCallback);
+  ASSERT_EQ(1, args.calls);
+  ASSERT_NO_FATALS(CheckSeek({SubKey(0, 0)}, DocumentKey(0)));
+}
+
+}  // namespace rocksdb
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -141,6 +141,10 @@ class InlineSkipList {
     // Advance to the first entry with a key >= target
     void Seek(const char* target);
 
+    // Position at the entry with the specified key.
+    // REQUIRES: key was returned by AllocateKey of this list and is already inserted.
+    void SeekToEntry(const char* key);
+
     // Position at the first entry in list.
     // Final state of iterator is Valid() iff list is not empty.
     void SeekToFirst();
@@ -335,6 +339,11 @@ inline void InlineSkipList<Comparator>::Iterator::Seek(const char* target) {
   node_ = list_->FindGreaterOrEqual(target);
 }
 
+template <class Comparator>
+inline void InlineSkipList<Comparator>::Iterator::SeekToEntry(const char* key) {
+  node_ = reinterpret_cast<Node*>(const_cast<char*>(key)) - 1;
+}
+
 template <class Comparator>
 inline void InlineSkipList<Comparator>::Iterator::SeekToFirst() {
   node_ = list_->head_->Next(0);
@@ -56,6 +56,8 @@ int main() {
 #include "yb/rocksdb/util/stop_watch.h"
 #include "yb/rocksdb/util/testutil.h"
 
+#include "yb/gutil/endian.h"
+
 using GFLAGS::ParseCommandLineFlags;
 using GFLAGS::RegisterFlagValidator;
 using GFLAGS::SetUsageMessage;
@@ -80,6 +82,7 @@ DEFINE_string(memtablerep, "skiplist",
               "\tvector              -- backed by an std::vector\n"
               "\thashskiplist        -- backed by a hash skip list\n"
               "\thashlinklist        -- backed by a hash linked list\n"
+              "\thashindexedskiplist -- backed by a skiplist with a hash index on key prefix\n"
               "\tcuckoo              -- backed by a cuckoo hash table");
 
 DEFINE_int64(bucket_count, 1000000,
@@ -140,6 +143,15 @@ DEFINE_int32(item_size, 100, "Number of bytes each item should be");
 DEFINE_int32(prefix_length, 8,
              "Prefix length to pass into NewFixedPrefixTransform");
 
+DEFINE_bool(docdb_key_shape, false,
+            "Generate keys shaped like DocDB records: 8 byte document key followed by 8 byte "
+            "subkey, so consecutive keys are subkeys of the same document. Reads look up the "
+            "first record of a document, like DocDB point reads by primary key. Use with "
+            "prefix_length=8 to index documents.");
+
+DEFINE_int32(subkeys_per_document, 8,
+             "Number of subkeys per document when docdb_key_shape is set");
+
 /* VectorRep settings */
 DEFINE_int64(vectorrep_count, 0,
              "Number of entries to reserve on VectorRep initialization");
@@ -185,6 +197,26 @@ class RandomGenerator {
 
 enum WriteMode { SEQUENTIAL, RANDOM, UNIQUE_RANDOM };
 
+size_t UserKeySize() {
+  return FLAGS_docdb_key_shape ? 16 : 8;
+}
+
+size_t InternalKeySize() {
+  return UserKeySize() + 8;
+}
+
+// Encodes user key for the specified key number. In DocDB key shape mode, big endian document key
+// is followed by the subkey, so keys of the same document are adjacent.
+char* EncodeUserKey(uint64_t key, char* p) {
+  if (FLAGS_docdb_key_shape) {
+    BigEndian::Store64(p, key / FLAGS_subkeys_per_document);
+    BigEndian::Store64(p + 8, key % FLAGS_subkeys_per_document);
+    return p + 16;
+  }
+  EncodeFixed64(p, key);
+  return p + 8;
+}
+
 class KeyGenerator {
  public:
   KeyGenerator(Random64* rand, WriteMode mode, uint64_t num)
@@ -263,15 +295,13 @@ class FillBenchmarkThread : public BenchmarkThread {
 
   void FillOne() {
     char* buf = nullptr;
-    auto internal_key_size = 16;
+    auto internal_key_size = InternalKeySize();
     auto encoded_len =
         FLAGS_item_size + VarintLength(internal_key_size) + internal_key_size;
     KeyHandle handle = table_->Allocate(encoded_len, &buf);
     assert(buf != nullptr);
-    char* p = EncodeVarint32(buf, internal_key_size);
-    auto key = key_gen_->Next();
-    EncodeFixed64(p, key);
-    p += 8;
+    char* p = EncodeVarint32(buf, static_cast<uint32_t>(internal_key_size));
+    p = EncodeUserKey(key_gen_->Next(), p);
     EncodeFixed64(p, ++(*sequence_));
     p += 8;
     Slice bytes = generator_.Generate(FLAGS_item_size);
@@ -326,20 +356,27 @@ class ReadBenchmarkThread : public BenchmarkThread {
     assert(callback_args != nullptr);
     uint32_t key_length;
     const char* key_ptr = GetVarint32Ptr(entry, entry + 5, &key_length);
-    if ((callback_args->comparator)
-            ->user_comparator()
-            ->Equal(Slice(key_ptr, key_length - 8),
-                    callback_args->key->user_key())) {
+    Slice user_key(key_ptr, key_length - 8);
+    if (FLAGS_docdb_key_shape) {
+      // Lookup key is the document key, so we are looking for the first record of the document.
+      callback_args->found = user_key.starts_with(callback_args->key->user_key());
+    } else if ((callback_args->comparator)
+                   ->user_comparator()
+                   ->Equal(user_key, callback_args->key->user_key())) {
       callback_args->found = true;
     }
     return false;
   }
 
   void ReadOne() {
-    std::string user_key;
+    char buf[16];
     auto key = key_gen_->Next();
-    PutFixed64(&user_key, key);
-    LookupKey lookup_key(user_key, *sequence_);
+    // In DocDB key shape mode only document key is used for lookup.
+    size_t user_key_size = EncodeUserKey(key, buf) - buf;
+    if (FLAGS_docdb_key_shape) {
+      user_key_size = 8;
+    }
+    LookupKey lookup_key(Slice(buf, user_key_size), *sequence_);
     InternalKeyComparator internal_key_comp(BytewiseComparator());
     CallbackVerifyArgs verify_args;
     verify_args.found = false;
@@ -348,7 +385,7 @@ class ReadBenchmarkThread : public BenchmarkThread {
     verify_args.comparator = &internal_key_comp;
     table_->Get(lookup_key, &verify_args, callback);
     if (verify_args.found) {
-      *bytes_read_ += VarintLength(16) + 16 + FLAGS_item_size;
+      *bytes_read_ += VarintLength(InternalKeySize()) + InternalKeySize() + FLAGS_item_size;
       ++*read_hits_;
     }
   }
@@ -372,7 +409,7 @@ class SeqReadBenchmarkThread : public BenchmarkThread {
     std::unique_ptr<MemTableRep::Iterator> iter(table_->GetIterator());
     for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
       // pretend to read the value
-      *bytes_read_ += VarintLength(16) + 16 + FLAGS_item_size;
+      *bytes_read_ += VarintLength(InternalKeySize()) + InternalKeySize() + FLAGS_item_size;
     }
     ++*read_hits_;
   }
@@ -615,6 +652,11 @@ int main(int argc, char** argv) {
         FLAGS_hashskiplist_branching_factor));
     options.prefix_extractor.reset(
         rocksdb::NewFixedPrefixTransform(FLAGS_prefix_length));
+  } else if (FLAGS_memtablerep == "hashindexedskiplist") {
+    factory.reset(new rocksdb::HashIndexedSkipListFactory(
+        std::shared_ptr<const rocksdb::SliceTransform>(
+            rocksdb::NewFixedPrefixTransform(FLAGS_prefix_length)),
+        FLAGS_bucket_count));
   } else if (FLAGS_memtablerep == "hashlinklist") {
     factory.reset(rocksdb::NewHashLinkListRepFactory(
         FLAGS_bucket_count, FLAGS_huge_page_tlb_size,
@@ -436,10 +436,13 @@ namespace {
 // encoded using EncodeFixed64.
 class LevelFileNumIterator : public InternalIterator {
  public:
+  // Files rejected by file_filter are skipped, as if they were not present in the level.
   LevelFileNumIterator(const InternalKeyComparator& icmp,
-                       const LevelFilesBrief* flevel)
+                       const LevelFilesBrief* flevel,
+                       const ReadFileFilter* file_filter = nullptr)
       : icmp_(icmp),
         flevel_(flevel),
+        file_filter_(file_filter),
         index_(static_cast<uint32_t>(flevel->num_files)),
         current_value_(0, 0, 0, 0) {  // Marks as invalid
   }
@@ -448,19 +451,25 @@ class LevelFileNumIterator : public InternalIterator {
 
   void Seek(const Slice& target) override {
     index_ = FindFile(icmp_, *flevel_, target);
+    SkipFilteredForward();
   }
 
-  void SeekToFirst() override { index_ = 0; }
+  void SeekToFirst() override {
+    index_ = 0;
+    SkipFilteredForward();
+  }
 
   void SeekToLast() override {
     index_ = (flevel_->num_files == 0)
                  ? 0
                  : static_cast<uint32_t>(flevel_->num_files) - 1;
+    SkipFilteredBackward();
   }
 
   void Next() override {
     assert(Valid());
     index_++;
+    SkipFilteredForward();
   }
 
   void Prev() override {
@@ -469,6 +478,7 @@ class LevelFileNumIterator : public InternalIterator {
       index_ = static_cast<uint32_t>(flevel_->num_files);  // Marks as invalid
     } else {
       index_--;
+      SkipFilteredBackward();
     }
   }
 
@@ -489,8 +499,29 @@ class LevelFileNumIterator : public InternalIterator {
   Status status() const override { return Status::OK(); }
 
  private:
+  bool Filtered(uint32_t index) const {
+    return file_filter_ && !file_filter_->Filter(flevel_->files[index]);
+  }
+
+  void SkipFilteredForward() {
+    while (Valid() && Filtered(index_)) {
+      index_++;
+    }
+  }
+
+  void SkipFilteredBackward() {
+    while (Valid() && Filtered(index_)) {
+      if (index_ == 0) {
+        index_ = static_cast<uint32_t>(flevel_->num_files);  // Marks as invalid
+        return;
+      }
+      index_--;
+    }
+  }
+
   const InternalKeyComparator icmp_;
   const LevelFilesBrief* flevel_;
+  const ReadFileFilter* file_filter_;
   uint32_t index_;
   mutable FileDescriptor current_value_;
 };
@@ -841,7 +872,8 @@ void Version::AddIterators(const ReadOptions& read_options,
                                  IsFilterSkipped(level));
       mem = arena->AllocateAligned(sizeof(LevelFileNumIterator));
       auto* first_level_iter = new (mem) LevelFileNumIterator(
-          *cfd_->internal_comparator(), &storage_info_.LevelFilesBrief(level));
+          *cfd_->internal_comparator(), &storage_info_.LevelFilesBrief(level),
+          read_options.file_filter.get());
       merge_iter_builder->AddIterator(NewTwoLevelIterator(state, first_level_iter, arena, false));
     }
   }
@@ -1257,6 +1289,14 @@ void VersionStorageInfo::ComputeCompactionScore(
       } else {
         score = static_cast<double>(num_sorted_runs) /
                 mutable_cf_options.level0_file_num_compaction_trigger;
+        if (compaction_style_ == kCompactionStyleLevel &&
+            mutable_cf_options.level0_universal_compaction) {
+          // Level-0 files are merged with each other, so their number stays small. Level-0 should
+          // be merged into the base level when its size exceeds the limit.
+          score = std::max(
+              score,
+              static_cast<double>(total_size) / mutable_cf_options.max_bytes_for_level_base);
+        }
       }
     } else {
       // Compute the ratio of current size to size limit.
@@ -2664,8 +2704,9 @@ Status VersionSet::Recover(
         // this should never happen since cf_in_builders is true
         assert(cfd != nullptr);
         if (edit.max_level_ >= cfd->current()->storage_info()->num_levels()) {
-          s = STATUS(InvalidArgument,
-              "db has more levels than options.num_levels");
+          s = STATUS_FORMAT(InvalidArgument,
+              "db has more levels than options.num_levels: file at level $0, num_levels $1",
+              edit.max_level_, cfd->current()->storage_info()->num_levels());
           break;
         }
 
@@ -2823,6 +2864,7 @@ Status VersionSet::Recover(
 
 Status VersionSet::Import(const std::string& source_dir,
                           SequenceNumber seqno,
+                          const UserFrontiers* file_frontiers,
                           VersionEdit* edit) {
   ManifestReader manifest_reader(env_, db_options_->get_checkpoint_env(), env_options_,
                                  db_options_->boundary_extractor.get(), source_dir);
@@ -2843,8 +2885,13 @@ Status VersionSet::Import(const std::string& source_dir,
     }
     for (const auto& file : current.GetNewFiles()) {
       auto filemeta = file.second;
-      filemeta.largest.user_frontier.reset();
-      filemeta.smallest.user_frontier.reset();
+      if (file_frontiers) {
+        filemeta.smallest.user_frontier = file_frontiers->Smallest().Clone();
+        filemeta.largest.user_frontier = file_frontiers->Largest().Clone();
+      } else {
+        filemeta.largest.user_frontier.reset();
+        filemeta.smallest.user_frontier.reset();
+      }
       filemeta.imported = true;
       if (filemeta.largest.seqno >= seqno) {
         return STATUS_FORMAT(InvalidArgument,
@@ -2921,6 +2968,29 @@ Status VersionSet::Import(const std::string& source_dir,
   return Status::OK();
 }
 
+Status VersionSet::GetMaxLevel(int* max_level,
+                               const std::string& dbname,
+                               BoundaryValuesExtractor* extractor,
+                               Env* env) {
+  ManifestReader manifest_reader(env, env, EnvOptions(), extractor, dbname);
+  auto status = manifest_reader.OpenManifest();
+  if (!status.ok()) {
+    return status;
+  }
+  *max_level = 0;
+  for (;;) {
+    status = manifest_reader.Next();
+    if (!status.ok()) {
+      break;
+    }
+    *max_level = std::max(*max_level, (*manifest_reader).max_level_);
+  }
+  if (!status.IsEndOfFile()) {
+    return status;
+  }
+  return Status::OK();
+}
+
 Status VersionSet::ListColumnFamilies(std::vector<std::string>* column_families,
                                       const std::string& dbname,
                                       BoundaryValuesExtractor* extractor,
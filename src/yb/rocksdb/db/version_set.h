@@ -633,6 +633,13 @@ class VersionSet {
                                    BoundaryValuesExtractor* extractor,
                                    Env* env);
 
+  // Reads a manifest file and returns in max_level the highest level that files were added to,
+  // i.e. the level count the DB should be opened with is at least max_level + 1.
+  static Status GetMaxLevel(int* max_level,
+                            const std::string& dbname,
+                            BoundaryValuesExtractor* extractor,
+                            Env* env);
+
 #ifndef ROCKSDB_LITE
   // Try to reduce the number of levels. This call is valid when
   // only one level from the new max level to the old
@@ -745,7 +752,10 @@ class VersionSet {
   ColumnFamilySet* GetColumnFamilySet() { return column_family_set_.get(); }
   const EnvOptions& env_options() { return env_options_; }
 
-  CHECKED_STATUS Import(const std::string& source_dir, SequenceNumber seqno, VersionEdit* edit);
+  CHECKED_STATUS Import(const std::string& source_dir,
+                        SequenceNumber seqno,
+                        const UserFrontiers* file_frontiers,
+                        VersionEdit* edit);
 
   void UnrefFile(ColumnFamilyData* cfd, FileMetaData* f);
 
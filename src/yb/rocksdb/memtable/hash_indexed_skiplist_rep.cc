@@ -0,0 +1,263 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <atomic>
+#include <mutex>
+
+#include "yb/rocksdb/db/inlineskiplist.h"
+#include "yb/rocksdb/db/memtable.h"
+#include "yb/rocksdb/memtablerep.h"
+#include "yb/rocksdb/slice_transform.h"
+#include "yb/rocksdb/util/arena.h"
+#include "yb/rocksdb/util/hash.h"
+
+namespace rocksdb {
+namespace {
+
+class HashIndexedSkipListRep : public MemTableRep {
+  typedef InlineSkipList<const MemTableRep::KeyComparator&> SkipList;
+
+ public:
+  HashIndexedSkipListRep(const MemTableRep::KeyComparator& compare,
+                         MemTableAllocator* allocator,
+                         const SliceTransform* key_prefix_extractor,
+                         size_t bucket_count,
+                         size_t lookahead)
+      : MemTableRep(allocator), skip_list_(compare, allocator), compare_(compare),
+        key_prefix_extractor_(key_prefix_extractor), bucket_count_(bucket_count),
+        lookahead_(lookahead) {
+  }
+
+  KeyHandle Allocate(const size_t len, char** buf) override {
+    *buf = skip_list_.AllocateKey(len);
+    return static_cast<KeyHandle>(*buf);
+  }
+
+  void Insert(KeyHandle handle) override {
+    skip_list_.Insert(static_cast<char*>(handle));
+    AddToIndex(static_cast<char*>(handle));
+  }
+
+  void InsertConcurrently(KeyHandle handle) override {
+    skip_list_.InsertConcurrently(static_cast<char*>(handle));
+    AddToIndex(static_cast<char*>(handle));
+  }
+
+  bool Contains(const char* key) const override {
+    return skip_list_.Contains(key);
+  }
+
+  size_t ApproximateMemoryUsage() override {
+    // All memory is allocated through allocator; nothing to report here
+    return 0;
+  }
+
+  void Get(const LookupKey& k, void* callback_args,
+           bool (*callback_func)(void* arg, const char* entry)) override {
+    SkipList::Iterator iter(&skip_list_);
+    const char* target = k.memtable_key().cdata();
+    auto user_key = k.user_key();
+    if (key_prefix_extractor_->InDomain(user_key)) {
+      const char* first = FindFirst(key_prefix_extractor_->Transform(user_key));
+      if (first == nullptr) {
+        // No entries have the same prefix, so there are no entries with the same user key.
+        return;
+      }
+      SeekFrom(first, target, &iter);
+    } else {
+      iter.Seek(target);
+    }
+    for (; iter.Valid() && callback_func(callback_args, iter.key()); iter.Next()) {
+    }
+  }
+
+  uint64_t ApproximateNumEntries(const Slice& start_ikey, const Slice& end_ikey) override {
+    std::string tmp;
+    uint64_t start_count = skip_list_.EstimateCount(EncodeKey(&tmp, start_ikey));
+    uint64_t end_count = skip_list_.EstimateCount(EncodeKey(&tmp, end_ikey));
+    return (end_count >= start_count) ? (end_count - start_count) : 0;
+  }
+
+  class Iterator : public MemTableRep::Iterator {
+   public:
+    explicit Iterator(const HashIndexedSkipListRep* rep) : rep_(rep), iter_(&rep->skip_list_) {}
+
+    bool Valid() const override {
+      return iter_.Valid();
+    }
+
+    const char* key() const override {
+      return iter_.key();
+    }
+
+    void Next() override {
+      iter_.Next();
+    }
+
+    void Prev() override {
+      iter_.Prev();
+    }
+
+    void Seek(const Slice& internal_key, const char* memtable_key) override {
+      rep_->Seek(memtable_key != nullptr ? memtable_key : EncodeKey(&tmp_, internal_key), &iter_);
+    }
+
+    void SeekToFirst() override {
+      iter_.SeekToFirst();
+    }
+
+    void SeekToLast() override {
+      iter_.SeekToLast();
+    }
+
+   private:
+    const HashIndexedSkipListRep* rep_;
+    SkipList::Iterator iter_;
+    std::string tmp_;       // For passing to EncodeKey
+  };
+
+  MemTableRep::Iterator* GetIterator(Arena* arena = nullptr) override {
+    void* mem = arena ? arena->AllocateAligned(sizeof(Iterator)) : operator new(sizeof(Iterator));
+    return new (mem) Iterator(this);
+  }
+
+ private:
+  struct IndexEntry {
+    // Points into the key of the entry that added this index entry. All entries with this prefix
+    // share these bytes, so it stays valid while the memtable is alive.
+    Slice prefix;
+    // Smallest entry with this prefix.
+    std::atomic<const char*> first_key;
+    // Immutable after the entry is published in the bucket.
+    IndexEntry* next;
+
+    IndexEntry(Slice prefix_, const char* key) : prefix(prefix_), first_key(key), next(nullptr) {}
+  };
+
+  // Buckets are allocated by the first insert, so memtables that are created but never written,
+  // like the active memtable of an idle tablet, don't hold the index.
+  std::atomic<IndexEntry*>* EnsureBuckets() {
+    std::call_once(buckets_allocated_, [this] {
+      auto* mem = allocator_->AllocateAligned(sizeof(std::atomic<IndexEntry*>) * bucket_count_);
+      auto* buckets = reinterpret_cast<std::atomic<IndexEntry*>*>(mem);
+      for (size_t i = 0; i != bucket_count_; ++i) {
+        new (&buckets[i]) std::atomic<IndexEntry*>(nullptr);
+      }
+      buckets_.store(buckets, std::memory_order_release);
+    });
+    return buckets_.load(std::memory_order_acquire);
+  }
+
+  std::atomic<IndexEntry*>& Bucket(std::atomic<IndexEntry*>* buckets, const Slice& prefix) const {
+    return buckets[GetSliceHash(prefix) % bucket_count_];
+  }
+
+  static IndexEntry* FindEntry(IndexEntry* entry, const Slice& prefix) {
+    while (entry != nullptr && entry->prefix != prefix) {
+      entry = entry->next;
+    }
+    return entry;
+  }
+
+  // Returns the smallest entry with the specified prefix, or nullptr if there is no such entry.
+  const char* FindFirst(const Slice& prefix) const {
+    auto* buckets = buckets_.load(std::memory_order_acquire);
+    if (buckets == nullptr) {
+      return nullptr;
+    }
+    auto* entry = FindEntry(Bucket(buckets, prefix).load(std::memory_order_acquire), prefix);
+    return entry ? entry->first_key.load(std::memory_order_acquire) : nullptr;
+  }
+
+  // Should be called after key is inserted into the skip list, so readers that found it in the
+  // index could navigate from it.
+  void AddToIndex(const char* key) {
+    auto user_key = UserKey(key);
+    if (!key_prefix_extractor_->InDomain(user_key)) {
+      return;
+    }
+    auto prefix = key_prefix_extractor_->Transform(user_key);
+    auto& bucket = Bucket(EnsureBuckets(), prefix);
+    IndexEntry* new_entry = nullptr;
+    IndexEntry* head = bucket.load(std::memory_order_acquire);
+    for (;;) {
+      auto* entry = FindEntry(head, prefix);
+      if (entry != nullptr) {
+        // When entry for this prefix was added concurrently, memory allocated for new_entry is
+        // wasted. It is rare and small, so we don't try to reuse it.
+        auto current = entry->first_key.load(std::memory_order_acquire);
+        while (compare_(key, current) < 0 &&
+               !entry->first_key.compare_exchange_weak(
+                   current, key, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        }
+        return;
+      }
+      if (new_entry == nullptr) {
+        new_entry = new (allocator_->AllocateAligned(sizeof(IndexEntry))) IndexEntry(prefix, key);
+      }
+      new_entry->next = head;
+      if (bucket.compare_exchange_weak(
+              head, new_entry, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return;
+      }
+    }
+  }
+
+  // Positions iter at the first entry >= target, starting from entry first, that is the smallest
+  // entry with the same prefix as target. Prefixes are bytewise prefixes of user keys, so when
+  // target is before first, first is the entry we are looking for.
+  void SeekFrom(const char* first, const char* target, SkipList::Iterator* iter) const {
+    iter->SeekToEntry(first);
+    for (size_t i = 0; i <= lookahead_; ++i) {
+      if (compare_(iter->key(), target) >= 0) {
+        return;
+      }
+      iter->Next();
+      if (!iter->Valid()) {
+        return;
+      }
+    }
+    iter->Seek(target);
+  }
+
+  void Seek(const char* target, SkipList::Iterator* iter) const {
+    auto user_key = UserKey(target);
+    if (key_prefix_extractor_->InDomain(user_key)) {
+      const char* first = FindFirst(key_prefix_extractor_->Transform(user_key));
+      if (first != nullptr) {
+        SeekFrom(first, target, iter);
+        return;
+      }
+    }
+    iter->Seek(target);
+  }
+
+  SkipList skip_list_;
+  const MemTableRep::KeyComparator& compare_;
+  const SliceTransform* const key_prefix_extractor_;
+  const size_t bucket_count_;
+  const size_t lookahead_;
+  std::once_flag buckets_allocated_;
+  std::atomic<std::atomic<IndexEntry*>*> buckets_{nullptr};
+};
+
+} // namespace
+
+MemTableRep* HashIndexedSkipListFactory::CreateMemTableRep(
+    const MemTableRep::KeyComparator& compare, MemTableAllocator* allocator,
+    const SliceTransform* transform, Logger* logger) {
+  return new HashIndexedSkipListRep(
+      compare, allocator, key_prefix_extractor_.get(), bucket_count_, lookahead_);
+}
+
+} // namespace rocksdb
@@ -268,6 +268,41 @@ class SkipListFactory : public MemTableRepFactory {
   const ConcurrentWrites concurrent_writes_;
 };
 
+// This uses a skip list with a hash index from key prefix to the smallest entry with this prefix.
+// Seeks to keys with an indexed prefix start from the entry found in the index instead of the skip
+// list head, and point lookups of absent prefixes don't touch the skip list at all.
+// Supports concurrent inserts.
+//
+// Parameters:
+//   key_prefix_extractor: extracts indexed prefixes from user keys, keys outside of its domain
+//     are not indexed. Prefix should be the same for all user keys starting with it, and user
+//     keys should be compared bytewise.
+//   bucket_count: number of hash index buckets allocated for each memtable. Buckets are
+//     allocated from the memtable arena by the first insert.
+//   lookahead: number of entries checked after the indexed entry, before falling back to the
+//     regular skip list seek.
+class HashIndexedSkipListFactory : public MemTableRepFactory {
+ public:
+  HashIndexedSkipListFactory(
+      std::shared_ptr<const SliceTransform> key_prefix_extractor, size_t bucket_count,
+      size_t lookahead = 16)
+      : key_prefix_extractor_(std::move(key_prefix_extractor)), bucket_count_(bucket_count),
+        lookahead_(lookahead) {}
+
+  MemTableRep* CreateMemTableRep(const MemTableRep::KeyComparator&,
+                                 MemTableAllocator*,
+                                 const SliceTransform*,
+                                 Logger* logger) override;
+  const char* Name() const override { return "HashIndexedSkipListFactory"; }
+
+  bool IsInsertConcurrentlySupported() const override { return true; }
+
+ private:
+  const std::shared_ptr<const SliceTransform> key_prefix_extractor_;
+  const size_t bucket_count_;
+  const size_t lookahead_;
+};
+
 class CDSSkipListFactory : public MemTableRepFactory {
  public:
   MemTableRep* CreateMemTableRep(const MemTableRep::KeyComparator&,
@@ -613,6 +613,15 @@ struct ColumnFamilyOptions {
   // Default: kCompactionPriByCompensatedSize
   CompactionPri compaction_pri;
 
+  // If true and compaction_style is kCompactionStyleLevel, level-0 files are merged with each
+  // other using universal compaction rules from compaction_options_universal, while total size
+  // of level-0 is below max_bytes_for_level_base. After that level-0 is merged into the base
+  // level as usual. So recent data is compacted size tiered, while older data lives in range
+  // partitioned levels, where size of each compaction is bounded by target file size.
+  //
+  // Default: false
+  bool level0_universal_compaction;
+
   // If true, compaction will verify checksum on every read that happens
   // as part of compaction
   //
@@ -1505,6 +1514,8 @@ struct ReadOptions {
   // files from being added to MergeIterator. By default doesn't filter files.
   std::shared_ptr<TableAwareReadFileFilter> table_aware_file_filter;
 
+  // Filter for pruning SST files of all levels based on their boundaries. Memtables are never
+  // filtered. By default doesn't filter files.
   std::shared_ptr<ReadFileFilter> file_filter;
 
   static const ReadOptions kDefault;
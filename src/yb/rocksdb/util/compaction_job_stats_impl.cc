@@ -33,6 +33,7 @@ void CompactionJobStats::Reset() {
 
   num_output_records = 0;
   num_output_files = 0;
+  num_subcompactions = 0;
 
   is_manual_compaction = 0;
 
@@ -64,6 +65,7 @@ void CompactionJobStats::Add(const CompactionJobStats& stats) {
 
   num_output_records += stats.num_output_records;
   num_output_files += stats.num_output_files;
+  num_subcompactions += stats.num_subcompactions;
 
   total_input_bytes += stats.total_input_bytes;
   total_output_bytes += stats.total_output_bytes;
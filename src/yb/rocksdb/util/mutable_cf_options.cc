@@ -107,6 +107,8 @@ void MutableCFOptions::Dump(Logger* log) const {
       level0_slowdown_writes_trigger);
   RLOG(log, "               level0_stop_writes_trigger: %d",
       level0_stop_writes_trigger);
+  RLOG(log, "              level0_universal_compaction: %d",
+      level0_universal_compaction);
   RLOG(log, "           max_grandparent_overlap_factor: %d",
       max_grandparent_overlap_factor);
   RLOG(log, "               expanded_compaction_factor: %d",
@@ -51,6 +51,7 @@ struct MutableCFOptions {
         level0_slowdown_writes_trigger(options.level0_slowdown_writes_trigger),
         level0_stop_writes_trigger(options.level0_stop_writes_trigger),
         compaction_pri(options.compaction_pri),
+        level0_universal_compaction(options.level0_universal_compaction),
         max_grandparent_overlap_factor(options.max_grandparent_overlap_factor),
         expanded_compaction_factor(options.expanded_compaction_factor),
         source_compaction_factor(options.source_compaction_factor),
@@ -87,6 +88,7 @@ struct MutableCFOptions {
         level0_slowdown_writes_trigger(0),
         level0_stop_writes_trigger(0),
         compaction_pri(kByCompensatedSize),
+        level0_universal_compaction(false),
         max_grandparent_overlap_factor(0),
         expanded_compaction_factor(0),
         source_compaction_factor(0),
@@ -139,6 +141,7 @@ struct MutableCFOptions {
   int level0_slowdown_writes_trigger;
   int level0_stop_writes_trigger;
   CompactionPri compaction_pri;
+  bool level0_universal_compaction;
   int max_grandparent_overlap_factor;
   int expanded_compaction_factor;
   int source_compaction_factor;
@@ -128,6 +128,7 @@ ColumnFamilyOptions::ColumnFamilyOptions()
       purge_redundant_kvs_while_flush(true),
       compaction_style(kCompactionStyleLevel),
       compaction_pri(kByCompensatedSize),
+      level0_universal_compaction(false),
       verify_checksums_in_compaction(true),
       filter_deletes(false),
       max_sequential_skip_in_iterations(8),
@@ -192,6 +193,7 @@ ColumnFamilyOptions::ColumnFamilyOptions(const Options& options)
       purge_redundant_kvs_while_flush(options.purge_redundant_kvs_while_flush),
       compaction_style(options.compaction_style),
       compaction_pri(options.compaction_pri),
+      level0_universal_compaction(options.level0_universal_compaction),
       verify_checksums_in_compaction(options.verify_checksums_in_compaction),
       compaction_options_universal(options.compaction_options_universal),
       compaction_options_fifo(options.compaction_options_fifo),
@@ -509,6 +511,8 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
       compaction_style);
   RHEADER(log, "                          Options.compaction_pri: %d",
       compaction_pri);
+  RHEADER(log, "             Options.level0_universal_compaction: %d",
+      level0_universal_compaction);
   RHEADER(log, " Options.compaction_options_universal.size_ratio: %u",
       compaction_options_universal.size_ratio);
   RHEADER(log, "Options.compaction_options_universal."
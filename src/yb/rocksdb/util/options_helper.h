@@ -379,6 +379,9 @@ static std::unordered_map<std::string, OptionTypeInfo> cf_options_type_info = {
      {offsetof(struct ColumnFamilyOptions,
                level_compaction_dynamic_level_bytes),
       OptionType::kBoolean, OptionVerificationType::kNormal}},
+    {"level0_universal_compaction",
+     {offsetof(struct ColumnFamilyOptions, level0_universal_compaction),
+      OptionType::kBoolean, OptionVerificationType::kNormal}},
     {"optimize_filters_for_hits",
      {offsetof(struct ColumnFamilyOptions, optimize_filters_for_hits),
       OptionType::kBoolean, OptionVerificationType::kNormal}},
@@ -71,7 +71,7 @@ namespace rpc {
 Acceptor::Acceptor(const scoped_refptr<MetricEntity>& metric_entity, NewSocketHandler handler)
     : handler_(std::move(handler)),
       rpc_connections_accepted_(METRIC_rpc_connections_accepted.Instantiate(metric_entity)),
-      loop_(kDefaultLibEvFlags) {
+      loop_(LibEvFlags()) {
 }
 
 Acceptor::~Acceptor() {
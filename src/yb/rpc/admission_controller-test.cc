@@ -0,0 +1,109 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/rpc/admission_controller.h"
+
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace rpc {
+
+class AdmissionControllerTest : public YBTest {
+ protected:
+  AdmissionControllerOptions Options() {
+    AdmissionControllerOptions result;
+    result.target = 10ms;
+    result.interval = 100ms;
+    result.max_backoff = 1s;
+    return result;
+  }
+};
+
+TEST_F(AdmissionControllerTest, OverloadDetection) {
+  AdmissionController controller(Options());
+  auto now = CoarseMonoClock::Now();
+
+  // The first interval starts with the first recorded sojourn time. Spike above target does not
+  // switch controller to overloaded state, while some calls are handled fast enough.
+  controller.RecordSojourn(20ms, now);
+  controller.RecordSojourn(5ms, now + 50ms);
+  controller.RecordSojourn(20ms, now + 90ms);
+  controller.RecordSojourn(20ms, now + 100ms);
+  ASSERT_FALSE(controller.overloaded());
+
+  // Sojourn time stays above target for the whole interval, but overload is detected only when
+  // the interval ends.
+  controller.RecordSojourn(30ms, now + 150ms);
+  ASSERT_FALSE(controller.overloaded());
+  controller.RecordSojourn(20ms, now + 200ms);
+  ASSERT_TRUE(controller.overloaded());
+  ASSERT_EQ(controller.BackoffHint(), 20ms);
+
+  // The last call is fast, but the state is changed only when the interval ends.
+  controller.RecordSojourn(1ms, now + 210ms);
+  ASSERT_TRUE(controller.overloaded());
+  ASSERT_EQ(controller.BackoffHint(), 10ms);
+
+  // Queue drained.
+  controller.RecordSojourn(15ms, now + 300ms);
+  ASSERT_FALSE(controller.overloaded());
+  ASSERT_EQ(controller.BackoffHint(), 15ms);
+}
+
+TEST_F(AdmissionControllerTest, FairShare) {
+  AdmissionController controller(Options());
+  const size_t kHeavyBucket = 1;
+  const size_t kLightBucket = 2;
+
+  for (int i = 0; i != 90; ++i) {
+    controller.CallQueued(kHeavyBucket);
+  }
+  for (int i = 0; i != 10; ++i) {
+    controller.CallQueued(kLightBucket);
+  }
+  ASSERT_EQ(controller.active_buckets(), 2);
+
+  // Nothing is rejected while queue is draining fast enough.
+  ASSERT_FALSE(controller.ShouldReject(kHeavyBucket));
+  ASSERT_FALSE(controller.ShouldReject(kLightBucket));
+
+  auto now = CoarseMonoClock::Now();
+  controller.RecordSojourn(50ms, now);
+  controller.RecordSojourn(50ms, now + 200ms);
+  ASSERT_TRUE(controller.overloaded());
+
+  ASSERT_TRUE(controller.ShouldReject(kHeavyBucket));
+  ASSERT_FALSE(controller.ShouldReject(kLightBucket));
+  ASSERT_EQ(controller.BackoffHint(), 50ms);
+
+  // Single active client is not rejected, since there is nobody to be fair to.
+  for (int i = 0; i != 10; ++i) {
+    controller.CallDequeued(kLightBucket);
+  }
+  ASSERT_EQ(controller.active_buckets(), 1);
+  ASSERT_FALSE(controller.ShouldReject(kHeavyBucket));
+
+  for (int i = 0; i != 90; ++i) {
+    controller.CallDequeued(kHeavyBucket);
+  }
+  ASSERT_EQ(controller.active_buckets(), 0);
+}
+
+} // namespace rpc
+} // namespace yb
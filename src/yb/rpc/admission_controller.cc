@@ -0,0 +1,110 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+
+#include "yb/rpc/admission_controller.h"
+
+#include <algorithm>
+
+#include <glog/logging.h>
+
+namespace yb {
+namespace rpc {
+
+AdmissionController::AdmissionController(const AdmissionControllerOptions& options)
+    : options_(options) {
+  for (auto& counter : queued_calls_) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+}
+
+size_t AdmissionController::BucketFor(size_t client_hash) {
+  return client_hash % kNumBuckets;
+}
+
+void AdmissionController::CallQueued(size_t bucket) {
+  total_queued_calls_.fetch_add(1, std::memory_order_acq_rel);
+  if (queued_calls_[bucket].fetch_add(1, std::memory_order_acq_rel) == 0) {
+    active_buckets_.fetch_add(1, std::memory_order_acq_rel);
+  }
+}
+
+void AdmissionController::CallDequeued(size_t bucket) {
+  total_queued_calls_.fetch_sub(1, std::memory_order_acq_rel);
+  auto queued_calls = queued_calls_[bucket].fetch_sub(1, std::memory_order_acq_rel);
+  if (queued_calls == 1) {
+    active_buckets_.fetch_sub(1, std::memory_order_acq_rel);
+  } else {
+    LOG_IF(DFATAL, queued_calls <= 0)
+        << "Negative number of queued calls in bucket " << bucket << ": " << queued_calls - 1;
+  }
+}
+
+void AdmissionController::RecordSojourn(CoarseDuration sojourn, CoarseTimePoint now) {
+  // Avoid writing shared state when nothing changed, this method is invoked for each call.
+  if (last_sojourn_.load(std::memory_order_relaxed) != sojourn) {
+    last_sojourn_.store(sojourn, std::memory_order_relaxed);
+  }
+
+  const auto now_since_epoch = now.time_since_epoch();
+  auto interval_end = interval_end_.load(std::memory_order_acquire);
+  if (now_since_epoch >= interval_end &&
+      interval_end_.compare_exchange_strong(
+          interval_end, now_since_epoch + options_.interval, std::memory_order_acq_rel)) {
+    // This call finishes the interval and starts the next one.
+    auto interval_min = std::min(
+        interval_min_sojourn_.exchange(sojourn, std::memory_order_acq_rel), sojourn);
+    // Nothing was observed before the first interval.
+    if (interval_end == CoarseDuration::zero()) {
+      return;
+    }
+    bool overloaded = interval_min >= options_.target;
+    if (overloaded_.load(std::memory_order_relaxed) != overloaded) {
+      overloaded_.store(overloaded, std::memory_order_release);
+    }
+    return;
+  }
+
+  auto interval_min = interval_min_sojourn_.load(std::memory_order_acquire);
+  while (sojourn < interval_min &&
+         !interval_min_sojourn_.compare_exchange_weak(
+             interval_min, sojourn, std::memory_order_acq_rel)) {
+  }
+}
+
+bool AdmissionController::ShouldReject(size_t bucket) const {
+  if (!overloaded()) {
+    return false;
+  }
+
+  // When there is only one active client there is nobody to be fair to, so overload is handled by
+  // regular queue limits.
+  auto active_buckets = active_buckets_.load(std::memory_order_acquire);
+  if (active_buckets < 2) {
+    return false;
+  }
+
+  auto fair_share = total_queued_calls_.load(std::memory_order_acquire) / active_buckets;
+  return queued_calls_[bucket].load(std::memory_order_acquire) > fair_share;
+}
+
+CoarseDuration AdmissionController::BackoffHint() const {
+  // Queue needs approximately the current sojourn time to drain, so there is no sense to retry
+  // earlier.
+  auto result = std::max(last_sojourn_.load(std::memory_order_relaxed), options_.target);
+  return std::min(result, options_.max_backoff);
+}
+
+} // namespace rpc
+} // namespace yb
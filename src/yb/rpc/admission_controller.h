@@ -0,0 +1,112 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+
+#ifndef YB_RPC_ADMISSION_CONTROLLER_H
+#define YB_RPC_ADMISSION_CONTROLLER_H
+
+#include <array>
+#include <atomic>
+
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace rpc {
+
+struct AdmissionControllerOptions {
+  // Calls are considered to be standing in the queue when their sojourn time exceeds target.
+  CoarseDuration target;
+
+  // Overload is detected when sojourn time stays above target for at least interval.
+  CoarseDuration interval;
+
+  // Upper bound for backoff hint sent to rejected clients.
+  CoarseDuration max_backoff;
+};
+
+// CoDel-style admission controller for service queue.
+//
+// Controller watches sojourn time of calls, i.e. time from receiving call till start of its
+// handling. At the end of each interval it checks the minimal sojourn time seen during the
+// interval. When it is above target, even the fastest call had to wait, i.e. queue does not drain
+// anymore, and controller switches to overloaded state until an interval with minimal sojourn time
+// below target.
+//
+// Fairness is provided using stochastic fair queuing: clients are hashed into fixed
+// number of buckets, and number of queued calls is tracked per bucket. While overloaded, calls from
+// buckets that occupy more than fair share of the queue are rejected early, with backoff hint,
+// so light clients are not starved by heavy one.
+//
+// All methods are lock free and could be invoked concurrently.
+class AdmissionController {
+ public:
+  static constexpr size_t kNumBuckets = 64;
+
+  explicit AdmissionController(const AdmissionControllerOptions& options);
+
+  // Returns bucket that should be used for the client with specified hash.
+  static size_t BucketFor(size_t client_hash);
+
+  // Should be invoked when call from specified bucket is added to the queue.
+  void CallQueued(size_t bucket);
+
+  // Should be invoked when call from specified bucket leaves the queue, i.e. it is handled,
+  // rejected or timed out.
+  void CallDequeued(size_t bucket);
+
+  // Records sojourn time of call that is about to be handled.
+  void RecordSojourn(CoarseDuration sojourn, CoarseTimePoint now = CoarseMonoClock::Now());
+
+  // Returns true when call from specified bucket should be rejected before queueing.
+  bool ShouldReject(size_t bucket) const;
+
+  // Returns delay the rejected client should wait before retry.
+  CoarseDuration BackoffHint() const;
+
+  bool overloaded() const {
+    return overloaded_.load(std::memory_order_acquire);
+  }
+
+  int64_t active_buckets() const {
+    return active_buckets_.load(std::memory_order_acquire);
+  }
+
+ private:
+  const AdmissionControllerOptions options_;
+
+  // Number of queued calls per bucket.
+  std::array<std::atomic<int64_t>, kNumBuckets> queued_calls_;
+
+  // Total number of queued calls.
+  std::atomic<int64_t> total_queued_calls_{0};
+
+  // Number of buckets that have queued calls.
+  std::atomic<int64_t> active_buckets_{0};
+
+  // End of the current interval. Zero means that no sojourn time was recorded yet.
+  std::atomic<CoarseDuration> interval_end_{CoarseDuration::zero()};
+
+  // Minimal sojourn time recorded during the current interval.
+  std::atomic<CoarseDuration> interval_min_sojourn_{CoarseDuration::max()};
+
+  // Last recorded sojourn time, used as backoff hint.
+  std::atomic<CoarseDuration> last_sojourn_{CoarseDuration::zero()};
+
+  std::atomic<bool> overloaded_{false};
+};
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_ADMISSION_CONTROLLER_H
@@ -47,6 +47,7 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/metrics.h"
+#include "yb/util/net/sockaddr.h"
 #include "yb/util/trace.h"
 #include "yb/util/memory/memory.h"
 
@@ -120,6 +121,10 @@ const Endpoint& InboundCall::local_address() const {
   return conn_->local();
 }
 
+size_t InboundCall::client_hash() const {
+  return hash_value(remote_address());
+}
+
 ConnectionPtr InboundCall::connection() const {
   return conn_;
 }
@@ -90,9 +90,9 @@ class InboundCallHandler {
 
   virtual void Failure(const InboundCallPtr& call, const Status& status) = 0;
 
-  virtual bool CallQueued() = 0;
+  virtual bool CallQueued(const InboundCall& call) = 0;
 
-  virtual void CallDequeued() = 0;
+  virtual void CallDequeued(const InboundCall& call) = 0;
 
  protected:
   ~InboundCallHandler() = default;
@@ -115,6 +115,10 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
   virtual const Endpoint& remote_address() const;
   virtual const Endpoint& local_address() const;
 
+  // Hash that identifies the client of this call, so load from different clients could be told
+  // apart. Calls received through the network are identified by remote address.
+  virtual size_t client_hash() const;
+
   ConnectionPtr connection() const;
   ConnectionContext& connection_context() const;
 
@@ -153,7 +157,7 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
 
   ThreadPoolTask* BindTask(InboundCallHandler* handler) {
     auto shared_this = shared_from(this);
-    if (!handler->CallQueued()) {
+    if (!handler->CallQueued(*this)) {
       return nullptr;
     }
     tracker_ = handler;
@@ -165,6 +169,12 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
   virtual const std::string& service_name() const = 0;
   virtual void RespondFailure(ErrorStatusPB::RpcErrorCodePB error_code, const Status& status) = 0;
 
+  // Responds with ERROR_SERVER_TOO_BUSY. retry_after is a hint for the client about how long it
+  // should wait before retrying, it is ignored by protocols that cannot transfer it.
+  virtual void RespondServerTooBusy(const Status& status, MonoDelta retry_after) {
+    RespondFailure(ErrorStatusPB::ERROR_SERVER_TOO_BUSY, status);
+  }
+
   // Do appropriate actions when call is timed out.
   //
   // message contains human readable information on why call timed out.
@@ -178,7 +188,7 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
       return false;
     }
     if (tracker_) {
-      tracker_->CallDequeued();
+      tracker_->CallDequeued(*this);
     }
     return true;
   }
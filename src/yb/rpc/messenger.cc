@@ -58,6 +58,7 @@
 #include "yb/rpc/rpc_header.pb.h"
 #include "yb/rpc/rpc_metrics.h"
 #include "yb/rpc/rpc_service.h"
+#include "yb/rpc/shared_exchange.h"
 #include "yb/rpc/tcp_stream.h"
 #include "yb/rpc/yb_rpc.h"
 
@@ -172,6 +173,9 @@ MessengerBuilder &MessengerBuilder::UseDefaultConnectionContextFactory(
 // ------------------------------------------------------------------------------------------------
 
 void Messenger::Shutdown() {
+  if (shared_exchange_client_) {
+    shared_exchange_client_->Shutdown();
+  }
   ShutdownThreadPools();
   ShutdownAcceptor();
   UnregisterAllServices();
@@ -471,7 +475,15 @@ class NotifyDisconnectedReactorTask : public ReactorTask {
   OutboundCallPtr call_;
 };
 
+void Messenger::SetSharedExchangeClient(std::unique_ptr<SharedExchangeClient> client) {
+  shared_exchange_client_ = std::move(client);
+}
+
 void Messenger::QueueOutboundCall(OutboundCallPtr call) {
+  if (shared_exchange_client_ && shared_exchange_client_->TrySend(call)) {
+    return;
+  }
+
   const auto& remote = call->conn_id().remote();
   Reactor *reactor = RemoteToReactor(remote, call->conn_id().idx());
 
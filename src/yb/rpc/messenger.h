@@ -216,6 +216,10 @@ class Messenger : public ProxyContext {
   // that reactor to assign and send the call.
   void QueueOutboundCall(OutboundCallPtr call) override;
 
+  // Send calls to the server that owns this shared exchange through shared memory instead of TCP.
+  // Should be invoked before any call is sent through this messenger.
+  void SetSharedExchangeClient(std::unique_ptr<SharedExchangeClient> client);
+
   // Enqueue a call for processing on the server.
   void QueueInboundCall(InboundCallPtr call) override;
 
@@ -372,6 +376,8 @@ class Messenger : public ProxyContext {
 
   std::unique_ptr<RpcMetrics> rpc_metrics_;
 
+  std::unique_ptr<SharedExchangeClient> shared_exchange_client_;
+
   // Use this IP address as base address for outbound connections from messenger.
   IpAddress test_outbound_ip_base_;
 
@@ -293,6 +293,9 @@ class OutboundCall : public RpcCall {
   const RpcController* controller() const { return controller_; }
   google::protobuf::Message* response() const { return response_; }
 
+  // Serialized request, including length prefix. Empty after Serialize() is called.
+  const RefCntBuffer& request_buffer() const { return buffer_; }
+
   int32_t call_id() const {
     return call_id_;
   }
@@ -70,6 +70,12 @@
 
 using namespace std::literals;
 
+DEFINE_string(rpc_reactor_backend, "auto",
+              "Event loop backend used by rpc reactors: auto, epoll, poll, select, kqueue, linuxaio "
+              "or io_uring. linuxaio and io_uring are available only when supported by libev. "
+              "auto lets libev pick the best available backend.");
+TAG_FLAG(rpc_reactor_backend, advanced);
+
 DECLARE_string(local_ip_for_outbound_sockets);
 DECLARE_int32(num_connections_to_server);
 DECLARE_int32(socket_receive_buffer_size);
@@ -107,12 +113,57 @@ void DoInitLibEv() {
   ev::set_syserr_cb(LibevSysErr);
 }
 
+// Returns libev backend with specified name, or 0 if it is not supported.
+unsigned int LibEvBackend(const std::string& name) {
+  if (name == "epoll") {
+    return EVBACKEND_EPOLL;
+  }
+  if (name == "poll") {
+    return EVBACKEND_POLL;
+  }
+  if (name == "select") {
+    return EVBACKEND_SELECT;
+  }
+  if (name == "kqueue") {
+    return EVBACKEND_KQUEUE;
+  }
+#ifdef EVBACKEND_LINUXAIO
+  if (name == "linuxaio") {
+    return EVBACKEND_LINUXAIO;
+  }
+#endif
+#ifdef EVBACKEND_IOURING
+  if (name == "io_uring") {
+    return EVBACKEND_IOURING;
+  }
+#endif
+  return 0;
+}
+
 bool HasReactorStartedClosing(ReactorState state) {
   return state == ReactorState::kClosing || state == ReactorState::kClosed;
 }
 
 } // anonymous namespace
 
+unsigned int LibEvFlags() {
+  const std::string& name = FLAGS_rpc_reactor_backend;
+  if (name == "auto") {
+    return kDefaultLibEvFlags;
+  }
+  auto backend = LibEvBackend(name);
+  if (backend == 0) {
+    LOG(WARNING) << "Unknown rpc reactor backend " << name << ", using default one";
+    return kDefaultLibEvFlags;
+  }
+  if ((ev::supported_backends() & backend) == 0) {
+    LOG(WARNING) << "Rpc reactor backend " << name << " is not supported, using default one";
+    return kDefaultLibEvFlags;
+  }
+  // EVFLAG_NOENV prevents LIBEV_FLAGS env variable from overriding explicitly selected backend.
+  return backend | EVFLAG_NOENV;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Reactor class members
 // ------------------------------------------------------------------------------------------------
@@ -123,7 +174,7 @@ Reactor::Reactor(Messenger* messenger,
     : messenger_(messenger),
       name_(StringPrintf("%s_R%03d", messenger->name().c_str(), index)),
       log_prefix_(name_ + ": "),
-      loop_(kDefaultLibEvFlags),
+      loop_(LibEvFlags()),
       cur_time_(CoarseMonoClock::Now()),
       last_unused_tcp_scan_(cur_time_),
       connection_keepalive_time_(bld.connection_keepalive_time()),
@@ -568,7 +619,7 @@ Status Reactor::FindOrStartConnection(const ConnectionId &conn_id,
   auto stream = VERIFY_RESULT(CreateStream(
       messenger_->stream_factories_, conn_id.protocol(),
       {conn_id.remote(), hostname, &sock,
-       messenger_->connection_context_factory_->buffer_tracker()}));
+       messenger_->connection_context_factory_->buffer_tracker(), &messenger_->rpc_metrics()}));
 
   // Register the new connection in our map.
   auto connection = std::make_shared<Connection>(
@@ -865,7 +916,7 @@ void Reactor::RegisterInboundSocket(
 
   auto stream = CreateStream(
       messenger_->stream_factories_, messenger_->listen_protocol_,
-      {remote, std::string(), socket, mem_tracker});
+      {remote, std::string(), socket, mem_tracker, &messenger_->rpc_metrics()});
   if (!stream.ok()) {
     LOG_WITH_PREFIX(DFATAL) << "Failed to create stream for " << remote << ": " << stream.status();
     return;
@@ -68,6 +68,9 @@ constexpr unsigned int kDefaultLibEvFlags = ev::KQUEUE;
 constexpr unsigned int kDefaultLibEvFlags = ev::AUTO;
 #endif
 
+// Returns libev flags for event loops, according to rpc_reactor_backend flag.
+unsigned int LibEvFlags();
+
 typedef std::list<ConnectionPtr> ConnectionList;
 
 class DumpRunningRpcsRequestPB;
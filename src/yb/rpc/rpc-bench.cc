@@ -36,12 +36,16 @@
 #include <gtest/gtest.h>
 
 #include "yb/rpc/rpc-test-base.h"
+#include "yb/rpc/rpc_metrics.h"
 #include "yb/rpc/rtest.proxy.h"
 #include "yb/util/countdown_latch.h"
 #include "yb/util/test_util.h"
 
 using namespace std::literals; // NOLINT
 
+DECLARE_int32(rpc_thread_pool_groups);
+DECLARE_string(rpc_reactor_backend);
+
 using std::string;
 using std::shared_ptr;
 
@@ -55,6 +59,8 @@ class RpcBench : public RpcTestBase {
  protected:
   friend class ClientThread;
 
+  void RunBenchmark(const TestServerOptions& options);
+
   HostPort server_hostport_;
   std::atomic<bool> should_run_{true};
 };
@@ -100,13 +106,9 @@ class ClientThread {
 };
 
 
-// Test making successful RPC calls.
-TEST_F(RpcBench, BenchmarkCalls) {
-  TestServerOptions options;
-  options.n_worker_threads = 1;
-
+void RpcBench::RunBenchmark(const TestServerOptions& options) {
   // Set up server.
-  StartTestServerWithGeneratedCode(&server_hostport_);
+  StartTestServerWithGeneratedCode(&server_hostport_, options);
 
   // Set up client.
   LOG(INFO) << "Connecting to " << server_hostport_;
@@ -147,6 +149,35 @@ TEST_F(RpcBench, BenchmarkCalls) {
   LOG(INFO) << "Reqs/sec:         " << reqs_per_second;
   LOG(INFO) << "User CPU per req: " << user_cpu_micros_per_req << "us";
   LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
+
+  // Client and server messengers share the same metric entity, so syscalls of both sides are
+  // counted.
+  auto& rpc_metrics = server_messenger()->rpc_metrics();
+  LOG(INFO) << "Reactor backend:  " << FLAGS_rpc_reactor_backend;
+  LOG(INFO) << "Recv syscalls per req: "
+            << static_cast<double>(rpc_metrics.tcp_receive_syscalls->value()) / total_reqs;
+  LOG(INFO) << "Send syscalls per req: "
+            << static_cast<double>(rpc_metrics.tcp_send_syscalls->value()) / total_reqs;
+}
+
+// Test making successful RPC calls.
+TEST_F(RpcBench, BenchmarkCalls) {
+  RunBenchmark(TestServerOptions());
+}
+
+TEST_F(RpcBench, BenchmarkCallsPollBackend) {
+  FLAGS_rpc_reactor_backend = "poll";
+  RunBenchmark(TestServerOptions());
+}
+
+// Small calls with many workers, split into groups with work stealing.
+TEST_F(RpcBench, BenchmarkCallsWithWorkerGroups) {
+  const size_t kNumCpus = std::max(std::thread::hardware_concurrency(), 1U);
+  FLAGS_rpc_thread_pool_groups = 4;
+  TestServerOptions options;
+  options.n_worker_threads = kNumCpus;
+  options.messenger_options.n_reactors = 4;
+  RunBenchmark(options);
 }
 
 } // namespace rpc
@@ -45,9 +45,11 @@
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/strings/join.h"
 #include "yb/rpc/serialization.h"
+#include "yb/rpc/shared_exchange.h"
 #include "yb/rpc/yb_rpc.h"
 #include "yb/util/countdown_latch.h"
 #include "yb/util/env.h"
+#include "yb/util/shared_mem.h"
 #include "yb/util/test_util.h"
 
 METRIC_DECLARE_histogram(handler_latency_yb_rpc_test_CalculatorService_Sleep);
@@ -59,6 +61,8 @@ DEFINE_int32(rpc_test_connection_keepalive_num_iterations, 1,
 DECLARE_uint64(rpc_connection_timeout_ms);
 DECLARE_int32(num_connections_to_server);
 DECLARE_bool(enable_rpc_keepalive);
+DECLARE_int32(shared_exchange_num_slots);
+DECLARE_int32(shared_exchange_slot_size);
 
 using namespace std::chrono_literals;
 using std::string;
@@ -390,6 +394,68 @@ TEST_F(TestRpc, TestRpcSidecar) {
   DoTestSidecar(&p, sizes);
 }
 
+// Test calls sent through shared memory exchange instead of TCP.
+TEST_F(TestRpc, SharedExchange) {
+  FLAGS_shared_exchange_num_slots = 4;
+  FLAGS_shared_exchange_slot_size = 4_KB;
+
+  HostPort server_addr;
+  StartTestServer(&server_addr);
+  auto exchange_server = ASSERT_RESULT(SharedExchangeServer::Create());
+  ASSERT_OK(exchange_server->Start(server_messenger(), {server().bound_endpoint()}));
+
+  auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
+  // Client takes ownership of the file descriptor.
+  auto exchange_client = ASSERT_RESULT(SharedExchangeClient::Open(dup(exchange_server->GetFd())));
+  auto* exchange_client_ptr = exchange_client.get();
+  client_messenger->SetSharedExchangeClient(std::move(exchange_client));
+  Proxy p(client_messenger.get(), server_addr);
+
+  ASSERT_OK(DoTestSyncCall(&p, CalculatorServiceMethods::AddMethod()));
+  DoTestSidecar(&p, {123, 456});
+  // Response that does not fit into slot is transferred in chunks.
+  DoTestSidecar(&p, {3_KB, 10_KB, 100_KB});
+  ASSERT_EQ(3, exchange_client_ptr->TEST_num_sent_calls());
+
+  // Request that does not fit into slot is sent over TCP.
+  rpc_test::EchoRequestPB req;
+  req.set_data(std::string(8_KB, 'X'));
+  rpc_test::EchoResponsePB resp;
+  RpcController controller;
+  controller.set_timeout(10s);
+  ASSERT_OK(p.SyncRequest(CalculatorServiceMethods::EchoMethod(), req, &resp, &controller));
+  ASSERT_EQ(req.data(), resp.data());
+  ASSERT_EQ(3, exchange_client_ptr->TEST_num_sent_calls());
+
+  // Concurrent calls exceeding number of slots.
+  std::vector<std::thread> threads;
+  for (int i = 0; i != 8; ++i) {
+    threads.emplace_back([this, &p] {
+      for (int j = 0; j != 100; ++j) {
+        ASSERT_OK(DoTestSyncCall(&p, CalculatorServiceMethods::AddMethod()));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_GT(exchange_client_ptr->TEST_num_sent_calls(), 3);
+
+  // Any process that mapped the segment could overwrite its header, the server keeps using its own
+  // copy of the number of slots and slot size.
+  {
+    auto segment = ASSERT_RESULT(SharedMemorySegment::Open(
+        dup(exchange_server->GetFd()), SharedMemorySegment::kReadWrite, 2 * sizeof(uint32_t)));
+    auto* geometry = static_cast<uint32_t*>(segment.GetAddress());
+    geometry[0] = std::numeric_limits<uint32_t>::max();
+    geometry[1] = std::numeric_limits<uint32_t>::max();
+  }
+  ASSERT_OK(DoTestSyncCall(&p, CalculatorServiceMethods::AddMethod()));
+  DoTestSidecar(&p, {3_KB, 10_KB});
+
+  exchange_server->Shutdown();
+}
+
 // Test that timeouts are properly handled.
 TEST_F(TestRpc, TestCallTimeout) {
   HostPort server_addr;
@@ -98,7 +98,11 @@ bool RpcRetrier::HandleResponse(
     if (err &&
         err->has_code() &&
         err->code() == ErrorStatusPB::ERROR_SERVER_TOO_BUSY) {
-      auto status = DelayedRetry(rpc, controller_status, BackoffStrategy::kExponential);
+      // Server could provide hint about when it expects to be able to handle the call.
+      auto min_delay = err->has_retry_after_ms()
+          ? MonoDelta::FromMilliseconds(err->retry_after_ms()) : MonoDelta();
+      auto status = DelayedRetry(
+          rpc, controller_status, BackoffStrategy::kExponential, min_delay);
       if (!status.ok()) {
         *out_status = status;
         return false;
@@ -112,7 +116,7 @@ bool RpcRetrier::HandleResponse(
 }
 
 Status RpcRetrier::DelayedRetry(
-    RpcCommand* rpc, const Status& why_status, BackoffStrategy strategy) {
+    RpcCommand* rpc, const Status& why_status, BackoffStrategy strategy, MonoDelta min_delay) {
   if (!why_status.ok() && (last_error_.ok() || last_error_.IsTimedOut())) {
     last_error_ = why_status;
   }
@@ -127,6 +131,10 @@ Status RpcRetrier::DelayedRetry(
                  FLAGS_min_backoff_ms_exponent + attempt_num_, FLAGS_max_backoff_ms_exponent)
            : attempt_num_) +
       RandomUniformInt(0, 4);
+  if (min_delay) {
+    num_ms = std::max(
+        num_ms, static_cast<int>(min_delay.ToMilliseconds()) + RandomUniformInt(0, 4));
+  }
   attempt_num_++;
 
   RpcRetrierState expected_state = RpcRetrierState::kIdle;
@@ -111,10 +111,13 @@ class RpcRetrier {
   // error when the RPC comes up for retrying. This is true even if the
   // deadline has already expired at the time that Retry() was called.
   //
+  // Retry is never scheduled earlier than min_delay, if it is specified.
+  //
   // Callers should ensure that 'rpc' remains alive.
   CHECKED_STATUS DelayedRetry(
       RpcCommand* rpc, const Status& why_status,
-      BackoffStrategy strategy = BackoffStrategy::kLinear);
+      BackoffStrategy strategy = BackoffStrategy::kLinear,
+      MonoDelta min_delay = MonoDelta());
 
   RpcController* mutable_controller() { return &controller_; }
   const RpcController& controller() const { return controller_; }
@@ -62,6 +62,8 @@ class Protocol;
 class Scheduler;
 class SecureContext;
 class ServicePoolImpl;
+class SharedExchangeClient;
+class SharedExchangeServer;
 class Stream;
 class StreamReadBuffer;
 class ThreadPool;
@@ -43,6 +43,16 @@ METRIC_DEFINE_counter(server, rpc_outbound_calls_created,
                       yb::MetricUnit::kRequests,
                       "Number of created RPC outbound calls.");
 
+METRIC_DEFINE_counter(server, rpc_tcp_receive_syscalls,
+                      "Number of receive syscalls issued by RPC TCP streams.",
+                      yb::MetricUnit::kOperations,
+                      "Number of receive syscalls issued by RPC TCP streams.");
+
+METRIC_DEFINE_counter(server, rpc_tcp_send_syscalls,
+                      "Number of send syscalls issued by RPC TCP streams.",
+                      yb::MetricUnit::kOperations,
+                      "Number of send syscalls issued by RPC TCP streams.");
+
 namespace yb {
 namespace rpc {
 
@@ -54,6 +64,8 @@ RpcMetrics::RpcMetrics(const scoped_refptr<MetricEntity>& metric_entity) {
     inbound_calls_created = METRIC_rpc_inbound_calls_created.Instantiate(metric_entity);
     outbound_calls_alive = METRIC_rpc_outbound_calls_alive.Instantiate(metric_entity, 0);
     outbound_calls_created = METRIC_rpc_outbound_calls_created.Instantiate(metric_entity);
+    tcp_receive_syscalls = METRIC_rpc_tcp_receive_syscalls.Instantiate(metric_entity);
+    tcp_send_syscalls = METRIC_rpc_tcp_send_syscalls.Instantiate(metric_entity);
   }
 }
 
@@ -28,6 +28,8 @@ struct RpcMetrics {
   scoped_refptr<Counter> inbound_calls_created;
   scoped_refptr<AtomicGauge<int64_t>> outbound_calls_alive;
   scoped_refptr<Counter> outbound_calls_created;
+  scoped_refptr<Counter> tcp_receive_syscalls;
+  scoped_refptr<Counter> tcp_send_syscalls;
 };
 
 } // namespace rpc
@@ -44,6 +44,7 @@
 #include "yb/gutil/gscoped_ptr.h"
 #include "yb/gutil/ref_counted.h"
 
+#include "yb/rpc/admission_controller.h"
 #include "yb/rpc/inbound_call.h"
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/scheduler.h"
@@ -73,6 +74,18 @@ DEFINE_int64(backpressure_recovery_period_ms, 600000,
              "for this duration (in ms)");
 TAG_FLAG(backpressure_recovery_period_ms, advanced);
 TAG_FLAG(backpressure_recovery_period_ms, runtime);
+DEFINE_bool(rpc_admission_control, false,
+            "Reject calls from clients that occupy more than their fair share of the service "
+            "queue, when the queue stays overloaded.");
+TAG_FLAG(rpc_admission_control, advanced);
+TAG_FLAG(rpc_admission_control, runtime);
+DEFINE_int64(rpc_admission_target_queue_time_ms, 50,
+             "Service queue is considered overloaded when the minimal time spent by calls in the "
+             "queue during rpc_admission_interval_ms is above this value.");
+TAG_FLAG(rpc_admission_target_queue_time_ms, advanced);
+DEFINE_int64(rpc_admission_interval_ms, 500,
+             "Interval used for overload detection, see rpc_admission_target_queue_time_ms.");
+TAG_FLAG(rpc_admission_interval_ms, advanced);
 DEFINE_test_flag(bool, enable_backpressure_mode_for_testing, false,
             "For testing purposes. Enables the rpc's to be considered timed out in the queue even "
             "when we have not had any backpressure in the recent past.");
@@ -103,6 +116,12 @@ METRIC_DEFINE_counter(server, rpcs_queue_overflow,
                       "Number of RPCs dropped because the service queue "
                       "was full.");
 
+METRIC_DEFINE_counter(server, rpcs_rejected_by_admission_control,
+                      "RPC Admission Control Rejections",
+                      yb::MetricUnit::kRequests,
+                      "Number of RPCs rejected because the service queue was overloaded and "
+                      "the client exceeded its fair share of the queue.");
+
 namespace yb {
 namespace rpc {
 
@@ -111,6 +130,14 @@ namespace {
 const CoarseDuration kTimeoutCheckGranularity = 100ms;
 const char* const kTimedOutInQueue = "Call waited in the queue past deadline";
 
+AdmissionControllerOptions GetAdmissionControllerOptions() {
+  AdmissionControllerOptions result;
+  result.target = FLAGS_rpc_admission_target_queue_time_ms * 1ms;
+  result.interval = FLAGS_rpc_admission_interval_ms * 1ms;
+  result.max_backoff = FLAGS_max_time_in_queue_ms * 1ms;
+  return result;
+}
+
 } // namespace
 
 class ServicePoolImpl final : public InboundCallHandler {
@@ -129,6 +156,9 @@ class ServicePoolImpl final : public InboundCallHandler {
         rpcs_timed_out_early_in_queue_(
             METRIC_rpcs_timed_out_early_in_queue.Instantiate(entity)),
         rpcs_queue_overflow_(METRIC_rpcs_queue_overflow.Instantiate(entity)),
+        rpcs_rejected_by_admission_control_(
+            METRIC_rpcs_rejected_by_admission_control.Instantiate(entity)),
+        admission_controller_(GetAdmissionControllerOptions()),
         check_timeout_strand_(scheduler->io_service()),
         log_prefix_(Format("$0: ", service_->service_name())) {
   }
@@ -168,6 +198,11 @@ class ServicePoolImpl final : public InboundCallHandler {
   void Enqueue(const InboundCallPtr& call) {
     TRACE_TO(call->trace(), "Inserting onto call queue");
 
+    if (PREDICT_FALSE(ShouldRejectByAdmissionControl(*call))) {
+      Reject(call);
+      return;
+    }
+
     auto task = call->BindTask(this);
     if (!task) {
       Overflow(call, "service", queued_calls_.load(std::memory_order_relaxed));
@@ -213,6 +248,20 @@ class ServicePoolImpl final : public InboundCallHandler {
         CoarseMonoClock::Now().time_since_epoch(), std::memory_order_release);
   }
 
+  void Reject(const InboundCallPtr& call) {
+    auto retry_after = admission_controller_.BackoffHint();
+    const auto err_msg =
+        Format("$0 request on $1 from $2 rejected because the service queue is overloaded, "
+                   "retry after $3",
+               call->method_name(),
+               service_->service_name(),
+               call->remote_address(),
+               retry_after);
+    YB_LOG_EVERY_N_SECS(WARNING, 3) << LogPrefix() << err_msg;
+    rpcs_rejected_by_admission_control_->Increment();
+    call->RespondServerTooBusy(STATUS(ServiceUnavailable, err_msg), retry_after);
+  }
+
   void Failure(const InboundCallPtr& call, const Status& status) override {
     if (!call->TryStartProcessing()) {
       return;
@@ -234,6 +283,9 @@ class ServicePoolImpl final : public InboundCallHandler {
     incoming->RecordHandlingStarted(incoming_queue_time_);
     ADOPT_TRACE(incoming->trace());
 
+    admission_controller_.RecordSojourn(
+        CoarseDuration(incoming->GetTimeInQueue().ToSteadyDuration()));
+
     const char* error_message;
     if (PREDICT_FALSE(incoming->ClientTimedOut())) {
       error_message = kTimedOutInQueue;
@@ -264,6 +316,13 @@ class ServicePoolImpl final : public InboundCallHandler {
     }
   }
 
+  bool ShouldRejectByAdmissionControl(const InboundCall& call) {
+    if (!GetAtomicFlag(&FLAGS_rpc_admission_control)) {
+      return false;
+    }
+    return admission_controller_.ShouldReject(AdmissionController::BucketFor(call.client_hash()));
+  }
+
   bool ShouldDropRequestDuringHighLoad(const InboundCallPtr& incoming) {
     CoarseTimePoint last_backpressure_at(last_backpressure_at_.load(std::memory_order_acquire));
 
@@ -363,7 +422,7 @@ class ServicePoolImpl final : public InboundCallHandler {
     return log_prefix_;
   }
 
-  bool CallQueued() override {
+  bool CallQueued(const InboundCall& call) override {
     auto queued_calls = queued_calls_.fetch_add(1, std::memory_order_acq_rel);
     if (queued_calls < 0) {
       YB_LOG_EVERY_N_SECS(DFATAL, 5) << "Negative number of queued calls: " << queued_calls;
@@ -374,11 +433,13 @@ class ServicePoolImpl final : public InboundCallHandler {
       return false;
     }
 
+    admission_controller_.CallQueued(AdmissionController::BucketFor(call.client_hash()));
     return true;
   }
 
-  void CallDequeued() override {
+  void CallDequeued(const InboundCall& call) override {
     queued_calls_.fetch_sub(1, std::memory_order_relaxed);
+    admission_controller_.CallDequeued(AdmissionController::BucketFor(call.client_hash()));
   }
 
   const size_t max_queued_calls_;
@@ -389,6 +450,8 @@ class ServicePoolImpl final : public InboundCallHandler {
   scoped_refptr<Counter> rpcs_timed_out_in_queue_;
   scoped_refptr<Counter> rpcs_timed_out_early_in_queue_;
   scoped_refptr<Counter> rpcs_queue_overflow_;
+  scoped_refptr<Counter> rpcs_rejected_by_admission_control_;
+  AdmissionController admission_controller_;
   // Have to use CoarseDuration here, since CoarseTimePoint does not work with clang + libstdc++
   std::atomic<CoarseDuration> last_backpressure_at_{CoarseTimePoint().time_since_epoch()};
   std::atomic<int64_t> queued_calls_{0};
@@ -0,0 +1,900 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rpc/shared_exchange.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include <glog/logging.h>
+
+#if defined(__linux__)
+#include "yb/gutil/linux_syscall_support.h"
+#endif
+
+#include "yb/rpc/call_data.h"
+#include "yb/rpc/constants.h"
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/outbound_call.h"
+#include "yb/rpc/rpc_controller.h"
+#include "yb/rpc/yb_rpc.h"
+
+#include "yb/util/debug/trace_event.h"
+#include "yb/util/errno.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/net/net_util.h"
+#include "yb/util/net/sockaddr.h"
+#include "yb/util/shared_mem.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/thread.h"
+
+using namespace std::literals;
+using namespace yb::size_literals;
+
+DEFINE_int32(shared_exchange_num_slots, 64,
+             "Max number of calls that could be in flight through the shared memory exchange "
+             "between PostgreSQL backends and the local tablet server.");
+TAG_FLAG(shared_exchange_num_slots, advanced);
+
+DEFINE_int32(shared_exchange_slot_size, 256_KB,
+             "Size of the shared memory exchange slot. Larger requests are sent over TCP, larger "
+             "responses are transferred in several chunks.");
+TAG_FLAG(shared_exchange_slot_size, advanced);
+
+namespace yb {
+namespace rpc {
+
+namespace {
+
+#if defined(__linux__)
+#define USE_FUTEX 1
+#else
+#define USE_FUTEX 0
+#endif
+
+// Slot lifetime:
+// kFree -> kWriting: client claimed the slot and is copying request into it.
+// kWriting -> kRequestSent: request is ready to be picked by server.
+// kRequestSent -> kProcessing: server picked the request and passed it to the service.
+// kProcessing -> kResponseChunk: server stored next part of response, that does not fit into slot.
+// kResponseChunk -> kChunkConsumed: client copied the chunk, server should store the next one.
+// kProcessing/kChunkConsumed -> kResponseSent: server stored the last part of response.
+// kResponseSent -> kFree: client copied the response.
+// kProcessing -> kAbandoned: owner of the slot is gone, server will free slot after responding.
+enum class SlotState : uint32_t {
+  kFree,
+  kWriting,
+  kRequestSent,
+  kProcessing,
+  kResponseChunk,
+  kChunkConsumed,
+  kResponseSent,
+  kAbandoned,
+};
+
+constexpr size_t kMaxEndpoints = 16;
+constexpr uint32_t kNoSlot = std::numeric_limits<uint32_t>::max();
+constexpr size_t kSlotAlignment = 64;
+
+struct ExchangeHeader {
+  uint32_t num_slots;
+  uint32_t slot_size;
+  // Incremented by clients when slot requires server attention.
+  std::atomic<uint32_t> server_doorbell{0};
+  // Set by server when it starts processing calls and endpoints are filled.
+  std::atomic<uint32_t> num_endpoints{0};
+  Endpoint endpoints[kMaxEndpoints];
+};
+
+constexpr uint64_t MakeStateWord(SlotState state, int32_t owner_pid) {
+  return static_cast<uint64_t>(static_cast<uint32_t>(owner_pid)) << 32 |
+         static_cast<uint32_t>(state);
+}
+
+constexpr SlotState StateOf(uint64_t word) {
+  return static_cast<SlotState>(static_cast<uint32_t>(word));
+}
+
+constexpr int32_t OwnerOf(uint64_t word) {
+  return static_cast<int32_t>(word >> 32);
+}
+
+struct SlotHeader {
+  // Slot state in the low half and pid of the process that owns the slot in the high half. So the
+  // owner is set atomically with claiming the slot, and cleared atomically with freeing it.
+  std::atomic<uint64_t> state_and_owner{MakeStateWord(SlotState::kFree, 0)};
+  // Incremented to wake the owner of this slot, when it waits for any of its slots.
+  std::atomic<uint32_t> wake_seq{0};
+  // Index of the slot, whose wake_seq is used by owner of this slot to wait for response.
+  std::atomic<uint32_t> wake_slot{kNoSlot};
+  // Size of the whole frame being transferred.
+  uint64_t frame_size = 0;
+  // Size of frame part currently stored in the slot.
+  uint32_t data_size = 0;
+
+  SlotState state() const {
+    return StateOf(state_and_owner.load(std::memory_order_acquire));
+  }
+
+  // Changes state from expected to desired, keeping the owner. The owner is cleared when the slot
+  // becomes free. Returns false if the slot was not in the expected state.
+  bool ChangeState(SlotState expected, SlotState desired) {
+    auto word = state_and_owner.load(std::memory_order_acquire);
+    while (StateOf(word) == expected) {
+      auto owner = desired == SlotState::kFree ? 0 : OwnerOf(word);
+      if (state_and_owner.compare_exchange_weak(
+              word, MakeStateWord(desired, owner), std::memory_order_acq_rel)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Claims free slot for the specified process.
+  bool Claim(int32_t owner_pid) {
+    auto word = MakeStateWord(SlotState::kFree, 0);
+    return state_and_owner.load(std::memory_order_relaxed) == word &&
+           state_and_owner.compare_exchange_strong(
+               word, MakeStateWord(SlotState::kWriting, owner_pid), std::memory_order_acq_rel);
+  }
+};
+
+size_t AlignUp(size_t value) {
+  return (value + kSlotAlignment - 1) / kSlotAlignment * kSlotAlignment;
+}
+
+size_t HeaderStride() {
+  return AlignUp(sizeof(ExchangeHeader));
+}
+
+size_t SlotStride(size_t slot_size) {
+  return AlignUp(sizeof(SlotHeader) + slot_size);
+}
+
+size_t SegmentSize(size_t num_slots, size_t slot_size) {
+  return HeaderStride() + num_slots * SlotStride(slot_size);
+}
+
+void FutexWake(void* word) {
+#if USE_FUTEX
+  // Futex is shared between processes, so FUTEX_PRIVATE_FLAG should not be used.
+  sys_futex(static_cast<int32_t*>(word), FUTEX_WAKE, INT_MAX, nullptr);
+#endif
+}
+
+// Waits until word value differs from expected or timeout passes. Could wake up spuriously.
+void FutexWait(void* word, uint32_t expected, MonoDelta timeout) {
+  if (timeout <= MonoDelta::kZero) {
+    return;
+  }
+#if USE_FUTEX
+  struct timespec ts;
+  timeout.ToTimeSpec(&ts);
+  kernel_timespec kernel_ts;
+  kernel_ts.tv_sec = ts.tv_sec;
+  kernel_ts.tv_nsec = ts.tv_nsec;
+  sys_futex(static_cast<int32_t*>(word), FUTEX_WAIT, static_cast<int32_t>(expected), &kernel_ts);
+#else
+  if (static_cast<std::atomic<uint32_t>*>(word)->load(std::memory_order_acquire) == expected) {
+    std::this_thread::sleep_for(std::min<MonoDelta>(timeout, 100us).ToSteadyDuration());
+  }
+#endif
+}
+
+bool IsProcessAlive(int32_t pid) {
+  return kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+// Provides access to header and slots of mapped segment.
+class ExchangeLayout {
+ public:
+  // Geometry of the segment is passed explicitly, since header could be modified by any process
+  // that mapped the segment.
+  ExchangeLayout(SharedMemorySegment segment, size_t num_slots, size_t slot_size)
+      : segment_(std::move(segment)),
+        base_(static_cast<char*>(segment_.GetAddress())),
+        header_(reinterpret_cast<ExchangeHeader*>(base_)),
+        num_slots_(num_slots),
+        slot_size_(slot_size),
+        slot_stride_(SlotStride(slot_size)) {
+  }
+
+  int GetFd() const {
+    return segment_.GetFd();
+  }
+
+  ExchangeHeader& header() const {
+    return *header_;
+  }
+
+  size_t num_slots() const {
+    return num_slots_;
+  }
+
+  size_t slot_size() const {
+    return slot_size_;
+  }
+
+  SlotHeader& slot(size_t idx) const {
+    return *reinterpret_cast<SlotHeader*>(base_ + HeaderStride() + idx * slot_stride_);
+  }
+
+  char* slot_data(size_t idx) const {
+    return reinterpret_cast<char*>(&slot(idx)) + sizeof(SlotHeader);
+  }
+
+  void RingServer() {
+    header_->server_doorbell.fetch_add(1, std::memory_order_acq_rel);
+    FutexWake(&header_->server_doorbell);
+  }
+
+  // Wakes owner of the slot, after slot state was changed by server.
+  void WakeOwner(size_t idx) {
+    auto wake_slot = slot(idx).wake_slot.load();
+    if (wake_slot < num_slots()) {
+      auto& wake_seq = slot(wake_slot).wake_seq;
+      wake_seq.fetch_add(1, std::memory_order_acq_rel);
+      FutexWake(&wake_seq);
+    }
+  }
+
+  // Releases slot owned by the specified process, that is gone. Returns true if the slot became
+  // free. Slot that was already claimed by another process is left intact.
+  bool ReleaseSlot(size_t idx, int32_t owner_pid) {
+    auto& state_and_owner = slot(idx).state_and_owner;
+    auto word = state_and_owner.load(std::memory_order_acquire);
+    for (;;) {
+      auto state = StateOf(word);
+      if (OwnerOf(word) != owner_pid || state == SlotState::kFree ||
+          state == SlotState::kAbandoned) {
+        return false;
+      }
+      // Server is executing the call, it will free slot when response is ready.
+      auto new_state = state == SlotState::kProcessing ? SlotState::kAbandoned
+                                                       : SlotState::kFree;
+      if (state_and_owner.compare_exchange_weak(
+              word, MakeStateWord(new_state, 0), std::memory_order_acq_rel)) {
+        return new_state == SlotState::kFree;
+      }
+    }
+  }
+
+ private:
+  SharedMemorySegment segment_;
+  char* base_;
+  ExchangeHeader* header_;
+  const size_t num_slots_;
+  const size_t slot_size_;
+  const size_t slot_stride_;
+};
+
+class SlotResponder {
+ public:
+  virtual void Respond(size_t slot, boost::container::small_vector_base<RefCntBuffer>* frame) = 0;
+
+  virtual ~SlotResponder() {}
+};
+
+class SharedExchangeInboundCall : public YBInboundCall {
+ public:
+  SharedExchangeInboundCall(
+      RpcMetrics* rpc_metrics, std::shared_ptr<SlotResponder> responder, size_t slot,
+      int32_t owner_pid)
+      : YBInboundCall(rpc_metrics, RemoteMethod()), responder_(std::move(responder)), slot_(slot),
+        owner_pid_(owner_pid) {
+  }
+
+  const Endpoint& remote_address() const override {
+    static const Endpoint endpoint;
+    return endpoint;
+  }
+
+  const Endpoint& local_address() const override {
+    static const Endpoint endpoint;
+    return endpoint;
+  }
+
+  // All calls received through shared exchange have the same empty remote address, so they are
+  // told apart by the process that sent them.
+  size_t client_hash() const override {
+    return std::hash<int32_t>()(owner_pid_);
+  }
+
+ protected:
+  void Respond(const google::protobuf::MessageLite& response, bool is_success) override {
+    TRACE_EVENT_FLOW_END0("rpc", "InboundCall", this);
+    auto status = SerializeResponseBuffer(response, is_success);
+    if (PREDICT_FALSE(!status.ok())) {
+      LOG(DFATAL) << "Unable to serialize response: " << status;
+    }
+
+    TRACE_EVENT_ASYNC_END1("rpc", "InboundCall", this, "method", method_name());
+
+    LogTrace();
+    boost::container::small_vector<RefCntBuffer, kMinBufferForSidecarSlices + 1> frame;
+    Serialize(&frame);
+    responder_->Respond(slot_, &frame);
+  }
+
+ private:
+  std::shared_ptr<SlotResponder> responder_;
+  const size_t slot_;
+  const int32_t owner_pid_;
+};
+
+} // namespace
+
+class SharedExchangeServer::Impl : public SlotResponder,
+                                   public std::enable_shared_from_this<Impl> {
+ public:
+  Impl(SharedMemorySegment segment, size_t num_slots, size_t slot_size)
+      : layout_(std::move(segment), num_slots, slot_size) {}
+
+  int GetFd() const {
+    return layout_.GetFd();
+  }
+
+  CHECKED_STATUS Start(Messenger* messenger, const std::vector<Endpoint>& endpoints) {
+    messenger_ = messenger;
+
+    auto& header = layout_.header();
+    size_t num_endpoints = 0;
+    auto add_endpoint = [&header, &num_endpoints](const Endpoint& endpoint) {
+      if (num_endpoints == kMaxEndpoints) {
+        LOG(WARNING) << "Too many endpoints for shared exchange, ignoring: " << endpoint;
+        return;
+      }
+      header.endpoints[num_endpoints++] = endpoint;
+    };
+    for (const auto& endpoint : endpoints) {
+      if (!endpoint.address().is_unspecified()) {
+        add_endpoint(endpoint);
+        continue;
+      }
+      // Server listens on all interfaces, so clients could use any local address.
+      std::vector<IpAddress> addresses;
+      RETURN_NOT_OK(GetLocalAddresses(&addresses, AddressFilter::ANY));
+      for (const auto& address : addresses) {
+        if (address.is_v4() == endpoint.address().is_v4()) {
+          add_endpoint(Endpoint(address, endpoint.port()));
+        }
+      }
+    }
+    header.num_endpoints.store(num_endpoints, std::memory_order_release);
+
+    return yb::Thread::Create(
+        "shared_exchange", "server", &Impl::Execute, shared_from_this(), &thread_);
+  }
+
+  void Shutdown() {
+    if (closing_.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+    layout_.header().num_endpoints.store(0, std::memory_order_release);
+    if (thread_) {
+      layout_.RingServer();
+      thread_->Join();
+    }
+  }
+
+  void Respond(size_t idx, boost::container::small_vector_base<RefCntBuffer>* frame) override {
+    PendingResponse response;
+    response.buffers.assign(std::make_move_iterator(frame->begin()),
+                            std::make_move_iterator(frame->end()));
+    // Length prefix is not transferred, since client knows frame size from the slot.
+    response.offset = kMsgLengthPrefixLength;
+    size_t frame_size = 0;
+    for (const auto& buffer : response.buffers) {
+      frame_size += buffer.size();
+    }
+    layout_.slot(idx).frame_size = frame_size - kMsgLengthPrefixLength;
+
+    bool last = WriteChunk(idx, &response);
+    if (!last) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_responses_[idx] = std::move(response);
+    }
+    Publish(idx, SlotState::kProcessing, last);
+  }
+
+ private:
+  struct PendingResponse {
+    boost::container::small_vector<RefCntBuffer, kMinBufferForSidecarSlices + 1> buffers;
+    size_t buffer_idx = 0;
+    size_t offset = 0;
+  };
+
+  void Execute() {
+    auto& header = layout_.header();
+    auto next_owners_check = CoarseMonoClock::now() + kOwnersCheckInterval;
+    while (!closing_.load(std::memory_order_acquire)) {
+      auto doorbell = header.server_doorbell.load(std::memory_order_acquire);
+      for (size_t idx = 0; idx != layout_.num_slots(); ++idx) {
+        auto state = layout_.slot(idx).state();
+        if (state == SlotState::kRequestSent) {
+          HandleRequest(idx);
+        } else if (state == SlotState::kChunkConsumed) {
+          SendNextChunk(idx);
+        }
+      }
+      auto now = CoarseMonoClock::now();
+      if (now >= next_owners_check) {
+        CheckOwners();
+        next_owners_check = now + kOwnersCheckInterval;
+      }
+      FutexWait(&header.server_doorbell, doorbell, kOwnersCheckInterval);
+    }
+  }
+
+  void HandleRequest(size_t idx) {
+    auto& slot = layout_.slot(idx);
+    if (!slot.ChangeState(SlotState::kRequestSent, SlotState::kProcessing)) {
+      return;
+    }
+
+    // Slot is shared with the client process, so its header is read once and validated before use.
+    const size_t data_size = slot.data_size;
+    if (data_size > layout_.slot_size()) {
+      LOG(WARNING) << "Request in shared exchange slot " << idx << " does not fit into slot: "
+                   << data_size << " > " << layout_.slot_size();
+      // Request could not be parsed, so we cannot respond with an error. Empty response fails the
+      // call on the client side and releases the slot.
+      slot.frame_size = 0;
+      slot.data_size = 0;
+      Publish(idx, SlotState::kProcessing, /* last= */ true);
+      return;
+    }
+
+    CallData call_data(data_size);
+    memcpy(call_data.data(), layout_.slot_data(idx), data_size);
+    auto call = InboundCall::Create<SharedExchangeInboundCall>(
+        &messenger_->rpc_metrics(), shared_from_this(), idx,
+        OwnerOf(slot.state_and_owner.load(std::memory_order_acquire)));
+    auto status = call->ParseFrom(messenger_->parent_mem_tracker(), &call_data);
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to parse call received through shared exchange: " << status;
+      call->RespondFailure(ErrorStatusPB::ERROR_INVALID_REQUEST, status);
+      return;
+    }
+    messenger_->QueueInboundCall(std::move(call));
+  }
+
+  void SendNextChunk(size_t idx) {
+    bool last;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = pending_responses_.find(idx);
+      if (it == pending_responses_.end()) {
+        // State of the slot could be set by any process that mapped the segment, so it is rejected
+        // instead of being trusted.
+        LOG(WARNING) << "Chunk consumed for shared exchange slot without pending response: "
+                     << idx;
+        layout_.slot(idx).ChangeState(SlotState::kChunkConsumed, SlotState::kFree);
+        return;
+      }
+      last = WriteChunk(idx, &it->second);
+      if (last) {
+        pending_responses_.erase(it);
+      }
+    }
+    Publish(idx, SlotState::kChunkConsumed, last);
+  }
+
+  // Copies next part of response to the slot. Returns true if it was the last part.
+  bool WriteChunk(size_t idx, PendingResponse* response) {
+    char* out = layout_.slot_data(idx);
+    size_t left = layout_.slot_size();
+    auto& buffers = response->buffers;
+    while (left && response->buffer_idx != buffers.size()) {
+      const auto& buffer = buffers[response->buffer_idx];
+      size_t len = std::min(buffer.size() - response->offset, left);
+      memcpy(out, buffer.data() + response->offset, len);
+      out += len;
+      left -= len;
+      response->offset += len;
+      if (response->offset == buffer.size()) {
+        ++response->buffer_idx;
+        response->offset = 0;
+      }
+    }
+    layout_.slot(idx).data_size = layout_.slot_size() - left;
+    return response->buffer_idx == buffers.size();
+  }
+
+  void Publish(size_t idx, SlotState expected, bool last) {
+    auto& slot = layout_.slot(idx);
+    auto new_state = last ? SlotState::kResponseSent : SlotState::kResponseChunk;
+    if (!slot.ChangeState(expected, new_state)) {
+      // Owner of the slot is gone while we were processing the call.
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_responses_.erase(idx);
+      }
+      slot.state_and_owner.store(
+          MakeStateWord(SlotState::kFree, 0), std::memory_order_release);
+      return;
+    }
+    layout_.WakeOwner(idx);
+  }
+
+  void CheckOwners() {
+    for (size_t idx = 0; idx != layout_.num_slots(); ++idx) {
+      auto word = layout_.slot(idx).state_and_owner.load(std::memory_order_acquire);
+      if (StateOf(word) == SlotState::kFree) {
+        continue;
+      }
+      auto pid = OwnerOf(word);
+      if (pid != 0 && !IsProcessAlive(pid)) {
+        LOG(INFO) << "Releasing shared exchange slot " << idx << " of terminated process " << pid;
+        if (layout_.ReleaseSlot(idx, pid)) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          pending_responses_.erase(idx);
+        }
+      }
+    }
+  }
+
+  static constexpr auto kOwnersCheckInterval = 1s;
+
+  ExchangeLayout layout_;
+  Messenger* messenger_ = nullptr;
+  std::atomic<bool> closing_{false};
+  scoped_refptr<Thread> thread_;
+
+  std::mutex mutex_;
+  std::unordered_map<size_t, PendingResponse> pending_responses_;
+};
+
+constexpr std::chrono::seconds SharedExchangeServer::Impl::kOwnersCheckInterval;
+
+Result<std::unique_ptr<SharedExchangeServer>> SharedExchangeServer::Create() {
+  const size_t num_slots = FLAGS_shared_exchange_num_slots;
+  const size_t slot_size = FLAGS_shared_exchange_slot_size;
+  auto segment = VERIFY_RESULT(SharedMemorySegment::Create(SegmentSize(num_slots, slot_size)));
+
+  auto* base = static_cast<char*>(segment.GetAddress());
+  auto* header = new (base) ExchangeHeader;
+  header->num_slots = num_slots;
+  header->slot_size = slot_size;
+  for (size_t idx = 0; idx != num_slots; ++idx) {
+    auto* slot = new (base + HeaderStride() + idx * SlotStride(slot_size)) SlotHeader;
+    // Same as for TServerSharedMemory, atomics stored in shared memory must be lock-free.
+    LOG_IF(FATAL, !header->server_doorbell.is_lock_free() ||
+                  !slot->state_and_owner.is_lock_free())
+        << "Shared memory atomics must be lock-free";
+  }
+
+  // Server uses its own copy of the segment geometry, clients could overwrite the header.
+  return std::unique_ptr<SharedExchangeServer>(new SharedExchangeServer(
+      std::make_shared<Impl>(std::move(segment), num_slots, slot_size)));
+}
+
+SharedExchangeServer::SharedExchangeServer(std::shared_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+SharedExchangeServer::~SharedExchangeServer() {
+  Shutdown();
+}
+
+int SharedExchangeServer::GetFd() const {
+  return impl_->GetFd();
+}
+
+Status SharedExchangeServer::Start(Messenger* messenger, const std::vector<Endpoint>& endpoints) {
+  return impl_->Start(messenger, endpoints);
+}
+
+void SharedExchangeServer::Shutdown() {
+  impl_->Shutdown();
+}
+
+class SharedExchangeClient::Impl {
+ public:
+  Impl(SharedMemorySegment segment, size_t num_slots, size_t slot_size)
+      : layout_(std::move(segment), num_slots, slot_size) {}
+
+  CHECKED_STATUS Start() {
+    return yb::Thread::Create("shared_exchange", "client", &Impl::Execute, this, &thread_);
+  }
+
+  bool TrySend(const OutboundCallPtr& call) {
+    const auto& request = call->request_buffer();
+    if (request.size() > layout_.slot_size() + kMsgLengthPrefixLength ||
+        !IsServerEndpoint(call->conn_id().remote())) {
+      return false;
+    }
+    auto idx = ClaimSlot();
+    if (!idx) {
+      return false;
+    }
+
+    auto& slot = layout_.slot(*idx);
+    slot.wake_slot.store(kNoSlot);
+    slot.data_size = request.size() - kMsgLengthPrefixLength;
+    slot.frame_size = slot.data_size;
+    memcpy(layout_.slot_data(*idx), request.data() + kMsgLengthPrefixLength, slot.data_size);
+
+    auto timeout = call->controller()->timeout();
+    InFlightCall in_flight_call;
+    in_flight_call.slot = *idx;
+    in_flight_call.call = call;
+    in_flight_call.deadline = timeout.Initialized() ? CoarseMonoClock::now() + timeout
+                                                    : CoarseTimePoint::max();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closing_) {
+        slot.ChangeState(SlotState::kWriting, SlotState::kFree);
+        return false;
+      }
+      new_calls_.push_back(std::move(in_flight_call));
+      slot.ChangeState(SlotState::kWriting, SlotState::kRequestSent);
+    }
+    layout_.RingServer();
+    cond_.notify_one();
+    // Waiter could already sleep on futex, so wake it to pick the new call.
+    auto waiting_slot = waiting_slot_.load();
+    if (waiting_slot != kNoSlot) {
+      auto& wake_seq = layout_.slot(waiting_slot).wake_seq;
+      wake_seq.fetch_add(1, std::memory_order_acq_rel);
+      FutexWake(&wake_seq);
+    }
+
+    num_sent_calls_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  void Shutdown() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closing_) {
+        return;
+      }
+      closing_ = true;
+    }
+    cond_.notify_one();
+    auto waiting_slot = waiting_slot_.load();
+    if (waiting_slot != kNoSlot) {
+      auto& wake_seq = layout_.slot(waiting_slot).wake_seq;
+      wake_seq.fetch_add(1, std::memory_order_acq_rel);
+      FutexWake(&wake_seq);
+    }
+    if (thread_) {
+      thread_->Join();
+    }
+  }
+
+  size_t num_sent_calls() const {
+    return num_sent_calls_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct InFlightCall {
+    size_t slot;
+    OutboundCallPtr call;
+    CoarseTimePoint deadline;
+    CallData frame;
+    size_t received = 0;
+    bool timed_out = false;
+  };
+
+  bool IsServerEndpoint(const Endpoint& endpoint) const {
+    auto& header = layout_.header();
+    auto num_endpoints = header.num_endpoints.load(std::memory_order_acquire);
+    for (size_t i = 0; i != num_endpoints; ++i) {
+      if (header.endpoints[i] == endpoint) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  boost::optional<size_t> ClaimSlot() {
+    const size_t num_slots = layout_.num_slots();
+    size_t start = next_slot_.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i != num_slots; ++i) {
+      size_t idx = (start + i) % num_slots;
+      if (layout_.slot(idx).Claim(pid_)) {
+        return idx;
+      }
+    }
+    return boost::none;
+  }
+
+  void Execute() {
+    std::vector<InFlightCall> calls;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (calls.empty()) {
+          cond_.wait(lock, [this] { return closing_ || !new_calls_.empty(); });
+        }
+        if (closing_) {
+          break;
+        }
+        std::move(new_calls_.begin(), new_calls_.end(), std::back_inserter(calls));
+        new_calls_.clear();
+      }
+
+      // Any slot state change wakes up the first call slot, because we cannot wait on several
+      // futexes at once.
+      const auto head = calls.front().slot;
+      waiting_slot_.store(head);
+      for (const auto& call : calls) {
+        layout_.slot(call.slot).wake_slot.store(head);
+      }
+      auto& wake_seq = layout_.slot(head).wake_seq;
+      auto seq = wake_seq.load();
+
+      auto now = CoarseMonoClock::now();
+      auto wait_until = now + kMaxWaitTime;
+      bool progress = false;
+      for (auto it = calls.begin(); it != calls.end();) {
+        if (ProcessCall(&*it, now, &progress)) {
+          it = calls.erase(it);
+        } else {
+          if (!it->timed_out) {
+            wait_until = std::min(wait_until, it->deadline);
+          }
+          ++it;
+        }
+      }
+
+      if (!progress) {
+        bool has_new_calls;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          has_new_calls = !new_calls_.empty() || closing_;
+        }
+        if (!has_new_calls) {
+          FutexWait(&wake_seq, seq, wait_until - now);
+        }
+      }
+      waiting_slot_.store(kNoSlot);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::move(new_calls_.begin(), new_calls_.end(), std::back_inserter(calls));
+      new_calls_.clear();
+    }
+    for (auto& call : calls) {
+      layout_.ReleaseSlot(call.slot, pid_);
+      if (!call.call->IsFinished()) {
+        call.call->SetFailed(STATUS(Aborted, "Shared exchange is shutting down"));
+      }
+    }
+  }
+
+  // Returns true when call is completed and its slot is released.
+  bool ProcessCall(InFlightCall* call, CoarseTimePoint now, bool* progress) {
+    auto& slot = layout_.slot(call->slot);
+    auto state = slot.state();
+    if (state == SlotState::kResponseChunk || state == SlotState::kResponseSent) {
+      *progress = true;
+      if (call->frame.empty()) {
+        call->frame = CallData(slot.frame_size);
+      }
+      if (call->received + slot.data_size > call->frame.size()) {
+        LOG(DFATAL) << "Response chunk does not fit into frame: " << call->received << " + "
+                    << slot.data_size << " > " << call->frame.size();
+        slot.ChangeState(state, SlotState::kFree);
+        Fail(call, STATUS(Corruption, "Invalid response received through shared exchange"));
+        return true;
+      }
+      memcpy(call->frame.data() + call->received, layout_.slot_data(call->slot), slot.data_size);
+      call->received += slot.data_size;
+      if (state == SlotState::kResponseChunk) {
+        slot.ChangeState(SlotState::kResponseChunk, SlotState::kChunkConsumed);
+        layout_.RingServer();
+        return false;
+      }
+      slot.ChangeState(SlotState::kResponseSent, SlotState::kFree);
+      Complete(call);
+      return true;
+    }
+
+    if (!call->timed_out && now >= call->deadline) {
+      // Slot is still used by server, so we keep it until response is received.
+      call->timed_out = true;
+      call->call->SetQueued();
+      call->call->SetTimedOut();
+    }
+    return false;
+  }
+
+  void Complete(InFlightCall* call) {
+    if (call->call->IsFinished()) {
+      return;
+    }
+    CallResponse response;
+    auto status = response.ParseFrom(&call->frame);
+    if (!status.ok()) {
+      Fail(call, status);
+      return;
+    }
+    call->call->SetQueued();
+    call->call->SetSent();
+    call->call->SetResponse(std::move(response));
+  }
+
+  void Fail(InFlightCall* call, const Status& status) {
+    if (!call->call->IsFinished()) {
+      call->call->SetFailed(status);
+    }
+  }
+
+  static constexpr auto kMaxWaitTime = 100ms;
+
+  ExchangeLayout layout_;
+  const int32_t pid_ = getpid();
+  std::atomic<size_t> next_slot_{0};
+  std::atomic<uint32_t> waiting_slot_{kNoSlot};
+  std::atomic<size_t> num_sent_calls_{0};
+  scoped_refptr<Thread> thread_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool closing_ = false;
+  std::vector<InFlightCall> new_calls_;
+};
+
+constexpr std::chrono::milliseconds SharedExchangeClient::Impl::kMaxWaitTime;
+
+Result<std::unique_ptr<SharedExchangeClient>> SharedExchangeClient::Open(int fd) {
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    return STATUS(IOError, "Failed to stat shared exchange segment", Errno(errno));
+  }
+  auto segment = VERIFY_RESULT(SharedMemorySegment::Open(
+      fd, SharedMemorySegment::kReadWrite, st.st_size));
+  const auto* header = static_cast<const ExchangeHeader*>(segment.GetAddress());
+  const size_t num_slots = header->num_slots;
+  const size_t slot_size = header->slot_size;
+  if (SegmentSize(num_slots, slot_size) > static_cast<size_t>(st.st_size)) {
+    return STATUS_FORMAT(Corruption, "Shared exchange segment is too small: $0 slots of $1 bytes "
+                         "in $2 bytes", num_slots, slot_size, st.st_size);
+  }
+  auto impl = std::make_unique<Impl>(std::move(segment), num_slots, slot_size);
+  RETURN_NOT_OK(impl->Start());
+  return std::unique_ptr<SharedExchangeClient>(new SharedExchangeClient(std::move(impl)));
+}
+
+SharedExchangeClient::SharedExchangeClient(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+SharedExchangeClient::~SharedExchangeClient() {
+  Shutdown();
+}
+
+bool SharedExchangeClient::TrySend(const OutboundCallPtr& call) {
+  return impl_->TrySend(call);
+}
+
+void SharedExchangeClient::Shutdown() {
+  impl_->Shutdown();
+}
+
+size_t SharedExchangeClient::TEST_num_sent_calls() const {
+  return impl_->num_sent_calls();
+}
+
+} // namespace rpc
+} // namespace yb
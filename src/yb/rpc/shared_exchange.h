@@ -0,0 +1,89 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_RPC_SHARED_EXCHANGE_H
+#define YB_RPC_SHARED_EXCHANGE_H
+
+#include <memory>
+#include <vector>
+
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/net/net_fwd.h"
+#include "yb/util/result.h"
+
+namespace yb {
+namespace rpc {
+
+// Exchange of RPC calls through shared memory between processes running on the same host.
+// Used by PostgreSQL backends to send calls to the local tablet server without loopback TCP.
+//
+// Request and response frames have exactly the same format as frames sent over TCP, so the server
+// dispatches them to the same services, and sidecars are delivered as part of response frame.
+//
+// Shared memory segment contains a fixed pool of slots, each slot holds one call at a time.
+// Request should fit into a slot, otherwise it is sent over TCP. Response is transferred in
+// chunks of slot size. Slot state words are used as futexes, so neither side polls.
+class SharedExchangeServer {
+ public:
+  // Creates shared memory segment, it could be done before the RPC server is started, so file
+  // descriptor of the segment could be passed to child processes.
+  static Result<std::unique_ptr<SharedExchangeServer>> Create();
+
+  ~SharedExchangeServer();
+
+  // Returns the file descriptor of the shared memory segment.
+  int GetFd() const;
+
+  // Starts processing calls received through shared memory, they are queued to services registered
+  // in messenger. Clients use the exchange for calls sent to one of the specified endpoints.
+  CHECKED_STATUS Start(Messenger* messenger, const std::vector<Endpoint>& endpoints);
+
+  void Shutdown();
+
+ private:
+  class Impl;
+
+  explicit SharedExchangeServer(std::shared_ptr<Impl> impl);
+
+  std::shared_ptr<Impl> impl_;
+};
+
+class SharedExchangeClient {
+ public:
+  // Maps shared memory segment created by SharedExchangeServer.
+  static Result<std::unique_ptr<SharedExchangeClient>> Open(int fd);
+
+  ~SharedExchangeClient();
+
+  // Sends call through shared memory. Returns false if call should be sent over TCP, i.e. its
+  // destination is not the local server, request is too big, or there are no free slots.
+  bool TrySend(const OutboundCallPtr& call);
+
+  // Aborts calls that are in flight.
+  void Shutdown();
+
+  size_t TEST_num_sent_calls() const;
+
+ private:
+  class Impl;
+
+  explicit SharedExchangeClient(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_SHARED_EXCHANGE_H
@@ -14,6 +14,7 @@
 #include "yb/rpc/tcp_stream.h"
 
 #include "yb/rpc/outbound_data.h"
+#include "yb/rpc/rpc_metrics.h"
 
 #include "yb/util/errno.h"
 #include "yb/util/flag_tags.h"
@@ -31,13 +32,16 @@ namespace rpc {
 
 namespace {
 
-const size_t kMaxIov = 16;
+// Number of buffers that could be sent by single syscall. Deep pipelines produce many small
+// buffers, so we want to send as many of them as possible at once.
+const size_t kMaxIov = 64;
 
 }
 
 TcpStream::TcpStream(const StreamCreateData& data)
     : socket_(std::move(*data.socket)),
-      remote_(data.remote) {
+      remote_(data.remote),
+      rpc_metrics_(data.rpc_metrics) {
   if (data.mem_tracker) {
     mem_tracker_ = MemTracker::FindOrCreateTracker("Sending", data.mem_tracker);
   }
@@ -90,6 +94,7 @@ Status TcpStream::DoStart(ev::loop_ref* loop, bool connect) {
   io_.set<TcpStream, &TcpStream::Handler>(this);
   int events = ev::READ | (!connected_ ? ev::WRITE : 0);
   io_.start(socket_.GetFd(), events);
+  current_events_ = events;
 
   DVLOG_WITH_PREFIX(3) << "Starting, listen events: " << events << ", fd: " << socket_.GetFd();
 
@@ -147,6 +152,7 @@ Status TcpStream::TryWrite() {
 
 TcpStream::FillIovResult TcpStream::FillIov(iovec* out) {
   int index = 0;
+  size_t total_len = 0;
   size_t offset = send_position_;
   bool only_heartbeats = true;
   for (auto& data : sending_) {
@@ -168,14 +174,15 @@ TcpStream::FillIovResult TcpStream::FillIov(iovec* out) {
 
       out[index].iov_base = bytes.data() + offset;
       out[index].iov_len = bytes.size() - offset;
+      total_len += out[index].iov_len;
       offset = 0;
       if (++index == kMaxIov) {
-        return FillIovResult{index, only_heartbeats};
+        return FillIovResult{index, only_heartbeats, total_len};
       }
     }
   }
 
-  return FillIovResult{index, only_heartbeats};
+  return FillIovResult{index, only_heartbeats, total_len};
 }
 
 Status TcpStream::DoWrite() {
@@ -194,9 +201,13 @@ Status TcpStream::DoWrite() {
     }
 
     int32_t written = 0;
-    auto status = fill_result.len != 0
-        ? socket_.Writev(iov, fill_result.len, &written)
-        : Status::OK();
+    Status status;
+    if (fill_result.len != 0) {
+      if (rpc_metrics_) {
+        IncrementCounter(rpc_metrics_->tcp_send_syscalls);
+      }
+      status = socket_.Writev(iov, fill_result.len, &written);
+    }
     DVLOG_WITH_PREFIX(4) << "Queued writes " << queued_bytes_to_send_ << " bytes. written "
                          << written << " . Status " << status << " sending_ .size() "
                          << sending_.size();
@@ -228,6 +239,12 @@ Status TcpStream::DoWrite() {
         context_->Transferred(data, Status::OK());
       }
     }
+
+    // Short write means that socket send buffer is full, so the next attempt would fail with
+    // EAGAIN. Wait for socket to become writable instead of wasting syscall.
+    if (static_cast<size_t>(written) < fill_result.total_len) {
+      break;
+    }
   }
 
   return Status::OK();
@@ -276,8 +293,10 @@ void TcpStream::UpdateEvents() {
   if (waiting_write_ready_) {
     events |= ev::WRITE;
   }
-  if (events) {
+  // Restarting watcher is not free, so we do it only when events are actually changed.
+  if (events && events != current_events_) {
     io_.set(events);
+    current_events_ = events;
   }
 }
 
@@ -298,13 +317,16 @@ Status TcpStream::ReadHandler() {
     if (!received.get()) {
       return Status::OK();
     }
+    // Short read means that we drained socket receive buffer, so the next receive would fail with
+    // EAGAIN. But we still should process received data.
+    bool drained = socket_drained_;
     // If we were not able to process next call exit loop.
     // If status is ok, it means that we just do not have enough data to process yet.
     auto continue_receiving = TryProcessReceived();
     if (!continue_receiving.ok()) {
       return continue_receiving.status();
     }
-    if (!continue_receiving.get()) {
+    if (!continue_receiving.get() || drained) {
       return Status::OK();
     }
   }
@@ -321,6 +343,13 @@ Result<bool> TcpStream::Receive() {
   }
   read_buffer_full_ = false;
 
+  size_t capacity = 0;
+  for (const auto& entry : *iov) {
+    capacity += entry.iov_len;
+  }
+  if (rpc_metrics_) {
+    IncrementCounter(rpc_metrics_->tcp_receive_syscalls);
+  }
   auto nread = socket_.Recvv(iov.get_ptr());
   if (!nread.ok()) {
     if (Socket::IsTemporarySocketError(nread.status())) {
@@ -329,6 +358,7 @@ Result<bool> TcpStream::Receive() {
     return nread.status();
   }
 
+  socket_drained_ = static_cast<size_t>(*nread) < capacity;
   ReadBuffer().DataAppended(*nread);
   return *nread != 0;
 }
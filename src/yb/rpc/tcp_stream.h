@@ -43,6 +43,7 @@ class TcpStream : public Stream {
   struct FillIovResult {
     int len;
     bool only_heartbeats;
+    size_t total_len;
   };
 
   CHECKED_STATUS Start(bool connect, ev::loop_ref* loop, StreamContext* context) override;
@@ -117,6 +118,14 @@ class TcpStream : public Stream {
 
   bool read_buffer_full_ = false;
 
+  // Set when the last receive did not fill provided buffers, i.e. socket receive buffer was drained.
+  bool socket_drained_ = false;
+
+  // Events that we are currently listening for.
+  int current_events_ = 0;
+
+  RpcMetrics* const rpc_metrics_;
+
   typedef boost::container::small_vector<RefCntBuffer, 4> SendingBytes;
 
   struct SendingData {
@@ -143,6 +143,39 @@ TEST_F(ThreadPoolTest, TestMultiProducers) {
   }
 }
 
+TEST_F(ThreadPoolTest, TestWorkerGroups) {
+  constexpr size_t kTotalTasks = 10000;
+  constexpr size_t kTotalWorkers = 8;
+  constexpr size_t kProducers = 4;
+  constexpr size_t kGroups = 4;
+  ThreadPool pool(ThreadPoolOptions{"test", kTotalTasks, kTotalWorkers, kGroups});
+
+  CountDownLatch latch(kTotalTasks);
+  std::vector<TestTask> tasks(kTotalTasks);
+  std::vector<std::thread> threads;
+  size_t begin = 0;
+  // Producers are mapped to groups by thread, so some groups could stay w/o tasks, and their
+  // workers should steal tasks from other groups.
+  for (size_t i = 0; i != kProducers; ++i) {
+    size_t end = kTotalTasks * (i + 1) / kProducers;
+    threads.emplace_back([&pool, &latch, &tasks, begin, end] {
+      CDSAttacher attacher;
+      for (size_t i = begin; i != end; ++i) {
+        tasks[i].SetLatch(&latch);
+        ASSERT_TRUE(pool.Enqueue(&tasks[i]));
+      }
+    });
+    begin = end;
+  }
+  latch.Wait();
+  for (auto& task : tasks) {
+    ASSERT_TRUE(task.IsCompleted());
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
 TEST_F(ThreadPoolTest, TestQueueOverflow) {
   constexpr size_t kTotalTasks = 10000;
   constexpr size_t kTotalWorkers = 4;
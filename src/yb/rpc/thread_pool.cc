@@ -18,13 +18,30 @@
 #include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #include <cds/container/basket_queue.h>
 #include <cds/gc/dhp.h>
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/thread.h"
 
+DEFINE_int32(rpc_thread_pool_groups, 1,
+             "Number of worker groups in rpc thread pool. Each group has its own task queue, "
+             "tasks are added to the queue of the group that corresponds to the enqueuing thread "
+             "(usually reactor), and idle workers steal tasks from other groups.");
+TAG_FLAG(rpc_thread_pool_groups, advanced);
+DEFINE_bool(rpc_thread_pool_pin_groups, false,
+            "Pin workers of each rpc thread pool group to its own subset of CPUs. Online CPUs are "
+            "split to contiguous ranges, that usually correspond to NUMA nodes.");
+TAG_FLAG(rpc_thread_pool_pin_groups, advanced);
+
 namespace yb {
 namespace rpc {
 
@@ -35,25 +52,95 @@ class Worker;
 typedef cds::container::BasketQueue<cds::gc::DHP, ThreadPoolTask*> TaskQueue;
 typedef cds::container::BasketQueue<cds::gc::DHP, Worker*> WaitingWorkers;
 
-struct ThreadPoolShare {
-  ThreadPoolOptions options;
+// Group of workers, that share the same task queue.
+struct WorkerGroup {
   TaskQueue task_queue;
   WaitingWorkers waiting_workers;
+};
+
+struct ThreadPoolShare {
+  ThreadPoolOptions options;
+  std::vector<std::unique_ptr<WorkerGroup>> groups;
 
   explicit ThreadPoolShare(ThreadPoolOptions o)
-      : options(std::move(o)) {}
+      : options(std::move(o)) {
+    if (options.num_groups == 0) {
+      options.num_groups = std::max(FLAGS_rpc_thread_pool_groups, 1);
+    }
+    // There is no sense to have group w/o workers.
+    options.num_groups = std::max<size_t>(
+        std::min(options.num_groups, options.max_workers), 1);
+    groups.reserve(options.num_groups);
+    while (groups.size() != options.num_groups) {
+      groups.push_back(std::make_unique<WorkerGroup>());
+    }
+  }
+
+  // Group used by the current thread to enqueue tasks.
+  size_t CurrentThreadGroup() const {
+    if (groups.size() == 1) {
+      return 0;
+    }
+    // Assign stable index to each thread, so tasks from the same reactor go to the same group.
+    static std::atomic<size_t> next_thread_index{0};
+    static thread_local size_t thread_index = next_thread_index.fetch_add(
+        1, std::memory_order_relaxed);
+    return thread_index % groups.size();
+  }
+
+  // Pops task, looking to the queue of specified group first, then stealing from other groups.
+  bool PopTask(size_t group, ThreadPoolTask** task) {
+    if (groups[group]->task_queue.pop(*task)) {
+      return true;
+    }
+    for (size_t i = 1; i < groups.size(); ++i) {
+      if (groups[(group + i) % groups.size()]->task_queue.pop(*task)) {
+        return true;
+      }
+    }
+    return false;
+  }
 };
 
 namespace {
 
 const std::string kRpcThreadCategory = "rpc_thread_pool";
 
+// Pins current thread to the part of online CPUs that corresponds to the specified group.
+void PinToGroupCpus(size_t group, size_t num_groups) {
+#if defined(__linux__)
+  cpu_set_t online;
+  CPU_ZERO(&online);
+  if (sched_getaffinity(0, sizeof(online), &online) != 0) {
+    return;
+  }
+  std::vector<int> cpus;
+  for (int cpu = 0; cpu != CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &online)) {
+      cpus.push_back(cpu);
+    }
+  }
+  if (cpus.size() < num_groups) {
+    return;
+  }
+  cpu_set_t group_cpus;
+  CPU_ZERO(&group_cpus);
+  for (size_t i = cpus.size() * group / num_groups; i != cpus.size() * (group + 1) / num_groups;
+       ++i) {
+    CPU_SET(cpus[i], &group_cpus);
+  }
+  int result = pthread_setaffinity_np(pthread_self(), sizeof(group_cpus), &group_cpus);
+  LOG_IF(WARNING, result != 0) << "Failed to pin rpc worker to CPUs of group " << group << ": "
+                               << result;
+#endif
+}
+
 } // namespace
 
 class Worker {
  public:
   explicit Worker(ThreadPoolShare* share, size_t index)
-      : share_(share) {
+      : share_(share), group_(index % share->groups.size()) {
     auto name = strings::Substitute("rpc_tp_$0_$1", share_->options.name, index);
     CHECK_OK(yb::Thread::Create(kRpcThreadCategory, name, &Worker::Execute, this, &thread_));
   }
@@ -93,6 +180,9 @@ class Worker {
   // does not have free hands (worker queue empty)
   void Execute() {
     Thread::current_thread()->SetUserData(share_);
+    if (share_->groups.size() > 1 && FLAGS_rpc_thread_pool_pin_groups) {
+      PinToGroupCpus(group_, share_->groups.size());
+    }
     while (!stop_requested_) {
       ThreadPoolTask* task = nullptr;
       if (PopTask(&task)) {
@@ -105,7 +195,7 @@ class Worker {
   bool PopTask(ThreadPoolTask** task) {
     // First of all we try to get already queued task, w/o locking.
     // If there is no task, so we could go to waiting state.
-    if (share_->task_queue.pop(*task)) {
+    if (share_->PopTask(group_, task)) {
       return true;
     }
     std::unique_lock<std::mutex> lock(mutex_);
@@ -121,7 +211,7 @@ class Worker {
       // the worker queue. So worker queue could be empty in this case, and nobody was notified
       // about new task. So we check there for this case. This technique is similar to
       // double check.
-      if (share_->task_queue.pop(*task)) {
+      if (share_->PopTask(group_, task)) {
         return true;
       }
 
@@ -129,7 +219,7 @@ class Worker {
 
       // Sometimes another worker could steal task before we wake up. In this case we will
       // just enqueue ourselves back.
-      if (share_->task_queue.pop(*task)) {
+      if (share_->PopTask(group_, task)) {
         return true;
       }
     }
@@ -138,13 +228,14 @@ class Worker {
 
   void AddToWaitingWorkers() {
     if (!added_to_waiting_workers_) {
-      auto pushed = share_->waiting_workers.push(this);
+      auto pushed = share_->groups[group_]->waiting_workers.push(this);
       DCHECK(pushed); // BasketQueue always succeed.
       added_to_waiting_workers_ = true;
     }
   }
 
   ThreadPoolShare* share_;
+  const size_t group_;
   scoped_refptr<yb::Thread> thread_;
   std::mutex mutex_;
   std::condition_variable cond_;
@@ -179,13 +270,20 @@ class ThreadPool::Impl {
       task->Done(shutdown_status_);
       return false;
     }
-    bool added = share_.task_queue.push(task);
+    // Task is added to the group of the current thread, so the same worker group processes
+    // tasks of the same reactor. But if this group does not have idle workers, we notify worker
+    // from another group, that would steal this task.
+    const auto group = share_.CurrentThreadGroup();
+    bool added = share_.groups[group]->task_queue.push(task);
     DCHECK(added); // BasketQueue always succeed.
     --adding_;
-    Worker* worker = nullptr;
-    while (share_.waiting_workers.pop(worker)) {
-      if (worker->Notify()) {
-        return true;
+    for (size_t i = 0; i != share_.groups.size(); ++i) {
+      auto& waiting_workers = share_.groups[(group + i) % share_.groups.size()]->waiting_workers;
+      Worker* worker = nullptr;
+      while (waiting_workers.pop(worker)) {
+        if (worker->Notify()) {
+          return true;
+        }
       }
     }
 
@@ -210,7 +308,9 @@ class ThreadPool::Impl {
     {
       std::lock_guard<std::mutex> lock(mutex_);
       if (closing_) {
-        CHECK(share_.task_queue.empty());
+        for (const auto& group : share_.groups) {
+          CHECK(group->task_queue.empty());
+        }
         CHECK(workers_.empty());
         return;
       }
@@ -229,8 +329,10 @@ class ThreadPool::Impl {
       std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
     ThreadPoolTask* task = nullptr;
-    while (share_.task_queue.pop(task)) {
-      task->Done(shutdown_status_);
+    for (const auto& group : share_.groups) {
+      while (group->task_queue.pop(task)) {
+        task->Done(shutdown_status_);
+      }
     }
   }
 
@@ -44,6 +44,9 @@ struct ThreadPoolOptions {
   std::string name;
   size_t queue_limit;
   size_t max_workers;
+  // Number of worker groups, each group has own task queue, see rpc_thread_pool_groups.
+  // 0 means that value of this flag is used.
+  size_t num_groups = 0;
 };
 
 class ThreadPool {
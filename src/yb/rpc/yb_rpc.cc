@@ -403,7 +403,7 @@ Status YBInboundCall::ParseParam(google::protobuf::Message *message) {
 void YBInboundCall::RespondBadMethod() {
   auto err = Format("Call on service $0 received from $1 with an invalid method name: $2",
                     remote_method_.service_name(),
-                    connection()->ToString(),
+                    yb::ToString(remote_address()),
                     remote_method_.method_name());
   LOG(WARNING) << err;
   RespondFailure(ErrorStatusPB::ERROR_NO_SUCH_METHOD, STATUS(InvalidArgument, err));
@@ -424,6 +424,18 @@ void YBInboundCall::RespondFailure(ErrorStatusPB::RpcErrorCodePB error_code,
   Respond(err, false);
 }
 
+void YBInboundCall::RespondServerTooBusy(const Status& status, MonoDelta retry_after) {
+  TRACE_EVENT0("rpc", "InboundCall::RespondServerTooBusy");
+  ErrorStatusPB err;
+  err.set_message(status.ToString());
+  err.set_code(ErrorStatusPB::ERROR_SERVER_TOO_BUSY);
+  if (retry_after.Initialized()) {
+    err.set_retry_after_ms(retry_after.ToMilliseconds());
+  }
+
+  Respond(err, false);
+}
+
 void YBInboundCall::RespondApplicationError(int error_ext_id, const std::string& message,
                                             const MessageLite& app_error_pb) {
   ErrorStatusPB err;
@@ -146,6 +146,8 @@ class YBInboundCall : public InboundCall {
   void RespondFailure(ErrorStatusPB::RpcErrorCodePB error_code,
                       const Status &status) override;
 
+  void RespondServerTooBusy(const Status& status, MonoDelta retry_after) override;
+
   void RespondApplicationError(int error_ext_id, const std::string& message,
                                const google::protobuf::MessageLite& app_error_pb);
 
@@ -185,13 +187,13 @@ class YBInboundCall : public InboundCall {
   // Serialize and queue the response.
   virtual void Respond(const google::protobuf::MessageLite& response, bool is_success);
 
- private:
   // Serialize a response message for either success or failure. If it is a success,
   // 'response' should be the user-defined response type for the call. If it is a
   // failure, 'response' should be an ErrorStatusPB instance.
   CHECKED_STATUS SerializeResponseBuffer(const google::protobuf::MessageLite& response,
                                          bool is_success);
 
+ private:
   // The header of the incoming call. Set by ParseFrom()
   RequestHeader header_;
 
@@ -216,5 +216,48 @@ TEST_F(HybridClockTest, CompareHybridClocksToDelta) {
       MonoDelta::FromMicroseconds(1)));
 }
 
+#if !defined(__APPLE__)
+TEST_F(HybridClockTest, CachedAdjTimeClock) {
+  auto adjtime_now = AdjTimeClock()->Now();
+  if (!adjtime_now.ok()) {
+    LOG(INFO) << "Skipping test, ntp_adjtime is not available: " << adjtime_now.status();
+    return;
+  }
+
+  const auto& clock = CachedAdjTimeClock();
+  for (int i = 0; i != 1000; ++i) {
+    auto now = ASSERT_RESULT(clock->Now());
+    ASSERT_GE(now.max_error, 1);
+  }
+  auto cached = ASSERT_RESULT(clock->Now());
+  auto exact = ASSERT_RESULT(AdjTimeClock()->Now());
+  // Cached error is increased with max frequency error, so it could not be less than exact one
+  // by more than maxerror granularity of the kernel.
+  ASSERT_GE(cached.max_error + 1000, exact.max_error);
+}
+#endif
+
+TEST_F(HybridClockTest, NowPerformance) {
+  constexpr int kIterations = 1000000;
+  std::vector<std::string> time_sources = {""};
+#if !defined(__APPLE__)
+  if (AdjTimeClock()->Now().ok()) {
+    time_sources.push_back(HybridClock::kAdjTimeSource);
+    time_sources.push_back(HybridClock::kCachedAdjTimeSource);
+  }
+#endif
+  for (const auto& time_source : time_sources) {
+    scoped_refptr<HybridClock> clock(new HybridClock(time_source));
+    ASSERT_OK(clock->Init());
+    auto start = MonoTime::Now();
+    for (int i = 0; i != kIterations; ++i) {
+      clock->Now();
+    }
+    auto passed = MonoTime::Now() - start;
+    LOG(INFO) << "Time source '" << time_source << "': "
+              << passed.ToNanoseconds() / kIterations << " ns per HybridClock::Now";
+  }
+}
+
 }  // namespace server
 }  // namespace yb
@@ -62,9 +62,11 @@ METRIC_DEFINE_gauge_uint64(server, hybrid_clock_error,
                            "Server clock maximum error.");
 
 DEFINE_string(time_source, "",
-              "The clock source that HybridClock should use (for tests only). "
-              "Leave empty for WallClock, other values depend on added clock providers and "
-              "specific for appropriate tests, that adds them.");
+              "The clock source that HybridClock should use. "
+              "Leave empty for WallClock. Use 'adjtime' to get time and error from ntp_adjtime on "
+              "each call, or 'cached_adjtime' to get error from ntp_adjtime periodically. "
+              "Other values depend on added clock providers and specific for appropriate tests, "
+              "that adds them.");
 TAG_FLAG(time_source, hidden);
 
 using yb::Status;
@@ -82,6 +84,14 @@ PhysicalClockPtr GetClock(const std::string& name) {
   if (name.empty()) {
     return WallClock();
   }
+#if !defined(__APPLE__)
+  if (name == HybridClock::kAdjTimeSource) {
+    return AdjTimeClock();
+  }
+  if (name == HybridClock::kCachedAdjTimeSource) {
+    return CachedAdjTimeClock();
+  }
+#endif
   std::lock_guard<std::mutex> lock(providers_mutex);
   auto it = providers.find(name);
   if (it == providers.end()) {
@@ -93,6 +103,9 @@ PhysicalClockPtr GetClock(const std::string& name) {
 
 } // namespace
 
+const std::string HybridClock::kAdjTimeSource = "adjtime";
+const std::string HybridClock::kCachedAdjTimeSource = "cached_adjtime";
+
 void HybridClock::RegisterProvider(std::string name, PhysicalClockProvider provider) {
   std::lock_guard<std::mutex> lock(providers_mutex);
   providers.emplace(std::move(name), std::move(provider));
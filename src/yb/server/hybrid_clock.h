@@ -107,6 +107,10 @@ class HybridClock : public Clock {
 
   static void RegisterProvider(std::string name, PhysicalClockProvider provider);
 
+  // Names of built-in time sources, that could be specified in time_source flag.
+  static const std::string kAdjTimeSource;
+  static const std::string kCachedAdjTimeSource;
+
   const PhysicalClockPtr& TEST_clock() { return clock_; }
 
  private:
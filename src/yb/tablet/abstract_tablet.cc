@@ -23,6 +23,18 @@
 namespace yb {
 namespace tablet {
 
+Status AbstractTablet::HandleRedisPointReadRequests(
+    CoarseTimePoint deadline,
+    const ReadHybridTime& read_time,
+    const google::protobuf::RepeatedPtrField<RedisReadRequestPB>& redis_read_requests,
+    google::protobuf::RepeatedPtrField<RedisResponsePB>* responses) {
+  responses->Clear();
+  for (const auto& request : redis_read_requests) {
+    RETURN_NOT_OK(HandleRedisReadRequest(deadline, read_time, request, responses->Add()));
+  }
+  return Status::OK();
+}
+
 Status AbstractTablet::HandleQLReadRequest(CoarseTimePoint deadline,
                                            const ReadHybridTime& read_time,
                                            const QLReadRequestPB& ql_read_request,
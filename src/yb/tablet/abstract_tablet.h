@@ -57,6 +57,13 @@ class AbstractTablet {
       const RedisReadRequestPB& redis_read_request,
       RedisResponsePB* response) = 0;
 
+  // Executes batch of point read requests. Default implementation executes requests one by one.
+  virtual CHECKED_STATUS HandleRedisPointReadRequests(
+      CoarseTimePoint deadline,
+      const ReadHybridTime& read_time,
+      const google::protobuf::RepeatedPtrField<RedisReadRequestPB>& redis_read_requests,
+      google::protobuf::RepeatedPtrField<RedisResponsePB>* responses);
+
   //------------------------------------------------------------------------------------------------
   // CQL support.
   virtual CHECKED_STATUS HandleQLReadRequest(
@@ -0,0 +1,101 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/operations/import_data_operation.h"
+
+#include <glog/logging.h>
+
+#include "yb/consensus/consensus.h"
+#include "yb/server/hybrid_clock.h"
+#include "yb/tablet/tablet.h"
+#include "yb/tserver/tserver.pb.h"
+#include "yb/util/trace.h"
+
+namespace yb {
+namespace tablet {
+
+using consensus::ReplicateMsg;
+using consensus::IMPORT_DATA_OP;
+
+void ImportDataOperationState::UpdateRequestFromConsensusRound() {
+  request_ = consensus_round()->replicate_msg()->mutable_import_data_request();
+}
+
+std::string ImportDataOperationState::ToString() const {
+  return Format("ImportDataOperationState [hybrid_time=$0, source_dir=$1]",
+                hybrid_time_even_if_unset(), request_ ? request_->source_dir() : "<NONE>");
+}
+
+ImportDataOperation::ImportDataOperation(std::unique_ptr<ImportDataOperationState> state)
+    : Operation(std::move(state), OperationType::kImportData) {
+}
+
+consensus::ReplicateMsgPtr ImportDataOperation::NewReplicateMsg() {
+  auto result = std::make_shared<ReplicateMsg>();
+  result->set_op_type(IMPORT_DATA_OP);
+  auto* request = result->mutable_import_data_request();
+  request->CopyFrom(*state()->request());
+  request->set_import_id(state()->import_id());
+  request->set_min_hybrid_time(state()->hybrid_time_range().first.ToUint64());
+  request->set_max_hybrid_time(state()->hybrid_time_range().second.ToUint64());
+  return result;
+}
+
+Status ImportDataOperation::Prepare() {
+  TRACE("PREPARE IMPORT DATA: started");
+  const auto& request = *state()->request();
+  RETURN_NOT_OK(state()->tablet()->PrepareImportData(request.source_dir(), request.import_id()));
+  TRACE("PREPARE IMPORT DATA: finished");
+  return Status::OK();
+}
+
+void ImportDataOperation::DoStart() {
+  state()->TrySetHybridTimeFromClock();
+
+  TRACE("START IMPORT DATA: hybrid time: $0",
+        server::HybridClock::GetPhysicalValueMicros(state()->hybrid_time()));
+}
+
+Status ImportDataOperation::DoAborted(const Status& status) {
+  auto remove_status = state()->tablet()->RemoveImportData(state()->request()->import_id());
+  if (!remove_status.ok()) {
+    LOG(WARNING) << "Failed to remove imported files of aborted " << ToString() << ": "
+                 << remove_status;
+  }
+  return status;
+}
+
+Status ImportDataOperation::DoReplicated(int64_t leader_term, Status* complete_status) {
+  TRACE("APPLY IMPORT DATA: started");
+
+  // Source files are validated by the leader before the operation is submitted and linked into
+  // the tablet before it is replicated, so failure to import them means that the replica diverged
+  // from the others. It is fatal, since the replica cannot apply further operations consistently.
+  RETURN_NOT_OK_PREPEND(state()->tablet()->ImportData(state()),
+                        Format("Failed to import data: $0", state()->ToString()));
+
+  if (state()->response()) {
+    state()->response()->mutable_op_id()->CopyFrom(state()->op_id());
+  }
+
+  TRACE("APPLY IMPORT DATA: finished");
+
+  return Status::OK();
+}
+
+std::string ImportDataOperation::ToString() const {
+  return Format("ImportDataOperation [state=$0]", state()->ToString());
+}
+
+}  // namespace tablet
+}  // namespace yb
@@ -0,0 +1,106 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_OPERATIONS_IMPORT_DATA_OPERATION_H
+#define YB_TABLET_OPERATIONS_IMPORT_DATA_OPERATION_H
+
+#include <string>
+#include <utility>
+
+#include "yb/gutil/macros.h"
+#include "yb/tablet/operations/operation.h"
+
+namespace yb {
+namespace tablet {
+
+// Operation Context for the ImportData operation.
+class ImportDataOperationState : public OperationState {
+ public:
+  explicit ImportDataOperationState(Tablet* tablet,
+                                    const tserver::ImportDataRequestPB* request = nullptr,
+                                    tserver::ImportDataResponsePB* response = nullptr)
+      : OperationState(tablet), request_(request), response_(response) {}
+  ~ImportDataOperationState() {}
+
+  const tserver::ImportDataRequestPB* request() const override { return request_; }
+
+  tserver::ImportDataResponsePB* response() const { return response_; }
+
+  // Used by the leader to pass results of source validation to the replicated request.
+  void set_import_info(const std::string& import_id,
+                       const std::pair<HybridTime, HybridTime>& hybrid_time_range) {
+    import_id_ = import_id;
+    hybrid_time_range_ = hybrid_time_range;
+  }
+
+  const std::string& import_id() const { return import_id_; }
+
+  const std::pair<HybridTime, HybridTime>& hybrid_time_range() const {
+    return hybrid_time_range_;
+  }
+
+  void UpdateRequestFromConsensusRound() override;
+
+  std::string ToString() const override;
+
+ private:
+  // The original RPC request.
+  const tserver::ImportDataRequestPB* request_;
+
+  // The RPC response, filled with the op id of the operation. Not set on followers and during
+  // bootstrap.
+  tserver::ImportDataResponsePB* response_;
+
+  // Import info set by the leader, before the replicate message is created.
+  std::string import_id_;
+  std::pair<HybridTime, HybridTime> hybrid_time_range_;
+
+  DISALLOW_COPY_AND_ASSIGN(ImportDataOperationState);
+};
+
+// Links files produced by bulk load into the regular RocksDB of each replica.
+// Files are linked at the log position of this operation, so import is not replayed during
+// bootstrap when it was already applied.
+class ImportDataOperation : public Operation {
+ public:
+  explicit ImportDataOperation(std::unique_ptr<ImportDataOperationState> operation_state);
+
+  ImportDataOperationState* state() override {
+    return down_cast<ImportDataOperationState*>(Operation::state());
+  }
+
+  const ImportDataOperationState* state() const override {
+    return down_cast<const ImportDataOperationState*>(Operation::state());
+  }
+
+  consensus::ReplicateMsgPtr NewReplicateMsg() override;
+
+  // Links imported files into the tablet, before the operation is replicated on the leader and
+  // when it is received by a follower.
+  CHECKED_STATUS Prepare() override;
+
+  std::string ToString() const override;
+
+ private:
+  // Starts the ImportDataOperation by assigning it a timestamp.
+  void DoStart() override;
+  CHECKED_STATUS DoReplicated(int64_t leader_term, Status* complete_status) override;
+  CHECKED_STATUS DoAborted(const Status& status) override;
+
+  DISALLOW_COPY_AND_ASSIGN(ImportDataOperation);
+};
+
+}  // namespace tablet
+}  // namespace yb
+
+#endif  // YB_TABLET_OPERATIONS_IMPORT_DATA_OPERATION_H
@@ -57,7 +57,8 @@ class OperationCompletionCallback;
 class OperationState;
 
 YB_DEFINE_ENUM(OperationType,
-               (kWrite)(kChangeMetadata)(kUpdateTransaction)(kSnapshot)(kTruncate)(kEmpty));
+               (kWrite)(kChangeMetadata)(kUpdateTransaction)(kSnapshot)(kTruncate)(kImportData)
+               (kEmpty));
 
 // Base class for transactions.  There are different implementations for different types (Write,
 // AlterSchema, etc.) OperationDriver implementations use Operations along with Consensus to execute
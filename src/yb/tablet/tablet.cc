@@ -46,6 +46,7 @@
 
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/db/memtable.h"
+#include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/statistics.h"
 #include "yb/rocksdb/utilities/checkpoint.h"
@@ -74,6 +75,7 @@
 #include "yb/docdb/conflict_resolution.h"
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/cql_operation.h"
+#include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb.pb.h"
@@ -101,6 +103,7 @@
 #include "yb/tablet/transaction_coordinator.h"
 #include "yb/tablet/transaction_participant.h"
 #include "yb/tablet/operations/change_metadata_operation.h"
+#include "yb/tablet/operations/import_data_operation.h"
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/write_operation.h"
 #include "yb/tablet/operations/snapshot_operation.h"
@@ -115,6 +118,7 @@
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/shared_lock.h"
 #include "yb/util/slice.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/trace.h"
@@ -162,6 +166,18 @@ DEFINE_test_flag(
     "After modifying the flushed frontier in RocksDB, verify that the restored value of it "
     "is as expected. Used for testing.");
 
+DEFINE_int32(index_backfill_write_batch_size, 128,
+             "Number of rows of the indexed table, whose index entries are written to index "
+             "tablets in a single batch during index backfill.");
+TAG_FLAG(index_backfill_write_batch_size, advanced);
+TAG_FLAG(index_backfill_write_batch_size, runtime);
+
+DEFINE_int32(index_backfill_rate_rows_per_sec, 0,
+             "Maximum number of rows per second processed by index backfill of a single tablet. "
+             "0 means unlimited.");
+TAG_FLAG(index_backfill_rate_rows_per_sec, advanced);
+TAG_FLAG(index_backfill_rate_rows_per_sec, runtime);
+
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
 
@@ -221,6 +237,7 @@ using docdb::PrimitiveValue;
 namespace {
 
 static const std::string kSnapshotsDirSuffix = ".snapshots";
+static const std::string kImportTempDirSuffix = ".tmp";
 
 void EmitRocksDbMetricsAsJson(
     std::shared_ptr<rocksdb::Statistics> rocksdb_statistics,
@@ -553,6 +570,12 @@ Status Tablet::OpenKeyValueTablet() {
   const string db_dir = metadata()->rocksdb_dir();
   RETURN_NOT_OK(CreateTabletDirectories(db_dir, metadata()->fs_manager()));
 
+  // Level related options of the intents DB are not affected by the regular DB ones.
+  const auto intents_num_levels = rocksdb_options.num_levels;
+  const auto intents_target_file_size_base = rocksdb_options.target_file_size_base;
+  docdb::InitRegularDBOptions(&rocksdb_options);
+  docdb::SetNumLevelsForExistingDB(db_dir, &rocksdb_options);
+
   LOG(INFO) << "Opening RocksDB at: " << db_dir;
   rocksdb::DB* db = nullptr;
   rocksdb::Status rocksdb_open_status = rocksdb::DB::Open(rocksdb_options, db_dir, &db);
@@ -583,7 +606,13 @@ Status Tablet::OpenKeyValueTablet() {
       Format("$0-$1", kIntentsDB, tablet_id()), block_based_table_mem_tracker_);
 
     rocksdb::DB* intents_db = nullptr;
+    // Erasing applied intents from memtable requires single writer skip list.
+    rocksdb_options.memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
+        0 /* lookahead */, rocksdb::ConcurrentWrites::kFalse);
     rocksdb_options.in_memory_erase = true;
+    rocksdb_options.num_levels = intents_num_levels;
+    rocksdb_options.target_file_size_base = intents_target_file_size_base;
+    docdb::SetNumLevelsForExistingDB(db_dir + kIntentsDBSuffix, &rocksdb_options);
     RETURN_NOT_OK(rocksdb::DB::Open(rocksdb_options, db_dir + kIntentsDBSuffix, &intents_db));
     intents_db_.reset(intents_db);
   }
@@ -954,6 +983,20 @@ Status Tablet::HandleRedisReadRequest(CoarseTimePoint deadline,
   return Status::OK();
 }
 
+Status Tablet::HandleRedisPointReadRequests(
+    CoarseTimePoint deadline,
+    const ReadHybridTime& read_time,
+    const google::protobuf::RepeatedPtrField<RedisReadRequestPB>& redis_read_requests,
+    google::protobuf::RepeatedPtrField<RedisResponsePB>* responses) {
+  ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_read_operation);
+
+  // Latency is recorded for each read, so read metrics do not depend on batching.
+  return docdb::ExecuteRedisPointReads(
+      redis_read_requests, doc_db(), deadline, read_time, responses,
+      metrics_->redis_read_latency.get());
+}
+
 //--------------------------------------------------------------------------------------------------
 // CQL Request Processing.
 Status Tablet::HandleQLReadRequest(
@@ -1419,6 +1462,145 @@ Status Tablet::ImportData(const std::string& source_dir) {
   return regular_db_->Import(source_dir);
 }
 
+Result<std::pair<HybridTime, HybridTime>> Tablet::CheckImportData(
+    const std::string& source_dir, HybridTime import_ht) {
+  rocksdb::Options rocksdb_options;
+  docdb::InitRocksDBOptions(
+      &rocksdb_options, LogPrefix(), /* statistics */ nullptr, tablet_options_);
+  docdb::SetNumLevelsForExistingDB(source_dir, &rocksdb_options);
+  rocksdb::DB* source_db = nullptr;
+  RETURN_NOT_OK(rocksdb::DB::OpenForReadOnly(rocksdb_options, source_dir, &source_db));
+  std::unique_ptr<rocksdb::DB> source_db_holder(source_db);
+
+  auto min_ht = HybridTime::kMax;
+  auto max_ht = HybridTime::kMin;
+  std::unique_ptr<rocksdb::Iterator> iter(source_db->NewIterator(rocksdb::ReadOptions()));
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    Slice key = iter->key();
+    auto doc_ht = VERIFY_RESULT(DocHybridTime::DecodeFromEnd(&key));
+    min_ht = std::min(min_ht, doc_ht.hybrid_time());
+    max_ht = std::max(max_ht, doc_ht.hybrid_time());
+  }
+  RETURN_NOT_OK(iter->status());
+
+  if (min_ht > max_ht) {
+    return STATUS_FORMAT(NotFound, "Imported DB is empty: $0", source_dir);
+  }
+  // Imported records keep hybrid times assigned by the bulk load tool, so they should precede the
+  // import. Reads before the import are disallowed when it is applied.
+  if (max_ht >= import_ht) {
+    return STATUS_FORMAT(InvalidArgument,
+                         "Imported DB $0 contains records at $1, that is not before import at $2",
+                         source_dir, max_ht, import_ht);
+  }
+  return std::make_pair(min_ht, max_ht);
+}
+
+Status Tablet::PrepareImportData(const std::string& source_dir, const std::string& import_id) {
+  if (import_id.empty()) {
+    return STATUS_FORMAT(InvalidArgument, "Import id is not specified for $0", source_dir);
+  }
+  auto* env = metadata_->fs_manager()->env();
+  const auto imports_dir = ImportsDirName(metadata_->rocksdb_dir());
+  const auto staging_dir = JoinPathSegments(imports_dir, import_id);
+  if (env->FileExists(staging_dir)) {
+    return Status::OK();
+  }
+
+  RETURN_NOT_OK_PREPEND(metadata_->fs_manager()->CreateDirIfMissing(imports_dir),
+                        Format("Unable to create imports directory $0", imports_dir));
+
+  // Files are linked into a temporary directory that is renamed afterwards, so the staging
+  // directory always contains all of them.
+  const auto temp_dir = staging_dir + kImportTempDirSuffix;
+  if (env->FileExists(temp_dir)) {
+    RETURN_NOT_OK(env->DeleteRecursively(temp_dir));
+  }
+  RETURN_NOT_OK(env->CreateDir(temp_dir));
+  const auto files = VERIFY_RESULT(env->GetChildren(source_dir, ExcludeDots::kTrue));
+  for (const auto& file : files) {
+    RETURN_NOT_OK_PREPEND(
+        env->LinkFile(JoinPathSegments(source_dir, file), JoinPathSegments(temp_dir, file)),
+        Format("Unable to link imported file $0 from $1", file, source_dir));
+  }
+  RETURN_NOT_OK(env->SyncDir(temp_dir));
+  RETURN_NOT_OK(env->RenameFile(temp_dir, staging_dir));
+  RETURN_NOT_OK(env->SyncDir(imports_dir));
+
+  LOG_WITH_PREFIX(INFO) << "Linked imported files from " << source_dir << " to " << staging_dir;
+  return Status::OK();
+}
+
+Status Tablet::RemoveImportData(const std::string& import_id) {
+  if (import_id.empty()) {
+    return Status::OK();
+  }
+  auto* env = metadata_->fs_manager()->env();
+  const auto staging_dir = JoinPathSegments(ImportsDirName(metadata_->rocksdb_dir()), import_id);
+  for (const auto& dir : {staging_dir + kImportTempDirSuffix, staging_dir}) {
+    if (env->FileExists(dir)) {
+      RETURN_NOT_OK(env->DeleteRecursively(dir));
+    }
+  }
+  return Status::OK();
+}
+
+void Tablet::DisallowReadsBefore(HybridTime read_time) {
+  {
+    std::lock_guard<std::mutex> lock(active_readers_mutex_);
+    earliest_read_time_allowed_ = std::max(earliest_read_time_allowed_, read_time);
+  }
+  for (;;) {
+    {
+      std::lock_guard<std::mutex> lock(active_readers_mutex_);
+      if (active_readers_cnt_.empty() || active_readers_cnt_.begin()->first >= read_time) {
+        return;
+      }
+    }
+    SleepFor(MonoDelta::FromMilliseconds(10));
+  }
+}
+
+Status Tablet::ImportData(ImportDataOperationState* operation_state) {
+  const auto& request = *operation_state->request();
+  const yb::OpId op_id(operation_state->op_id().term(), operation_state->op_id().index());
+  const auto import_ht = operation_state->hybrid_time();
+
+  // Files are linked by every replica before the operation is applied. They are linked again
+  // from the source only when bootstrap replays the operation without the staging directory.
+  RETURN_NOT_OK(PrepareImportData(request.source_dir(), request.import_id()));
+  const auto staging_dir = JoinPathSegments(
+      ImportsDirName(metadata_->rocksdb_dir()), request.import_id());
+
+  // Imported records have hybrid times before the import, so they would appear in results of
+  // reads before the import, that are started or restarted after it.
+  DisallowReadsBefore(import_ht);
+
+  docdb::ConsensusFrontier frontier;
+  frontier.set_op_id(op_id);
+  frontier.set_hybrid_time(import_ht);
+  // Restores the earliest read time allowed when the tablet is opened after restart.
+  frontier.set_history_cutoff(import_ht);
+
+  // Imported files are bounded by the actual hybrid times of their records, so frontier based
+  // decisions, like history cleanup during compactions, remain correct for them.
+  docdb::ConsensusFrontiers file_frontiers;
+  set_op_id(op_id, &file_frontiers);
+  file_frontiers.Smallest().set_hybrid_time(HybridTime(request.min_hybrid_time()));
+  file_frontiers.Largest().set_hybrid_time(HybridTime(request.max_hybrid_time()));
+
+  LOG_WITH_PREFIX(INFO) << "Importing data from " << staging_dir << " at " << frontier.ToString()
+                        << ", record hybrid times: " << file_frontiers.ToString();
+  RETURN_NOT_OK(regular_db_->Import(staging_dir, frontier.Clone(), &file_frontiers));
+
+  // Imported files are linked into the regular DB, so the staging directory is not needed anymore.
+  auto status = RemoveImportData(request.import_id());
+  if (!status.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Failed to remove " << staging_dir << ": " << status;
+  }
+  return Status::OK();
+}
+
 template <class Data>
 void InitFrontiers(const Data& data, docdb::ConsensusFrontiers* frontiers) {
   set_op_id({data.op_id.term(), data.op_id.index()}, frontiers);
@@ -1439,6 +1621,9 @@ Status Tablet::ApplyIntents(const TransactionApplyData& data) {
   // We don't set transaction field of put_batch, otherwise we would write another bunch of intents.
   docdb::ConsensusFrontiers frontiers;
   InitFrontiers(data, &frontiers);
+  // Records are written with commit hybrid time, that is lower than hybrid time of apply operation.
+  // Compaction relies on smallest frontier being not higher than hybrid time of any record.
+  frontiers.Smallest().set_hybrid_time(data.commit_ht);
   WriteBatch(&frontiers, &regular_write_batch, regular_db_.get());
   return Status::OK();
 }
@@ -1615,6 +1800,8 @@ Status Tablet::ModifyFlushedFrontier(
     rocksdb::Options rocksdb_options;
     docdb::InitRocksDBOptions(
         &rocksdb_options, LogPrefix(), /* statistics */ nullptr, tablet_options_);
+    docdb::InitRegularDBOptions(&rocksdb_options);
+    docdb::SetNumLevelsForExistingDB(checkpoint_dir_for_test, &rocksdb_options);
     rocksdb_options.create_if_missing = false;
     LOG_WITH_PREFIX(INFO) << "Opening the test RocksDB at " << checkpoint_dir_for_test
         << ", expecting to see flushed frontier of " << frontier.ToString();
@@ -2135,6 +2322,26 @@ uint64_t Tablet::GetCurrentVersionSstFilesSize() const {
   return regular_db_->GetCurrentVersionSstFilesSize();
 }
 
+bool Tablet::IsEmpty() const {
+  ScopedPendingOperation scoped_operation(&pending_op_counter_);
+  SharedLock<rw_spinlock> lock(component_lock_);
+
+  if (!pending_op_counter_.IsReady() || !regular_db_) {
+    return false;
+  }
+  for (auto* db : {regular_db_.get(), intents_db_.get()}) {
+    if (!db) {
+      continue;
+    }
+    std::unique_ptr<rocksdb::Iterator> iter(db->NewIterator(rocksdb::ReadOptions()));
+    iter->SeekToFirst();
+    if (iter->Valid() || !iter->status().ok()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 uint64_t Tablet::GetCurrentVersionSstFilesUncompressedSize() const {
   ScopedPendingOperation scoped_operation(&pending_op_counter_);
   std::lock_guard<rw_spinlock> lock(component_lock_);
@@ -2159,6 +2366,96 @@ uint64_t Tablet::GetCurrentVersionNumSSTFiles() const {
   return regular_db_->GetCurrentVersionNumSSTFiles();
 }
 
+Result<std::string> Tablet::GetMiddlePartitionKey() const {
+  ScopedPendingOperation scoped_operation(&pending_op_counter_);
+  SharedLock<rw_spinlock> lock(component_lock_);
+
+  if (!pending_op_counter_.IsReady() || !regular_db_) {
+    return STATUS_FORMAT(IllegalState, "Tablet $0 is not ready", tablet_id());
+  }
+  if (!metadata_->partition_schema().IsHashPartitioning()) {
+    return STATUS_FORMAT(NotSupported, "Tablet $0 is not hash partitioned", tablet_id());
+  }
+
+  struct FileHashRange {
+    uint32_t first;
+    uint32_t last;
+    uint64_t size;
+  };
+  std::vector<FileHashRange> ranges;
+  uint64_t total_size = 0;
+  std::vector<rocksdb::LiveFileMetaData> files;
+  regular_db_->GetLiveFilesMetaData(&files);
+  for (const auto& file : files) {
+    uint16_t first_hash = 0, last_hash = 0;
+    docdb::DocKeyDecoder first_decoder(file.smallest.key);
+    docdb::DocKeyDecoder last_decoder(file.largest.key);
+    RETURN_NOT_OK(first_decoder.DecodeCotableId());
+    RETURN_NOT_OK(last_decoder.DecodeCotableId());
+    if (VERIFY_RESULT(first_decoder.DecodeHashCode(&first_hash)) &&
+        VERIFY_RESULT(last_decoder.DecodeHashCode(&last_hash))) {
+      ranges.push_back(FileHashRange{first_hash, last_hash, file.total_size});
+      total_size += file.total_size;
+    }
+  }
+  if (total_size == 0) {
+    return STATUS_FORMAT(IllegalState, "Tablet $0 does not have SST files", tablet_id());
+  }
+
+  // Data inside each file is assumed to be uniformly distributed over its hash range, so we look
+  // for the hash code that splits tablet data into two approximately equal halves.
+  // Files from different levels could overlap, so binary search is used instead of a single pass.
+  auto size_below = [&ranges](uint32_t hash) {
+    double result = 0;
+    for (const auto& range : ranges) {
+      if (hash > range.last) {
+        result += range.size;
+      } else if (hash > range.first) {
+        result += static_cast<double>(range.size) * (hash - range.first) /
+                  (range.last - range.first + 1);
+      }
+    }
+    return result;
+  };
+  constexpr uint32_t kHashEnd = std::numeric_limits<uint16_t>::max() + 1;
+  uint32_t lower = 0, upper = kHashEnd;
+  while (upper - lower > 1) {
+    auto middle = (lower + upper) / 2;
+    if (size_below(middle) * 2 < total_size) {
+      lower = middle;
+    } else {
+      upper = middle;
+    }
+  }
+
+  const auto& partition = metadata_->partition();
+  uint32_t partition_start = partition.partition_key_start().empty()
+      ? 0 : PartitionSchema::DecodeMultiColumnHashValue(partition.partition_key_start());
+  uint32_t partition_end = partition.partition_key_end().empty()
+      ? kHashEnd : PartitionSchema::DecodeMultiColumnHashValue(partition.partition_key_end());
+  if (upper <= partition_start || upper >= partition_end) {
+    return STATUS_FORMAT(
+        IllegalState, "Tablet $0 middle hash $1 is not inside partition [$2, $3)",
+        tablet_id(), upper, partition_start, partition_end);
+  }
+  return PartitionSchema::EncodeMultiColumnHashValue(static_cast<uint16_t>(upper));
+}
+
+uint64_t Tablet::GetTotalReadOps() const {
+  if (!metrics_) {
+    return 0;
+  }
+  return metrics_->redis_read_latency->TotalCount() + metrics_->ql_read_latency->TotalCount();
+}
+
+uint64_t Tablet::GetTotalWriteOps() const {
+  if (!metrics_) {
+    return 0;
+  }
+  return metrics_->write_op_duration_client_propagated_consistency->TotalCount() +
+         metrics_->write_op_duration_commit_wait_consistency->TotalCount();
+}
+
 // ------------------------------------------------------------------------------------------------
 
 Result<TransactionOperationContextOpt> Tablet::CreateTransactionOperationContext(
@@ -2344,6 +2641,10 @@ std::string Tablet::SnapshotsDirName(const std::string& rocksdb_dir) {
   return rocksdb_dir + kSnapshotsDirSuffix;
 }
 
+std::string Tablet::ImportsDirName(const std::string& rocksdb_dir) {
+  return rocksdb_dir + kImportsDirSuffix;
+}
+
 Result<IsolationLevel> Tablet::GetIsolationLevel(const TransactionMetadataPB& transaction) {
   if (transaction.has_isolation()) {
     return transaction.isolation();
@@ -2379,6 +2680,131 @@ Result<int64_t> Tablet::CountIntents() {
   return num_intents;
 }
 
+namespace {
+
+// Flushes index writes applied to the session, returns the first error if any.
+Status FlushBackfillBatch(client::YBSession* session,
+                          std::vector<std::shared_ptr<client::YBqlWriteOp>>* index_ops) {
+  auto status = session->Flush();
+  if (status.IsIOError()) {
+    for (const auto& error : session->GetPendingErrors()) {
+      return error->status();
+    }
+  }
+  RETURN_NOT_OK(status);
+  for (const auto& index_op : *index_ops) {
+    if (!index_op->succeeded()) {
+      return STATUS_FORMAT(
+          RuntimeError, "Index backfill write failed: $0", index_op->response().error_message());
+    }
+  }
+  index_ops->clear();
+  return Status::OK();
+}
+
+} // namespace
+
+Status Tablet::BackfillIndexes(const std::vector<IndexInfo>& indexes,
+                               const std::string& start_key,
+                               HybridTime read_time,
+                               CoarseTimePoint deadline,
+                               std::string* backfilled_until,
+                               size_t* num_rows) {
+  if (!metadata_cache_) {
+    return STATUS(IllegalState, "Table metadata cache is not present for index backfill");
+  }
+
+  // Rows written after read_time should be indexed by the regular index maintenance, so all
+  // indexes should be present in the tablet schema.
+  std::vector<std::pair<const IndexInfo*, client::YBTablePtr>> index_tables;
+  index_tables.reserve(indexes.size());
+  for (const auto& index : indexes) {
+    if (!metadata_->index_map().FindIndex(index.table_id()).ok()) {
+      return STATUS_FORMAT(TryAgain, "Index $0 is not present in the tablet schema yet",
+                           index.table_id());
+    }
+    client::YBTablePtr index_table;
+    bool cache_used_ignored = false;
+    RETURN_NOT_OK(metadata_cache_->GetTable(index.table_id(), &index_table, &cache_used_ignored));
+    index_tables.emplace_back(&index, std::move(index_table));
+  }
+
+  // Prevents history needed by the scan from being garbage collected.
+  auto scoped_read_operation = VERIFY_RESULT(ScopedReadOperation::Create(
+      this, RequireLease::kFalse, ReadHybridTime::SingleTime(read_time)));
+
+  const Schema schema = SchemaRef();
+  auto txn_op_ctx = CreateTransactionOperationContext(boost::none /* transaction_id */);
+  docdb::DocRowwiseIterator iter(
+      schema, schema, txn_op_ctx, doc_db(), deadline, scoped_read_operation.read_time(),
+      &pending_op_counter_);
+  RETURN_NOT_OK(iter.Init());
+  if (!start_key.empty()) {
+    // Row with start_key could be already deleted, so the iterator is just positioned at the first
+    // row after it.
+    RETURN_NOT_OK(iter.SeekTuple(start_key));
+  }
+
+  auto session = std::make_shared<YBSession>(client_future_.get());
+  session->SetTimeout(deadline - CoarseMonoClock::now());
+
+  // Index entries are written with the user timestamp right before read_time. So entry is not
+  // written when the index row was updated or deleted by the index maintenance of a concurrent
+  // write to the indexed table after read_time, that would make the backfilled entry stale.
+  const auto user_timestamp = read_time.GetPhysicalValueMicros() - 1;
+  const auto start = CoarseMonoClock::now();
+  const auto stop_at = start + (deadline - start) / 2;
+  const size_t batch_size = std::max(FLAGS_index_backfill_write_batch_size, 1);
+  docdb::DocExprExecutor expr_executor;
+  std::vector<std::shared_ptr<client::YBqlWriteOp>> index_ops;
+  QLTableRow row;
+  size_t batch_rows = 0;
+
+  backfilled_until->clear();
+  *num_rows = 0;
+  while (VERIFY_RESULT(iter.HasNext())) {
+    if (batch_rows >= batch_size) {
+      RETURN_NOT_OK(FlushBackfillBatch(session.get(), &index_ops));
+      batch_rows = 0;
+
+      const auto rate = FLAGS_index_backfill_rate_rows_per_sec;
+      if (rate > 0) {
+        auto wait_until = start + std::chrono::microseconds(*num_rows * 1000000 / rate);
+        auto now = CoarseMonoClock::now();
+        if (wait_until > now) {
+          SleepFor(MonoDelta(std::min(wait_until, stop_at) - now));
+        }
+      }
+      if (CoarseMonoClock::now() >= stop_at) {
+        *backfilled_until = VERIFY_RESULT(iter.GetTupleId()).ToBuffer();
+        return Status::OK();
+      }
+    }
+
+    // Static columns are not indexed.
+    if (iter.IsNextStaticColumn()) {
+      iter.SkipRow();
+      continue;
+    }
+
+    row.Clear();
+    RETURN_NOT_OK(iter.NextRow(&row));
+    for (const auto& index_and_table : index_tables) {
+      std::shared_ptr<client::YBqlWriteOp> index_op(index_and_table.second->NewQLWrite());
+      auto* request = index_op->mutable_request();
+      RETURN_NOT_OK(docdb::PrepareIndexInsertRequest(
+          *index_and_table.first, row, &expr_executor, request));
+      request->set_user_timestamp_usec(user_timestamp);
+      RETURN_NOT_OK(session->Apply(index_op));
+      index_ops.push_back(std::move(index_op));
+    }
+    ++batch_rows;
+    ++*num_rows;
+  }
+
+  return FlushBackfillBatch(session.get(), &index_ops);
+}
+
 // ------------------------------------------------------------------------------------------------
 
 Result<ScopedReadOperation> ScopedReadOperation::Create(
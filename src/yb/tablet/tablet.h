@@ -114,6 +114,7 @@ class MaintenanceOpStats;
 namespace tablet {
 
 class ChangeMetadataOperationState;
+class ImportDataOperationState;
 class ScopedReadOperation;
 struct TabletMetrics;
 struct TransactionApplyData;
@@ -215,6 +216,26 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   CHECKED_STATUS ImportData(const std::string& source_dir);
 
+  // Imports SST files prepared by the bulk load tool as part of a Raft-replicated operation.
+  // The regular DB flushed frontier is moved to the operation id in the same version edit, so
+  // the operation is not replayed during bootstrap once the import is persisted.
+  // Reads at hybrid times before the operation are not allowed afterwards, since imported records
+  // keep hybrid times assigned by the bulk load tool.
+  CHECKED_STATUS ImportData(ImportDataOperationState* operation_state);
+
+  // Checks that the RocksDB located in source_dir is not empty and could be imported at
+  // import_ht, i.e. all its records have lower hybrid times. Returns the range of hybrid times
+  // of its records.
+  Result<std::pair<HybridTime, HybridTime>> CheckImportData(
+      const std::string& source_dir, HybridTime import_ht);
+
+  // Hard links files of the RocksDB located in source_dir into the staging directory of the
+  // replicated import with the specified id. Does nothing when they are already linked.
+  CHECKED_STATUS PrepareImportData(const std::string& source_dir, const std::string& import_id);
+
+  // Removes the staging directory of the replicated import with the specified id.
+  CHECKED_STATUS RemoveImportData(const std::string& import_id);
+
   CHECKED_STATUS ApplyIntents(const TransactionApplyData& data) override;
 
   CHECKED_STATUS RemoveIntents(const RemoveIntentsData& data, const TransactionId& id) override;
@@ -284,6 +305,14 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       const RedisReadRequestPB& redis_read_request,
       RedisResponsePB* response) override;
 
+  // Executes batch of point read requests (see RedisReadOperation::IsPointRead) in key order,
+  // in the calling thread.
+  CHECKED_STATUS HandleRedisPointReadRequests(
+      CoarseTimePoint deadline,
+      const ReadHybridTime& read_time,
+      const google::protobuf::RepeatedPtrField<RedisReadRequestPB>& redis_read_requests,
+      google::protobuf::RepeatedPtrField<RedisResponsePB>* responses) override;
+
   //------------------------------------------------------------------------------------------------
   // CQL Request Processing.
   CHECKED_STATUS HandleQLReadRequest(
@@ -470,9 +499,22 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       docdb::KeyValueWriteBatchPB* out);
 
   uint64_t GetCurrentVersionSstFilesSize() const;
+
+  // Returns true if neither regular nor intents DB of the tablet has any records, including
+  // deletion markers. Returns false when the tablet is not ready.
+  bool IsEmpty() const;
   uint64_t GetCurrentVersionSstFilesUncompressedSize() const;
   uint64_t GetCurrentVersionNumSSTFiles() const;
 
+  // Returns partition key that splits data of this tablet into two approximately equal halves,
+  // estimated using boundaries and sizes of live SST files. Only hash partitioned tablets are
+  // supported.
+  Result<std::string> GetMiddlePartitionKey() const;
+
+  // Number of read and write operations handled by this tablet since it was opened.
+  uint64_t GetTotalReadOps() const;
+  uint64_t GetTotalWriteOps() const;
+
   void SetHybridTimeLeaseProvider(HybridTimeLeaseProvider provider) {
     ht_lease_provider_ = std::move(provider);
   }
@@ -527,6 +569,8 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   static std::string SnapshotsDirName(const std::string& rocksdb_dir);
 
+  static std::string ImportsDirName(const std::string& rocksdb_dir);
+
   // Get the isolation level of the given transaction from the metadata stored in the provisional
   // records RocksDB.
   Result<IsolationLevel> GetIsolationLevel(const TransactionMetadataPB& transaction) override;
@@ -539,6 +583,18 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Scans the intent db. Potentially takes a long time. Used for testing/debugging.
   Result<int64_t> CountIntents();
 
+  // Writes entries of the specified indexes for rows of this tablet, read at read_time, starting
+  // from the row with the encoded primary key start_key (from the beginning when empty).
+  // Stops when about half of the time till deadline has passed, so the caller has time to respond.
+  // Sets backfilled_until to the key of the row to continue from, or clears it when all rows were
+  // processed.
+  CHECKED_STATUS BackfillIndexes(const std::vector<IndexInfo>& indexes,
+                                 const std::string& start_key,
+                                 HybridTime read_time,
+                                 CoarseTimePoint deadline,
+                                 std::string* backfilled_until,
+                                 size_t* num_rows);
+
   // Flushed intents db if necessary.
   void FlushIntentsDbIfNecessary(const yb::OpId& lastest_log_entry_op_id);
 
@@ -718,6 +774,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   Result<bool> IntentsDbFlushFilter(const rocksdb::MemTable& memtable);
 
+  // Disallows reads before read_time and waits until reads, that already started before it,
+  // are finished.
+  void DisallowReadsBefore(HybridTime read_time);
+
   template <class Ids>
   CHECKED_STATUS RemoveIntentsImpl(const RemoveIntentsData& data, const Ids& ids);
 
@@ -38,6 +38,7 @@
 #include "yb/consensus/log_util.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/consensus-test-util.h"
+#include "yb/rocksdb/utilities/checkpoint.h"
 #include "yb/server/logical_clock.h"
 #include "yb/server/metadata.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
@@ -45,6 +46,9 @@
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/util/tostring.h"
 #include "yb/tablet/tablet_options.h"
+#include "yb/tserver/tserver.pb.h"
+
+DECLARE_uint64(initial_seqno);
 
 using std::shared_ptr;
 using std::string;
@@ -80,6 +84,7 @@ class BootstrapTest : public LogTestBase {
  protected:
 
   static constexpr TableType kTableType = TableType::YQL_TABLE_TYPE;
+  static constexpr const char* kImportId = "test-import";
 
   void SetUp() override {
     LogTestBase::SetUp();
@@ -161,6 +166,54 @@ class BootstrapTest : public LogTestBase {
     return Status::OK();
   }
 
+  // Prepares a RocksDB to import, containing the row written by the operation with the specified
+  // id. Returns the directory of this RocksDB.
+  // Operation is applied to a tablet with low initial seqno, so its files could be imported into
+  // a tablet created later. Tablet data is removed afterwards, so the next bootstrap starts from
+  // scratch.
+  Result<std::string> PrepareImportSource(const OpId& opid, const TupleForAppend& row) {
+    const auto initial_seqno = FLAGS_initial_seqno;
+    FLAGS_initial_seqno = 1 << 20;
+    AppendReplicateBatch(opid, opid, {row}, true /* sync */);
+    shared_ptr<TabletClass> tablet;
+    ConsensusBootstrapInfo boot_info;
+    auto status = BootstrapTestTablet(&tablet, &boot_info);
+    FLAGS_initial_seqno = initial_seqno;
+    RETURN_NOT_OK(status);
+
+    RETURN_NOT_OK(tablet->Flush(FlushMode::kSync));
+    auto source_dir = GetTestPath("import_source");
+    RETURN_NOT_OK(rocksdb::checkpoint::CreateCheckpoint(tablet->TEST_db(), source_dir));
+
+    auto db_dir = tablet->metadata()->rocksdb_dir();
+    import_rocksdb_dir_ = db_dir;
+    tablet->Shutdown();
+    tablet.reset();
+    RETURN_NOT_OK(env_->DeleteRecursively(db_dir));
+    RETURN_NOT_OK(env_->DeleteRecursively(db_dir + kIntentsDBSuffix));
+    return source_dir;
+  }
+
+  // Appends replicated import of source_dir that overwrites all operations starting from opid
+  // index. Records of source_dir should have hybrid times starting from min_hybrid_time.
+  void AppendImportData(const OpId& opid, const std::string& source_dir,
+                        HybridTime min_hybrid_time, HybridTime hybrid_time) {
+    ASSERT_OK(RollLog());
+    auto replicate = std::make_shared<ReplicateMsg>();
+    replicate->set_op_type(consensus::IMPORT_DATA_OP);
+    *replicate->mutable_id() = opid;
+    *replicate->mutable_committed_op_id() = opid;
+    replicate->set_hybrid_time(hybrid_time.ToUint64());
+    auto* request = replicate->mutable_import_data_request();
+    request->set_tablet_id(log::kTestTablet);
+    request->set_source_dir(source_dir);
+    request->set_replicated(true);
+    request->set_import_id(kImportId);
+    request->set_min_hybrid_time(min_hybrid_time.ToUint64());
+    request->set_max_hybrid_time(hybrid_time.ToUint64());
+    AppendReplicateBatch(replicate, true /* sync */);
+  }
+
   void IterateTabletRows(const Tablet* tablet,
                          vector<string>* results) {
     auto iter = tablet->NewRowIterator(schema_, boost::none);
@@ -170,6 +223,10 @@ class BootstrapTest : public LogTestBase {
       VLOG(1) << result;
     }
   }
+
+  // RocksDB directory of the tablet, that the source prepared by PrepareImportSource is imported
+  // into.
+  std::string import_rocksdb_dir_;
 };
 
 // Tests a normal bootstrap scenario.
@@ -361,5 +418,70 @@ TEST_F(BootstrapTest, TestBootstrapHighOpIdIndex) {
   ASSERT_OPID_EQ(last_opid, boot_info.last_committed_id);
 }
 
+// Tests that replicated import is replayed during bootstrap, when it was not flushed.
+TEST_F(BootstrapTest, TestImportData) {
+  BuildLog();
+
+  auto before_write = clock_->Now();
+  auto source_dir = ASSERT_RESULT(PrepareImportSource(
+      MakeOpId(1, 1), TupleForAppend(100, 7, "imported row")));
+
+  // Import overwrites the write operation that produced the source, so the imported row could
+  // appear in the tablet only through the import.
+  const OpId import_opid = MakeOpId(2, 1);
+  auto import_ht = clock_->Now();
+  AppendImportData(import_opid, source_dir, before_write, import_ht);
+
+  ConsensusBootstrapInfo boot_info;
+  shared_ptr<TabletClass> tablet;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+  ASSERT_EQ(boot_info.orphaned_replicates.size(), 0);
+  ASSERT_OPID_EQ(boot_info.last_committed_id, import_opid);
+
+  vector<string> results;
+  IterateTabletRows(tablet.get(), &results);
+  ASSERT_EQ(1, results.size());
+  ASSERT_EQ("{ int32_value: 100 int32_value: 7 string_value: \"imported row\" }", results[0]);
+
+  // Imported row has hybrid time before the import, but it should not appear in reads before it.
+  auto read_op = ScopedReadOperation::Create(
+      tablet.get(), RequireLease::kFalse, ReadHybridTime::SingleTime(before_write));
+  ASSERT_TRUE(read_op.status().IsSnapshotTooOld()) << read_op.status();
+
+  // Import moves the flushed frontier, so it is not replayed again.
+  auto op_ids = ASSERT_RESULT(tablet->MaxPersistentOpId());
+  ASSERT_EQ(import_opid.index(), op_ids.regular.index);
+
+  // Linked files are removed after import.
+  ASSERT_FALSE(env_->FileExists(JoinPathSegments(
+      Tablet::ImportsDirName(tablet->metadata()->rocksdb_dir()), kImportId)));
+}
+
+// Tests that import is replayed from files linked into the tablet before the operation was
+// applied, after the source files were removed.
+TEST_F(BootstrapTest, TestImportDataAfterSourceRemoved) {
+  BuildLog();
+
+  auto before_write = clock_->Now();
+  auto source_dir = ASSERT_RESULT(PrepareImportSource(
+      MakeOpId(1, 1), TupleForAppend(100, 7, "imported row")));
+
+  AppendImportData(MakeOpId(2, 1), source_dir, before_write, clock_->Now());
+
+  // Move source files to the place where the replica links them before applying the import.
+  auto imports_dir = Tablet::ImportsDirName(import_rocksdb_dir_);
+  ASSERT_OK(env_->CreateDir(imports_dir));
+  ASSERT_OK(env_->RenameFile(source_dir, JoinPathSegments(imports_dir, kImportId)));
+
+  ConsensusBootstrapInfo boot_info;
+  shared_ptr<TabletClass> tablet;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+
+  vector<string> results;
+  IterateTabletRows(tablet.get(), &results);
+  ASSERT_EQ(1, results.size());
+  ASSERT_EQ("{ int32_value: 100 int32_value: 7 string_value: \"imported row\" }", results[0]);
+}
+
 } // namespace tablet
 } // namespace yb
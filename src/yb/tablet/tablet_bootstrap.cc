@@ -40,6 +40,7 @@
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/operations/change_metadata_operation.h"
+#include "yb/tablet/operations/import_data_operation.h"
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/update_txn_operation.h"
 #include "yb/tablet/operations/write_operation.h"
@@ -700,6 +701,9 @@ Status TabletBootstrap::HandleOperation(consensus::OperationType op_type,
     case consensus::TRUNCATE_OP:
       return PlayTruncateRequest(replicate);
 
+    case consensus::IMPORT_DATA_OP:
+      return PlayImportDataRequest(replicate);
+
     case consensus::NO_OP:
       return PlayNoOpRequest(replicate);
 
@@ -789,6 +793,13 @@ Status TabletBootstrap::HandleEntryPair(
           OperationType_Name(op_type), *replicate));
     }
     state->max_committed_hybrid_time.MakeAtLeast(HybridTime(replicate->hybrid_time()));
+  } else if (op_type == consensus::IMPORT_DATA_OP) {
+    // The import was persisted, but its staging directory could remain if we crashed right
+    // after that.
+    auto status = tablet_->RemoveImportData(replicate->import_data_request().import_id());
+    if (!status.ok()) {
+      LOG_WITH_PREFIX(WARNING) << "Failed to remove imported files: " << status;
+    }
   }
 
   return Status::OK();
@@ -1101,6 +1112,21 @@ Status TabletBootstrap::PlayTruncateRequest(ReplicateMsg* replicate_msg) {
   return Status::OK();
 }
 
+Status TabletBootstrap::PlayImportDataRequest(ReplicateMsg* replicate_msg) {
+  ImportDataOperationState operation_state(nullptr, replicate_msg->mutable_import_data_request());
+  operation_state.mutable_op_id()->CopyFrom(replicate_msg->id());
+  operation_state.set_hybrid_time(HybridTime(replicate_msg->hybrid_time()));
+
+  // Files were linked into the tablet before the operation was applied, and the source files
+  // are removed only after all replicas applied it. So failure to replay the import means that
+  // the tablet data could not be restored.
+  Status s = tablet_->ImportData(&operation_state);
+
+  RETURN_NOT_OK_PREPEND(s, Format("Failed to import data at $0:", replicate_msg->id()));
+
+  return Status::OK();
+}
+
 Status TabletBootstrap::PlayUpdateTransactionRequest(
     ReplicateMsg* replicate_msg, AlreadyApplied already_applied) {
   DCHECK(replicate_msg->has_hybrid_time());
@@ -124,6 +124,8 @@ class TabletBootstrap {
 
   CHECKED_STATUS PlayTruncateRequest(consensus::ReplicateMsg* replicate_msg);
 
+  CHECKED_STATUS PlayImportDataRequest(consensus::ReplicateMsg* replicate_msg);
+
   CHECKED_STATUS PlayTabletSnapshotOpRequest(consensus::ReplicateMsg* replicate_msg);
 
   void DumpReplayStateToLog(const ReplayState& state);
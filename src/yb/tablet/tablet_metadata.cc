@@ -82,6 +82,7 @@ namespace tablet {
 const int64 kNoDurableMemStore = -1;
 const std::string kIntentsSubdir = "intents";
 const std::string kIntentsDBSuffix = ".intents";
+const std::string kImportsDirSuffix = ".imports";
 
 // ============================================================================
 //  Raft group metadata
@@ -403,6 +404,15 @@ Status RaftGroupMetadata::DeleteTabletData(TabletDataState delete_type,
     }
   }
 
+  // Files of replicated imports, that were linked but not yet applied.
+  const auto imports_dir = rocksdb_dir + kImportsDirSuffix;
+  if (fs_manager_->env()->FileExists(imports_dir)) {
+    status = fs_manager_->env()->DeleteRecursively(imports_dir);
+    if (!status.ok()) {
+      LOG(ERROR) << "Failed to delete imports directory: " << imports_dir << ": " << status;
+    }
+  }
+
   // Flushing will sync the new tablet_data_state_ to disk and will now also
   // delete all the data.
   RETURN_NOT_OK(Flush());
@@ -498,6 +498,7 @@ CHECKED_STATUS MigrateSuperblock(RaftGroupReplicaSuperBlockPB* superblock);
 
 extern const std::string kIntentsSubdir;
 extern const std::string kIntentsDBSuffix;
+extern const std::string kImportsDirSuffix;
 
 } // namespace tablet
 } // namespace yb
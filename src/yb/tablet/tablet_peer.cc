@@ -71,6 +71,7 @@
 #include "yb/tablet/tablet_peer_mm_ops.h"
 
 #include "yb/tablet/operations/change_metadata_operation.h"
+#include "yb/tablet/operations/import_data_operation.h"
 #include "yb/tablet/operations/operation_driver.h"
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/write_operation.h"
@@ -173,7 +174,8 @@ Status TabletPeer::InitTabletPeer(const shared_ptr<TabletClass> &tablet,
                                   const scoped_refptr<MetricEntity> &metric_entity,
                                   ThreadPool* raft_pool,
                                   ThreadPool* tablet_prepare_pool,
-                                  consensus::RetryableRequests* retryable_requests) {
+                                  consensus::RetryableRequests* retryable_requests,
+                                  consensus::MultiRaftManager* multi_raft_manager) {
 
   DCHECK(tablet) << "A TabletPeer must be provided with a Tablet";
   DCHECK(log) << "A TabletPeer must be provided with a Log";
@@ -251,7 +253,8 @@ Status TabletPeer::InitTabletPeer(const shared_ptr<TabletClass> &tablet,
         mark_dirty_clbk_,
         tablet_->table_type(),
         raft_pool,
-        retryable_requests);
+        retryable_requests,
+        multi_raft_manager);
     has_consensus_.store(true, std::memory_order_release);
     auto ht_lease_provider = [this](MicrosTime min_allowed, CoarseTimePoint deadline) {
       MicrosTime lease_micros {
@@ -655,6 +658,9 @@ consensus::OperationType MapOperationTypeToPB(OperationType operation_type) {
     case OperationType::kTruncate:
       return consensus::TRUNCATE_OP;
 
+    case OperationType::kImportData:
+      return consensus::IMPORT_DATA_OP;
+
     case OperationType::kEmpty:
       LOG(FATAL) << "OperationType::kEmpty cannot be converted to consensus::OperationType";
   }
@@ -822,6 +828,12 @@ std::unique_ptr<Operation> TabletPeer::CreateOperation(consensus::ReplicateMsg*
       return std::make_unique<TruncateOperation>(
           std::make_unique<TruncateOperationState>(tablet()));
 
+    case consensus::IMPORT_DATA_OP:
+      DCHECK(replicate_msg->has_import_data_request()) << "IMPORT_DATA_OP replica"
+          " operation must receive an ImportDataRequestPB";
+      return std::make_unique<ImportDataOperation>(
+          std::make_unique<ImportDataOperationState>(tablet()));
+
     case consensus::SNAPSHOT_OP:
        DCHECK(replicate_msg->has_snapshot_request()) << "SNAPSHOT_OP replica"
           " transaction must receive an TabletSnapshotOpRequestPB";
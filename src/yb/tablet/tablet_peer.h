@@ -119,7 +119,8 @@ class TabletPeer : public consensus::ReplicaOperationFactory,
                                 const scoped_refptr<MetricEntity> &metric_entity,
                                 ThreadPool* raft_pool,
                                 ThreadPool* tablet_prepare_pool,
-                                consensus::RetryableRequests* retryable_requests);
+                                consensus::RetryableRequests* retryable_requests,
+                                consensus::MultiRaftManager* multi_raft_manager = nullptr);
 
   // Starts the TabletPeer, making it available for Write()s. If this
   // TabletPeer is part of a consensus configuration this will connect it to other peers
@@ -11,6 +11,8 @@
 // under the License.
 //
 
+#include <sys/stat.h>
+
 #include <string>
 #include <thread>
 #include <gtest/gtest.h>
@@ -70,6 +72,7 @@ static const char* const kTableName = "my_table";
 static constexpr int32_t kNumIterations = NonTsanVsTsan(10000, 30);
 static constexpr int32_t kNumTablets = NonTsanVsTsan(3, 3);
 static constexpr int32_t kNumTabletServers = 1;
+static constexpr int32_t kNumReplicas = 3;
 static constexpr int32_t kV2Value = 12345;
 static constexpr size_t kV2Index = 5;
 static constexpr uint64_t kNumFilesPerTablet = 5;
@@ -83,7 +86,7 @@ class YBBulkLoadTest : public YBMiniClusterTestBase<MiniCluster> {
     YBMiniClusterTestBase::SetUp();
     MiniClusterOptions opts;
 
-    opts.num_tablet_servers = kNumTabletServers;
+    opts.num_tablet_servers = num_tablet_servers();
 
     // Use a high enough initial sequence number.
     FLAGS_initial_seqno = 1 << 20;
@@ -138,6 +141,10 @@ class YBBulkLoadTest : public YBMiniClusterTestBase<MiniCluster> {
     ASSERT_OK(partition_generator_->Init());
   }
 
+  virtual int num_tablet_servers() const {
+    return kNumTabletServers;
+  }
+
   void DoTearDown() override {
     client_messenger_->Shutdown();
     client_.reset();
@@ -391,6 +398,52 @@ class YBBulkLoadTestWithoutRebalancing : public YBBulkLoadTest {
   }
 };
 
+class YBBulkLoadReplicatedImportTest : public YBBulkLoadTestWithoutRebalancing {
+ public:
+  void SetUp() override {
+    FLAGS_replication_factor = kNumReplicas;
+    YBBulkLoadTestWithoutRebalancing::SetUp();
+  }
+
+  int num_tablet_servers() const override {
+    return kNumReplicas;
+  }
+
+ protected:
+  // Writes an executable script with the specified body to the test directory.
+  CHECKED_STATUS WriteScript(const string& name, const string& body, string* path) {
+    *path = JoinPathSegments(GetTestDataDirectory(), name);
+    RETURN_NOT_OK(WriteStringToFile(env_.get(), "#!/usr/bin/env bash\nset -eu\n" + body, *path));
+    if (chmod(path->c_str(), 0755) != 0) {
+      return STATUS_FORMAT(IOError, "Failed to make $0 executable: $1", *path, errno);
+    }
+    return Status::OK();
+  }
+
+  // Returns number of regular DB records of each tablet of the test table on every replica.
+  std::map<TabletId, vector<size_t>> CountRecords() {
+    std::map<TabletId, vector<size_t>> result;
+    for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      for (const auto& peer : cluster_->GetTabletPeers(i)) {
+        if (peer->tablet() && peer->tablet_metadata()->table_id() == table_->id()) {
+          result[peer->tablet_id()].push_back(peer->tablet()->TEST_CountRegularDBRecords());
+        }
+      }
+    }
+    return result;
+  }
+
+  void VerifyRecords(const std::map<TabletId, vector<size_t>>& records) {
+    ASSERT_EQ(kNumTablets, records.size());
+    for (const auto& tablet_records : records) {
+      ASSERT_EQ(kNumReplicas, tablet_records.second.size()) << tablet_records.first;
+      ASSERT_GT(tablet_records.second.front(), 0) << tablet_records.first;
+      for (auto count : tablet_records.second) {
+        ASSERT_EQ(tablet_records.second.front(), count) << tablet_records.first;
+      }
+    }
+  }
+};
 
 TEST_F(YBBulkLoadTest, VerifyPartitions) {
   for (int i = 0; i < kNumIterations; i++) {
@@ -694,5 +747,103 @@ TEST_F_EX(YBBulkLoadTest, TestCLITool, YBBulkLoadTestWithoutRebalancing) {
   }
 }
 
+// Runs the bulk load tool with --bulk_load_replicated_import and checks that the import is applied
+// by all replicas before files are removed, and survives restart.
+TEST_F(YBBulkLoadReplicatedImportTest, ReplicatedImport) {
+  const int num_rows = NonTsanVsTsan(1000, 30);
+  vector<string> input;
+  for (int i = 0; i < num_rows; i++) {
+    string row = GenerateRow(i);
+    string tablet_id;
+    string partition_key;
+    ASSERT_OK(partition_generator_->LookupTabletId(row, &tablet_id, &partition_key));
+    input.push_back(tablet_id + "\t" + row + "\n");
+  }
+  std::sort(input.begin(), input.end());
+
+  // Replicas of the mini cluster share the file system, so the helper script places files to
+  // a single directory used by all of them.
+  const string test_dir = GetTestDataDirectory();
+  const string shared_dir = JoinPathSegments(test_dir, "shared");
+  const string bulk_load_data = JoinPathSegments(test_dir, "bulk_load_data");
+  const string cleanup_log = JoinPathSegments(test_dir, "cleanup.log");
+  ASSERT_OK(env_->CreateDir(shared_dir));
+  ASSERT_OK(env_->CreateDir(bulk_load_data));
+
+  string helper_script;
+  ASSERT_OK(WriteScript("bulk_load_helper.sh",
+      "while getopts 't:r:i:d:' opt; do\n"
+      "  case $opt in\n"
+      "    t) tablet=$OPTARG ;;\n"
+      "    r) replicas=$OPTARG ;;\n"
+      "    d) dir=$OPTARG ;;\n"
+      "    *) ;;\n"
+      "  esac\n"
+      "done\n"
+      "dest=" + shared_dir + "/$tablet\n"
+      "cp -r \"$dir\" \"$dest\"\n"
+      "for host in ${replicas//,/ }; do\n"
+      "  echo \"$host,$dest\"\n"
+      "done\n",
+      &helper_script));
+  string cleanup_script;
+  ASSERT_OK(WriteScript("bulk_load_cleanup.sh",
+      "while getopts 'd:t:i:' opt; do\n"
+      "  case $opt in\n"
+      "    d) dir=$OPTARG ;;\n"
+      "    t) host=$OPTARG ;;\n"
+      "    *) ;;\n"
+      "  esac\n"
+      "done\n"
+      "echo \"$host $dir\" >> " + cleanup_log + "\n"
+      "rm -rf \"$dir\"\n",
+      &cleanup_script));
+
+  vector<string> bulk_load_argv = {
+      kBulkLoadToolName,
+      "-master_addresses", master_addresses_comma_separated_,
+      "-table_name", kTableName,
+      "-namespace_name", kNamespace,
+      "-base_dir", bulk_load_data,
+      "-initial_seqno", "0",
+      "-export_files",
+      "-ssh_key_file", "unused",
+      "-bulk_load_helper_script", helper_script,
+      "-bulk_load_cleanup_script", cleanup_script,
+      "-bulk_load_replicated_import"
+  };
+
+  FILE *out;
+  FILE *in;
+  std::unique_ptr<Subprocess> bulk_load_process;
+  ASSERT_OK(StartProcessAndGetStreams(GetToolPath(kBulkLoadToolName), bulk_load_argv, &out, &in,
+                                      &bulk_load_process));
+  for (const auto& line : input) {
+    ASSERT_GT(fprintf(out, "%s", line.c_str()), 0);
+  }
+  ASSERT_EQ(0, fflush(out));
+  CloseStreamsAndWaitForProcess(out, in, bulk_load_process.get());
+
+  // Files are removed from every replica, and only after all of them applied the import.
+  string cleanup_log_content;
+  ASSERT_OK(ReadFileToString(env_.get(), cleanup_log, &cleanup_log_content));
+  vector<string> cleanup_lines;
+  boost::split(cleanup_lines, boost::trim_copy(cleanup_log_content), boost::is_any_of("\n"));
+  ASSERT_EQ(kNumTablets * kNumReplicas, cleanup_lines.size()) << cleanup_log_content;
+  vector<string> shared_files;
+  ASSERT_OK(env_->GetChildren(shared_dir, &shared_files));
+  for (const auto& file : shared_files) {
+    ASSERT_TRUE(file == "." || file == "..") << file;
+  }
+
+  auto records = CountRecords();
+  ASSERT_NO_FATALS(VerifyRecords(records));
+
+  // Imported files are persisted by all replicas, so the import is not replayed on restart.
+  ASSERT_OK(cluster_->RestartSync());
+  ASSERT_OK(WaitFor([this, &records] { return CountRecords() == records; },
+                    30s, "Wait for imported records after restart"));
+}
+
 } // namespace tools
 } // namespace yb
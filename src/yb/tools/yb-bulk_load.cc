@@ -46,6 +46,7 @@
 #include "yb/util/threadpool.h"
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
+#include "yb/util/monotime.h"
 #include "yb/util/path_util.h"
 #include "yb/util/subprocess.h"
 
@@ -85,6 +86,13 @@ DEFINE_int32(bulk_load_max_background_flushes, 2, "Number of flushes to perform
 DEFINE_uint64(bulk_load_num_files_per_tablet, 5,
               "Determines how to compact the data of a tablet to ensure we have only a certain "
               "number of sst files per tablet");
+DEFINE_bool(bulk_load_replicated_import, false,
+            "Import files through a Raft-replicated operation submitted to the tablet leader, "
+            "instead of importing them on each replica independently. Requires the helper script "
+            "to copy files to the same directory on every replica.");
+DEFINE_int32(bulk_load_replicated_import_timeout_sec, 300,
+             "How long to wait for all replicas to apply the replicated import, before giving up. "
+             "Imported files are removed from replicas only after all of them applied the import.");
 
 DECLARE_string(skipped_cols);
 
@@ -409,6 +417,7 @@ Status BulkLoad::FinishTabletProcessing(const TabletId &tablet_id,
   master::TabletLocationsPB tablet_locations;
   RETURN_NOT_OK(client_->GetTabletLocation(tablet_id, &tablet_locations));
   string csv_replicas;
+  string leader_host;
   std::map<string, int32_t> host_to_rpcport;
   for (const master::TabletLocationsPB_ReplicaPB &replica : tablet_locations.replicas()) {
     if (!csv_replicas.empty()) {
@@ -417,6 +426,9 @@ Status BulkLoad::FinishTabletProcessing(const TabletId &tablet_id,
     const string &host = replica.ts_info().private_rpc_addresses(0).host();
     csv_replicas += host;
     host_to_rpcport[host] = replica.ts_info().private_rpc_addresses(0).port();
+    if (replica.role() == consensus::RaftPeerPB::LEADER) {
+      leader_host = host;
+    }
   }
 
   // Invoke the bulk_load_helper script.
@@ -429,10 +441,8 @@ Status BulkLoad::FinishTabletProcessing(const TabletId &tablet_id,
   boost::trim(bulk_load_helper_stdout);
   LOG(INFO) << "Helper script stdout: " << bulk_load_helper_stdout;
 
-  // Finalize the import.
-  rpc::MessengerBuilder bld("Client");
-  std::unique_ptr<rpc::Messenger> client_messenger = VERIFY_RESULT(bld.Build());
-  rpc::ProxyCache proxy_cache(client_messenger.get());
+  // Parse the (replica host, directory) pairs.
+  vector<std::pair<string, string>> replica_dirs;
   vector<string> lines;
   boost::split(lines, bulk_load_helper_stdout, boost::is_any_of("\n"));
   for (const string &line : lines) {
@@ -441,22 +451,97 @@ Status BulkLoad::FinishTabletProcessing(const TabletId &tablet_id,
     if (tokens.size() != 2) {
       return STATUS_SUBSTITUTE(InvalidArgument, "Invalid line $0", line);
     }
-    const string &replica_host = tokens[0];
-    const string &directory = tokens[1];
-    HostPort hostport(replica_host, host_to_rpcport[replica_host]);
+    replica_dirs.emplace_back(tokens[0], tokens[1]);
+  }
+
+  // Finalize the import.
+  rpc::MessengerBuilder bld("Client");
+  std::unique_ptr<rpc::Messenger> client_messenger = VERIFY_RESULT(bld.Build());
+  rpc::ProxyCache proxy_cache(client_messenger.get());
+  auto send_import_request = [&](const string& host,
+                                 tserver::ImportDataRequestPB* req,
+                                 tserver::ImportDataResponsePB* resp) -> Status {
+    HostPort hostport(host, host_to_rpcport[host]);
 
     tserver::TabletServerServiceProxy proxy(&proxy_cache, hostport);
+    req->set_tablet_id(tablet_id);
+
+    rpc::RpcController controller;
+    RETURN_NOT_OK(proxy.ImportData(*req, resp, &controller));
+    if (resp->has_error()) {
+      RETURN_NOT_OK(StatusFromPB(resp->error().status()));
+    }
+    return Status::OK();
+  };
+
+  auto import_data = [&](const string& host, const string& directory, bool replicated,
+                         OpIdPB* op_id) -> Status {
     tserver::ImportDataRequestPB req;
-    req.set_tablet_id(tablet_id);
     req.set_source_dir(directory);
+    req.set_replicated(replicated);
 
     tserver::ImportDataResponsePB resp;
-    rpc::RpcController controller;
-    LOG(INFO) << "Importing " << directory << " on " << replica_host << " for tablet_id: "
-              << tablet_id;
-    RETURN_NOT_OK(proxy.ImportData(req, &resp, &controller));
-    if (resp.has_error()) {
-      RETURN_NOT_OK(StatusFromPB(resp.error().status()));
+    LOG(INFO) << "Importing " << directory << " on " << host << " for tablet_id: "
+              << tablet_id << (replicated ? " (replicated)" : "");
+    RETURN_NOT_OK(send_import_request(host, &req, &resp));
+    if (op_id) {
+      *op_id = resp.op_id();
+    }
+    return Status::OK();
+  };
+
+  // Source files are linked by each replica when it applies the import, that happens
+  // asynchronously on followers. So files could be removed only after all replicas applied it.
+  auto wait_import_applied = [&](const string& host, const OpIdPB& op_id) -> Status {
+    auto deadline = MonoTime::Now() + MonoDelta::FromSeconds(
+        FLAGS_bulk_load_replicated_import_timeout_sec);
+    auto delay = MonoDelta::FromMilliseconds(100);
+    for (;;) {
+      tserver::ImportDataRequestPB req;
+      *req.mutable_check_applied_op_id() = op_id;
+      tserver::ImportDataResponsePB resp;
+      auto status = send_import_request(host, &req, &resp);
+      if (status.ok()) {
+        return Status::OK();
+      }
+      if (MonoTime::Now() + delay > deadline) {
+        return status.CloneAndPrepend(Format(
+            "Replica $0 did not apply import $1 of tablet $2", host, op_id.ShortDebugString(),
+            tablet_id));
+      }
+      VLOG(1) << "Waiting for " << host << " to apply import of tablet " << tablet_id << ": "
+              << status;
+      SleepFor(delay);
+      delay = std::min(delay * 2, MonoDelta::FromSeconds(5));
+    }
+  };
+
+  if (FLAGS_bulk_load_replicated_import) {
+    // All replicas link files from the same path when the operation is applied, so the helper
+    // script should place them identically.
+    for (const auto& replica_dir : replica_dirs) {
+      if (replica_dir.second != replica_dirs.front().second) {
+        return STATUS_FORMAT(
+            IllegalState, "Replicated import requires the same directory on all replicas: $0 vs $1",
+            replica_dir.second, replica_dirs.front().second);
+      }
+    }
+    if (leader_host.empty()) {
+      return STATUS_FORMAT(NotFound, "No leader for tablet $0", tablet_id);
+    }
+    OpIdPB op_id;
+    RETURN_NOT_OK(import_data(
+        leader_host, replica_dirs.front().second, /* replicated */ true, &op_id));
+    for (const auto& replica_dir : replica_dirs) {
+      RETURN_NOT_OK(wait_import_applied(replica_dir.first, op_id));
+    }
+  }
+
+  for (const auto& replica_dir : replica_dirs) {
+    const string &replica_host = replica_dir.first;
+    const string &directory = replica_dir.second;
+    if (!FLAGS_bulk_load_replicated_import) {
+      RETURN_NOT_OK(import_data(replica_host, directory, /* replicated */ false, nullptr));
     }
 
     // Now cleanup the files from the production tserver.
@@ -35,6 +35,8 @@
 #include <memory>
 #include <vector>
 #include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <gflags/gflags.h>
 #include <glog/logging.h>
@@ -127,6 +129,9 @@ class Heartbeater::Thread {
   void SetupCommonField(master::TSToMasterCommonPB* common);
   bool IsCurrentThread() const;
   uint64_t CalculateUptime();
+  void FillTabletLeaderMetrics(
+      const std::vector<std::shared_ptr<tablet::TabletPeer>>& tablet_peers,
+      double elapsed_seconds, master::TServerMetricsPB* metrics);
 
   const std::string& LogPrefix() const {
     return log_prefix_;
@@ -192,6 +197,9 @@ class Heartbeater::Thread {
   uint64_t prev_reads_ = 0;
   uint64_t prev_writes_ = 0;
 
+  // Stores the total read and write ops of tablets led by this server, keyed by tablet id.
+  std::unordered_map<TabletId, std::pair<uint64_t, uint64_t>> prev_tablet_ops_;
+
   MonoTime start_time_;
 
   rpc::Rpcs rpcs_;
@@ -351,6 +359,73 @@ uint64_t Heartbeater::Thread::CalculateUptime() {
   return uptime_seconds;
 }
 
+void Heartbeater::Thread::FillTabletLeaderMetrics(
+    const std::vector<std::shared_ptr<tablet::TabletPeer>>& tablet_peers,
+    double elapsed_seconds, master::TServerMetricsPB* metrics) {
+  // Load of the tablet is used by the master only to pick split candidates.
+  const bool split_enabled = last_hb_response_.tablet_split_enabled();
+  // Emptiness is only used by the master to skip backfill, and checking it opens iterators.
+  const std::unordered_set<TableId> backfill_pending_tables(
+      last_hb_response_.backfill_pending_table_ids().begin(),
+      last_hb_response_.backfill_pending_table_ids().end());
+  decltype(prev_tablet_ops_) tablet_ops;
+  for (const auto& tablet_peer : tablet_peers) {
+    if (!tablet_peer ||
+        tablet_peer->LeaderStatus() != consensus::LeaderStatus::LEADER_AND_READY) {
+      continue;
+    }
+    auto tablet = tablet_peer->shared_tablet();
+    if (!tablet) {
+      continue;
+    }
+    const auto& tablet_id = tablet_peer->tablet_id();
+
+    // Schema version is taken before the check, so writes applied after it already had that
+    // schema.
+    auto schema_version = tablet->metadata()->schema_version();
+    auto sst_files_size = tablet->GetCurrentVersionSstFilesSize();
+    bool empty = sst_files_size == 0 &&
+                 backfill_pending_tables.count(tablet->metadata()->table_id()) &&
+                 tablet->IsEmpty();
+    if (!split_enabled && !empty) {
+      continue;
+    }
+    auto* tablet_metrics = metrics->add_tablet_leader_metrics();
+    tablet_metrics->set_tablet_id(tablet_id);
+    if (empty) {
+      tablet_metrics->set_empty_at_schema_version(schema_version);
+    }
+    if (!split_enabled) {
+      continue;
+    }
+
+    auto num_reads = tablet->GetTotalReadOps();
+    auto num_writes = tablet->GetTotalWriteOps();
+    tablet_ops.emplace(tablet_id, std::make_pair(num_reads, num_writes));
+    tablet_metrics->set_sst_files_size(sst_files_size);
+    auto it = prev_tablet_ops_.find(tablet_id);
+    // Rates are reported only when we have previous values, i.e. starting from the second
+    // submission after this server became leader.
+    if (it != prev_tablet_ops_.end() && elapsed_seconds > 0) {
+      tablet_metrics->set_read_ops_per_sec(
+          static_cast<double>(num_reads - it->second.first) / elapsed_seconds);
+      tablet_metrics->set_write_ops_per_sec(
+          static_cast<double>(num_writes - it->second.second) / elapsed_seconds);
+    }
+    // Split key is estimated from SST file boundaries, so there is none without them.
+    if (sst_files_size != 0) {
+      auto split_partition_key = tablet->GetMiddlePartitionKey();
+      if (split_partition_key.ok()) {
+        tablet_metrics->set_split_partition_key(*split_partition_key);
+      } else {
+        VLOG_WITH_PREFIX(4) << "Unable to get split key for " << tablet_id << ": "
+                            << split_partition_key.status();
+      }
+    }
+  }
+  prev_tablet_ops_.swap(tablet_ops);
+}
+
 Status Heartbeater::Thread::TryHeartbeat() {
   master::TSHeartbeatRequestPB req;
 
@@ -427,6 +502,7 @@ Status Heartbeater::Thread::TryHeartbeat() {
     prev_writes_ = num_writes;
     req.mutable_metrics()->set_read_ops_per_sec(rops_per_sec);
     req.mutable_metrics()->set_write_ops_per_sec(wops_per_sec);
+    FillTabletLeaderMetrics(tablet_peers, div, req.mutable_metrics());
     uint64_t uptime_seconds = CalculateUptime();
 
     req.mutable_metrics()->set_uptime_seconds(uptime_seconds);
@@ -0,0 +1,137 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/pg_table_cache.h"
+
+#include <glog/logging.h>
+
+#include "yb/client/client.h"
+#include "yb/client/table.h"
+
+#include "yb/common/wire_protocol.h"
+
+namespace yb {
+namespace tserver {
+
+bool PgTableCache::Entry::IsValid(
+    uint64_t min_catalog_version, const boost::optional<uint32_t>& outdated_schema_version) const {
+  if (!info || catalog_version < min_catalog_version) {
+    return false;
+  }
+  return !outdated_schema_version || info->schema().version() > *outdated_schema_version;
+}
+
+PgTableCache::PgTableCache(std::shared_future<client::YBClient*> client_future)
+    : client_future_(std::move(client_future)) {
+}
+
+PgTableCache::~PgTableCache() {
+}
+
+Status PgTableCache::GetTableInfo(
+    const GetTableInfoRequestPB& req, uint64_t catalog_version, GetTableInfoResponsePB* resp) {
+  const TableId& table_id = req.table_id();
+  const auto min_catalog_version = std::max(req.ysql_catalog_version(), catalog_version);
+  boost::optional<uint32_t> outdated_schema_version;
+  if (req.has_outdated_schema_version()) {
+    outdated_schema_version = req.outdated_schema_version();
+  }
+
+  TableInfoPtr info;
+  std::shared_ptr<Entry> entry;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    EvictOutdatedEntries(min_catalog_version);
+    auto& entry_ptr = entries_[table_id];
+    if (!entry_ptr) {
+      entry_ptr = std::make_shared<Entry>();
+    } else if (entry_ptr->IsValid(min_catalog_version, outdated_schema_version)) {
+      info = entry_ptr->info;
+    }
+    entry = entry_ptr;
+  }
+
+  if (!info) {
+    std::lock_guard<std::mutex> load_lock(entry->load_mutex);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (entry->IsValid(min_catalog_version, outdated_schema_version)) {
+        info = entry->info;
+      }
+    }
+    if (!info) {
+      // Information loaded now reflects all catalog changes made before min_catalog_version was
+      // observed, so it is tagged with this version.
+      auto loaded = Load(table_id);
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!loaded.ok()) {
+        auto it = entries_.find(table_id);
+        if (loaded.status().IsNotFound() && it != entries_.end() && it->second == entry) {
+          entries_.erase(it);
+        }
+        return loaded.status();
+      }
+      info = *loaded;
+      if (!entry->info || entry->catalog_version <= min_catalog_version) {
+        entry->info = info;
+        entry->catalog_version = min_catalog_version;
+      }
+    }
+  }
+
+  *resp->mutable_schema() = info->schema();
+  *resp->mutable_partitions() = info->partitions();
+  return Status::OK();
+}
+
+void PgTableCache::EvictOutdatedEntries(uint64_t catalog_version) {
+  if (catalog_version <= evicted_catalog_version_) {
+    return;
+  }
+  evicted_catalog_version_ = catalog_version;
+  // Entries without info are being loaded for the first time, their loaders still refer to them.
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second->info && it->second->catalog_version < catalog_version) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+Result<PgTableCache::TableInfoPtr> PgTableCache::Load(const TableId& table_id) {
+  VLOG(2) << "Loading table " << table_id;
+
+  std::shared_ptr<client::YBTable> table;
+  RETURN_NOT_OK(client_future_.get()->OpenTable(table_id, &table));
+
+  auto info = std::make_shared<GetTableInfoResponsePB>();
+  auto& schema = *info->mutable_schema();
+  SchemaToPB(table->InternalSchema(), schema.mutable_schema());
+  schema.set_version(table->schema().version());
+  table->partition_schema().ToPB(schema.mutable_partition_schema());
+  table->name().SetIntoTableIdentifierPB(schema.mutable_identifier());
+  schema.mutable_identifier()->set_table_id(table->id());
+  schema.set_table_type(client::YBTable::ClientToPBTableType(table->table_type()));
+  table->index_map().ToPB(schema.mutable_indexes());
+  if (table->IsIndex()) {
+    table->index_info().ToPB(schema.mutable_index_info());
+  }
+  for (const auto& partition : table->GetPartitions()) {
+    info->add_partitions(partition);
+  }
+  return TableInfoPtr(std::move(info));
+}
+
+} // namespace tserver
+} // namespace yb
@@ -0,0 +1,84 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_PG_TABLE_CACHE_H
+#define YB_TSERVER_PG_TABLE_CACHE_H
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include "yb/client/client_fwd.h"
+
+#include "yb/common/entity_ids.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/result.h"
+
+namespace yb {
+namespace tserver {
+
+// Caches information required to open tables, i.e. schema and partitions, on behalf of all
+// PostgreSQL backends connected to this tablet server. So a new backend does not have to fetch it
+// from master, and a DDL results in a single reload per tablet server instead of one per backend.
+//
+// Cached information is tagged with the YSQL catalog version observed before it was loaded, and is
+// loaded again when a newer catalog version is requested. Entries loaded before such a version are
+// dropped once it is observed, so tables removed or altered by a DDL do not stay cached.
+class PgTableCache {
+ public:
+  explicit PgTableCache(std::shared_future<client::YBClient*> client_future);
+  ~PgTableCache();
+
+  // Fills resp with information about the table requested in req. catalog_version is the current
+  // catalog version of the tablet server, the version requested in req is taken into account too.
+  CHECKED_STATUS GetTableInfo(
+      const GetTableInfoRequestPB& req, uint64_t catalog_version, GetTableInfoResponsePB* resp);
+
+ private:
+  typedef std::shared_ptr<const GetTableInfoResponsePB> TableInfoPtr;
+
+  struct Entry {
+    // Held while the table is loaded, so concurrent requests for the same table wait for a single
+    // load instead of sending their own requests to master.
+    std::mutex load_mutex;
+
+    // Protected by PgTableCache::mutex_.
+    TableInfoPtr info;
+    uint64_t catalog_version = 0;
+
+    bool IsValid(uint64_t min_catalog_version,
+                 const boost::optional<uint32_t>& outdated_schema_version) const;
+  };
+
+  Result<TableInfoPtr> Load(const TableId& table_id);
+
+  // Removes loaded entries older than catalog_version. Requires mutex_ to be held.
+  void EvictOutdatedEntries(uint64_t catalog_version);
+
+  std::shared_future<client::YBClient*> client_future_;
+
+  std::mutex mutex_;
+  std::unordered_map<TableId, std::shared_ptr<Entry>> entries_;
+  // The newest catalog version, that entries_ was checked against.
+  uint64_t evicted_catalog_version_ = 0;
+};
+
+} // namespace tserver
+} // namespace yb
+
+#endif // YB_TSERVER_PG_TABLE_CACHE_H
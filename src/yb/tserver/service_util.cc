@@ -60,8 +60,12 @@ Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer) {
     typedef consensus::LeaderStatus LeaderStatus;
     auto status = leader_state.CreateStatus();
     switch (leader_state.status) {
-      case LeaderStatus::NOT_LEADER: FALLTHROUGH_INTENDED;
       case LeaderStatus::LEADER_BUT_NO_MAJORITY_REPLICATED_LEASE:
+        // The lease could have expired because heartbeats were suspended, the client would retry
+        // after they are resumed.
+        consensus->NoteLeaderActivity();
+        FALLTHROUGH_INTENDED;
+      case LeaderStatus::NOT_LEADER:
         // We are returning a NotTheLeader as opposed to LeaderNotReady, because there is a chance
         // that we're a partitioned-away leader, and the client needs to do another leader lookup.
         return status.CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::NOT_THE_LEADER));
@@ -78,6 +82,43 @@ Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer) {
   return leader_state.term;
 }
 
+Status CheckUuidMatch(const std::string& local_uuid,
+                      const char* method_name,
+                      const std::string& dest_uuid) {
+  if (PREDICT_FALSE(dest_uuid != local_uuid)) {
+    return STATUS_FORMAT(
+        InvalidArgument, "$0: Wrong destination UUID requested. Local UUID: $1. Requested UUID: $2",
+        method_name, local_uuid, dest_uuid).CloneAndAddErrorCode(
+            TabletServerError(TabletServerErrorPB::WRONG_SERVER_UUID));
+  }
+  return Status::OK();
+}
+
+Result<std::shared_ptr<tablet::TabletPeer>> LookupTabletPeer(
+    TabletPeerLookupIf* tablet_manager,
+    const std::string& tablet_id) {
+  std::shared_ptr<tablet::TabletPeer> result;
+  Status status = tablet_manager->GetTabletPeer(tablet_id, &result);
+  if (PREDICT_FALSE(!status.ok())) {
+    TabletServerErrorPB::Code code = status.IsServiceUnavailable() ?
+                                     TabletServerErrorPB::UNKNOWN_ERROR :
+                                     TabletServerErrorPB::TABLET_NOT_FOUND;
+    return status.CloneAndAddErrorCode(TabletServerError(code));
+  }
+
+  // Check RUNNING state.
+  tablet::RaftGroupStatePB state = result->state();
+  if (PREDICT_FALSE(state != tablet::RUNNING)) {
+    Status s = STATUS(IllegalState, "Tablet not RUNNING", tablet::RaftGroupStatePB_Name(state));
+    if (state == tablet::FAILED) {
+      s = s.CloneAndAppend(result->error().ToString());
+    }
+    return s.CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::TABLET_NOT_RUNNING));
+  }
+
+  return result;
+}
+
 bool LeaderTabletPeer::FillTerm(TabletServerErrorPB* error, rpc::RpcContext* context) {
   auto leader_term = LeaderTerm(*peer);
   if (!leader_term.ok()) {
@@ -40,6 +40,18 @@ void SetupErrorAndRespond(TabletServerErrorPB* error,
 
 Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer);
 
+// Checks that a request addressed to dest_uuid could be handled by the server with local_uuid.
+// The returned error is tagged with WRONG_SERVER_UUID.
+CHECKED_STATUS CheckUuidMatch(const std::string& local_uuid,
+                              const char* method_name,
+                              const std::string& dest_uuid);
+
+// Lookup the given tablet, ensuring that it both exists and is RUNNING.
+// The returned error is tagged with the TabletServerErrorPB code describing the failure.
+Result<std::shared_ptr<tablet::TabletPeer>> LookupTabletPeer(
+    TabletPeerLookupIf* tablet_manager,
+    const std::string& tablet_id);
+
 // Template helpers.
 
 template<class ReqClass, class RespClass>
@@ -60,14 +72,11 @@ bool CheckUuidMatchOrRespond(TabletPeerLookupIf* tablet_manager,
 #endif
     return true;
   }
-  if (PREDICT_FALSE(req->dest_uuid() != local_uuid)) {
-    const Status s = STATUS_SUBSTITUTE(InvalidArgument,
-        "$0: Wrong destination UUID requested. Local UUID: $1. Requested UUID: $2",
-        method_name, local_uuid, req->dest_uuid());
+  Status s = CheckUuidMatch(local_uuid, method_name, req->dest_uuid());
+  if (PREDICT_FALSE(!s.ok())) {
     LOG(WARNING) << s.ToString() << ": from " << context->requestor_string()
                  << ": " << req->ShortDebugString();
-    SetupErrorAndRespond(resp->mutable_error(), s,
-                         TabletServerErrorPB::WRONG_SERVER_UUID, context);
+    SetupErrorAndRespond(resp->mutable_error(), s, context);
     return false;
   }
   return true;
@@ -109,28 +118,10 @@ Result<std::shared_ptr<tablet::TabletPeer>> LookupTabletPeerOrRespond(
     const string& tablet_id,
     RespClass* resp,
     rpc::RpcContext* context) {
-  std::shared_ptr<tablet::TabletPeer> result;
-  Status status = tablet_manager->GetTabletPeer(tablet_id, &result);
-  if (PREDICT_FALSE(!status.ok())) {
-    TabletServerErrorPB::Code code = status.IsServiceUnavailable() ?
-                                     TabletServerErrorPB::UNKNOWN_ERROR :
-                                     TabletServerErrorPB::TABLET_NOT_FOUND;
-    SetupErrorAndRespond(resp->mutable_error(), status, code, context);
-    return status;
+  auto result = LookupTabletPeer(tablet_manager, tablet_id);
+  if (PREDICT_FALSE(!result.ok())) {
+    SetupErrorAndRespond(resp->mutable_error(), result.status(), context);
   }
-
-  // Check RUNNING state.
-  tablet::RaftGroupStatePB state = result->state();
-  if (PREDICT_FALSE(state != tablet::RUNNING)) {
-    Status s = STATUS(IllegalState, "Tablet not RUNNING", tablet::RaftGroupStatePB_Name(state));
-    if (state == tablet::FAILED) {
-      s = s.CloneAndAppend(result->error().ToString());
-    }
-    SetupErrorAndRespond(resp->mutable_error(), s,
-                         TabletServerErrorPB::TABLET_NOT_RUNNING, context);
-    return s;
-  }
-
   return result;
 }
 
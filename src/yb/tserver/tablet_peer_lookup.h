@@ -45,6 +45,7 @@ class NodeInstancePB;
 class ServerRegistrationPB;
 
 namespace consensus {
+class MultiRaftManager;
 class StartRemoteBootstrapRequestPB;
 } // namespace consensus
 
@@ -72,6 +73,11 @@ class TabletPeerLookupIf {
 
   virtual CHECKED_STATUS StartRemoteBootstrap(
       const consensus::StartRemoteBootstrapRequestPB& req) = 0;
+
+  // Returns manager of multi Raft group communication, if supported.
+  virtual consensus::MultiRaftManager* multi_raft_manager() {
+    return nullptr;
+  }
 };
 
 } // namespace tserver
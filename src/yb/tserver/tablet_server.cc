@@ -42,12 +42,14 @@
 #include "yb/fs/fs_manager.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/rpc/service_if.h"
+#include "yb/rpc/shared_exchange.h"
 #include "yb/rpc/yb_rpc.h"
 #include "yb/server/rpc_server.h"
 #include "yb/server/webserver.h"
 #include "yb/tablet/maintenance_manager.h"
 #include "yb/tserver/heartbeater.h"
 #include "yb/tserver/metrics_snapshotter.h"
+#include "yb/tserver/pg_table_cache.h"
 #include "yb/tserver/tablet_service.h"
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/tserver/tserver-path-handlers.h"
@@ -124,6 +126,11 @@ DEFINE_bool(start_pgsql_proxy, false,
 
 DEFINE_bool(tserver_enable_metrics_snapshotter, false, "Should metrics snapshotter be enabled");
 
+DEFINE_bool(ysql_use_shared_exchange, false,
+            "Whether PostgreSQL backends send calls to the local tablet server through shared "
+            "memory instead of TCP loopback");
+TAG_FLAG(ysql_use_shared_exchange, advanced);
+
 namespace yb {
 namespace tserver {
 
@@ -139,6 +146,9 @@ TabletServer::TabletServer(const TabletServerOptions& opts)
       tablet_server_service_(nullptr) {
   SetConnectionContextFactory(rpc::CreateConnectionContextFactory<rpc::YBInboundConnectionContext>(
       FLAGS_inbound_rpc_memory_limit, mem_tracker()));
+  if (FLAGS_ysql_use_shared_exchange) {
+    shared_exchange_ = CHECK_RESULT(rpc::SharedExchangeServer::Create());
+  }
 }
 
 TabletServer::~TabletServer() {
@@ -237,6 +247,8 @@ Status TabletServer::Init() {
   RETURN_NOT_OK_PREPEND(tablet_manager_->Init(),
                         "Could not init Tablet Manager");
 
+  pg_table_cache_ = std::make_unique<PgTableCache>(tablet_manager_->client_future());
+
   initted_.store(true, std::memory_order_release);
   return Status::OK();
 }
@@ -301,6 +313,10 @@ Status TabletServer::Start() {
   RETURN_NOT_OK(RegisterServices());
   RETURN_NOT_OK(RpcAndWebServerBase::Start());
 
+  if (shared_exchange_) {
+    RETURN_NOT_OK(shared_exchange_->Start(messenger(), rpc_server()->GetBoundAddresses()));
+  }
+
   // If enabled, creates a proxy to call this tablet server locally.
   if (FLAGS_enable_direct_local_tablet_server_call) {
     proxy_ = std::make_shared<TabletServerServiceProxy>(proxy_cache_.get(), HostPort());
@@ -336,6 +352,9 @@ void TabletServer::Shutdown() {
       tablet_server_service_ = nullptr;
     }
     tablet_manager_->StartShutdown();
+    if (shared_exchange_) {
+      shared_exchange_->Shutdown();
+    }
     RpcAndWebServerBase::Shutdown();
     tablet_manager_->CompleteShutdown();
   }
@@ -433,6 +452,10 @@ int TabletServer::GetSharedMemoryFd() {
   return shared_memory_.GetFd();
 }
 
+int TabletServer::GetSharedExchangeFd() {
+  return shared_exchange_ ? shared_exchange_->GetFd() : -1;
+}
+
 void TabletServer::SetYSQLCatalogVersion(uint64_t new_version) {
   std::lock_guard<simple_spinlock> l(lock_);
   if (new_version > ysql_catalog_version_) {
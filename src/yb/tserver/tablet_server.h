@@ -177,6 +177,8 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
     return ysql_catalog_version_;
   }
 
+  PgTableCache* pg_table_cache() override { return pg_table_cache_.get(); }
+
   virtual Env* GetEnv();
 
   virtual rocksdb::Env* GetRocksDBEnv();
@@ -187,6 +189,10 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
   // Returns the file descriptor of this tablet server's shared memory segment.
   int GetSharedMemoryFd();
 
+  // Returns the file descriptor of the shared memory exchange with PostgreSQL backends, or -1 if
+  // it is disabled.
+  int GetSharedExchangeFd();
+
   // Currently only used by cdc.
   virtual int32_t cluster_config_version() const {
     return std::numeric_limits<int32_t>::max();
@@ -256,6 +262,12 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
   // Shared memory owned by the tablet server.
   TServerSharedMemory shared_memory_;
 
+  // Exchange used by PostgreSQL backends to send calls through shared memory.
+  std::unique_ptr<rpc::SharedExchangeServer> shared_exchange_;
+
+  // Information about YSQL tables shared by PostgreSQL backends.
+  std::unique_ptr<PgTableCache> pg_table_cache_;
+
   DISALLOW_COPY_AND_ASSIGN(TabletServer);
 };
 
@@ -21,6 +21,7 @@
 namespace yb {
 namespace tserver {
 
+class PgTableCache;
 class TabletPeerLookupIf;
 class TSTabletManager;
 
@@ -36,6 +37,9 @@ class TabletServerIf : public LocalTabletServer {
 
   virtual uint64_t ysql_catalog_version() const = 0;
 
+  // Returns nullptr if this server does not serve YSQL table information.
+  virtual PgTableCache* pg_table_cache() = 0;
+
   virtual const scoped_refptr<MetricEntity>& MetricEnt() const = 0;
 };
 
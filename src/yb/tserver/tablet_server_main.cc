@@ -183,6 +183,7 @@ int TabletServerMain(int argc, char** argv) {
     LOG_AND_RETURN_FROM_MAIN_NOT_OK(pg_process_conf_result);
     pg_process_conf = std::move(*pg_process_conf_result);
     pg_process_conf->master_addresses = tablet_server_options->master_addresses_flag;
+    pg_process_conf->tserver_shared_exchange_fd = server->GetSharedExchangeFd();
 
     LOG(INFO) << "Starting PostgreSQL server listening on "
               << pg_process_conf->listen_addresses << ", port " << pg_process_conf->pg_port;
@@ -41,10 +41,12 @@
 #include "yb/common/wire_protocol.h"
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/leader_lease.h"
+#include "yb/consensus/multi_raft_batcher.h"
 
 #include "yb/docdb/cql_operation.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/pgsql_operation.h"
+#include "yb/docdb/redis_operation.h"
 
 #include "yb/gutil/bind.h"
 #include "yb/gutil/casts.h"
@@ -60,10 +62,12 @@
 #include "yb/tablet/tablet_metrics.h"
 
 #include "yb/tablet/operations/change_metadata_operation.h"
+#include "yb/tablet/operations/import_data_operation.h"
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/update_txn_operation.h"
 #include "yb/tablet/operations/write_operation.h"
 
+#include "yb/tserver/pg_table_cache.h"
 #include "yb/tserver/remote_bootstrap_service.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
@@ -76,6 +80,7 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/monotime.h"
+#include "yb/util/oid_generator.h"
 #include "yb/util/random_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
@@ -112,6 +117,13 @@ DEFINE_bool(parallelize_read_ops, true,
 TAG_FLAG(parallelize_read_ops, advanced);
 TAG_FLAG(parallelize_read_ops, runtime);
 
+DEFINE_int32(redis_point_reads_batch_threshold, 4,
+             "Redis read batches that contain at least this number of point reads (GET, HGET, "
+             "etc.) and nothing else are executed in key order in the RPC thread, instead of "
+             "submitting each read to the read pool. 0 to disable.");
+TAG_FLAG(redis_point_reads_batch_threshold, advanced);
+TAG_FLAG(redis_point_reads_batch_threshold, runtime);
+
 // Fault injection flags.
 DEFINE_test_flag(int32, scanner_inject_latency_on_each_batch_ms, 0,
                  "If set, the scanner will pause the specified number of milliesconds "
@@ -125,6 +137,10 @@ DEFINE_int32(max_wait_for_safe_time_ms, 5000,
 
 DEFINE_test_flag(bool, tserver_noop_read_write, false, "Respond NOOP to read/write.");
 
+DEFINE_test_flag(int32, write_rpc_inject_latency_ms, 0,
+                 "If set, the tablet server will pause the specified number of milliseconds "
+                 "before handling each Write RPC.");
+
 DEFINE_int32(max_stale_read_bound_time_ms, 0, "If we are allowed to read from followers, "
              "specify the maximum time a follower can be behind by using the last message received "
              "from the leader. If set to zero, a read can be served by a follower regardless of "
@@ -195,18 +211,26 @@ using tablet::WriteOperationState;
 
 namespace {
 
+Result<shared_ptr<Consensus>> GetConsensus(const TabletPeerPtr& tablet_peer) {
+  auto consensus = tablet_peer->shared_consensus();
+  if (!consensus) {
+    return STATUS(ServiceUnavailable, "Consensus unavailable. Tablet not running")
+        .CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::TABLET_NOT_RUNNING));
+  }
+  return consensus;
+}
+
 template<class RespClass>
 bool GetConsensusOrRespond(const TabletPeerPtr& tablet_peer,
                            RespClass* resp,
                            rpc::RpcContext* context,
                            shared_ptr<Consensus>* consensus) {
-  *consensus = tablet_peer->shared_consensus();
-  if (!*consensus) {
-    Status s = STATUS(ServiceUnavailable, "Consensus unavailable. Tablet not running");
-    SetupErrorAndRespond(resp->mutable_error(), s,
-                         TabletServerErrorPB::TABLET_NOT_RUNNING, context);
+  auto result = GetConsensus(tablet_peer);
+  if (!result.ok()) {
+    SetupErrorAndRespond(resp->mutable_error(), result.status(), context);
     return false;
   }
+  *consensus = std::move(*result);
   return true;
 }
 
@@ -749,6 +773,67 @@ void TabletServiceAdminImpl::CountIntents(
   context.RespondSuccess();
 }
 
+void TabletServiceAdminImpl::BackfillIndex(
+    const BackfillIndexRequestPB* req, BackfillIndexResponsePB* resp, rpc::RpcContext context) {
+  if (!CheckUuidMatchOrRespond(server_->tablet_manager(), "BackfillIndex", req, resp, &context)) {
+    return;
+  }
+  DVLOG(3) << "Received BackfillIndex RPC: " << req->DebugString();
+
+  server::UpdateClock(*req, server_->Clock());
+
+  auto tablet = LookupLeaderTabletOrRespond(
+      server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
+  if (!tablet) {
+    return;
+  }
+
+  // Backfill could start only after the tablet got the schema with the indexes, otherwise rows
+  // written after the read time would not be indexed.
+  if (tablet.peer->tablet_metadata()->schema_version() < req->schema_version()) {
+    SetupErrorAndRespond(
+        resp->mutable_error(),
+        STATUS_FORMAT(TryAgain, "Tablet has an older schema version $0, while $1 is required",
+                      tablet.peer->tablet_metadata()->schema_version(), req->schema_version()),
+        TabletServerErrorPB::MISMATCHED_SCHEMA, &context);
+    return;
+  }
+
+  auto read_time = tablet.peer->tablet()->SafeTime(
+      tablet::RequireLease::kTrue, HybridTime::kMin, context.GetClientDeadline());
+  if (!read_time.is_valid()) {
+    SetupErrorAndRespond(
+        resp->mutable_error(), STATUS(TimedOut, "Timed out waiting for safe time"),
+        TabletServerErrorPB::UNKNOWN_ERROR, &context);
+    return;
+  }
+
+  std::vector<IndexInfo> indexes;
+  indexes.reserve(req->indexes_size());
+  for (const auto& index : req->indexes()) {
+    indexes.emplace_back(index);
+  }
+
+  std::string backfilled_until;
+  size_t num_rows = 0;
+  auto status = tablet.peer->tablet()->BackfillIndexes(
+      indexes, req->start_key(), read_time, context.GetClientDeadline(), &backfilled_until,
+      &num_rows);
+  if (!status.ok()) {
+    SetupErrorAndRespond(resp->mutable_error(), status, TabletServerErrorPB::UNKNOWN_ERROR,
+                         &context);
+    return;
+  }
+
+  VLOG(1) << "T " << req->tablet_id() << ": backfilled " << num_rows << " rows from "
+          << Slice(req->start_key()).ToDebugHexString() << " till "
+          << Slice(backfilled_until).ToDebugHexString();
+  resp->set_backfilled_until(backfilled_until);
+  resp->set_num_rows(num_rows);
+  resp->set_propagated_hybrid_time(server_->Clock()->Now().ToUint64());
+  context.RespondSuccess();
+}
+
 void TabletServiceImpl::Write(const WriteRequestPB* req,
                               WriteResponsePB* resp,
                               rpc::RpcContext context) {
@@ -759,6 +844,9 @@ void TabletServiceImpl::Write(const WriteRequestPB* req,
     context.RespondSuccess();
     return;
   }
+  if (PREDICT_FALSE(FLAGS_write_rpc_inject_latency_ms > 0)) {
+    SleepFor(MonoDelta::FromMilliseconds(FLAGS_write_rpc_inject_latency_ms));
+  }
   TRACE("Start Write");
   TRACE_EVENT1("tserver", "TabletServiceImpl::Write",
                "tablet_id", req->tablet_id());
@@ -1384,6 +1472,13 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(ReadContext* read_context) {
     // Assert the primary table is a redis table.
     DCHECK_EQ(read_context->tablet->table_type(), TableType::REDIS_TABLE_TYPE);
     size_t count = read_context->req->redis_batch_size();
+    if (docdb::ShouldExecuteRedisPointReadsInBatch(
+            read_context->req->redis_batch(), FLAGS_redis_point_reads_batch_threshold)) {
+      RETURN_NOT_OK(read_context->tablet->HandleRedisPointReadRequests(
+          read_context->context->GetClientDeadline(), read_tx.read_time(),
+          read_context->req->redis_batch(), read_context->resp->mutable_redis_batch()));
+      return ReadHybridTime();
+    }
     std::vector<Status> rets(count);
     CountDownLatch latch(count);
     for (int idx = 0; idx < count; idx++) {
@@ -1539,6 +1634,55 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
   context.RespondSuccess();
 }
 
+void ConsensusServiceImpl::MultiRaftUpdateConsensus(
+    const consensus::MultiRaftConsensusRequestPB* req,
+    consensus::MultiRaftConsensusResponsePB* resp,
+    rpc::RpcContext context) {
+  DVLOG(3) << "Received Multi Raft Consensus Update RPC with "
+           << req->consensus_request_size() << " requests";
+  const auto& local_uuid = tablet_manager_->NodeInstance().permanent_uuid();
+  const auto deadline = context.GetClientDeadline();
+  // Handle liveness first, so a follower woken by this RPC could accept quiescence again.
+  auto* multi_raft_manager = tablet_manager_->multi_raft_manager();
+  if (multi_raft_manager) {
+    multi_raft_manager->ProcessLeaderServerLiveness(*req);
+  }
+  resp->mutable_consensus_response()->Reserve(req->consensus_request_size());
+  for (const auto& consensus_req : req->consensus_request()) {
+    // See UpdateConsensus for the reason of const_cast.
+    DoUpdateConsensus(
+        local_uuid, const_cast<ConsensusRequestPB*>(&consensus_req),
+        resp->add_consensus_response(), deadline);
+  }
+  context.RespondSuccess();
+}
+
+Status ConsensusServiceImpl::DoUpdateConsensusImpl(
+    const std::string& local_uuid, ConsensusRequestPB* req, ConsensusResponsePB* resp,
+    CoarseTimePoint deadline) {
+  RETURN_NOT_OK(CheckUuidMatch(local_uuid, "MultiRaftUpdateConsensus", req->dest_uuid()));
+  auto tablet_peer = VERIFY_RESULT(LookupTabletPeer(tablet_manager_, req->tablet_id()));
+  auto consensus = VERIFY_RESULT(GetConsensus(tablet_peer));
+  auto status = consensus->Update(req, resp, deadline);
+  if (PREDICT_FALSE(!status.ok())) {
+    return status.CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::UNKNOWN_ERROR));
+  }
+  return Status::OK();
+}
+
+void ConsensusServiceImpl::DoUpdateConsensus(
+    const std::string& local_uuid, ConsensusRequestPB* req, ConsensusResponsePB* resp,
+    CoarseTimePoint deadline) {
+  // All errors returned by DoUpdateConsensusImpl are tagged with TabletServerError.
+  auto status = DoUpdateConsensusImpl(local_uuid, req, resp, deadline);
+  if (PREDICT_FALSE(!status.ok())) {
+    // See UpdateConsensus for the reason of clearing the response.
+    resp->Clear();
+    StatusToPB(status, resp->mutable_error()->mutable_status());
+    resp->mutable_error()->set_code(TabletServerError(status).value());
+  }
+}
+
 void ConsensusServiceImpl::RequestConsensusVote(const VoteRequestPB* req,
                                                 VoteResponsePB* resp,
                                                 rpc::RpcContext context) {
@@ -1895,6 +2039,63 @@ void TabletServiceImpl::Checksum(const ChecksumRequestPB* req,
 void TabletServiceImpl::ImportData(const ImportDataRequestPB* req,
                                    ImportDataResponsePB* resp,
                                    rpc::RpcContext context) {
+  if (req->has_check_applied_op_id()) {
+    auto peer = VERIFY_RESULT_OR_RETURN(LookupTabletPeerOrRespond(
+        server_->tablet_peer_lookup(), req->tablet_id(), resp, &context));
+
+    // Import moves the flushed frontier of the regular DB to its op id atomically, so the
+    // persistent op id shows whether the import was applied by this replica.
+    auto op_ids = peer->tablet()->MaxPersistentOpId();
+    Status status = op_ids.ok() ? Status::OK() : op_ids.status();
+    if (status.ok() && op_ids->regular.index < req->check_applied_op_id().index()) {
+      status = STATUS_FORMAT(TryAgain, "Import $0 is not yet applied, applied op id: $1",
+                             yb::OpId::FromPB(req->check_applied_op_id()), op_ids->regular);
+    }
+    if (!status.ok()) {
+      SetupErrorAndRespond(resp->mutable_error(),
+                           status,
+                           TabletServerErrorPB::UNKNOWN_ERROR,
+                           &context);
+      return;
+    }
+    context.RespondSuccess();
+    return;
+  }
+
+  if (req->replicated()) {
+    UpdateClock(*req, server_->Clock());
+
+    auto tablet = LookupLeaderTabletOrRespond(
+        server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
+    if (!tablet) {
+      return;
+    }
+
+    // Failure to apply the import is fatal for the replica, so source files are validated once,
+    // before the operation is submitted. Operation hybrid time is not less than the current time.
+    auto hybrid_time_range = tablet.peer->tablet()->CheckImportData(
+        req->source_dir(), server_->Clock()->Now());
+    if (!hybrid_time_range.ok()) {
+      SetupErrorAndRespond(resp->mutable_error(),
+                           hybrid_time_range.status(),
+                           TabletServerErrorPB::UNKNOWN_ERROR,
+                           &context);
+      return;
+    }
+
+    auto operation_state = std::make_unique<tablet::ImportDataOperationState>(
+        tablet.peer->tablet(), req, resp);
+    operation_state->set_import_info(ObjectIdGenerator().Next(), *hybrid_time_range);
+    operation_state->set_completion_callback(
+        MakeRpcOperationCompletionCallback(std::move(context), resp, server_->Clock()));
+
+    // Every replica links files from the same source directory before the operation is applied.
+    tablet.peer->Submit(
+        std::make_unique<tablet::ImportDataOperation>(std::move(operation_state)),
+        tablet.leader_term);
+    return;
+  }
+
   auto peer = VERIFY_RESULT_OR_RETURN(LookupTabletPeerOrRespond(
       server_->tablet_peer_lookup(), req->tablet_id(), resp, &context));
 
@@ -1935,6 +2136,21 @@ void TabletServiceImpl::IsTabletServerReady(const IsTabletServerReadyRequestPB*
   context.RespondSuccess();
 }
 
+void TabletServiceImpl::GetTableInfo(const GetTableInfoRequestPB* req,
+                                     GetTableInfoResponsePB* resp,
+                                     rpc::RpcContext context) {
+  auto* pg_table_cache = server_->pg_table_cache();
+  Status s = pg_table_cache
+      ? pg_table_cache->GetTableInfo(*req, server_->ysql_catalog_version(), resp)
+      : STATUS(NotSupported, "Table info cache is not available");
+  if (!s.ok()) {
+    SetupErrorAndRespond(resp->mutable_error(), s, TabletServerErrorPB::UNKNOWN_ERROR,
+                         &context);
+    return;
+  }
+  context.RespondSuccess();
+}
+
 void TabletServiceImpl::Shutdown() {
 }
 
@@ -124,6 +124,10 @@ class TabletServiceImpl : public TabletServerServiceIf {
                            IsTabletServerReadyResponsePB* resp,
                            rpc::RpcContext context) override;
 
+  void GetTableInfo(const GetTableInfoRequestPB* req,
+                    GetTableInfoResponsePB* resp,
+                    rpc::RpcContext context) override;
+
   void Shutdown() override;
 
  private:
@@ -195,6 +199,10 @@ class TabletServiceAdminImpl : public TabletServerAdminServiceIf {
                     CountIntentsResponsePB* resp,
                     rpc::RpcContext context) override;
 
+  void BackfillIndex(const BackfillIndexRequestPB* req,
+                     BackfillIndexResponsePB* resp,
+                     rpc::RpcContext context) override;
+
  private:
   TabletServer* server_;
 };
@@ -210,6 +218,10 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                consensus::ConsensusResponsePB *resp,
                                rpc::RpcContext context) override;
 
+  void MultiRaftUpdateConsensus(const consensus::MultiRaftConsensusRequestPB* req,
+                                consensus::MultiRaftConsensusResponsePB* resp,
+                                rpc::RpcContext context) override;
+
   virtual void RequestConsensusVote(const consensus::VoteRequestPB* req,
                                     consensus::VoteResponsePB* resp,
                                     rpc::RpcContext context) override;
@@ -247,6 +259,17 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                     rpc::RpcContext context) override;
 
  private:
+  // Applies a single update of MultiRaftUpdateConsensus, errors are reported in resp.
+  void DoUpdateConsensus(const std::string& local_uuid,
+                         consensus::ConsensusRequestPB* req,
+                         consensus::ConsensusResponsePB* resp,
+                         CoarseTimePoint deadline);
+
+  CHECKED_STATUS DoUpdateConsensusImpl(const std::string& local_uuid,
+                                       consensus::ConsensusRequestPB* req,
+                                       consensus::ConsensusResponsePB* resp,
+                                       CoarseTimePoint deadline);
+
   TabletPeerLookupIf* tablet_manager_;
 };
 
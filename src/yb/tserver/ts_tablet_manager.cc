@@ -50,6 +50,7 @@
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/metadata.pb.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/quorum_util.h"
 #include "yb/consensus/retryable_requests.h"
@@ -490,6 +491,9 @@ Status TSTabletManager::Init() {
       &server_->options(), server_->metric_entity(), server_->mem_tracker(),
       server_->messenger());
 
+  multi_raft_manager_ = std::make_unique<consensus::MultiRaftManager>(
+      server_->messenger(), &server_->proxy_cache(), NodeInstance());
+
   tablet_options_.env = server_->GetEnv();
   tablet_options_.rocksdb_env = server_->GetRocksDBEnv();
   tablet_options_.listeners = server_->options().listeners;
@@ -1129,7 +1133,8 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
                                          tablet->GetMetricEntity(),
                                          raft_pool(),
                                          tablet_prepare_pool(),
-                                         &retryable_requests);
+                                         &retryable_requests,
+                                         multi_raft_manager_.get());
 
     if (!s.ok()) {
       LOG(ERROR) << kLogPrefix << "Tablet failed to init: "
@@ -1163,6 +1168,10 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
 void TSTabletManager::StartShutdown() {
   async_client_init_->Shutdown();
 
+  if (multi_raft_manager_) {
+    multi_raft_manager_->Shutdown();
+  }
+
   if(background_task_) {
     background_task_->Shutdown();
   }
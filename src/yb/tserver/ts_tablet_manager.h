@@ -197,6 +197,10 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
 
   CHECKED_STATUS GetRegistration(ServerRegistrationPB* reg) const override;
 
+  consensus::MultiRaftManager* multi_raft_manager() override {
+    return multi_raft_manager_.get();
+  }
+
   // Initiate remote bootstrap of the specified tablet.
   // See the StartRemoteBootstrap() RPC declaration in consensus.proto for details.
   // Currently this runs the entire procedure synchronously.
@@ -289,6 +293,10 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
 
   TabletServer* server() { return server_; }
 
+  const std::shared_future<client::YBClient*>& client_future() const {
+    return async_client_init_->get_client_future();
+  }
+
   MemoryMonitor* memory_monitor() { return tablet_options_.memory_monitor.get(); }
 
   // Flush some tablet if the memstore memory limit is exceeded
@@ -481,6 +489,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
 
   boost::optional<yb::client::AsyncClientInitialiser> async_client_init_;
 
+  // Coalesces heartbeats sent by tablet leaders of this server to the same server.
+  std::unique_ptr<consensus::MultiRaftManager> multi_raft_manager_;
+
   TabletPeers shutting_down_peers_;
 
   std::shared_ptr<GarbageCollector> block_based_table_gc_;
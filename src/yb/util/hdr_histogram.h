@@ -105,6 +105,11 @@ class HdrHistogram {
   void IncrementWithExpectedInterval(int64_t value,
                                      int64_t expected_interval_between_samples);
 
+  // Adds all values recorded in other to this histogram.
+  // other should have the same highest trackable value and number of significant digits.
+  // It is not a consistent snapshot of other if it is modified concurrently.
+  void MergeFrom(const HdrHistogram& other);
+
   // Fetch configuration params.
   uint64_t highest_trackable_value() const { return highest_trackable_value_; }
   int num_significant_digits() const { return num_significant_digits_; }
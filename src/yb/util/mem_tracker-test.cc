@@ -33,6 +33,7 @@
 #include "yb/util/mem_tracker.h"
 
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -46,6 +47,7 @@
 
 DECLARE_int32(memory_limit_soft_percentage);
 DECLARE_int64(mem_tracker_update_consumption_interval_us);
+DECLARE_int64(mem_tracker_batch_size_bytes);
 
 namespace yb {
 
@@ -358,4 +360,72 @@ TEST(MemTrackerTest, UnregisterFromParent) {
   shared_ptr<MemTracker> c2 = MemTracker::CreateTracker("child", p);
 }
 
+TEST(MemTrackerTest, BatchedConsumption) {
+  shared_ptr<MemTracker> p = MemTracker::CreateTracker("parent");
+  shared_ptr<MemTracker> c = MemTracker::CreateTracker("child", p);
+  shared_ptr<MemTracker> limited = MemTracker::CreateTracker(1000, "limited", p);
+
+  // Small changes are accumulated per CPU, but are still visible in consumption.
+  c->Consume(10);
+  ASSERT_EQ(10, c->consumption());
+  ASSERT_EQ(10, p->consumption());
+
+  // Tracker with limit is always updated exactly.
+  ASSERT_TRUE(limited->TryConsume(900));
+  ASSERT_FALSE(limited->TryConsume(200));
+  ASSERT_EQ(900, limited->consumption());
+  ASSERT_EQ(910, p->consumption());
+  limited->Release(900);
+
+  c->Consume(FLAGS_mem_tracker_batch_size_bytes);
+  ASSERT_EQ(FLAGS_mem_tracker_batch_size_bytes + 10, c->consumption());
+  ASSERT_GE(c->peak_consumption(), FLAGS_mem_tracker_batch_size_bytes);
+  c->Release(FLAGS_mem_tracker_batch_size_bytes + 10);
+  ASSERT_EQ(0, c->consumption());
+
+  // Batches of destroyed tracker are flushed.
+  c->Consume(20);
+  ASSERT_EQ(20, p->consumption());
+  c->Release(20);
+  c.reset();
+  ASSERT_EQ(0, p->consumption());
+}
+
+TEST(MemTrackerTest, MultiThreadedConsumeRelease) {
+  constexpr int kMaxThreads = 64;
+  constexpr int kIterations = 100000;
+  constexpr int64_t kBytes = 100;
+
+  shared_ptr<MemTracker> p = MemTracker::CreateTracker("parent");
+  for (int num_threads = 1; num_threads <= kMaxThreads; num_threads *= 2) {
+    vector<shared_ptr<MemTracker>> children;
+    for (int i = 0; i != num_threads; ++i) {
+      children.push_back(MemTracker::CreateTracker(Format("child-$0", i), p));
+    }
+    vector<std::thread> threads;
+    auto start = MonoTime::Now();
+    for (const auto& child : children) {
+      threads.emplace_back([child] {
+        for (int i = 0; i != kIterations; ++i) {
+          child->Consume(kBytes);
+          child->Release(kBytes);
+        }
+        child->Consume(kBytes);
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    auto passed = MonoTime::Now() - start;
+    LOG(INFO) << num_threads << " threads: "
+              << num_threads * kIterations * 2 / passed.ToSeconds() << " ops/sec";
+    ASSERT_EQ(num_threads * kBytes, p->consumption());
+    for (const auto& child : children) {
+      ASSERT_EQ(kBytes, child->consumption());
+      child->Release(kBytes);
+    }
+    ASSERT_EQ(0, p->consumption());
+  }
+}
+
 } // namespace yb
@@ -32,12 +32,17 @@
 
 #include "yb/util/mem_tracker.h"
 
+#include <sched.h>
+
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <deque>
 #include <limits>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <thread>
 
 #ifdef TCMALLOC_ENABLED
 #include <gperftools/malloc_extension.h>
@@ -48,6 +53,7 @@
 #include "yb/gutil/strings/join.h"
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/sysinfo.h"
 #include "yb/util/debug-util.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/env.h"
@@ -102,6 +108,12 @@ DEFINE_int64(mem_tracker_update_consumption_interval_us, 2000000,
              "Interval that is used to update memory consumption from external source. "
              "For instance from tcmalloc statistics.");
 
+DEFINE_int64(mem_tracker_batch_size_bytes, 64 * 1024,
+             "Consumption changes of memory trackers without limit are accumulated per CPU and "
+             "applied to the shared counter when accumulated change exceeds this value. "
+             "0 to disable batching for trackers created after that.");
+TAG_FLAG(mem_tracker_batch_size_bytes, advanced);
+
 namespace yb {
 
 // NOTE: this class has been adapted from Impala, so the code style varies
@@ -167,6 +179,61 @@ void IncrementBy(int64_t amount, HighWaterMark* consumption,
   }
 }
 
+constexpr size_t kMemTrackerBatchSlots = 16;
+
+// Consumption changes of batched trackers accumulated on a single CPU.
+// Each tracker uses fixed slot, so trackers sharing the same slot evict each other.
+// Slots are updated under mutex, but could be read without it, so they are atomic.
+struct MemTrackerBatch {
+  simple_spinlock mutex;
+  std::array<std::atomic<MemTracker*>, kMemTrackerBatchSlots> trackers;
+  std::array<std::atomic<int64_t>, kMemTrackerBatchSlots> deltas;
+
+  MemTrackerBatch() {
+    for (size_t i = 0; i != kMemTrackerBatchSlots; ++i) {
+      trackers[i].store(nullptr, std::memory_order_relaxed);
+      deltas[i].store(0, std::memory_order_relaxed);
+    }
+  }
+} CACHELINE_ALIGNED;
+
+class MemTrackerBatches {
+ public:
+  MemTrackerBatches()
+      : size_(base::MaxCPUIndex() + 1), batches_(new MemTrackerBatch[size_]) {
+  }
+
+  MemTrackerBatch& Current() {
+#if defined(__APPLE__)
+    // OSX doesn't have a way to get the CPU, so we'll pick one based on thread id.
+    size_t cpu = std::hash<std::thread::id>()(std::this_thread::get_id()) % size_;
+#else
+    int cpu = sched_getcpu();
+    if (PREDICT_FALSE(cpu < 0 || static_cast<size_t>(cpu) >= size_)) {
+      // sched_getcpu could fail, for instance when the kernel does not support it.
+      // Any batch is correct, so just use the first one.
+      cpu = 0;
+    }
+#endif // defined(__APPLE__)
+    return batches_[cpu];
+  }
+
+  MemTrackerBatch* begin() { return batches_.get(); }
+  MemTrackerBatch* end() { return batches_.get() + size_; }
+
+ private:
+  const size_t size_;
+  std::unique_ptr<MemTrackerBatch[]> batches_;
+};
+
+MemTrackerBatches& Batches() {
+  // Never destroyed, since trackers could be released during static destruction.
+  static MemTrackerBatches* batches = new MemTrackerBatches;
+  return *batches;
+}
+
+std::atomic<size_t> next_batch_slot{0};
+
 std::string CreateMetricName(const MemTracker& mem_tracker) {
   if (mem_tracker.metric_entity() &&
         (!mem_tracker.parent() ||
@@ -304,6 +371,10 @@ MemTracker::MemTracker(int64_t byte_limit, const string& id,
       consumption_functor_(std::move(consumption_functor)),
       descr_(Substitute("memory consumption for $0", id)),
       parent_(std::move(parent)),
+      batched_(!consumption_functor_ && limit_ < 0 &&
+               GetAtomicFlag(&FLAGS_mem_tracker_batch_size_bytes) > 0),
+      batch_slot_(next_batch_slot.fetch_add(1, std::memory_order_relaxed) %
+                  kMemTrackerBatchSlots),
       rand_(GetRandomSeed32()),
       enable_logging_(FLAGS_mem_tracker_logging),
       log_stack_(FLAGS_mem_tracker_log_stack_trace),
@@ -335,6 +406,9 @@ MemTracker::MemTracker(int64_t byte_limit, const string& id,
 
 MemTracker::~MemTracker() {
   VLOG(1) << "Destroying tracker " << ToString();
+  if (batched_) {
+    FlushBatches();
+  }
   if (!consumption_functor_) {
     DCHECK_EQ(consumption(), 0) << "Memory tracker " << ToString();
   }
@@ -474,8 +548,8 @@ void MemTracker::Consume(int64_t bytes) {
   }
   for (auto& tracker : all_trackers_) {
     if (!tracker->UpdateConsumption()) {
-      IncrementBy(bytes, &tracker->consumption_, tracker->metrics_);
-      DCHECK_GE(tracker->consumption_.current_value(), 0);
+      tracker->IncrementConsumption(bytes);
+      DCHECK(tracker->batched_ || tracker->consumption_.current_value() >= 0);
     }
   }
 }
@@ -495,7 +569,7 @@ bool MemTracker::TryConsume(int64_t bytes, MemTracker** blocking_mem_tracker) {
   for (i = all_trackers_.size() - 1; i >= 0; --i) {
     MemTracker *tracker = all_trackers_[i];
     if (tracker->limit_ < 0) {
-      IncrementBy(bytes, &tracker->consumption_, tracker->metrics_);
+      tracker->IncrementConsumption(bytes);
     } else {
       if (!TryIncrementBy(bytes, tracker->limit_, &tracker->consumption_, tracker->metrics_)) {
         // One of the trackers failed, attempt to GC memory or expand our limit. If that
@@ -526,7 +600,7 @@ bool MemTracker::TryConsume(int64_t bytes, MemTracker** blocking_mem_tracker) {
   // to adjust the consumption of the query tracker to stop the resource from never
   // getting used by a subsequent TryConsume()?
   for (int j = all_trackers_.size() - 1; j > i; --j) {
-    IncrementBy(-bytes, &all_trackers_[j]->consumption_, all_trackers_[j]->metrics_);
+    all_trackers_[j]->IncrementConsumption(-bytes);
   }
   if (blocking_mem_tracker) {
     *blocking_mem_tracker = all_trackers_[i];
@@ -559,14 +633,71 @@ void MemTracker::Release(int64_t bytes) {
 
   for (auto& tracker : all_trackers_) {
     if (!tracker->UpdateConsumption()) {
-      IncrementBy(-bytes, &tracker->consumption_, tracker->metrics_);
+      tracker->IncrementConsumption(-bytes);
       // If a UDF calls FunctionContext::TrackAllocation() but allocates less than the
       // reported amount, the subsequent call to FunctionContext::Free() may cause the
       // process mem tracker to go negative until it is synced back to the tcmalloc
       // metric. Don't blow up in this case. (Note that this doesn't affect non-process
       // trackers since we can enforce that the reported memory usage is internally
       // consistent.)
-      DCHECK_GE(tracker->consumption_.current_value(), 0) << "Tracker: " << tracker->ToString();
+      DCHECK(tracker->batched_ || tracker->consumption_.current_value() >= 0)
+          << "Tracker: " << tracker->ToString();
+    }
+  }
+}
+
+void MemTracker::IncrementConsumption(int64_t delta) {
+  if (!batched_) {
+    ApplyConsumption(delta);
+    return;
+  }
+
+  auto& batch = Batches().Current();
+  std::lock_guard<simple_spinlock> lock(batch.mutex);
+  auto& tracker = batch.trackers[batch_slot_];
+  auto& pending = batch.deltas[batch_slot_];
+  auto* old_tracker = tracker.load(std::memory_order_relaxed);
+  int64_t new_pending = delta;
+  if (old_tracker == this) {
+    new_pending += pending.load(std::memory_order_relaxed);
+  } else {
+    if (old_tracker) {
+      old_tracker->ApplyConsumption(pending.load(std::memory_order_relaxed));
+    }
+    pending.store(0, std::memory_order_relaxed);
+    tracker.store(this, std::memory_order_release);
+  }
+  auto batch_size = GetAtomicFlag(&FLAGS_mem_tracker_batch_size_bytes);
+  if (new_pending >= batch_size || new_pending <= -batch_size) {
+    ApplyConsumption(new_pending);
+    new_pending = 0;
+  }
+  pending.store(new_pending, std::memory_order_relaxed);
+}
+
+void MemTracker::ApplyConsumption(int64_t delta) {
+  IncrementBy(delta, &consumption_, metrics_);
+}
+
+int64_t MemTracker::PendingConsumption() const {
+  // Batches are read without locking, so a delta that is being flushed concurrently could be
+  // counted twice or missed. The result is off by at most a batch per CPU, and only momentarily.
+  int64_t result = 0;
+  for (auto& batch : Batches()) {
+    if (batch.trackers[batch_slot_].load(std::memory_order_acquire) == this) {
+      result += batch.deltas[batch_slot_].load(std::memory_order_relaxed);
+    }
+  }
+  return result;
+}
+
+void MemTracker::FlushBatches() {
+  for (auto& batch : Batches()) {
+    std::lock_guard<simple_spinlock> lock(batch.mutex);
+    if (batch.trackers[batch_slot_].load(std::memory_order_relaxed) == this) {
+      ApplyConsumption(batch.deltas[batch_slot_].load(std::memory_order_relaxed));
+      batch.trackers[batch_slot_].store(nullptr, std::memory_order_relaxed);
+      batch.deltas[batch_slot_].store(0, std::memory_order_relaxed);
     }
   }
 }
@@ -319,7 +319,8 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
 
   // Returns the memory consumed in bytes.
   int64_t consumption() const {
-    return consumption_.current_value();
+    return batched_ ? consumption_.current_value() + PendingConsumption()
+                    : consumption_.current_value();
   }
 
   int64_t GetUpdatedConsumption(bool force = false) {
@@ -331,6 +332,7 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   // will be the max value we've recorded in consumption(), not
   // necessarily the highest value consumption_func_ has ever
   // reached.
+  // For batched trackers it is the max value observed when per CPU deltas were flushed.
   int64_t peak_consumption() const { return consumption_.max_value(); }
 
   // Retrieve the parent tracker, or NULL If one is not set.
@@ -383,6 +385,19 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   // Logs the stack of the current consume/release. Used for debugging only.
   void LogUpdate(bool is_consume, int64_t bytes) const;
 
+  // Adds delta to consumption of this tracker, using per CPU batch when tracker is batched.
+  void IncrementConsumption(int64_t delta);
+
+  // Applies delta to shared consumption counter and metrics of this tracker.
+  void ApplyConsumption(int64_t delta);
+
+  // Returns sum of deltas accumulated in per CPU batches, that were not yet flushed.
+  // Batches are read without locking, so the result is approximate while they are updated.
+  int64_t PendingConsumption() const;
+
+  // Flushes deltas accumulated in per CPU batches for this tracker and detaches them from it.
+  void FlushBatches();
+
   // Variant of CreateTracker() that:
   // 1. Must be called with a non-NULL parent, and
   // 2. Must be called with parent->child_trackers_lock_ held.
@@ -422,6 +437,15 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
 
   HighWaterMark consumption_{0};
 
+  // Whether small consumption changes of this tracker are accumulated in per CPU batches, and
+  // applied to consumption_ only when accumulated delta exceeds mem_tracker_batch_size_bytes.
+  // Used only for trackers without limit and external consumption source, so limit checks are
+  // always performed against exact values.
+  const bool batched_;
+
+  // Index of slot in per CPU batch that is used by this tracker.
+  const size_t batch_slot_;
+
   // this tracker plus all of its ancestors
   std::vector<MemTracker*> all_trackers_;
   // all_trackers_ with valid limits
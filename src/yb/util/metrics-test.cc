@@ -31,6 +31,7 @@
 //
 
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
@@ -174,14 +175,53 @@ TEST_F(MetricsTest, SimpleHistogramTest) {
   scoped_refptr<Histogram> hist = METRIC_test_hist.Instantiate(entity_);
   hist->Increment(2);
   hist->IncrementBy(4, 1);
-  ASSERT_EQ(2, hist->histogram_->MinValue());
-  ASSERT_EQ(3, hist->histogram_->MeanValue());
-  ASSERT_EQ(4, hist->histogram_->MaxValue());
-  ASSERT_EQ(2, hist->histogram_->TotalCount());
-  ASSERT_EQ(6, hist->histogram_->TotalSum());
+  auto snapshot = hist->Snapshot();
+  ASSERT_EQ(2, snapshot->MinValue());
+  ASSERT_EQ(3, snapshot->MeanValue());
+  ASSERT_EQ(4, snapshot->MaxValue());
+  ASSERT_EQ(2, snapshot->TotalCount());
+  ASSERT_EQ(6, snapshot->TotalSum());
   // TODO: Test coverage needs to be improved a lot.
 }
 
+METRIC_DEFINE_histogram(server, test_server_hist, "Test Server Histogram",
+                        MetricUnit::kMicroseconds, "foo", 1000000, 2);
+
+TEST_F(MetricsTest, ShardedHistogramTest) {
+  constexpr int kNumThreads = 16;
+  constexpr int kValuesPerThread = 10000;
+
+  auto server_entity = METRIC_ENTITY_server.Instantiate(&registry_, "my-server");
+  scoped_refptr<Histogram> hist = METRIC_test_server_hist.Instantiate(server_entity);
+  HdrHistogram expected(1000000, 2);
+
+  vector<std::thread> threads;
+  for (int i = 0; i != kNumThreads; ++i) {
+    threads.emplace_back([hist, i] {
+      for (int j = 1; j <= kValuesPerThread; ++j) {
+        hist->Increment(i * j);
+      }
+    });
+    for (int j = 1; j <= kValuesPerThread; ++j) {
+      expected.Increment(i * j);
+    }
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Shards are merged without losing accuracy.
+  auto snapshot = hist->Snapshot();
+  ASSERT_EQ(kNumThreads * kValuesPerThread, hist->TotalCount());
+  ASSERT_EQ(expected.TotalCount(), snapshot->TotalCount());
+  ASSERT_EQ(expected.TotalSum(), snapshot->TotalSum());
+  ASSERT_EQ(expected.MinValue(), snapshot->MinValue());
+  ASSERT_EQ(expected.MaxValue(), snapshot->MaxValue());
+  for (auto percentile : {50.0, 75.0, 95.0, 99.0, 99.9, 99.99}) {
+    ASSERT_EQ(expected.ValueAtPercentile(percentile), snapshot->ValueAtPercentile(percentile));
+  }
+}
+
 TEST_F(MetricsTest, JsonPrintTest) {
   scoped_refptr<Counter> bytes_seen = METRIC_reqs_pending.Instantiate(entity_);
   bytes_seen->Increment();
@@ -31,10 +31,13 @@
 //
 #include "yb/util/metrics.h"
 
+#include <sched.h>
+
 #include <iostream>
 #include <map>
 #include <regex>
 #include <set>
+#include <thread>
 
 #include <gflags/gflags.h>
 
@@ -44,6 +47,7 @@
 #include "yb/gutil/singleton.h"
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/sysinfo.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/hdr_histogram.h"
 #include "yb/util/histogram.pb.h"
@@ -62,6 +66,13 @@ TAG_FLAG(metrics_retirement_age_ms, advanced);
 DEFINE_string(metric_node_name, "DEFAULT_NODE_NAME",
               "Value to use as node name for metrics reporting");
 
+DEFINE_int32(server_histogram_shards, 8,
+             "Number of shards used by histograms of the server entity. Such histograms are "
+             "updated by all threads of the server, so recording to a single shared histogram "
+             "causes cache line contention. Histograms of other entities, like tablets, are "
+             "much more numerous and use a single shard to save memory.");
+TAG_FLAG(server_histogram_shards, advanced);
+
 // Process/server-wide metrics should go into the 'server' entity.
 // More complex applications will define other entities.
 METRIC_DEFINE_entity(server);
@@ -196,6 +207,13 @@ void MetricEntity::CheckInstantiation(const MetricPrototype* proto) const {
       << "Metric name is not compatible with Prometheus: " << proto->name();
 }
 
+size_t MetricEntity::NumHistogramShards() const {
+  if (prototype_ != &METRIC_ENTITY_server) {
+    return 1;
+  }
+  return std::min<size_t>(std::max(FLAGS_server_histogram_shards, 1), base::MaxCPUIndex() + 1);
+}
+
 scoped_refptr<Metric> MetricEntity::FindOrNull(const MetricPrototype& prototype) const {
   std::lock_guard<simple_spinlock> l(lock_);
   return FindPtrOrNull(metric_map_, &prototype);
@@ -750,17 +768,69 @@ scoped_refptr<Histogram> HistogramPrototype::Instantiate(
 // Histogram
 /////////////////////////////////////////////////
 
-Histogram::Histogram(const HistogramPrototype* proto)
+Histogram::Histogram(const HistogramPrototype* proto, size_t num_shards)
   : Metric(proto),
-    histogram_(new HdrHistogram(proto->max_trackable_value(), proto->num_sig_digits())) {
+    histogram_prototype_(proto),
+    num_shards_(std::max<size_t>(num_shards, 1)),
+    num_cpus_(base::MaxCPUIndex() + 1),
+    shards_(new std::atomic<HdrHistogram*>[num_shards_]) {
+  shards_[0].store(
+      new HdrHistogram(proto->max_trackable_value(), proto->num_sig_digits()),
+      std::memory_order_release);
+  for (size_t i = 1; i != num_shards_; ++i) {
+    shards_[i].store(nullptr, std::memory_order_release);
+  }
+}
+
+Histogram::~Histogram() {
+  for (size_t i = 0; i != num_shards_; ++i) {
+    delete shards_[i].load(std::memory_order_acquire);
+  }
+}
+
+HdrHistogram* Histogram::CurrentShard() {
+  if (num_shards_ == 1) {
+    return shards_[0].load(std::memory_order_relaxed);
+  }
+#if defined(__APPLE__)
+  // OSX doesn't have a way to get the CPU, so we'll pick a shard based on thread id.
+  size_t cpu = std::hash<std::thread::id>()(std::this_thread::get_id()) % num_cpus_;
+#else
+  size_t cpu = sched_getcpu();
+  DCHECK_LT(cpu, num_cpus_);
+#endif // defined(__APPLE__)
+  // Adjacent CPUs share the same shard, so shared cache lines do not cross sockets.
+  auto& shard = shards_[cpu * num_shards_ / num_cpus_];
+  auto* result = shard.load(std::memory_order_acquire);
+  if (PREDICT_TRUE(result != nullptr)) {
+    return result;
+  }
+  std::unique_ptr<HdrHistogram> new_shard(new HdrHistogram(
+      histogram_prototype_->max_trackable_value(), histogram_prototype_->num_sig_digits()));
+  if (shard.compare_exchange_strong(result, new_shard.get(), std::memory_order_acq_rel)) {
+    return new_shard.release();
+  }
+  return result;
+}
+
+std::unique_ptr<HdrHistogram> Histogram::Snapshot() const {
+  std::unique_ptr<HdrHistogram> result(
+      new HdrHistogram(*shards_[0].load(std::memory_order_acquire)));
+  for (size_t i = 1; i != num_shards_; ++i) {
+    auto* shard = shards_[i].load(std::memory_order_acquire);
+    if (shard) {
+      result->MergeFrom(*shard);
+    }
+  }
+  return result;
 }
 
 void Histogram::Increment(int64_t value) {
-  histogram_->Increment(value);
+  CurrentShard()->Increment(value);
 }
 
 void Histogram::IncrementBy(int64_t value, int64_t amount) {
-  histogram_->IncrementBy(value, amount);
+  CurrentShard()->IncrementBy(value, amount);
 }
 
 Status Histogram::WriteAsJson(JsonWriter* writer,
@@ -774,7 +844,8 @@ Status Histogram::WriteAsJson(JsonWriter* writer,
 
 CHECKED_STATUS Histogram::WriteForPrometheus(
     PrometheusWriter* writer, const MetricEntity::AttributeMap& attr) const {
-  HdrHistogram snapshot(*histogram_);
+  auto snapshot_holder = Snapshot();
+  const auto& snapshot = *snapshot_holder;
 
   // Representing the sum and count require suffixed names.
   std::string hist_name = prototype_->name();
@@ -807,7 +878,8 @@ CHECKED_STATUS Histogram::WriteForPrometheus(
 
 Status Histogram::GetHistogramSnapshotPB(HistogramSnapshotPB* snapshot_pb,
                                          const MetricJsonOptions& opts) const {
-  HdrHistogram snapshot(*histogram_);
+  auto snapshot_holder = Snapshot();
+  auto& snapshot = *snapshot_holder;
   snapshot_pb->set_name(prototype_->name());
   if (opts.include_schema_info) {
     snapshot_pb->set_type(MetricType::Name(prototype_->type()));
@@ -841,22 +913,29 @@ Status Histogram::GetHistogramSnapshotPB(HistogramSnapshotPB* snapshot_pb,
 }
 
 uint64_t Histogram::CountInBucketForValueForTests(uint64_t value) const {
-  return histogram_->CountInBucketForValue(value);
+  return Snapshot()->CountInBucketForValue(value);
 }
 
 uint64_t Histogram::TotalCount() const {
-  return histogram_->TotalCount();
+  uint64_t result = 0;
+  for (size_t i = 0; i != num_shards_; ++i) {
+    auto* shard = shards_[i].load(std::memory_order_acquire);
+    if (shard) {
+      result += shard->TotalCount();
+    }
+  }
+  return result;
 }
 
 uint64_t Histogram::MinValueForTests() const {
-  return histogram_->MinValue();
+  return Snapshot()->MinValue();
 }
 
 uint64_t Histogram::MaxValueForTests() const {
-  return histogram_->MaxValue();
+  return Snapshot()->MaxValue();
 }
 double Histogram::MeanValueForTests() const {
-  return histogram_->MeanValue();
+  return Snapshot()->MeanValue();
 }
 
 ScopedLatencyMetric::ScopedLatencyMetric(
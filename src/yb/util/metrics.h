@@ -239,6 +239,8 @@
 /////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
@@ -567,6 +569,9 @@ class MetricEntity : public RefCountedThreadSafe<MetricEntity> {
   // type defined within the metric prototype.
   void CheckInstantiation(const MetricPrototype* proto) const;
 
+  // Number of shards that should be used by histograms of this entity.
+  size_t NumHistogramShards() const;
+
   const MetricEntityPrototype* const prototype_;
   const std::string id_;
 
@@ -1224,8 +1229,13 @@ class HistogramPrototype : public MetricPrototype {
   DISALLOW_COPY_AND_ASSIGN(HistogramPrototype);
 };
 
+// Histogram is backed by several HdrHistogram shards, so concurrent recording from different
+// CPUs does not update the same cache lines. Shards are allocated lazily on first use and merged
+// when histogram is read.
 class Histogram : public Metric {
  public:
+  ~Histogram();
+
   // Increment the histogram for the given value.
   // 'value' must be non-negative.
   void Increment(int64_t value);
@@ -1249,9 +1259,8 @@ class Histogram : public Metric {
                                 const MetricJsonOptions& opts) const;
 
 
-  // Returns a pointer to the underlying histogram. The implementation of HdrHistogram
-  //   // is thread safe.
-  const HdrHistogram* histogram() const { return histogram_.get(); }
+  // Returns a (non-consistent) snapshot of this histogram, with all shards merged.
+  std::unique_ptr<HdrHistogram> Snapshot() const;
 
   uint64_t CountInBucketForValueForTests(uint64_t value) const;
   uint64_t MinValueForTests() const;
@@ -1261,9 +1270,17 @@ class Histogram : public Metric {
  private:
   FRIEND_TEST(MetricsTest, SimpleHistogramTest);
   friend class MetricEntity;
-  explicit Histogram(const HistogramPrototype* proto);
+  Histogram(const HistogramPrototype* proto, size_t num_shards);
+
+  // Returns shard that should be used by the current CPU, allocating it when necessary.
+  HdrHistogram* CurrentShard();
+
+  const HistogramPrototype* const histogram_prototype_;
+  const size_t num_shards_;
+  const size_t num_cpus_;
+  // The first shard is always allocated.
+  std::unique_ptr<std::atomic<HdrHistogram*>[]> shards_;
 
-  const gscoped_ptr<HdrHistogram> histogram_;
   DISALLOW_COPY_AND_ASSIGN(Histogram);
 };
 
@@ -1322,7 +1339,7 @@ inline scoped_refptr<Histogram> MetricEntity::FindOrCreateHistogram(
   std::lock_guard<simple_spinlock> l(lock_);
   scoped_refptr<Histogram> m = down_cast<Histogram*>(FindPtrOrNull(metric_map_, proto).get());
   if (!m) {
-    m = new Histogram(proto);
+    m = new Histogram(proto, NumHistogramShards());
     InsertOrDie(&metric_map_, proto, m);
   }
   return m;
@@ -17,6 +17,8 @@
 #include <sys/timex.h>
 #endif
 
+#include <mutex>
+
 #include "yb/gutil/walltime.h"
 
 #include "yb/util/atomic.h"
@@ -37,6 +39,10 @@ DEFINE_uint64(max_clock_skew_usec, 50000,
               "Transaction read clock skew in usec. "
               "This is the maximum allowed time delta between servers of a single cluster.");
 
+DEFINE_int32(cached_adjtime_refresh_interval_ms, 500,
+             "How often the cached adjtime clock queries maximum clock error from the kernel.");
+TAG_FLAG(cached_adjtime_refresh_interval_ms, advanced);
+
 namespace yb {
 
 namespace {
@@ -93,26 +99,83 @@ CHECKED_STATUS CallAdjTime(timex* tx) {
   }
 }
 
+Result<PhysicalTime> AdjTimeNow() {
+  const MicrosTime kMicrosPerSec = 1000000;
+
+  timex tx;
+  RETURN_NOT_OK(CallAdjTime(&tx));
+
+  if (tx.status & STA_NANO) {
+    tx.time.tv_usec /= 1000;
+  }
+  DCHECK_LT(tx.time.tv_usec, 1000000);
+
+  return PhysicalTime{ tx.time.tv_sec * kMicrosPerSec + tx.time.tv_usec,
+                       static_cast<yb::MicrosTime>(tx.maxerror) };
+}
+
 class AdjTimeClockImpl : public PhysicalClock {
   Result<PhysicalTime> Now() override {
-    const MicrosTime kMicrosPerSec = 1000000;
+    return CheckClockSyncError(VERIFY_RESULT(AdjTimeNow()));
+  }
 
-    timex tx;
-    RETURN_NOT_OK(CallAdjTime(&tx));
+  MicrosTime MaxGlobalTime(PhysicalTime time) override {
+    return time.time_point + GetAtomicFlag(&FLAGS_max_clock_skew_usec);
+  }
+};
 
-    if (tx.status & STA_NANO) {
-      tx.time.tv_usec /= 1000;
+// Clock that reads time from CLOCK_REALTIME, which is served by vDSO without a syscall, and
+// queries maximum error from the kernel using ntp_adjtime only once per
+// cached_adjtime_refresh_interval_ms.
+//
+// Between queries the error bound is increased by the maximum frequency error that the kernel
+// allows (500 ppm), which is the same rate the kernel itself uses to grow maxerror when it does
+// not get NTP updates. So reported error is never lower than the one AdjTimeClock would report.
+class CachedAdjTimeClockImpl : public PhysicalClock {
+ public:
+  Result<PhysicalTime> Now() override {
+    // Load cached value before reading time, so time could be less than cached one only when
+    // realtime clock was stepped back.
+    auto last = last_adjtime_.load(boost::memory_order_acquire);
+    auto now = static_cast<MicrosTime>(GetCurrentTimeMicros());
+    if (PREDICT_FALSE(last.time_point == 0 || now < last.time_point)) {
+      // Nothing was cached yet or realtime clock was stepped back, so cached error could not be
+      // used and we have to wait for the refresh.
+      std::lock_guard<std::mutex> lock(refresh_mutex_);
+      last = VERIFY_RESULT(RefreshUnlocked());
+      now = last.time_point;
+    } else if (PREDICT_FALSE(
+        now - last.time_point >=
+            GetAtomicFlag(&FLAGS_cached_adjtime_refresh_interval_ms) * 1000ULL)) {
+      // Only one thread refreshes cached error, others use the previous one with increased bound.
+      std::unique_lock<std::mutex> lock(refresh_mutex_, std::try_to_lock);
+      if (lock.owns_lock()) {
+        last = VERIFY_RESULT(RefreshUnlocked());
+        now = last.time_point;
+      }
     }
-    DCHECK_LT(tx.time.tv_usec, 1000000);
 
-    return CheckClockSyncError(
-        { tx.time.tv_sec * kMicrosPerSec + tx.time.tv_usec,
-          static_cast<yb::MicrosTime>(tx.maxerror) });
+    // Add 1 microsecond, to round up elapsed part.
+    auto drift = (now - last.time_point) * kMaxFrequencyErrorPpm / 1000000 + 1;
+    return CheckClockSyncError({ now, last.max_error + drift });
   }
 
   MicrosTime MaxGlobalTime(PhysicalTime time) override {
     return time.time_point + GetAtomicFlag(&FLAGS_max_clock_skew_usec);
   }
+
+ private:
+  // Maximum frequency error of the kernel clock, see MAXFREQ in kernel timex.h.
+  static constexpr MicrosTime kMaxFrequencyErrorPpm = 500;
+
+  Result<PhysicalTime> RefreshUnlocked() {
+    auto result = VERIFY_RESULT(AdjTimeNow());
+    last_adjtime_.store(result, boost::memory_order_release);
+    return result;
+  }
+
+  std::mutex refresh_mutex_;
+  boost::atomic<PhysicalTime> last_adjtime_{{0, 0}};
 };
 
 #endif
@@ -129,6 +192,11 @@ const PhysicalClockPtr& AdjTimeClock() {
   static PhysicalClockPtr instance = std::make_shared<AdjTimeClockImpl>();
   return instance;
 }
+
+const PhysicalClockPtr& CachedAdjTimeClock() {
+  static PhysicalClockPtr instance = std::make_shared<CachedAdjTimeClockImpl>();
+  return instance;
+}
 #endif
 
 Result<PhysicalTime> MockClock::Now() {
@@ -63,7 +63,12 @@ class MockClock : public PhysicalClock {
 const PhysicalClockPtr& WallClock();
 
 #if !defined(__APPLE__)
+// Clock that queries time and maximum error from the kernel using ntp_adjtime on each call.
 const PhysicalClockPtr& AdjTimeClock();
+
+// Clock with the same error guarantees as AdjTimeClock, that does not perform syscalls on most
+// calls, see CachedAdjTimeClockImpl for details.
+const PhysicalClockPtr& CachedAdjTimeClock();
 #endif
 
 } // namespace yb
@@ -470,6 +470,10 @@ CHECKED_STATUS PTSelectStmt::AnalyzeIndexes(SemContext *sem_context) {
   selectivities.reserve(table_->index_map().size() + 1);
   selectivities.emplace_back(sem_context->PTempMem(), *this);
   for (const std::pair<TableId, IndexInfo>& index : table_->index_map()) {
+    // Index that is still being backfilled does not contain all rows yet.
+    if (!index.second.HasReadPermission()) {
+      continue;
+    }
     selectivities.emplace_back(sem_context->PTempMem(), *this, index.second);
   }
   std::sort(selectivities.begin(), selectivities.end(), std::greater<Selectivity>());
@@ -195,15 +195,27 @@ PgDocReadOp::PgDocReadOp(
 PgDocReadOp::~PgDocReadOp() {
 }
 
+void PgDocReadOp::SetHashKeyReadOps(
+    std::vector<std::shared_ptr<client::YBPgsqlReadOp>> read_ops) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  hash_key_read_ops_ = std::move(read_ops);
+}
+
 void PgDocReadOp::InitUnlocked(std::unique_lock<std::mutex>* lock) {
   PgDocOp::InitUnlocked(lock);
 
-  read_op_->mutable_request()->set_return_paging_state(true);
+  if (hash_key_read_ops_.empty()) {
+    active_read_ops_ = { read_op_ };
+  } else {
+    active_read_ops_ = hash_key_read_ops_;
+  }
+  for (const auto& read_op : active_read_ops_) {
+    read_op->mutable_request()->set_return_paging_state(true);
+  }
 }
 
-void PgDocReadOp::SetRequestPrefetchLimit() {
+void PgDocReadOp::SetRequestPrefetchLimit(PgsqlReadRequestPB *req) {
   // Predict the maximum prefetch-limit using the associated gflags.
-  PgsqlReadRequestPB *req = read_op_->mutable_request();
   int predicted_limit = FLAGS_ysql_prefetch_limit;
   if (!req->is_forward_scan()) {
     // Backward scan is slower than forward scan, so predicted limit is a smaller number.
@@ -218,11 +230,10 @@ void PgDocReadOp::SetRequestPrefetchLimit() {
   req->set_limit(limit_count);
 }
 
-void PgDocReadOp::SetRowMarks() {
+void PgDocReadOp::SetRowMarks(PgsqlReadRequestPB *req) {
   if (exec_params_.rowmark < 0) {
     return;
   }
-  PgsqlReadRequestPB *req = read_op_->mutable_request();
 
   // We only support one type of row lock at a time.
   if (req->row_mark_type_size() > 0) {
@@ -234,10 +245,13 @@ void PgDocReadOp::SetRowMarks() {
 Status PgDocReadOp::SendRequestUnlocked() {
   CHECK(!waiting_for_response_);
 
-  SetRequestPrefetchLimit();
-  SetRowMarks();
-  SCHECK_EQ(VERIFY_RESULT(pg_session_->PgApplyAsync(read_op_, &read_time_)), OpBuffered::kFalse,
-            IllegalState, "YSQL read operation should not be buffered");
+  // All operations are flushed together, so the session sends a single RPC to each tablet.
+  for (const auto& read_op : active_read_ops_) {
+    SetRequestPrefetchLimit(read_op->mutable_request());
+    SetRowMarks(read_op->mutable_request());
+    SCHECK_EQ(VERIFY_RESULT(pg_session_->PgApplyAsync(read_op, &read_time_)), OpBuffered::kFalse,
+              IllegalState, "YSQL read operation should not be buffered");
+  }
 
   waiting_for_response_ = true;
   Status s = pg_session_->PgFlushAsync([this](const Status& s) {
@@ -257,8 +271,16 @@ void PgDocReadOp::ReceiveResponse(Status exec_status) {
   waiting_for_response_ = false;
   exec_status_ = exec_status;
 
-  if (exec_status.ok() && CheckRestartUnlocked(read_op_.get())) {
-    return;
+  // Check all operations before caching any rows, so a restart resends all of them.
+  if (exec_status.ok()) {
+    for (const auto& read_op : active_read_ops_) {
+      if (CheckRestartUnlocked(read_op.get())) {
+        return;
+      }
+      if (!exec_status_.ok()) {
+        break;
+      }
+    }
   }
 
   // exec_status_ could be changed by CheckRestartUnlocked
@@ -268,36 +290,49 @@ void PgDocReadOp::ReceiveResponse(Status exec_status) {
   }
 
   if (!is_canceled_) {
-    // Save it to cache.
-    WriteToCacheUnlocked(read_op_);
-
-    // Setup request for the next batch of data.
-    const PgsqlResponsePB& res = read_op_->response();
-    if (res.has_paging_state()) {
-      PgsqlReadRequestPB *req = read_op_->mutable_request();
-      // Set up paging state for next request.
-      // A query request can be nested, and paging state belong to the innermost query which is
-      // the read operator that is operated first and feeds data to other queries.
-      // Recursive Proto Message:
-      //     PgsqlReadRequestPB { PgsqlReadRequestPB index_request; }
-      PgsqlReadRequestPB *innermost_req = req;
-      while (innermost_req->has_index_request()) {
-        innermost_req = innermost_req->mutable_index_request();
+    auto it = active_read_ops_.begin();
+    while (it != active_read_ops_.end()) {
+      // Save it to cache.
+      WriteToCacheUnlocked(*it);
+
+      // Setup request for the next batch of data.
+      if (SetupNextPageUnlocked(it->get())) {
+        ++it;
+      } else {
+        it = active_read_ops_.erase(it);
       }
-      *innermost_req->mutable_paging_state() = res.paging_state();
-      // Parse/Analysis/Rewrite catalog version has already been checked on the first request.
-      // The docdb layer will check the target table's schema version is compatible.
-      // This allows long-running queries to continue in the presence of other DDL statements
-      // as long as they do not affect the table(s) being queried.
-      req->clear_ysql_catalog_version();
-    } else {
-      end_of_data_ = true;
     }
+    end_of_data_ = active_read_ops_.empty();
   } else {
     end_of_data_ = true;
   }
 }
 
+bool PgDocReadOp::SetupNextPageUnlocked(client::YBPgsqlReadOp* read_op) {
+  const PgsqlResponsePB& res = read_op->response();
+  if (!res.has_paging_state()) {
+    return false;
+  }
+
+  PgsqlReadRequestPB *req = read_op->mutable_request();
+  // Set up paging state for next request.
+  // A query request can be nested, and paging state belong to the innermost query which is
+  // the read operator that is operated first and feeds data to other queries.
+  // Recursive Proto Message:
+  //     PgsqlReadRequestPB { PgsqlReadRequestPB index_request; }
+  PgsqlReadRequestPB *innermost_req = req;
+  while (innermost_req->has_index_request()) {
+    innermost_req = innermost_req->mutable_index_request();
+  }
+  *innermost_req->mutable_paging_state() = res.paging_state();
+  // Parse/Analysis/Rewrite catalog version has already been checked on the first request.
+  // The docdb layer will check the target table's schema version is compatible.
+  // This allows long-running queries to continue in the presence of other DDL statements
+  // as long as they do not affect the table(s) being queried.
+  req->clear_ysql_catalog_version();
+  return true;
+}
+
 //--------------------------------------------------------------------------------------------------
 
 PgDocWriteOp::PgDocWriteOp(PgSession::ScopedRefPtr pg_session, client::YBPgsqlWriteOp *write_op)
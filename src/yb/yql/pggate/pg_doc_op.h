@@ -138,6 +138,10 @@ class PgDocReadOp : public PgDocOp {
     return read_op_;
   }
 
+  // Executes the given operations instead of read_op_, e.g. lookups of the hash keys listed by an
+  // IN condition. They are sent together, so the session batches them into one RPC per tablet.
+  void SetHashKeyReadOps(std::vector<std::shared_ptr<client::YBPgsqlReadOp>> read_ops);
+
  private:
   // Process response from DocDB.
   void InitUnlocked(std::unique_lock<std::mutex>* lock) override;
@@ -145,13 +149,23 @@ class PgDocReadOp : public PgDocOp {
   virtual void ReceiveResponse(Status exec_status);
 
   // Analyze options and pick the appropriate prefetch limit.
-  void SetRequestPrefetchLimit();
+  void SetRequestPrefetchLimit(PgsqlReadRequestPB *req);
 
   // Add a row_mark_type element. For now we only support one.
-  void SetRowMarks();
+  void SetRowMarks(PgsqlReadRequestPB *req);
+
+  // Sets up paging state of the given operation for its next request. Returns false if the
+  // operation has read all its data.
+  bool SetupNextPageUnlocked(client::YBPgsqlReadOp* read_op);
 
   // Operator.
   std::shared_ptr<client::YBPgsqlReadOp> read_op_;
+
+  // Operators executed instead of read_op_ if set.
+  std::vector<std::shared_ptr<client::YBPgsqlReadOp>> hash_key_read_ops_;
+
+  // Operators that have more data to read, they are sent together by the next request.
+  std::vector<std::shared_ptr<client::YBPgsqlReadOp>> active_read_ops_;
 };
 
 class PgDocWriteOp : public PgDocOp {
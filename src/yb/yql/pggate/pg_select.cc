@@ -17,6 +17,8 @@
 #include "yb/yql/pggate/util/pg_doc_data.h"
 #include "yb/client/yb_op.h"
 #include "yb/docdb/primitive_value.h"
+#include "yb/gutil/casts.h"
+#include "yb/yql/pggate/pggate_flags.h"
 
 namespace yb {
 namespace pggate {
@@ -131,12 +133,16 @@ Status PgSelect::DeleteEmptyPrimaryBinds() {
     bool miss_partition_columns = false;
     bool has_partition_columns = false;
 
+    // Hash key columns with IN conditions are bound to each of their values by separate lookups.
+    lookup_hash_keys_ = CanLookupHashKeys();
+
     for (size_t i = 0; i < table_desc->num_hash_key_columns(); i++) {
       PgColumn &col = table_desc->columns()[i];
-      if (expr_binds_.find(col.bind_pb()) == expr_binds_.end()) {
-        miss_partition_columns = true;
-      } else {
+      if (expr_binds_.find(col.bind_pb()) != expr_binds_.end() ||
+          (lookup_hash_keys_ && hash_in_values_[i])) {
         has_partition_columns = true;
+      } else {
+        miss_partition_columns = true;
       }
     }
 
@@ -171,6 +177,7 @@ Status PgSelect::DeleteEmptyPrimaryBinds() {
     range_column_values->DeleteSubrange(num_bound_range_columns,
                                         range_column_values->size() - num_bound_range_columns);
   } else {
+    lookup_hash_keys_ = false;
     read_req_->clear_partition_column_values();
     read_req_->clear_range_column_values();
   }
@@ -178,6 +185,57 @@ Status PgSelect::DeleteEmptyPrimaryBinds() {
   return Status::OK();
 }
 
+bool PgSelect::CanLookupHashKeys() {
+  if (hash_in_values_.empty() || index_id_.IsValid() || has_aggregate_targets() ||
+      FLAGS_ysql_max_hash_key_lookups <= 0) {
+    return false;
+  }
+
+  size_t num_lookups = 1;
+  for (size_t i = 0; i < table_desc_->num_hash_key_columns(); i++) {
+    if (hash_in_values_[i]) {
+      num_lookups *= hash_in_values_[i]->elems_size();
+      if (num_lookups > static_cast<size_t>(FLAGS_ysql_max_hash_key_lookups)) {
+        return false;
+      }
+    } else if (expr_binds_.find(table_desc_->columns()[i].bind_pb()) == expr_binds_.end()) {
+      return false;
+    }
+  }
+  return num_lookups > 0;
+}
+
+std::vector<std::shared_ptr<client::YBPgsqlReadOp>> PgSelect::MakeHashKeyReadOps() {
+  const size_t num_hash_key_columns = table_desc_->num_hash_key_columns();
+  std::vector<std::shared_ptr<client::YBPgsqlReadOp>> read_ops;
+  std::vector<int> value_indexes(num_hash_key_columns, 0);
+  for (;;) {
+    std::shared_ptr<client::YBPgsqlReadOp> read_op(table_desc_->NewPgsqlSelect());
+    PgsqlReadRequestPB *read_req = read_op->mutable_request();
+    *read_req = *read_req_;
+    for (size_t i = 0; i < num_hash_key_columns; i++) {
+      if (hash_in_values_[i]) {
+        *read_req->mutable_partition_column_values(i)->mutable_value() =
+            hash_in_values_[i]->elems(value_indexes[i]);
+      }
+    }
+    read_ops.push_back(std::move(read_op));
+
+    // Advance to the next combination of values, the last column changes first.
+    size_t i = num_hash_key_columns;
+    for (; i > 0; i--) {
+      const QLSeqValuePB* values = hash_in_values_[i - 1];
+      if (values && ++value_indexes[i - 1] < values->elems_size()) {
+        break;
+      }
+      value_indexes[i - 1] = 0;
+    }
+    if (i == 0) {
+      return read_ops;
+    }
+  }
+}
+
 //--------------------------------------------------------------------------------------------------
 
 Status PgSelect::FindIndexColumn(int attr_num, PgColumn **col) {
@@ -237,6 +295,13 @@ Status PgSelect::Exec(const PgExecParameters *exec_params) {
     DCHECK(!has_aggregate_targets()) << "Aggregate pushdown should not happen with index";
   }
 
+  // Look up the hash keys listed by IN conditions, each lookup reads a copy of read_req_.
+  std::vector<std::shared_ptr<client::YBPgsqlReadOp>> hash_key_read_ops;
+  if (lookup_hash_keys_) {
+    hash_key_read_ops = MakeHashKeyReadOps();
+  }
+  down_cast<PgDocReadOp*>(doc_op_.get())->SetHashKeyReadOps(std::move(hash_key_read_ops));
+
   // Execute select statement asynchronously.
   SCHECK_EQ(VERIFY_RESULT(doc_op_->Execute()), RequestSent::kTrue, IllegalState,
             "YSQL read operation was not sent");
@@ -389,6 +454,12 @@ Status PgSelect::BindColumnCondIn(int attr_num, int n_attr_values, PgExpr **attr
     }
   }
 
+  // Remember values of hash key columns, so the listed keys could be looked up separately.
+  if (col->desc()->is_partition()) {
+    hash_in_values_.resize(table_desc_->num_hash_key_columns());
+    hash_in_values_[col->desc()->index()] = &op2_pb->value().list_value();
+  }
+
   return Status::OK();
 }
 
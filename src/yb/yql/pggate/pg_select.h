@@ -90,6 +90,13 @@ class PgSelect : public PgDml {
   // Delete allocated target for columns that have no bind-values.
   CHECKED_STATUS DeleteEmptyPrimaryBinds();
 
+  // Whether every hash key column is bound to a value or has an IN condition, so the statement
+  // could look up the listed hash keys instead of scanning the whole table.
+  bool CanLookupHashKeys();
+
+  // Create a read operation for every combination of the hash key values.
+  std::vector<std::shared_ptr<client::YBPgsqlReadOp>> MakeHashKeyReadOps();
+
   // Load index.
   CHECKED_STATUS LoadIndex();
 
@@ -100,6 +107,12 @@ class PgSelect : public PgDml {
   std::shared_ptr<client::YBPgsqlReadOp> read_op_;
   PgsqlReadRequestPB *read_req_ = nullptr;
   PgsqlReadRequestPB *index_req_ = nullptr;
+
+  // Values of IN conditions on hash key columns, indexed by column. Null for other columns.
+  std::vector<const QLSeqValuePB*> hash_in_values_;
+
+  // Whether hash keys of IN conditions are looked up instead of scanning the table.
+  bool lookup_hash_keys_ = false;
 };
 
 }  // namespace pggate
@@ -32,8 +32,13 @@
 #include "yb/common/pgsql_error.h"
 #include "yb/common/ql_protocol_util.h"
 
+#include "yb/tserver/tablet_server.h"
+#include "yb/tserver/tserver_service.proxy.h"
 #include "yb/tserver/tserver_shared_mem.h"
 
+#include "yb/util/async_util.h"
+#include "yb/util/logging.h"
+#include "yb/util/net/net_util.h"
 #include "yb/util/string_util.h"
 #include "yb/util/random_util.h"
 
@@ -61,6 +66,7 @@ using yb::master::IsInitDbDoneRequestPB;
 using yb::master::IsInitDbDoneResponsePB;
 using yb::master::MasterServiceProxy;
 
+using yb::tserver::TabletServerServiceProxy;
 using yb::tserver::TServerSharedMemory;
 
 #if defined(__APPLE__) && !defined(NDEBUG)
@@ -73,6 +79,8 @@ const int kDefaultPgYbSessionTimeoutMs = 60 * 1000;
 DEFINE_int32(pg_yb_session_timeout_ms, kDefaultPgYbSessionTimeoutMs,
              "Timeout for operations between PostgreSQL server and YugaByte DocDB services");
 
+DECLARE_string(rpc_bind_addresses);
+
 //--------------------------------------------------------------------------------------------------
 // Constants used for the sequences data table.
 //--------------------------------------------------------------------------------------------------
@@ -104,6 +112,16 @@ std::unique_ptr<TServerSharedMemory> InitTServerSharedMemory() {
       SharedMemorySegment::AccessMode::kReadOnly);
 }
 
+std::unique_ptr<TabletServerServiceProxy> CreateTServerProxy(rpc::ProxyCache* proxy_cache) {
+  auto host_ports = HostPort::ParseStrings(FLAGS_rpc_bind_addresses, tserver::TabletServer::kDefaultPort);
+  if (!host_ports.ok() || host_ports->empty()) {
+    LOG(WARNING) << "Failed to determine local tablet server address from '"
+                 << FLAGS_rpc_bind_addresses << "', tables will be loaded from master";
+    return nullptr;
+  }
+  return std::make_unique<TabletServerServiceProxy>(proxy_cache, host_ports->front());
+}
+
 }  // namespace
 
 //--------------------------------------------------------------------------------------------------
@@ -122,6 +140,11 @@ PgSession::PgSession(
       tserver_shared_memory_(InitTServerSharedMemory()) {
   session_->SetTimeout(MonoDelta::FromMilliseconds(FLAGS_pg_yb_session_timeout_ms));
   session_->SetForceConsistentRead(client::ForceConsistentRead::kTrue);
+  // Table cache of the tablet server is used only when this process was started by the local
+  // tablet server, i.e. its shared memory is available.
+  if (tserver_shared_memory_ && FLAGS_ysql_use_tserver_table_cache) {
+    tserver_proxy_ = CreateTServerProxy(&client_->proxy_cache());
+  }
 }
 
 PgSession::~PgSession() {
@@ -430,7 +453,7 @@ Result<PgTableDesc::ScopedRefPtr> PgSession::LoadTable(const PgObjectId& table_i
 
   auto cached_yb_table = table_cache_.find(yb_table_id);
   if (cached_yb_table == table_cache_.end()) {
-    Status s = client_->OpenTable(yb_table_id, &table);
+    Status s = OpenTable(yb_table_id, &table);
     if (!s.ok()) {
       VLOG(3) << "LoadTable: Server returns an error: " << s;
       // TODO: NotFound might not always be the right status here.
@@ -449,7 +472,54 @@ Result<PgTableDesc::ScopedRefPtr> PgSession::LoadTable(const PgObjectId& table_i
 
 void PgSession::InvalidateTableCache(const PgObjectId& table_id) {
   const TableId yb_table_id = table_id.GetYBTableId();
-  table_cache_.erase(yb_table_id);
+  auto it = table_cache_.find(yb_table_id);
+  if (it == table_cache_.end()) {
+    return;
+  }
+  outdated_schema_versions_[yb_table_id] = it->second->schema().version();
+  table_cache_.erase(it);
+}
+
+Status PgSession::OpenTable(const TableId& table_id, std::shared_ptr<YBTable>* table) {
+  if (!tserver_proxy_) {
+    return client_->OpenTable(table_id, table);
+  }
+
+  tserver::GetTableInfoRequestPB req;
+  tserver::GetTableInfoResponsePB resp;
+  req.set_table_id(table_id);
+  auto catalog_version = GetSharedCatalogVersion();
+  if (catalog_version.ok()) {
+    req.set_ysql_catalog_version(*catalog_version);
+  }
+  auto outdated_it = outdated_schema_versions_.find(table_id);
+  if (outdated_it != outdated_schema_versions_.end()) {
+    req.set_outdated_schema_version(outdated_it->second);
+  }
+
+  rpc::RpcController controller;
+  controller.set_timeout(MonoDelta::FromSeconds(FLAGS_pggate_rpc_timeout_secs));
+  Status s = tserver_proxy_->GetTableInfo(req, &resp, &controller);
+  if (s.ok() && resp.has_error()) {
+    s = StatusFromPB(resp.error().status());
+    if (s.IsNotFound()) {
+      return s;
+    }
+  }
+  if (!s.ok()) {
+    YB_LOG_EVERY_N_SECS(WARNING, 10)
+        << "Failed to load table " << table_id << " from the local tablet server, "
+        << "loading it from master: " << s;
+    return client_->OpenTable(table_id, table);
+  }
+
+  RETURN_NOT_OK(client_->OpenTable(
+      resp.schema(), std::vector<std::string>(resp.partitions().begin(), resp.partitions().end()),
+      table));
+  if (outdated_it != outdated_schema_versions_.end()) {
+    outdated_schema_versions_.erase(outdated_it);
+  }
+  return Status::OK();
 }
 
 Status PgSession::StartBufferingWriteOperations() {
@@ -482,32 +552,79 @@ Status PgSession::FlushBufferedWriteOperations(PgsqlOpBuffer* write_ops, bool tr
         num_writes = 0;
       }
     }
-    for (auto it = write_ops->begin(); it != write_ops->end(); ++it) {
-      // Handle any QL errors from individual ops.
-      std::shared_ptr<client::YBPgsqlOp> op = *it;
-      if (!op->succeeded()) {
-        const auto& response = op->response();
-        YBPgErrorCode pg_error_code = YBPgErrorCode::YB_PG_INTERNAL_ERROR;
-        if (response.has_pg_error_code()) {
-          pg_error_code = static_cast<YBPgErrorCode>(response.pg_error_code());
-        }
-
-        Status s;
-        if (response.status() == PgsqlResponsePB::PGSQL_STATUS_DUPLICATE_KEY_ERROR) {
-          s = STATUS(AlreadyPresent, op->response().error_message(), Slice(),
-                     PgsqlError(pg_error_code));
-        } else {
-          s = STATUS(QLError, op->response().error_message(), Slice(),
-                     PgsqlError(pg_error_code));
-        }
-        final_status = CombineStatuses(final_status, s);
-      }
-    }
+    final_status = CombineWriteOpErrors(*write_ops, final_status);
     write_ops->clear();
   }
   return final_status;
 }
 
+Status PgSession::CombineWriteOpErrors(const PgsqlOpBuffer& write_ops, Status status) {
+  for (const auto& op : write_ops) {
+    // Handle any QL errors from individual ops.
+    if (!op->succeeded()) {
+      const auto& response = op->response();
+      YBPgErrorCode pg_error_code = YBPgErrorCode::YB_PG_INTERNAL_ERROR;
+      if (response.has_pg_error_code()) {
+        pg_error_code = static_cast<YBPgErrorCode>(response.pg_error_code());
+      }
+
+      Status s;
+      if (response.status() == PgsqlResponsePB::PGSQL_STATUS_DUPLICATE_KEY_ERROR) {
+        s = STATUS(AlreadyPresent, op->response().error_message(), Slice(),
+                   PgsqlError(pg_error_code));
+      } else {
+        s = STATUS(QLError, op->response().error_message(), Slice(),
+                   PgsqlError(pg_error_code));
+      }
+      status = CombineStatuses(status, s);
+    }
+  }
+  return status;
+}
+
+Result<client::YBSessionPtr> PgSession::NewWriteBatchSession(bool transactional) {
+  if (transactional) {
+    RETURN_NOT_OK(GetSession(transactional, false /* read_only_op */));
+    return pg_txn_manager_->NewWriteBatchSession();
+  }
+  auto session = client_->NewSession();
+  session->SetTimeout(session_->timeout());
+  session->SetForceConsistentRead(client::ForceConsistentRead::kTrue);
+  return session;
+}
+
+Status PgSession::SendBufferedWriteOperations(PgsqlOpBuffer* write_ops, bool transactional) {
+  // Each batch in flight uses its own session, so errors of its operations are not mixed with
+  // errors of other batches.
+  auto session = VERIFY_RESULT(NewWriteBatchSession(transactional));
+
+  InFlightWriteBatch batch;
+  batch.ops.swap(*write_ops);
+  for (const auto& op : batch.ops) {
+    DCHECK_EQ(op->IsTransactional(), transactional);
+    RETURN_NOT_OK(session->Apply(op));
+  }
+  batch.flush_status = MakeFuture<Status>([this, session](auto callback) {
+    session->FlushAsync([this, session, callback](const Status& status) {
+      callback(CombineErrorsToStatus(session->GetPendingErrors(), status));
+    });
+  });
+  in_flight_write_batches_.push_back(std::move(batch));
+
+  while (in_flight_write_batches_.size() >
+             static_cast<size_t>(FLAGS_ysql_session_max_in_flight_write_batches)) {
+    RETURN_NOT_OK(WaitForInFlightWriteBatch());
+  }
+  return Status::OK();
+}
+
+Status PgSession::WaitForInFlightWriteBatch() {
+  auto& batch = in_flight_write_batches_.front();
+  auto status = CombineWriteOpErrors(batch.ops, batch.flush_status.get());
+  in_flight_write_batches_.pop_front();
+  return status;
+}
+
 Status PgSession::FlushBufferedWriteOperations() {
   CHECK_GT(buffer_write_ops_, 0);
   if (--buffer_write_ops_ > 0) {
@@ -519,6 +636,10 @@ Status PgSession::FlushBufferedWriteOperations() {
   final_status = CombineStatuses(final_status, s);
   s = FlushBufferedWriteOperations(&buffered_txn_write_ops_, true /* transactional */);
   final_status = CombineStatuses(final_status, s);
+  while (!in_flight_write_batches_.empty()) {
+    s = WaitForInFlightWriteBatch();
+    final_status = CombineStatuses(final_status, s);
+  }
   return final_status;
 }
 
@@ -546,10 +667,12 @@ Result<OpBuffered> PgSession::PgApplyAsync(const std::shared_ptr<client::YBPgsql
   // catalog tables during initdb. Continuing read ops to scan the table can be issued while
   // writes to its index are being buffered.
   if (buffer_write_ops_ > 0 && op->type() == YBOperation::Type::PGSQL_WRITE) {
-    if (op->IsTransactional()) {
-      buffered_txn_write_ops_.push_back(op);
-    } else {
-      buffered_write_ops_.push_back(op);
+    auto* write_ops = op->IsTransactional() ? &buffered_txn_write_ops_ : &buffered_write_ops_;
+    write_ops->push_back(op);
+    // Send full batches right away, so e.g. COPY keeps parsing input while they are written.
+    if (FLAGS_ysql_session_max_in_flight_write_batches > 0 &&
+        write_ops->size() >= static_cast<size_t>(FLAGS_ysql_session_max_batch_size)) {
+      RETURN_NOT_OK(SendBufferedWriteOperations(write_ops, op->IsTransactional()));
     }
     return OpBuffered::kTrue;
   }
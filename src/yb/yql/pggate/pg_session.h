@@ -14,6 +14,9 @@
 #ifndef YB_YQL_PGGATE_PG_SESSION_H_
 #define YB_YQL_PGGATE_PG_SESSION_H_
 
+#include <deque>
+#include <future>
+
 #include <boost/optional.hpp>
 
 #include "yb/client/client.h"
@@ -36,6 +39,7 @@ namespace yb {
 
 namespace tserver {
 
+class TabletServerServiceProxy;
 class TServerSharedMemory;
 
 }  // namespace tserver
@@ -132,6 +136,7 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   CHECKED_STATUS DropIndex(const PgObjectId& index_id);
   CHECKED_STATUS TruncateTable(const PgObjectId& table_id);
   Result<PgTableDesc::ScopedRefPtr> LoadTable(const PgObjectId& table_id);
+  // Drops the table from the cache, so it is loaded again with a schema newer than the cached one.
   void InvalidateTableCache(const PgObjectId& table_id);
 
   // Buffer write operations.
@@ -223,6 +228,24 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   // Flush buffered write operations from the given buffer.
   Status FlushBufferedWriteOperations(PgsqlOpBuffer* write_ops, bool transactional);
 
+  // Returns a new session for a batch of buffered write operations sent by
+  // SendBufferedWriteOperations().
+  Result<client::YBSessionPtr> NewWriteBatchSession(bool transactional);
+
+  // Sends buffered write operations from the given buffer without waiting for them to complete.
+  // Waits for the oldest sent batch while there are too many batches in flight.
+  CHECKED_STATUS SendBufferedWriteOperations(PgsqlOpBuffer* write_ops, bool transactional);
+
+  // Waits for the oldest batch sent by SendBufferedWriteOperations() and returns its status.
+  CHECKED_STATUS WaitForInFlightWriteBatch();
+
+  // Combines status with errors of individual operations.
+  Status CombineWriteOpErrors(const PgsqlOpBuffer& write_ops, Status status);
+
+  // Opens the table using information cached by the local tablet server, falls back to fetching
+  // it from master when the tablet server cannot provide it.
+  CHECKED_STATUS OpenTable(const TableId& table_id, std::shared_ptr<client::YBTable>* table);
+
   // YBClient, an API that SQL engine uses to communicate with all servers.
   client::YBClient* const client_;
 
@@ -246,11 +269,22 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   std::unordered_map<TableId, std::shared_ptr<client::YBTable>> table_cache_;
 
+  // Schema versions of tables that were invalidated by InvalidateTableCache, so the local tablet
+  // server reloads them if it still has these versions cached.
+  std::unordered_map<TableId, uint32_t> outdated_schema_versions_;
+
   // Should write operations be buffered?
   uint buffer_write_ops_ = 0;
   PgsqlOpBuffer buffered_write_ops_;
   PgsqlOpBuffer buffered_txn_write_ops_;
 
+  // Buffered write operations that were sent while buffering continues.
+  struct InFlightWriteBatch {
+    PgsqlOpBuffer ops;
+    std::future<Status> flush_status;
+  };
+  std::deque<InFlightWriteBatch> in_flight_write_batches_;
+
   bool has_txn_ops_ = false;
   bool has_non_txn_ops_ = false;
 
@@ -260,6 +294,10 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   // Local tablet-server shared memory segment handle. This has a value of nullptr
   // if the shared memory has not been initialized (e.g. during initdb).
   std::unique_ptr<tserver::TServerSharedMemory> tserver_shared_memory_;
+
+  // Proxy to the local tablet server, used to load tables from its cache. This has a value of
+  // nullptr if the tablet server cache is not used.
+  std::unique_ptr<tserver::TabletServerServiceProxy> tserver_proxy_;
 };
 
 }  // namespace pggate
@@ -100,6 +100,14 @@ Status PgTxnManager::BeginWriteTransactionIfNecessary(bool read_only_op) {
   return Status::OK();
 }
 
+Result<YBSessionPtr> PgTxnManager::NewWriteBatchSession() {
+  RETURN_NOT_OK(BeginWriteTransactionIfNecessary(false /* read_only_op */));
+  auto session = std::make_shared<YBSession>(async_client_init_->client(), clock_);
+  session->SetForceConsistentRead(client::ForceConsistentRead::kTrue);
+  session->SetTransaction(txn_);
+  return session;
+}
+
 Status PgTxnManager::RestartTransaction() {
   if (!txn_in_progress_ || !txn_) {
     if (!session_->IsRestartRequired()) {
@@ -48,6 +48,10 @@ YBC_STATUS_METHOD(SetIsolationLevel, ((int, isolation)));
   yb::Result<client::YBSession*> GetTransactionalSession();
 
   Status BeginWriteTransactionIfNecessary(bool read_only_op);
+
+  // Returns a new session, that writes in the current write transaction, but collects errors
+  // separately from the transactional session.
+  yb::Result<client::YBSessionPtr> NewWriteBatchSession();
   Status RestartTransaction();
 
   bool CanRestart() { return can_restart_.load(std::memory_order_acquire); }
@@ -27,6 +27,7 @@
 #include "yb/client/client_utils.h"
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/secure_stream.h"
+#include "yb/rpc/shared_exchange.h"
 #include "yb/yql/pggate/pggate_flags.h"
 
 DECLARE_string(rpc_bind_addresses);
@@ -117,6 +118,16 @@ PgApiImpl::PgApiImpl(const YBCPgTypeEntity *YBCDataTypeArray, int count)
       pg_txn_manager_(new PgTxnManager(&async_client_init_, clock_)) {
   CHECK_OK(clock_->Init());
 
+  if (FLAGS_pggate_tserver_shared_exchange_fd >= 0) {
+    auto exchange = rpc::SharedExchangeClient::Open(FLAGS_pggate_tserver_shared_exchange_fd);
+    if (exchange.ok()) {
+      messenger_holder_.messenger->SetSharedExchangeClient(std::move(*exchange));
+    } else {
+      LOG(WARNING) << "Failed to open shared exchange with the local tablet server, "
+                   << "falling back to TCP: " << exchange.status();
+    }
+  }
+
   // Setup type mapping.
   for (int idx = 0; idx < count; idx++) {
     const YBCPgTypeEntity *type_entity = &YBCDataTypeArray[idx];
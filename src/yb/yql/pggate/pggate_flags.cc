@@ -42,6 +42,10 @@ DEFINE_string(pggate_master_addresses, "",
 DEFINE_int32(pggate_tserver_shm_fd, -1,
               "File descriptor of the local tablet server's shared memory.");
 
+DEFINE_int32(pggate_tserver_shared_exchange_fd, -1,
+             "File descriptor of the shared memory exchange used to send calls to the local tablet "
+             "server. When not set, calls are sent over TCP.");
+
 DEFINE_test_flag(bool, pggate_ignore_tserver_shm, false,
               "Ignore the shared memory of the local tablet server.");
 
@@ -51,13 +55,28 @@ DEFINE_int32(ysql_prefetch_limit, 1024,
 DEFINE_double(ysql_backward_prefetch_scale_factor, 0.0625 /* 1/16th */,
               "Scale factor to reduce ysql_prefetch_limit for backward scan");
 
+DEFINE_int32(ysql_max_hash_key_lookups, 1024,
+             "Maximum number of hash keys listed by IN conditions on the hash key of a table, that "
+             "are looked up by separate reads sent together in one RPC per tablet. A statement "
+             "listing more keys scans the whole table. 0 to always scan.");
+
 DEFINE_int32(ysql_session_max_batch_size, 512,
              "Maximum batch size for buffered writes between PostgreSQL server and YugaByte DocDB "
              "services");
 
+DEFINE_int32(ysql_session_max_in_flight_write_batches, 4,
+             "Maximum number of batches of buffered writes, e.g. rows of COPY, that are sent to "
+             "YugaByte DocDB services while more writes are buffered. When the limit is reached, "
+             "buffering waits for the oldest batch to complete. 0 to send buffered writes only "
+             "when buffering ends.");
+
 DEFINE_bool(ysql_non_txn_copy, false,
             "Execute COPY inserts non-transactionally.");
 
+DEFINE_bool(ysql_use_tserver_table_cache, false,
+            "Load table schemas and partitions through the cache of the local tablet server, "
+            "instead of fetching them from master in every PostgreSQL backend.");
+
 // Top-level flag to enable all YSQL beta features.
 DEFINE_bool(ysql_beta_features, true,
             "Whether to enable all ysql beta features");
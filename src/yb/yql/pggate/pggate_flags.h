@@ -22,11 +22,15 @@ DECLARE_int32(pggate_ybclient_reactor_threads);
 DECLARE_string(pggate_proxy_bind_address);
 DECLARE_string(pggate_master_addresses);
 DECLARE_int32(pggate_tserver_shm_fd);
+DECLARE_int32(pggate_tserver_shared_exchange_fd);
 DECLARE_bool(pggate_ignore_tserver_shm);
 DECLARE_int32(ysql_prefetch_limit);
 DECLARE_double(ysql_backward_prefetch_scale_factor);
+DECLARE_int32(ysql_max_hash_key_lookups);
 DECLARE_int32(ysql_session_max_batch_size);
+DECLARE_int32(ysql_session_max_in_flight_write_batches);
 DECLARE_bool(ysql_non_txn_copy);
+DECLARE_bool(ysql_use_tserver_table_cache);
 
 DECLARE_bool(ysql_beta_features);
 DECLARE_bool(ysql_beta_feature_function);
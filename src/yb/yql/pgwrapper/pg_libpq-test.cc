@@ -23,9 +23,12 @@ using namespace std::literals;
 
 DECLARE_int64(external_mini_cluster_max_log_bytes);
 DECLARE_int64(retryable_rpc_single_call_timeout_ms);
+DECLARE_int32(ysql_session_max_batch_size);
 
+METRIC_DECLARE_entity(server);
 METRIC_DECLARE_entity(tablet);
 METRIC_DECLARE_counter(transaction_not_found);
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_Read);
 
 namespace yb {
 namespace pgwrapper {
@@ -746,5 +749,206 @@ TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(BulkCopy)) {
   }
 }
 
+TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(BulkCopyDuplicateKey)) {
+  // Rows are written by several batches in flight, an error in any of them should fail COPY.
+  const std::string kTableName = "copy_dup";
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.ExecuteFormat("CREATE TABLE $0 (k INT PRIMARY KEY, v TEXT)", kTableName));
+
+  constexpr int kNumRows = 5000;
+
+  ASSERT_OK(conn.CopyBegin(Format("COPY $0 FROM STDIN WITH BINARY", kTableName)));
+  for (int i = 0; i != kNumRows; ++i) {
+    conn.CopyStartRow(2);
+    // The last row duplicates the first one.
+    conn.CopyPutInt32(i + 1 == kNumRows ? 0 : i);
+    conn.CopyPutString(Format("Value $0", i));
+  }
+  auto copy_result = conn.CopyEnd();
+  if (copy_result.ok()) {
+    ASSERT_EQ(PQresultStatus(copy_result->get()), PGRES_FATAL_ERROR);
+  }
+
+  auto result = ASSERT_RESULT(conn.FetchFormat("SELECT COUNT(*) FROM $0", kTableName));
+  ASSERT_EQ(ASSERT_RESULT(GetInt64(result.get(), 0, 0)), 0);
+}
+
+TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(BulkCopyConflictInFlightBatches)) {
+  // Rows of two batches, that are in flight at the same time, conflict with each other.
+  const std::string kTableName = "copy_conflict";
+  const int batch_size = FLAGS_ysql_session_max_batch_size;
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.ExecuteFormat("CREATE TABLE $0 (k INT PRIMARY KEY, v TEXT)", kTableName));
+
+  // Delay writes, so the second batch is sent before the first one completes.
+  ASSERT_OK(cluster_->SetFlagOnTServers("write_rpc_inject_latency_ms", "500"));
+  ASSERT_OK(conn.CopyBegin(Format("COPY $0 FROM STDIN WITH BINARY", kTableName)));
+  for (int i = 0; i != 2 * batch_size; ++i) {
+    conn.CopyStartRow(2);
+    conn.CopyPutInt32(i % batch_size);
+    conn.CopyPutString(Format("Value $0", i));
+  }
+  auto copy_result = conn.CopyEnd();
+  ASSERT_OK(cluster_->SetFlagOnTServers("write_rpc_inject_latency_ms", "0"));
+  if (copy_result.ok()) {
+    ASSERT_EQ(PQresultStatus(copy_result->get()), PGRES_FATAL_ERROR);
+  }
+
+  auto result = ASSERT_RESULT(conn.FetchFormat("SELECT COUNT(*) FROM $0", kTableName));
+  ASSERT_EQ(ASSERT_RESULT(GetInt64(result.get(), 0, 0)), 0);
+}
+
+TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(BulkCopyBatchesInFlight)) {
+  // Batches are sent while COPY keeps parsing its input, so several of them are in flight.
+  const std::string kTableName = "copy_in_flight";
+  constexpr int kNumBatches = 16;
+  constexpr int kWriteLatencyMs = 200;
+  const int num_rows = kNumBatches * FLAGS_ysql_session_max_batch_size;
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.ExecuteFormat("CREATE TABLE $0 (k INT PRIMARY KEY, v TEXT)", kTableName));
+
+  ASSERT_OK(cluster_->SetFlagOnTServers(
+      "write_rpc_inject_latency_ms", std::to_string(kWriteLatencyMs)));
+  auto start = MonoTime::Now();
+  ASSERT_OK(conn.CopyBegin(Format("COPY $0 FROM STDIN WITH BINARY", kTableName)));
+  for (int i = 0; i != num_rows; ++i) {
+    conn.CopyStartRow(2);
+    conn.CopyPutInt32(i);
+    conn.CopyPutString(Format("Value $0", i));
+  }
+  ASSERT_OK(conn.CopyEnd());
+  auto elapsed = MonoTime::Now() - start;
+  ASSERT_OK(cluster_->SetFlagOnTServers("write_rpc_inject_latency_ms", "0"));
+  LOG(INFO) << "Copied " << num_rows << " rows in " << elapsed;
+
+  // Each batch waits for its delayed write RPCs, so sending batches one by one would take at
+  // least kNumBatches * kWriteLatencyMs.
+  ASSERT_LT(elapsed.ToMilliseconds(), kNumBatches * kWriteLatencyMs);
+
+  auto result = ASSERT_RESULT(conn.FetchFormat("SELECT COUNT(*) FROM $0", kTableName));
+  ASSERT_EQ(ASSERT_RESULT(GetInt64(result.get(), 0, 0)), num_rows);
+}
+
+TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(HashKeyInLookup)) {
+  // Keys listed by IN are looked up by reads sent together, instead of scanning the whole table.
+  constexpr int kNumRows = 10000;
+  constexpr int kNumKeys = 100;
+  // Each table has one tablet per tablet server.
+  const int num_tablets = cluster_->num_tablet_servers();
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute("CREATE TABLE t (k INT PRIMARY KEY, v INT)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, i * 2 FROM generate_series(1, $0) AS i", kNumRows));
+
+  // Keys above kNumRows are missing, so half of the listed keys are found.
+  std::string keys;
+  for (int i = 0; i != kNumKeys; ++i) {
+    keys += Format("$0$1", i == 0 ? "" : ", ", (i + 1) * 200);
+  }
+  const auto query = Format("SELECT k, v FROM t WHERE k IN ($0)", keys);
+
+  auto read_rpcs = [this]() -> Result<int64_t> {
+    int64_t result = 0;
+    for (auto* tserver : cluster_->tserver_daemons()) {
+      int64_t value = 0;
+      RETURN_NOT_OK(tserver->GetInt64Metric(
+          &METRIC_ENTITY_server, "yb.tabletserver",
+          &METRIC_handler_latency_yb_tserver_TabletServerService_Read, "total_count", &value));
+      result += value;
+    }
+    return result;
+  };
+
+  auto check_result = [&conn, &query] {
+    auto res = ASSERT_RESULT(conn.Fetch(query));
+    ASSERT_EQ(PQntuples(res.get()), kNumKeys / 2);
+    for (int row = 0; row != kNumKeys / 2; ++row) {
+      auto k = ASSERT_RESULT(GetInt32(res.get(), row, 0));
+      ASSERT_EQ(k % 200, 0);
+      ASSERT_LE(k, kNumRows);
+      ASSERT_EQ(ASSERT_RESULT(GetInt32(res.get(), row, 1)), k * 2);
+    }
+  };
+
+  // Load the table and its locations first.
+  ASSERT_NO_FATALS(check_result());
+
+  auto read_rpcs_before = ASSERT_RESULT(read_rpcs());
+  ASSERT_NO_FATALS(check_result());
+  auto num_read_rpcs = ASSERT_RESULT(read_rpcs()) - read_rpcs_before;
+  LOG(INFO) << "Read RPCs: " << num_read_rpcs;
+  // A scan of the whole table would need more than kNumRows / ysql_prefetch_limit RPCs.
+  ASSERT_LE(num_read_rpcs, num_tablets * 2);
+
+  // Lookups of a compound hash key combine values of all its columns.
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE t2 (h1 INT, h2 TEXT, r INT, v INT, PRIMARY KEY ((h1, h2), r))"));
+  ASSERT_OK(conn.Execute(
+      "INSERT INTO t2 SELECT i % 10, (i % 7)::TEXT, i, i FROM generate_series(1, 1000) AS i"));
+  auto res = ASSERT_RESULT(conn.Fetch(
+      "SELECT r FROM t2 WHERE h1 IN (1, 3) AND h2 IN ('1', '4', 'none') "
+      "AND r IN (211, 213, 221, 431) ORDER BY r"));
+  ASSERT_EQ(PQntuples(res.get()), 3);
+  ASSERT_EQ(ASSERT_RESULT(GetInt32(res.get(), 0, 0)), 211);
+  ASSERT_EQ(ASSERT_RESULT(GetInt32(res.get(), 1, 0)), 221);
+  ASSERT_EQ(ASSERT_RESULT(GetInt32(res.get(), 2, 0)), 431);
+}
+
+class PgLibPqTableCacheTest : public PgLibPqTest {
+ protected:
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    options->extra_tserver_flags.emplace_back("--ysql_use_tserver_table_cache=true");
+  }
+};
+
+// Backends that start while the table is being altered should never load a schema older than
+// the last committed ALTER from the tablet server table cache.
+TEST_F(PgLibPqTableCacheTest, YB_DISABLE_TEST_IN_TSAN(ConcurrentAlterOnStartup)) {
+  constexpr int kNumAlters = 20;
+  constexpr int kStartupThreads = 4;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (k INT PRIMARY KEY)"));
+
+  std::atomic<int> last_altered(0);
+  std::atomic<int> startups(0);
+  TestThreadHolder thread_holder;
+
+  for (int i = 0; i != kStartupThreads; ++i) {
+    thread_holder.AddThreadFunctor(
+        [this, &last_altered, &startups, &stop = thread_holder.stop_flag()] {
+      while (!stop.load(std::memory_order_acquire)) {
+        auto altered = last_altered.load(std::memory_order_acquire);
+        auto startup_conn = ASSERT_RESULT(Connect());
+        auto res = startup_conn.Fetch(altered == 0
+            ? std::string("SELECT * FROM t")
+            : Format("SELECT c$0 FROM t", altered));
+        if (!res.ok()) {
+          auto msg = res.status().message().ToBuffer();
+          ASSERT_NE(msg.find("Catalog Version Mismatch"), std::string::npos) << res.status();
+          continue;
+        }
+        ++startups;
+      }
+    });
+  }
+
+  for (int i = 1; i <= kNumAlters; ++i) {
+    ASSERT_OK(conn.ExecuteFormat("ALTER TABLE t ADD COLUMN c$0 INT", i));
+    last_altered.store(i, std::memory_order_release);
+    std::this_thread::sleep_for(100ms);
+  }
+
+  thread_holder.Stop();
+
+  LOG(INFO) << "Backends started: " << startups.load();
+  ASSERT_GT(startups.load(), 0);
+
+  auto new_conn = ASSERT_RESULT(Connect());
+  auto res = ASSERT_RESULT(new_conn.Fetch("SELECT * FROM t"));
+  ASSERT_EQ(PQnfields(res.get()), kNumAlters + 1);
+}
+
 } // namespace pgwrapper
 } // namespace yb
@@ -270,6 +270,9 @@ Status PgWrapper::Start() {
   pg_proc_->ShareParentStdout();
   pg_proc_->SetParentDeathSignal(SIGINT);
   pg_proc_->InheritNonstandardFd(conf_.tserver_shm_fd);
+  if (conf_.tserver_shared_exchange_fd >= 0) {
+    pg_proc_->InheritNonstandardFd(conf_.tserver_shared_exchange_fd);
+  }
   SetCommonEnv(&pg_proc_.get(), /* yb_enabled */ true);
   RETURN_NOT_OK(pg_proc_->Start());
   LOG(INFO) << "PostgreSQL server running as pid " << pg_proc_->pid();
@@ -384,6 +387,8 @@ void PgWrapper::SetCommonEnv(Subprocess* proc, bool yb_enabled) {
     proc->SetEnv("YB_ENABLED_IN_POSTGRES", "1");
     proc->SetEnv("FLAGS_pggate_master_addresses", conf_.master_addresses);
     proc->SetEnv("FLAGS_pggate_tserver_shm_fd", std::to_string(conf_.tserver_shm_fd));
+    proc->SetEnv("FLAGS_pggate_tserver_shared_exchange_fd",
+                 std::to_string(conf_.tserver_shared_exchange_fd));
 
     proc->SetEnv("YB_PG_TRANSACTIONS_ENABLED", FLAGS_pg_transactions_enabled ? "1" : "0");
 
@@ -405,6 +410,7 @@ void PgWrapper::SetCommonEnv(Subprocess* proc, bool yb_enabled) {
       // Skip the flags that we set explicitly using conf_ above.
       if (flag_info.name != "pggate_master_addresses"
           && flag_info.name != "pggate_tserver_shm_fd"
+          && flag_info.name != "pggate_tserver_shared_exchange_fd"
           && !flag_info.is_default) {
         proc->SetEnv(env_var_name, flag_info.current_value);
       }
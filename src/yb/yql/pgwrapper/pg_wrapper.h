@@ -48,6 +48,9 @@ struct PgProcessConf {
 
   // File descriptor of the local tserver's shared memory.
   int tserver_shm_fd = -1;
+
+  // File descriptor of the shared memory exchange with the local tserver, -1 when not used.
+  int tserver_shared_exchange_fd = -1;
 };
 
 // Invokes a PostgreSQL child process once. Also allows invoking initdb. Not thread-safe.
@@ -106,6 +106,9 @@ namespace redisserver {
     ((zrevrange, ZRevRange, -4, READ)) \
     ((zrange, ZRange, -4, READ)) \
     ((zscore, ZScore, 3, READ)) \
+    ((zrank, ZRank, 3, READ)) \
+    ((zrevrank, ZRevRank, 3, READ)) \
+    ((zcount, ZCount, 4, READ)) \
     ((tsrem, TsRem, -3, WRITE)) \
     ((zrem, ZRem, -3, WRITE)) \
     ((zadd, ZAdd, -4, WRITE)) \
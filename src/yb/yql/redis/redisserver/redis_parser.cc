@@ -560,6 +560,7 @@ CHECKED_STATUS ParseTsBoundArg(const Slice& slice, RedisSubKeyBoundPB* bound_pb,
         bound_pb->mutable_subkey_bound()->set_timestamp_subkey(*ts_bound);
         break;
       }
+      case RedisCollectionGetRangeRequestPB_GetRangeRequestType_ZCOUNT: FALLTHROUGH_INTENDED;
       case RedisCollectionGetRangeRequestPB_GetRangeRequestType_ZRANGEBYSCORE: {
         auto double_bound = util::CheckedStold(slice);
         RETURN_NOT_OK(double_bound);
@@ -743,6 +744,23 @@ CHECKED_STATUS ParseZRangeByScore(YBRedisReadOp* op, const RedisClientCommand& a
   return ParseRangeByScoreOptions(op, args);
 }
 
+CHECKED_STATUS ParseZCount(YBRedisReadOp* op, const RedisClientCommand& args) {
+  op->mutable_request()->mutable_get_collection_range_request()->set_request_type(
+      RedisCollectionGetRangeRequestPB_GetRangeRequestType_ZCOUNT);
+
+  const auto& key = args[1];
+  RETURN_NOT_OK(ParseTsSubKeyBound(
+      args[2],
+      op->mutable_request()->mutable_subkey_range()->mutable_lower_bound(),
+      RedisCollectionGetRangeRequestPB_GetRangeRequestType_ZCOUNT));
+  RETURN_NOT_OK(ParseTsSubKeyBound(
+      args[3],
+      op->mutable_request()->mutable_subkey_range()->mutable_upper_bound(),
+      RedisCollectionGetRangeRequestPB_GetRangeRequestType_ZCOUNT));
+  op->mutable_request()->mutable_key_value()->set_key(key.ToBuffer());
+  return Status::OK();
+}
+
 CHECKED_STATUS ParseIndexBasedQuery(
     YBRedisReadOp* op,
     const RedisClientCommand& args,
@@ -804,6 +822,27 @@ CHECKED_STATUS ParseZScore(YBRedisReadOp* op, const RedisClientCommand& args) {
   return Status::OK();
 }
 
+CHECKED_STATUS ParseZRankLikeCommands(
+    YBRedisReadOp* op, const RedisClientCommand& args,
+    RedisGetRequestPB_GetRequestType request_type) {
+  op->mutable_request()->mutable_get_request()->set_request_type(request_type);
+
+  const auto& key = args[1];
+  op->mutable_request()->mutable_key_value()->set_key(key.cdata(), key.size());
+  auto member = args[2].ToBuffer();
+  op->mutable_request()->mutable_key_value()->add_subkey()->set_string_subkey(member);
+
+  return Status::OK();
+}
+
+CHECKED_STATUS ParseZRank(YBRedisReadOp* op, const RedisClientCommand& args) {
+  return ParseZRankLikeCommands(op, args, RedisGetRequestPB_GetRequestType_ZRANK);
+}
+
+CHECKED_STATUS ParseZRevRank(YBRedisReadOp* op, const RedisClientCommand& args) {
+  return ParseZRankLikeCommands(op, args, RedisGetRequestPB_GetRequestType_ZREVRANK);
+}
+
 CHECKED_STATUS ParseHStrLen(YBRedisReadOp* op, const RedisClientCommand& args) {
   return ParseHGetLikeCommands(op, args, RedisGetRequestPB_GetRequestType_HSTRLEN);
 }
@@ -49,6 +49,7 @@ DECLARE_uint64(redis_max_queued_bytes);
 DECLARE_int64(redis_rpc_block_size);
 DECLARE_bool(redis_safe_batch);
 DECLARE_bool(emulate_redis_responses);
+DECLARE_bool(redis_sorted_set_block_counts);
 DECLARE_bool(test_tserver_timeout);
 DECLARE_bool(enable_backpressure_mode_for_testing);
 DECLARE_bool(yedis_enable_flush);
@@ -3659,6 +3660,97 @@ TEST_F(TestRedisService, TestZScore) {
   VerifyCallbacks();
 }
 
+TEST_F(TestRedisService, TestZRankAndZCount) {
+  // The default value is true, but we explicitly set this here for clarity.
+  FLAGS_emulate_redis_responses = true;
+  FLAGS_redis_sorted_set_block_counts = true;
+  // Scores are picked so members fall into different score blocks.
+  DoRedisTestInt(__LINE__, {"ZADD", "z_multi", "-1000.5", "v0", "0", "v1", "0", "v2",
+      "1", "v3", "100", "v4", "100", "v5", "1e9", "v6"}, 7);
+  SyncClient();
+
+  DoRedisTestInt(__LINE__, {"ZRANK", "z_multi", "v0"}, 0);
+  DoRedisTestInt(__LINE__, {"ZRANK", "z_multi", "v2"}, 2);
+  DoRedisTestInt(__LINE__, {"ZRANK", "z_multi", "v5"}, 5);
+  DoRedisTestInt(__LINE__, {"ZRANK", "z_multi", "v6"}, 6);
+  DoRedisTestInt(__LINE__, {"ZREVRANK", "z_multi", "v6"}, 0);
+  DoRedisTestInt(__LINE__, {"ZREVRANK", "z_multi", "v1"}, 5);
+  DoRedisTestNull(__LINE__, {"ZRANK", "z_multi", "v_no_exist"});
+  DoRedisTestNull(__LINE__, {"ZREVRANK", "z_no_exist", "v0"});
+
+  DoRedisTestInt(__LINE__, {"ZCOUNT", "z_multi", "-inf", "+inf"}, 7);
+  DoRedisTestInt(__LINE__, {"ZCOUNT", "z_multi", "0", "100"}, 5);
+  DoRedisTestInt(__LINE__, {"ZCOUNT", "z_multi", "(0", "(100"}, 1);
+  DoRedisTestInt(__LINE__, {"ZCOUNT", "z_multi", "-2000", "0"}, 3);
+  DoRedisTestInt(__LINE__, {"ZCOUNT", "z_multi", "1", "1e10"}, 4);
+  DoRedisTestInt(__LINE__, {"ZCOUNT", "z_multi", "100", "0"}, 0);
+  DoRedisTestInt(__LINE__, {"ZCOUNT", "z_no_exist", "-inf", "+inf"}, 0);
+
+  DoRedisTestArray(__LINE__, {"ZRANGE", "z_multi", "4", "5"}, {"v4", "v5"});
+  DoRedisTestArray(__LINE__, {"ZRANGE", "z_multi", "5", "100"}, {"v5", "v6"});
+  DoRedisTestArray(__LINE__, {"ZREVRANGE", "z_multi", "0", "1"}, {"v6", "v5"});
+
+  // Move and remove members, so block counts are updated.
+  DoRedisTestInt(__LINE__, {"ZADD", "z_multi", "-5000", "v6"}, 0);
+  DoRedisTestInt(__LINE__, {"ZREM", "z_multi", "v3"}, 1);
+  SyncClient();
+
+  DoRedisTestInt(__LINE__, {"ZRANK", "z_multi", "v6"}, 0);
+  DoRedisTestInt(__LINE__, {"ZRANK", "z_multi", "v4"}, 4);
+  DoRedisTestInt(__LINE__, {"ZREVRANK", "z_multi", "v0"}, 4);
+  DoRedisTestInt(__LINE__, {"ZCOUNT", "z_multi", "-inf", "+inf"}, 6);
+  DoRedisTestInt(__LINE__, {"ZCOUNT", "z_multi", "-inf", "(0"}, 2);
+  DoRedisTestArray(__LINE__, {"ZRANGE", "z_multi", "3", "4"}, {"v2", "v4"});
+
+  DoRedisTestExpectError(__LINE__, {"ZRANK", "z_multi"});
+  DoRedisTestExpectError(__LINE__, {"ZCOUNT", "z_multi", "0"});
+  DoRedisTestExpectError(__LINE__, {"ZCOUNT", "z_multi", "a", "b"});
+
+  // Test key with wrong type.
+  DoRedisTestOk(__LINE__, {"SET", "s_key", "s_val"});
+  DoRedisTestExpectError(__LINE__, {"ZRANK", "s_key", "v0"});
+  DoRedisTestExpectError(__LINE__, {"ZCOUNT", "s_key", "0", "1"});
+
+  SyncClient();
+  VerifyCallbacks();
+}
+
+TEST_F(TestRedisService, TestZRangeSkipsBlocks) {
+  FLAGS_emulate_redis_responses = true;
+  // Create the set without block counts, so they are rebuilt by the first write after enabling.
+  FLAGS_redis_sorted_set_block_counts = false;
+  // Scores are in different score blocks, and each score has several members.
+  DoRedisTestInt(__LINE__, {"ZADD", "z_blocks", "1", "a0", "1", "a1", "1", "a2",
+      "2", "b0", "2", "b1", "2", "b2"}, 6);
+  SyncClient();
+  FLAGS_redis_sorted_set_block_counts = true;
+  DoRedisTestInt(__LINE__, {"ZADD", "z_blocks", "3", "c0", "3", "c1", "3", "c2"}, 3);
+  SyncClient();
+
+  // Ranges start after skipped blocks, in the middle of a block.
+  DoRedisTestArray(__LINE__, {"ZRANGE", "z_blocks", "4", "7"}, {"b1", "b2", "c0", "c1"});
+  DoRedisTestArray(__LINE__, {"ZRANGE", "z_blocks", "6", "6"}, {"c0"});
+  DoRedisTestArray(__LINE__, {"ZRANGE", "z_blocks", "8", "100"}, {"c2"});
+  DoRedisTestArray(__LINE__, {"ZREVRANGE", "z_blocks", "1", "3"}, {"c1", "c0", "b2"});
+  DoRedisTestArray(__LINE__, {"ZRANGEBYSCORE", "z_blocks", "2", "3", "LIMIT", "1", "3"},
+      {"b1", "b2", "c0"});
+  DoRedisTestInt(__LINE__, {"ZRANK", "z_blocks", "b1"}, 4);
+  DoRedisTestInt(__LINE__, {"ZCOUNT", "z_blocks", "(1", "+inf"}, 6);
+
+  // Counts modified while disabled are not used after enabling them again.
+  FLAGS_redis_sorted_set_block_counts = false;
+  DoRedisTestInt(__LINE__, {"ZADD", "z_blocks", "2", "b3"}, 1);
+  DoRedisTestInt(__LINE__, {"ZREM", "z_blocks", "a0"}, 1);
+  SyncClient();
+  FLAGS_redis_sorted_set_block_counts = true;
+  DoRedisTestArray(__LINE__, {"ZRANGE", "z_blocks", "4", "6"}, {"b2", "b3", "c0"});
+  DoRedisTestInt(__LINE__, {"ZRANK", "z_blocks", "c0"}, 6);
+  DoRedisTestInt(__LINE__, {"ZCOUNT", "z_blocks", "2", "2"}, 4);
+
+  SyncClient();
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestTimeSeriesTTL) {
   int64_t ttl_sec = 10;
   TestTSTtl("EXPIRE_IN", ttl_sec, ttl_sec, "test_expire_in");